@@ -0,0 +1,498 @@
+/**
+ * @file xf_ble_aes.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 软件 AES-128 (仅加密，即安全函数 e)。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_ble_aes.h"
+
+#if XF_BLE_IS_ENABLE
+
+#if XF_BLE_AES_AESNI_ENABLE
+#include <wmmintrin.h>
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+#define AES_LANE_BITS       (16)            /*!< 每个分组在位平面字中占用的位数 */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* 位平面字：每 16 位一段，各段为一个分组 */
+#if (XF_BLE_AES_BATCH_NUM == 4)
+typedef uint64_t aes_word_t;
+#else
+typedef uint32_t aes_word_t;
+#endif
+
+/* ==================== [Static Prototypes] ================================= */
+
+#if XF_BLE_AES_AESNI_ENABLE
+static __m128i aes_aesni_expand(__m128i k, __m128i assist);
+#else
+static void aes_rounds(aes_word_t q[8], const xf_ble_aes_ctx_t *const ctx_list[XF_BLE_AES_BATCH_NUM]);
+static void aes_add_round_key(aes_word_t q[8], const xf_ble_aes_ctx_t *const ctx_list[XF_BLE_AES_BATCH_NUM],
+                              uint8_t r);
+static void aes_shift_rows(aes_word_t q[8]);
+static void aes_mix_columns(aes_word_t q[8]);
+static void aes_bitslice_pack(aes_word_t q[8], const uint8_t s[XF_BLE_AES_BLOCK_SIZE]);
+static void aes_bitslice_unpack(uint8_t s[XF_BLE_AES_BLOCK_SIZE], const aes_word_t q[8]);
+static void aes_sbox_bitslice(aes_word_t q[8]);
+static void aes_wipe(void *buf, uint32_t len);
+#endif
+
+/* ==================== [Static Variables] ================================== */
+
+#if !XF_BLE_AES_AESNI_ENABLE
+static const uint8_t s_rcon[10] = {
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36,
+};
+#endif
+
+/* ==================== [Macros] ============================================ */
+
+#if XF_BLE_AES_AESNI_ENABLE
+/* 生成第 i 轮密钥并保存 (AESKEYGENASSIST 的 rcon 须为立即数) */
+#define AES_AESNI_EXPAND(rk, k, i, rcon) do { \
+        (k) = aes_aesni_expand((k), _mm_aeskeygenassist_si128((k), (rcon))); \
+        _mm_storeu_si128((__m128i *)&(rk)[XF_BLE_AES_BLOCK_SIZE * (i)], (k)); \
+    } while (0)
+#else
+/* 16 位常数复制到位平面字的各段 */
+#define AES_LANES(m)        ((aes_word_t)(m) * (((aes_word_t)-1) / 0xFFFF))
+#endif
+
+/* ==================== [Global Functions] ================================== */
+
+uint32_t xf_ble_aes_ah(const xf_ble_aes_ctx_t *ctx, uint32_t prand)
+{
+    uint32_t hash;
+    xf_ble_aes_ah_batch(&ctx, 1, prand, &hash);
+    return hash;
+}
+
+#if XF_BLE_AES_AESNI_ENABLE
+
+/**
+ * @brief 密钥扩展 (AESKEYGENASSIST)
+ */
+void xf_ble_aes_set_key(xf_ble_aes_ctx_t *ctx, const uint8_t key[XF_BLE_AES_BLOCK_SIZE])
+{
+    __m128i k = _mm_loadu_si128((const __m128i *)key);
+    _mm_storeu_si128((__m128i *)&ctx->rk[0], k);
+    AES_AESNI_EXPAND(ctx->rk, k, 1, 0x01);
+    AES_AESNI_EXPAND(ctx->rk, k, 2, 0x02);
+    AES_AESNI_EXPAND(ctx->rk, k, 3, 0x04);
+    AES_AESNI_EXPAND(ctx->rk, k, 4, 0x08);
+    AES_AESNI_EXPAND(ctx->rk, k, 5, 0x10);
+    AES_AESNI_EXPAND(ctx->rk, k, 6, 0x20);
+    AES_AESNI_EXPAND(ctx->rk, k, 7, 0x40);
+    AES_AESNI_EXPAND(ctx->rk, k, 8, 0x80);
+    AES_AESNI_EXPAND(ctx->rk, k, 9, 0x1B);
+    AES_AESNI_EXPAND(ctx->rk, k, 10, 0x36);
+}
+
+void xf_ble_aes_encrypt(const xf_ble_aes_ctx_t *ctx,
+                        const uint8_t in[XF_BLE_AES_BLOCK_SIZE], uint8_t out[XF_BLE_AES_BLOCK_SIZE])
+{
+    const __m128i *rk = (const __m128i *)ctx->rk;
+    __m128i s = _mm_xor_si128(_mm_loadu_si128((const __m128i *)in), _mm_loadu_si128(&rk[0]));
+    for (uint8_t r = 1; r < 10; r++) {
+        s = _mm_aesenc_si128(s, _mm_loadu_si128(&rk[r]));
+    }
+    s = _mm_aesenclast_si128(s, _mm_loadu_si128(&rk[10]));
+    _mm_storeu_si128((__m128i *)out, s);
+}
+
+void xf_ble_aes_ah_batch(const xf_ble_aes_ctx_t *const ctx_list[], uint8_t num,
+                         uint32_t prand, uint32_t hash_list[])
+{
+    /* 明文 = 0 (13 字节) || prand (3 字节) */
+    uint8_t b[XF_BLE_AES_BLOCK_SIZE] = {0};
+    b[13] = (uint8_t)(prand >> 16);
+    b[14] = (uint8_t)(prand >> 8);
+    b[15] = (uint8_t)prand;
+    for (uint8_t i = 0; i < num; i++) {
+        uint8_t c[XF_BLE_AES_BLOCK_SIZE];
+        xf_ble_aes_encrypt(ctx_list[i], b, c);
+        hash_list[i] = ((uint32_t)c[13] << 16) | ((uint32_t)c[14] << 8) | c[15];
+    }
+}
+
+#else
+
+/**
+ * @brief 密钥扩展直接在位平面形式下进行 (S 盒同样为位切片实现)，轮密钥只占各平面的第 0 段
+ */
+void xf_ble_aes_set_key(xf_ble_aes_ctx_t *ctx, const uint8_t key[XF_BLE_AES_BLOCK_SIZE])
+{
+    aes_word_t q[8];
+    aes_bitslice_pack(q, key);
+    for (uint8_t b = 0; b < 8; b++) {
+        ctx->rk[0][b] = (uint16_t)q[b];
+    }
+    for (uint8_t r = 1; r <= 10; r++) {
+        const uint16_t *prev = ctx->rk[r - 1];
+        /* RotWord: 上一轮密钥的字 3 (第 12 ~ 15 位) 循环移动一个字节后放到第 0 ~ 3 位 */
+        for (uint8_t b = 0; b < 8; b++) {
+            q[b] = ((prev[b] >> 13) & 0x7) | ((prev[b] >> 9) & 0x8);
+        }
+        aes_sbox_bitslice(q);
+        for (uint8_t b = 0; b < 8; b++) {
+            /* w[i] = w[i - 4] ^ ... ^ w[i - 4 + j] ^ T ：对 4 个字做前缀异或，再异或复制到各字的 T */
+            uint32_t t = ((uint32_t)q[b] & 0xF) ^ ((s_rcon[r - 1] >> b) & 1);
+            t |= t << 4;
+            t |= t << 8;
+            uint32_t x = prev[b];
+            x ^= x << 4;
+            x ^= x << 8;
+            ctx->rk[r][b] = (uint16_t)(x ^ t);
+        }
+    }
+    aes_wipe(q, sizeof(q));
+}
+
+void xf_ble_aes_encrypt(const xf_ble_aes_ctx_t *ctx,
+                        const uint8_t in[XF_BLE_AES_BLOCK_SIZE], uint8_t out[XF_BLE_AES_BLOCK_SIZE])
+{
+    const xf_ble_aes_ctx_t *ctx_list[XF_BLE_AES_BATCH_NUM];
+    for (uint8_t l = 0; l < XF_BLE_AES_BATCH_NUM; l++) {
+        ctx_list[l] = ctx;
+    }
+    aes_word_t q[8];
+    aes_bitslice_pack(q, in);
+    aes_rounds(q, ctx_list);
+    aes_bitslice_unpack(out, q);
+    aes_wipe(q, sizeof(q));
+}
+
+void xf_ble_aes_ah_batch(const xf_ble_aes_ctx_t *const ctx_list[], uint8_t num,
+                         uint32_t prand, uint32_t hash_list[])
+{
+    const xf_ble_aes_ctx_t *batch[XF_BLE_AES_BATCH_NUM];
+    aes_word_t q[8];
+    for (uint8_t i = 0; i < num; i += XF_BLE_AES_BATCH_NUM) {
+        uint8_t n = ((num - i) < XF_BLE_AES_BATCH_NUM) ? (uint8_t)(num - i) : XF_BLE_AES_BATCH_NUM;
+        /* 不足一批时以最后一个补齐空闲的段 */
+        for (uint8_t l = 0; l < XF_BLE_AES_BATCH_NUM; l++) {
+            batch[l] = ctx_list[i + ((l < n) ? l : (n - 1))];
+        }
+        /* 明文 = 0 (13 字节) || prand (3 字节)：字节 13 ~ 15 即各平面的第 13 ~ 15 位，各段相同 */
+        for (uint8_t b = 0; b < 8; b++) {
+            uint32_t x = (((prand >> (16 + b)) & 1) << 13) | (((prand >> (8 + b)) & 1) << 14)
+                         | (((prand >> b) & 1) << 15);
+            q[b] = AES_LANES(x);
+        }
+        aes_rounds(q, batch);
+        /* 哈希为密文的字节 13 ~ 15 */
+        for (uint8_t l = 0; l < n; l++) {
+            uint32_t hash = 0;
+            for (uint8_t b = 0; b < 8; b++) {
+                uint32_t x = (uint32_t)(q[b] >> (AES_LANE_BITS * l));
+                hash |= (((x >> 13) & 1) << (16 + b)) | (((x >> 14) & 1) << (8 + b)) | (((x >> 15) & 1) << b);
+            }
+            hash_list[i + l] = hash;
+        }
+    }
+    aes_wipe(q, sizeof(q));
+}
+
+#endif /* XF_BLE_AES_AESNI_ENABLE */
+
+/* ==================== [Static Functions] ================================== */
+
+#if XF_BLE_AES_AESNI_ENABLE
+
+static __m128i aes_aesni_expand(__m128i k, __m128i assist)
+{
+    assist = _mm_shuffle_epi32(assist, 0xFF);
+    k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+    k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+    k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+    return _mm_xor_si128(k, assist);
+}
+
+#else
+
+/**
+ * @brief 10 轮加密，状态在各轮间始终保持位平面形式；第 l 段使用 ctx_list[l] 的轮密钥
+ */
+static void aes_rounds(aes_word_t q[8], const xf_ble_aes_ctx_t *const ctx_list[XF_BLE_AES_BATCH_NUM])
+{
+    aes_add_round_key(q, ctx_list, 0);
+    for (uint8_t r = 1; r <= 10; r++) {
+        aes_sbox_bitslice(q);
+        aes_shift_rows(q);
+        if (r < 10) {
+            aes_mix_columns(q);
+        }
+        aes_add_round_key(q, ctx_list, r);
+    }
+}
+
+static void aes_add_round_key(aes_word_t q[8], const xf_ble_aes_ctx_t *const ctx_list[XF_BLE_AES_BATCH_NUM],
+                              uint8_t r)
+{
+    for (uint8_t l = 0; l < XF_BLE_AES_BATCH_NUM; l++) {
+        const uint16_t *rk = ctx_list[l]->rk[r];
+        for (uint8_t b = 0; b < 8; b++) {
+            q[b] ^= (aes_word_t)rk[b] << (AES_LANE_BITS * l);
+        }
+    }
+}
+
+/**
+ * @brief 位平面形式的 ShiftRows: 字节 i (行 i % 4 ，列 i / 4) 对应各段的第 i 位，
+ *  第 r 行左移 r 列即段内循环右移 4r 位后取该行的位
+ */
+static void aes_shift_rows(aes_word_t q[8])
+{
+    for (uint8_t b = 0; b < 8; b++) {
+        aes_word_t x = q[b];
+        q[b] = (x & AES_LANES(0x1111))
+               | ((x >> 4) & AES_LANES(0x0222)) | ((x << 12) & AES_LANES(0x2000))
+               | ((x >> 8) & AES_LANES(0x0044)) | ((x << 8) & AES_LANES(0x4400))
+               | ((x >> 12) & AES_LANES(0x0008)) | ((x << 4) & AES_LANES(0x8880));
+    }
+}
+
+/**
+ * @brief 位平面形式的 MixColumns:
+ *  out[r] = xtime(a[r] ^ a[r + 1]) ^ a[r + 1] ^ a[r + 2] ^ a[r + 3] ，列内取行 r + k 即 4 位内的循环移位，
+ *  其中 a[r + 2] ^ a[r + 3] 即 a[r] ^ a[r + 1] 再移两行
+ */
+static void aes_mix_columns(aes_word_t q[8])
+{
+    aes_word_t t[8];
+    aes_word_t o[8];
+    for (uint8_t b = 0; b < 8; b++) {
+        aes_word_t x = q[b];
+        aes_word_t r1 = ((x >> 1) & AES_LANES(0x7777)) | ((x << 3) & AES_LANES(0x8888));
+        t[b] = x ^ r1;
+        o[b] = r1 ^ ((t[b] >> 2) & AES_LANES(0x3333)) ^ ((t[b] << 2) & AES_LANES(0xCCCC));
+    }
+    /* xtime: 平面整体上移一位，最高位平面按 0x1B 反馈到第 0 、 1 、 3 、 4 位 */
+    q[0] = o[0] ^ t[7];
+    q[1] = o[1] ^ t[0] ^ t[7];
+    q[2] = o[2] ^ t[1];
+    q[3] = o[3] ^ t[2] ^ t[7];
+    q[4] = o[4] ^ t[3] ^ t[7];
+    q[5] = o[5] ^ t[4];
+    q[6] = o[6] ^ t[5];
+    q[7] = o[7] ^ t[6];
+}
+
+/**
+ * @brief 16 字节拆为 8 个位平面 (第 0 段)， q[b] 的第 i 位为字节 i 的第 b 位
+ */
+static void aes_bitslice_pack(aes_word_t q[8], const uint8_t s[XF_BLE_AES_BLOCK_SIZE])
+{
+    /* 每 4 字节为一个字，字节 k 位于第 8k 位；乘法将 4 个字节的同一位收拢到相邻 4 位 (无进位) */
+    uint32_t w[4];
+    for (uint8_t j = 0; j < 4; j++) {
+        w[j] = (uint32_t)s[4 * j] | ((uint32_t)s[4 * j + 1] << 8)
+               | ((uint32_t)s[4 * j + 2] << 16) | ((uint32_t)s[4 * j + 3] << 24);
+    }
+    for (uint8_t b = 0; b < 8; b++) {
+        uint32_t x = 0;
+        for (uint8_t j = 0; j < 4; j++) {
+            x |= ((((w[j] >> b) & 0x01010101) * 0x01020408) >> 24) << (4 * j);
+        }
+        q[b] = x;
+    }
+}
+
+/**
+ * @brief 第 0 段的 8 个位平面合并为 16 字节 (aes_bitslice_pack() 的逆变换)
+ */
+static void aes_bitslice_unpack(uint8_t s[XF_BLE_AES_BLOCK_SIZE], const aes_word_t q[8])
+{
+    for (uint8_t j = 0; j < 4; j++) {
+        uint32_t w = 0;
+        for (uint8_t b = 0; b < 8; b++) {
+            w |= (((((uint32_t)q[b] >> (4 * j)) & 0x0F) * 0x00204081) & 0x01010101) << b;
+        }
+        s[4 * j] = (uint8_t)w;
+        s[4 * j + 1] = (uint8_t)(w >> 8);
+        s[4 * j + 2] = (uint8_t)(w >> 16);
+        s[4 * j + 3] = (uint8_t)(w >> 24);
+    }
+}
+
+/**
+ * @brief AES S 盒的位切片电路 (Boyar-Peralta ，113 个门)， q[b] 为各字节的第 b 位
+ */
+static void aes_sbox_bitslice(aes_word_t q[8])
+{
+    aes_word_t x0, x1, x2, x3, x4, x5, x6, x7;
+    aes_word_t y1, y2, y3, y4, y5, y6, y7, y8, y9;
+    aes_word_t y10, y11, y12, y13, y14, y15, y16, y17, y18, y19;
+    aes_word_t y20, y21;
+    aes_word_t z0, z1, z2, z3, z4, z5, z6, z7, z8, z9;
+    aes_word_t z10, z11, z12, z13, z14, z15, z16, z17;
+    aes_word_t t0, t1, t2, t3, t4, t5, t6, t7, t8, t9;
+    aes_word_t t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+    aes_word_t t20, t21, t22, t23, t24, t25, t26, t27, t28, t29;
+    aes_word_t t30, t31, t32, t33, t34, t35, t36, t37, t38, t39;
+    aes_word_t t40, t41, t42, t43, t44, t45, t46, t47, t48, t49;
+    aes_word_t t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+    aes_word_t t60, t61, t62, t63, t64, t65, t66, t67;
+    aes_word_t s0, s1, s2, s3, s4, s5, s6, s7;
+
+    x0 = q[7];
+    x1 = q[6];
+    x2 = q[5];
+    x3 = q[4];
+    x4 = q[3];
+    x5 = q[2];
+    x6 = q[1];
+    x7 = q[0];
+
+    /* 顶部线性变换 */
+    y14 = x3 ^ x5;
+    y13 = x0 ^ x6;
+    y9 = x0 ^ x3;
+    y8 = x0 ^ x5;
+    t0 = x1 ^ x2;
+    y1 = t0 ^ x7;
+    y4 = y1 ^ x3;
+    y12 = y13 ^ y14;
+    y2 = y1 ^ x0;
+    y5 = y1 ^ x6;
+    y3 = y5 ^ y8;
+    t1 = x4 ^ y12;
+    y15 = t1 ^ x5;
+    y20 = t1 ^ x1;
+    y6 = y15 ^ x7;
+    y10 = y15 ^ t0;
+    y11 = y20 ^ y9;
+    y7 = x7 ^ y11;
+    y17 = y10 ^ y11;
+    y19 = y10 ^ y8;
+    y16 = t0 ^ y11;
+    y21 = y13 ^ y16;
+    y18 = x0 ^ y16;
+
+    /* 非线性部分 (GF(2^8) 求逆) */
+    t2 = y12 & y15;
+    t3 = y3 & y6;
+    t4 = t3 ^ t2;
+    t5 = y4 & x7;
+    t6 = t5 ^ t2;
+    t7 = y13 & y16;
+    t8 = y5 & y1;
+    t9 = t8 ^ t7;
+    t10 = y2 & y7;
+    t11 = t10 ^ t7;
+    t12 = y9 & y11;
+    t13 = y14 & y17;
+    t14 = t13 ^ t12;
+    t15 = y8 & y10;
+    t16 = t15 ^ t12;
+    t17 = t4 ^ t14;
+    t18 = t6 ^ t16;
+    t19 = t9 ^ t14;
+    t20 = t11 ^ t16;
+    t21 = t17 ^ y20;
+    t22 = t18 ^ y19;
+    t23 = t19 ^ y21;
+    t24 = t20 ^ y18;
+    t25 = t21 ^ t22;
+    t26 = t21 & t23;
+    t27 = t24 ^ t26;
+    t28 = t25 & t27;
+    t29 = t28 ^ t22;
+    t30 = t23 ^ t24;
+    t31 = t22 ^ t26;
+    t32 = t31 & t30;
+    t33 = t32 ^ t24;
+    t34 = t23 ^ t33;
+    t35 = t27 ^ t33;
+    t36 = t24 & t35;
+    t37 = t36 ^ t34;
+    t38 = t27 ^ t36;
+    t39 = t29 & t38;
+    t40 = t25 ^ t39;
+    t41 = t40 ^ t37;
+    t42 = t29 ^ t33;
+    t43 = t29 ^ t40;
+    t44 = t33 ^ t37;
+    t45 = t42 ^ t41;
+    z0 = t44 & y15;
+    z1 = t37 & y6;
+    z2 = t33 & x7;
+    z3 = t43 & y16;
+    z4 = t40 & y1;
+    z5 = t29 & y7;
+    z6 = t42 & y11;
+    z7 = t45 & y17;
+    z8 = t41 & y10;
+    z9 = t44 & y12;
+    z10 = t37 & y3;
+    z11 = t33 & y4;
+    z12 = t43 & y13;
+    z13 = t40 & y5;
+    z14 = t29 & y2;
+    z15 = t42 & y9;
+    z16 = t45 & y14;
+    z17 = t41 & y8;
+
+    /* 底部线性变换 */
+    t46 = z15 ^ z16;
+    t47 = z10 ^ z11;
+    t48 = z5 ^ z13;
+    t49 = z9 ^ z10;
+    t50 = z2 ^ z12;
+    t51 = z2 ^ z5;
+    t52 = z7 ^ z8;
+    t53 = z0 ^ z3;
+    t54 = z6 ^ z7;
+    t55 = z16 ^ z17;
+    t56 = z12 ^ t48;
+    t57 = t50 ^ t53;
+    t58 = z4 ^ t46;
+    t59 = z3 ^ t54;
+    t60 = t46 ^ t57;
+    t61 = z14 ^ t57;
+    t62 = t52 ^ t58;
+    t63 = t49 ^ t58;
+    t64 = z4 ^ t59;
+    t65 = t61 ^ t62;
+    t66 = z1 ^ t63;
+    s0 = t59 ^ t63;
+    s6 = t56 ^ ~t62;
+    s7 = t48 ^ ~t60;
+    t67 = t64 ^ t65;
+    s3 = t53 ^ t66;
+    s4 = t51 ^ t66;
+    s5 = t47 ^ t65;
+    s1 = t64 ^ ~s3;
+    s2 = t55 ^ ~t67;
+
+    q[7] = s0;
+    q[6] = s1;
+    q[5] = s2;
+    q[4] = s3;
+    q[3] = s4;
+    q[2] = s5;
+    q[1] = s6;
+    q[0] = s7;
+}
+
+static void aes_wipe(void *buf, uint32_t len)
+{
+    volatile uint8_t *p = (volatile uint8_t *)buf;
+    while (len--) {
+        *p++ = 0;
+    }
+}
+
+#endif /* XF_BLE_AES_AESNI_ENABLE */
+
+#endif /* XF_BLE_IS_ENABLE */
@@ -0,0 +1,124 @@
+/**
+ * @file xf_ble_aes.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 软件 AES-128 (仅加密，即安全函数 e)。
+ *  供无硬件加密的平台使用：位切片实现，状态及轮密钥始终为 8 个位平面 (位平面的第 i 位对应第 i 字节)，
+ *  S 盒为布尔电路，无查表，运算与密钥无关 (常数时间)。
+ *  位平面按字长并行多个分组，同一随机数对多个 IRK 计算 ah 时可批量进行 (见 xf_ble_aes_ah_batch())。
+ *  x86 主机构建可改用 AES-NI 指令 (见 XF_BLE_AES_AESNI_ENABLE)。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_AES_H__
+#define __XF_BLE_AES_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief BLE AES-128 分组及密钥长度 (字节)
+ */
+#define XF_BLE_AES_BLOCK_SIZE           (16)
+
+/**
+ * @brief BLE AES-128 位平面字并行的分组数，即 xf_ble_aes_ah_batch() 一轮运算处理的 IRK 数:
+ *  64 位平台为 4 (64 位字)，其余为 2 (32 位字)
+ */
+#if (UINTPTR_MAX > 0xFFFFFFFFu)
+#define XF_BLE_AES_BATCH_NUM            (4)
+#else
+#define XF_BLE_AES_BATCH_NUM            (2)
+#endif
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE AES-128 上下文 (展开后的轮密钥)
+ */
+typedef struct {
+#if XF_BLE_AES_AESNI_ENABLE
+    uint8_t rk[11 * XF_BLE_AES_BLOCK_SIZE]; /*!< 轮密钥 (字节序同 FIPS-197) */
+#else
+    uint16_t rk[11][8];                     /*!< 轮密钥 (11 轮 * 8 个位平面) */
+#endif
+} xf_ble_aes_ctx_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE AES-128: 设置密钥 (展开轮密钥)
+ *
+ * @note 上下文含密钥信息，不再使用时应清零
+ * @param[out] ctx 上下文，见 @ref xf_ble_aes_ctx_t
+ * @param key 密钥 (16 字节， MSB 在前，同蓝牙核心规范中安全函数 e 的 key)
+ */
+void xf_ble_aes_set_key(xf_ble_aes_ctx_t *ctx, const uint8_t key[XF_BLE_AES_BLOCK_SIZE]);
+
+/**
+ * @brief BLE AES-128: 加密一个分组
+ *
+ * @param ctx 上下文，见 @ref xf_ble_aes_ctx_t
+ * @param in 明文 (16 字节， MSB 在前)
+ * @param[out] out 密文 (16 字节， MSB 在前)，可与 in 相同
+ */
+void xf_ble_aes_encrypt(const xf_ble_aes_ctx_t *ctx,
+                        const uint8_t in[XF_BLE_AES_BLOCK_SIZE], uint8_t out[XF_BLE_AES_BLOCK_SIZE]);
+
+/**
+ * @brief BLE AES-128: 随机地址哈希函数 ah(k, r) = e(k, 0 || r) mod 2^24
+ *
+ * @param ctx 以 IRK 为密钥的上下文，见 @ref xf_ble_aes_ctx_t
+ * @param prand 24 位随机数 (低 24 位有效)
+ * @return uint32_t 24 位哈希值
+ */
+uint32_t xf_ble_aes_ah(const xf_ble_aes_ctx_t *ctx, uint32_t prand);
+
+/**
+ * @brief BLE AES-128: 以同一随机数对多个 IRK 批量计算 ah
+ *
+ * @details 每 XF_BLE_AES_BATCH_NUM 个 IRK 共用一次位切片运算 (各占位平面字中的一段)，
+ *  明文相同，只需转换一次；耗时与单个 xf_ble_aes_ah() 相当。
+ *  使用 AES-NI 时逐个计算 (各分组互不依赖，指令可流水执行)。
+ *
+ * @param ctx_list 上下文指针数组，见 @ref xf_ble_aes_ctx_t
+ * @param num 上下文数量
+ * @param prand 24 位随机数 (低 24 位有效)
+ * @param[out] hash_list 24 位哈希值，与 ctx_list 一一对应
+ */
+void xf_ble_aes_ah_batch(const xf_ble_aes_ctx_t *const ctx_list[], uint8_t num,
+                         uint32_t prand, uint32_t hash_list[]);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_AES_H__ */
@@ -0,0 +1,186 @@
+/**
+ * @file xf_ble_app_assoc.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 应用与广播、连接的关联表 (参考实现)。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_ble_app_assoc.h"
+
+#if XF_BLE_IS_ENABLE && XF_BLE_APP_ASSOC_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_app_assoc"
+
+#if (XF_BLE_APP_ASSOC_ADV_NUM > 32) || (XF_BLE_APP_ASSOC_CONN_NUM > 32)
+#error "XF_BLE_APP_ASSOC_ADV_NUM / XF_BLE_APP_ASSOC_CONN_NUM must not exceed 32"
+#endif
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static xf_err_t assoc_attach(xf_ble_app_id_t app_id, uint8_t id, uint8_t id_num,
+                             xf_ble_app_id_t *app_set, uint32_t *app_mask_set);
+static xf_err_t assoc_detach(xf_ble_app_id_t app_id, uint8_t id, uint8_t id_num,
+                             xf_ble_app_id_t *app_set, uint32_t *app_mask_set);
+static xf_err_t assoc_get_id(xf_ble_app_id_t *app_id, uint8_t id, uint8_t id_num,
+                             const xf_ble_app_id_t *app_set);
+
+/* ==================== [Static Variables] ================================== */
+
+/* 以广播 ID / 连接 ID 为下标的所属应用 ID ， XF_BLE_APP_ID_INVALID 表示未关联 */
+static xf_ble_app_id_t s_adv_app_set[XF_BLE_APP_ASSOC_ADV_NUM] = {0};
+static xf_ble_app_id_t s_conn_app_set[XF_BLE_APP_ASSOC_CONN_NUM] = {0};
+
+/* 以应用 ID 为下标的已关联广播 / 连接位图 */
+static uint32_t s_app_adv_mask_set[XF_BLE_APP_ASSOC_APP_NUM] = {0};
+static uint32_t s_app_conn_mask_set[XF_BLE_APP_ASSOC_APP_NUM] = {0};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_ble_app_attach_adv(
+    xf_ble_app_id_t app_id, xf_ble_adv_id_t adv_id)
+{
+    return assoc_attach(app_id, adv_id, XF_BLE_APP_ASSOC_ADV_NUM,
+                        s_adv_app_set, s_app_adv_mask_set);
+}
+
+xf_err_t xf_ble_app_attach_conn(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id)
+{
+    return assoc_attach(app_id, conn_id, XF_BLE_APP_ASSOC_CONN_NUM,
+                        s_conn_app_set, s_app_conn_mask_set);
+}
+
+xf_err_t xf_ble_app_detach_adv(
+    xf_ble_app_id_t app_id, xf_ble_adv_id_t adv_id)
+{
+    return assoc_detach(app_id, adv_id, XF_BLE_APP_ASSOC_ADV_NUM,
+                        s_adv_app_set, s_app_adv_mask_set);
+}
+
+xf_err_t xf_ble_app_detach_conn(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id)
+{
+    return assoc_detach(app_id, conn_id, XF_BLE_APP_ASSOC_CONN_NUM,
+                        s_conn_app_set, s_app_conn_mask_set);
+}
+
+xf_err_t xf_ble_app_get_id_by_adv(
+    xf_ble_app_id_t *app_id, xf_ble_adv_id_t adv_id)
+{
+    return assoc_get_id(app_id, adv_id, XF_BLE_APP_ASSOC_ADV_NUM, s_adv_app_set);
+}
+
+xf_err_t xf_ble_app_get_id_by_conn(
+    xf_ble_app_id_t *app_id, xf_ble_conn_id_t conn_id)
+{
+    return assoc_get_id(app_id, conn_id, XF_BLE_APP_ASSOC_CONN_NUM, s_conn_app_set);
+}
+
+uint32_t xf_ble_app_assoc_get_conn_mask(xf_ble_app_id_t app_id)
+{
+    if ((app_id == XF_BLE_APP_ID_INVALID) || (app_id >= XF_BLE_APP_ASSOC_APP_NUM)) {
+        return 0;
+    }
+    return s_app_conn_mask_set[app_id];
+}
+
+uint32_t xf_ble_app_assoc_get_adv_mask(xf_ble_app_id_t app_id)
+{
+    if ((app_id == XF_BLE_APP_ID_INVALID) || (app_id >= XF_BLE_APP_ASSOC_APP_NUM)) {
+        return 0;
+    }
+    return s_app_adv_mask_set[app_id];
+}
+
+uint8_t xf_ble_app_assoc_get_conns(xf_ble_app_id_t app_id,
+                                   xf_ble_conn_id_t *conn_id_set, uint8_t max_cnt)
+{
+    XF_ASSERT(conn_id_set != NULL, 0, TAG, "conn_id_set == NULL");
+
+    uint32_t mask = xf_ble_app_assoc_get_conn_mask(app_id);
+    uint8_t cnt = 0;
+    while ((mask != 0) && (cnt < max_cnt)) {
+        conn_id_set[cnt++] = (xf_ble_conn_id_t)__builtin_ctz(mask);
+        mask &= mask - 1;
+    }
+    return cnt;
+}
+
+void xf_ble_app_assoc_reset(void)
+{
+    XF_BLE_ENTER_CRITICAL();
+    xf_memset(s_adv_app_set, 0, sizeof(s_adv_app_set));
+    xf_memset(s_conn_app_set, 0, sizeof(s_conn_app_set));
+    xf_memset(s_app_adv_mask_set, 0, sizeof(s_app_adv_mask_set));
+    xf_memset(s_app_conn_mask_set, 0, sizeof(s_app_conn_mask_set));
+    XF_BLE_EXIT_CRITICAL();
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static xf_err_t assoc_attach(xf_ble_app_id_t app_id, uint8_t id, uint8_t id_num,
+                             xf_ble_app_id_t *app_set, uint32_t *app_mask_set)
+{
+    XF_CHECK((app_id == XF_BLE_APP_ID_INVALID) || (app_id >= XF_BLE_APP_ASSOC_APP_NUM),
+             XF_ERR_INVALID_ARG, TAG, "invalid app_id: %d", app_id);
+    XF_CHECK(id >= id_num, XF_ERR_INVALID_ARG, TAG, "id(%d) exceeds max: %d", id, id_num);
+
+    xf_err_t ret = XF_OK;
+    XF_BLE_ENTER_CRITICAL();
+    if (app_set[id] == XF_BLE_APP_ID_INVALID) {
+        app_set[id] = app_id;
+        app_mask_set[app_id] |= (1UL << id);
+    } else if (app_set[id] != app_id) {
+        ret = XF_ERR_BUSY;
+    }
+    XF_BLE_EXIT_CRITICAL();
+
+    XF_CHECK(ret != XF_OK, ret, TAG, "id(%d) already attached to app(%d)", id, app_set[id]);
+    return XF_OK;
+}
+
+static xf_err_t assoc_detach(xf_ble_app_id_t app_id, uint8_t id, uint8_t id_num,
+                             xf_ble_app_id_t *app_set, uint32_t *app_mask_set)
+{
+    XF_CHECK((app_id == XF_BLE_APP_ID_INVALID) || (app_id >= XF_BLE_APP_ASSOC_APP_NUM),
+             XF_ERR_INVALID_ARG, TAG, "invalid app_id: %d", app_id);
+    XF_CHECK(id >= id_num, XF_ERR_INVALID_ARG, TAG, "id(%d) exceeds max: %d", id, id_num);
+
+    xf_err_t ret = XF_ERR_NOT_FOUND;
+    XF_BLE_ENTER_CRITICAL();
+    if (app_set[id] == app_id) {
+        app_set[id] = XF_BLE_APP_ID_INVALID;
+        app_mask_set[app_id] &= ~(1UL << id);
+        ret = XF_OK;
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return ret;
+}
+
+static xf_err_t assoc_get_id(xf_ble_app_id_t *app_id, uint8_t id, uint8_t id_num,
+                             const xf_ble_app_id_t *app_set)
+{
+    XF_ASSERT(app_id != NULL, XF_ERR_INVALID_ARG, TAG, "app_id == NULL");
+    if (id >= id_num) {
+        return XF_ERR_INVALID_ARG;
+    }
+    xf_ble_app_id_t app = app_set[id];
+    if (app == XF_BLE_APP_ID_INVALID) {
+        return XF_ERR_NOT_FOUND;
+    }
+    *app_id = app;
+    return XF_OK;
+}
+
+#endif /* XF_BLE_IS_ENABLE && XF_BLE_APP_ASSOC_ENABLE */
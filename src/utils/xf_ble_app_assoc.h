@@ -0,0 +1,88 @@
+/**
+ * @file xf_ble_app_assoc.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 应用与广播、连接的关联表 (参考实现)。
+ *  开启 XF_BLE_APP_ASSOC_ENABLE 后由本模块实现 xf_ble_app_attach_adv() 、
+ *  xf_ble_app_attach_conn() 、 xf_ble_app_get_id_by_conn() 等接口 (平台侧无需再实现)，
+ *  以广播 ID 、连接 ID 直接索引，关联、解除关联及查询均为 O(1)；
+ *  并以位图记录每个应用关联的广播及连接，支持反向枚举。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_APP_ASSOC_H__
+#define __XF_BLE_APP_ASSOC_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gap.h"
+
+#if (XF_BLE_IS_ENABLE && XF_BLE_APP_ASSOC_ENABLE) || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE 应用关联表: 获取应用关联的连接位图
+ *
+ * @param app_id 应用 ID
+ * @return uint32_t 第 n 位表示连接 ID n 已关联到该应用，无效应用 ID 时为 0
+ */
+uint32_t xf_ble_app_assoc_get_conn_mask(xf_ble_app_id_t app_id);
+
+/**
+ * @brief BLE 应用关联表: 获取应用关联的广播位图
+ *
+ * @param app_id 应用 ID
+ * @return uint32_t 第 n 位表示广播 ID n 已关联到该应用，无效应用 ID 时为 0
+ */
+uint32_t xf_ble_app_assoc_get_adv_mask(xf_ble_app_id_t app_id);
+
+/**
+ * @brief BLE 应用关联表: 枚举应用关联的连接 (按连接 ID 升序)
+ *
+ * @param app_id 应用 ID
+ * @param[out] conn_id_set 连接 ID 数组
+ * @param max_cnt 数组容量
+ * @return uint8_t 写入的连接 ID 数量
+ */
+uint8_t xf_ble_app_assoc_get_conns(xf_ble_app_id_t app_id,
+                                   xf_ble_conn_id_t *conn_id_set, uint8_t max_cnt);
+
+/**
+ * @brief BLE 应用关联表: 清除所有关联
+ */
+void xf_ble_app_assoc_reset(void);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE && XF_BLE_APP_ASSOC_ENABLE */
+
+#endif /* __XF_BLE_APP_ASSOC_H__ */
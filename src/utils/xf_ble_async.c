@@ -0,0 +1,629 @@
+/**
+ * @file xf_ble_async.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 异步命令。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_sys.h"
+#include "xf_ble_gap.h"
+#include "xf_ble_gatt_server.h"
+#include "xf_ble_gatt_client.h"
+#include "xf_ble_trace.h"
+#include "xf_ble_latency.h"
+#include "xf_ble_utils.h"
+#include "xf_ble_async.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_async"
+
+#define ASYNC_TOKEN_INDEX_BITS  (8)
+#define ASYNC_TOKEN_INDEX_MASK  ((1U << ASYNC_TOKEN_INDEX_BITS) - 1)
+#define ASYNC_GEN_MASK          (0xFFFFFFU)
+
+#if XF_BLE_ASYNC_REQ_MAX > ASYNC_TOKEN_INDEX_MASK
+#error "XF_BLE_ASYNC_REQ_MAX too large"
+#endif
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef enum {
+    ASYNC_STATE_FREE = 0,
+    ASYNC_STATE_PENDING,        /*!< 命令已发出，等待完成 */
+    ASYNC_STATE_DONE,           /*!< 已完成，等待轮询取出 (无回调时) */
+} async_state_t;
+
+typedef struct {
+    async_state_t state;
+    xf_ble_async_op_t op;
+    uint32_t gen;               /*!< 代数，每次分配时递增 (不为 0 ) */
+    uint32_t seq;               /*!< 发起顺序，同一关联键有多个请求时先发起者先完成 */
+    xf_ble_conn_id_t conn_id;
+    xf_ble_attr_handle_t handle;
+    xf_ble_addr_t addr;
+    uint64_t deadline_us;
+    xf_ble_async_cb_t cb;
+    void *user_data;
+    xf_ble_async_result_t result;
+} async_req_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static async_req_t *async_req_alloc(xf_ble_async_op_t op, xf_ble_async_cb_t cb, void *user_data);
+static void async_req_submitted(async_req_t *req, xf_err_t ret, xf_ble_async_token_t *token);
+static async_req_t *async_req_get(xf_ble_async_token_t token);
+static bool async_req_match(
+    const async_req_t *req, xf_ble_async_op_t op,
+    xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle, const xf_ble_addr_t *addr);
+static int async_req_find(
+    xf_ble_async_op_t op, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t handle, const xf_ble_addr_t *addr, uint32_t *gen);
+static void async_req_finish(uint8_t index, uint32_t gen, const xf_ble_async_result_t *result);
+static xf_ble_async_token_t async_token(uint8_t index, uint32_t gen);
+
+/* ==================== [Static Variables] ================================== */
+
+static async_req_t s_async_req_set[XF_BLE_ASYNC_REQ_MAX] = {0};
+static uint32_t s_async_gen = 0;
+static uint32_t s_async_seq = 0;
+static uint32_t s_async_timeout_ms = XF_BLE_ASYNC_TIMEOUT_MS_DEFAULT;
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_ble_async_gap_connect(
+    const xf_ble_addr_t *addr,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token)
+{
+    XF_ASSERT(addr != NULL, XF_ERR_INVALID_ARG, TAG, "addr == NULL");
+    async_req_t *req = async_req_alloc(XF_BLE_ASYNC_OP_GAP_CONNECT, cb, user_data);
+    XF_CHECK(req == NULL, XF_ERR_NO_MEM, TAG, "async req full");
+    req->addr = *addr;
+    xf_err_t ret = XF_OK;
+    XF_BLE_LATENCY_START_CONNECT(addr);
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_CONNECT, XF_BLE_TRACE_CONN_ID_NONE, 0, xf_ble_gap_connect(addr));
+    if (ret != XF_OK) {
+        XF_BLE_LATENCY_CANCEL_CONNECT(addr);
+    }
+    async_req_submitted(req, ret, token);
+    return ret;
+}
+
+xf_err_t xf_ble_async_gap_disconnect(
+    const xf_ble_addr_t *addr,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token)
+{
+    XF_ASSERT(addr != NULL, XF_ERR_INVALID_ARG, TAG, "addr == NULL");
+    async_req_t *req = async_req_alloc(XF_BLE_ASYNC_OP_GAP_DISCONNECT, cb, user_data);
+    XF_CHECK(req == NULL, XF_ERR_NO_MEM, TAG, "async req full");
+    req->addr = *addr;
+    xf_err_t ret = XF_OK;
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_DISCONNECT, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                          xf_ble_gap_disconnect(addr));
+    async_req_submitted(req, ret, token);
+    return ret;
+}
+
+xf_err_t xf_ble_async_gap_update_conn_param(
+    xf_ble_conn_id_t conn_id, xf_ble_gap_conn_param_update_t *param,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token)
+{
+    XF_CHECK(param == NULL, XF_ERR_INVALID_ARG, TAG, "param == NULL");
+    async_req_t *req = async_req_alloc(XF_BLE_ASYNC_OP_GAP_UPDATE_CONN_PARAM, cb, user_data);
+    XF_CHECK(req == NULL, XF_ERR_NO_MEM, TAG, "async req full");
+    req->conn_id = conn_id;
+    xf_err_t ret = XF_OK;
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_UPDATE_CONN_PARAM, conn_id, 0,
+                          xf_ble_gap_update_conn_param(conn_id, param));
+    async_req_submitted(req, ret, token);
+    return ret;
+}
+
+xf_err_t xf_ble_async_gap_request_pair(
+    xf_ble_conn_id_t conn_id,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token)
+{
+    async_req_t *req = async_req_alloc(XF_BLE_ASYNC_OP_GAP_REQUEST_PAIR, cb, user_data);
+    XF_CHECK(req == NULL, XF_ERR_NO_MEM, TAG, "async req full");
+    req->conn_id = conn_id;
+    xf_err_t ret = XF_OK;
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_REQUEST_PAIR, conn_id, 0, xf_ble_gap_request_pair(conn_id));
+    async_req_submitted(req, ret, token);
+    return ret;
+}
+
+xf_err_t xf_ble_async_gattc_read(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token)
+{
+    async_req_t *req = async_req_alloc(XF_BLE_ASYNC_OP_GATTC_READ, cb, user_data);
+    XF_CHECK(req == NULL, XF_ERR_NO_MEM, TAG, "async req full");
+    req->conn_id = conn_id;
+    req->handle = handle;
+    xf_err_t ret = XF_OK;
+    XF_BLE_LATENCY_START(XF_BLE_LATENCY_OP_READ, conn_id, handle);
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GATTC_REQUEST_READ_BY_HANDLE, conn_id, handle,
+                          xf_ble_gattc_request_read_by_handle(app_id, conn_id, handle));
+    if (ret != XF_OK) {
+        XF_BLE_LATENCY_CANCEL(XF_BLE_LATENCY_OP_READ, conn_id, handle);
+    }
+    async_req_submitted(req, ret, token);
+    return ret;
+}
+
+xf_err_t xf_ble_async_gattc_write(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle,
+    uint8_t *value, uint16_t value_len,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token)
+{
+    async_req_t *req = async_req_alloc(XF_BLE_ASYNC_OP_GATTC_WRITE, cb, user_data);
+    XF_CHECK(req == NULL, XF_ERR_NO_MEM, TAG, "async req full");
+    req->conn_id = conn_id;
+    req->handle = handle;
+    xf_err_t ret = XF_OK;
+    XF_BLE_LATENCY_START(XF_BLE_LATENCY_OP_WRITE, conn_id, handle);
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GATTC_REQUEST_WRITE, conn_id, handle,
+                          xf_ble_gattc_request_write(app_id, conn_id, handle, value, value_len,
+                                                     XF_BLE_GATT_WRITE_TYPE_WITH_RSP));
+    if (ret != XF_OK) {
+        XF_BLE_LATENCY_CANCEL(XF_BLE_LATENCY_OP_WRITE, conn_id, handle);
+    }
+    async_req_submitted(req, ret, token);
+    return ret;
+}
+
+xf_err_t xf_ble_async_gattc_exchange_mtu(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id, uint16_t mtu_size,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token)
+{
+    async_req_t *req = async_req_alloc(XF_BLE_ASYNC_OP_GATTC_EXCHANGE_MTU, cb, user_data);
+    XF_CHECK(req == NULL, XF_ERR_NO_MEM, TAG, "async req full");
+    req->conn_id = conn_id;
+    xf_err_t ret = XF_OK;
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GATTC_REQUEST_EXCHANGE_MTU, conn_id, 0,
+                          xf_ble_gattc_request_exchange_mtu(app_id, conn_id, mtu_size));
+    async_req_submitted(req, ret, token);
+    return ret;
+}
+
+xf_err_t xf_ble_async_gattc_read_by_uuid(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t start_handle, xf_ble_attr_handle_t end_handle,
+    const xf_ble_uuid_info_t *uuid,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token)
+{
+    XF_CHECK(uuid == NULL, XF_ERR_INVALID_ARG, TAG, "uuid == NULL");
+    async_req_t *req = async_req_alloc(XF_BLE_ASYNC_OP_GATTC_READ_BY_UUID, cb, user_data);
+    XF_CHECK(req == NULL, XF_ERR_NO_MEM, TAG, "async req full");
+    req->conn_id = conn_id;
+    xf_err_t ret = XF_OK;
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GATTC_REQUEST_READ_BY_UUID, conn_id, start_handle,
+                          xf_ble_gattc_request_read_by_uuid(app_id, conn_id, start_handle, end_handle, uuid));
+    async_req_submitted(req, ret, token);
+    return ret;
+}
+
+xf_err_t xf_ble_async_gap_set_phy(
+    xf_ble_conn_id_t conn_id,
+    xf_ble_gap_phy_mask_t tx_phys, xf_ble_gap_phy_mask_t rx_phys,
+    xf_ble_gap_phy_coded_opt_t coded_opts,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token)
+{
+    async_req_t *req = async_req_alloc(XF_BLE_ASYNC_OP_GAP_SET_PHY, cb, user_data);
+    XF_CHECK(req == NULL, XF_ERR_NO_MEM, TAG, "async req full");
+    req->conn_id = conn_id;
+    xf_err_t ret = XF_OK;
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_SET_PHY, conn_id, 0,
+                          xf_ble_gap_set_phy(conn_id, tx_phys, rx_phys, coded_opts));
+    async_req_submitted(req, ret, token);
+    return ret;
+}
+
+xf_err_t xf_ble_async_gap_set_data_len(
+    xf_ble_conn_id_t conn_id, uint16_t tx_octets, uint16_t tx_time,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token)
+{
+    async_req_t *req = async_req_alloc(XF_BLE_ASYNC_OP_GAP_SET_DATA_LEN, cb, user_data);
+    XF_CHECK(req == NULL, XF_ERR_NO_MEM, TAG, "async req full");
+    req->conn_id = conn_id;
+    xf_err_t ret = XF_OK;
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_SET_DATA_LEN, conn_id, 0,
+                          xf_ble_gap_set_data_len(conn_id, tx_octets, tx_time));
+    async_req_submitted(req, ret, token);
+    return ret;
+}
+
+xf_err_t xf_ble_async_gatts_send_indication(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id, xf_ble_gatts_ind_t *param,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token)
+{
+    XF_CHECK(param == NULL, XF_ERR_INVALID_ARG, TAG, "param == NULL");
+    async_req_t *req = async_req_alloc(XF_BLE_ASYNC_OP_GATTS_SEND_INDICATION, cb, user_data);
+    XF_CHECK(req == NULL, XF_ERR_NO_MEM, TAG, "async req full");
+    req->conn_id = conn_id;
+    req->handle = param->handle;
+    xf_err_t ret = XF_OK;
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GATTS_SEND_INDICATION, conn_id, param->handle,
+                          xf_ble_gatts_send_indication(app_id, conn_id, param));
+    async_req_submitted(req, ret, token);
+    return ret;
+}
+
+void xf_ble_async_set_timeout(uint32_t timeout_ms)
+{
+    s_async_timeout_ms = timeout_ms;
+}
+
+xf_err_t xf_ble_async_poll(xf_ble_async_token_t token, xf_ble_async_result_t *result)
+{
+    xf_err_t ret = XF_ERR_NOT_FOUND;
+
+    XF_BLE_ENTER_CRITICAL();
+    async_req_t *req = async_req_get(token);
+    if ((req != NULL) && (req->cb == NULL)) {
+        if (req->state == ASYNC_STATE_PENDING) {
+            ret = XF_ERR_BUSY;
+        } else {
+            if (result != NULL) {
+                *result = req->result;
+            }
+            req->state = ASYNC_STATE_FREE;
+            ret = XF_OK;
+        }
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return ret;
+}
+
+xf_err_t xf_ble_async_wait(
+    xf_ble_async_token_t token, uint32_t timeout_ms, xf_ble_async_result_t *result)
+{
+    uint64_t start_us = xf_sys_time_get_us();
+    while (1) {
+        xf_err_t ret = xf_ble_async_poll(token, result);
+        if (ret != XF_ERR_BUSY) {
+            return ret;
+        }
+        if ((xf_sys_time_get_us() - start_us) >= (uint64_t)timeout_ms * 1000) {
+            return XF_ERR_TIMEOUT;
+        }
+        XF_BLE_ASYNC_WAIT_YIELD();
+    }
+}
+
+xf_err_t xf_ble_async_cancel(xf_ble_async_token_t token)
+{
+    XF_BLE_ENTER_CRITICAL();
+    async_req_t *req = async_req_get(token);
+    if (req == NULL) {
+        XF_BLE_EXIT_CRITICAL();
+        return XF_ERR_NOT_FOUND;
+    }
+    req->state = ASYNC_STATE_FREE;
+    XF_BLE_EXIT_CRITICAL();
+    return XF_OK;
+}
+
+void xf_ble_async_process(void)
+{
+    uint64_t now_us = xf_sys_time_get_us();
+    xf_ble_async_result_t result = {.result = XF_ERR_TIMEOUT};
+
+    for (uint8_t i = 0; i < XF_BLE_ASYNC_REQ_MAX; i++) {
+        async_req_t *req = &s_async_req_set[i];
+        XF_BLE_ENTER_CRITICAL();
+        bool is_timeout = (req->state == ASYNC_STATE_PENDING) && (now_us >= req->deadline_us);
+        uint32_t gen = req->gen;
+        result.conn_id = req->conn_id;
+        result.handle = req->handle;
+        XF_BLE_EXIT_CRITICAL();
+        if (is_timeout) {
+            XF_LOGW(TAG, "req(%d) op(%d) timeout", i, req->op);
+            async_req_finish(i, gen, &result);
+        }
+    }
+}
+
+xf_ble_evt_res_t xf_ble_async_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param)
+{
+    if (param == NULL) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+
+    xf_ble_async_result_t result = {.result = XF_OK};
+    uint32_t gen = 0;
+    int index = -1;
+
+    switch (event) {
+    case XF_BLE_GAP_EVT_CONNECT:
+        result.conn_id = param->connect.conn_id;
+        if (param->connect.addr != NULL) {
+            index = async_req_find(XF_BLE_ASYNC_OP_GAP_CONNECT, 0, 0, param->connect.addr, &gen);
+        }
+        break;
+    case XF_BLE_GAP_EVT_DISCONNECT: {
+        result.conn_id = param->disconnect.conn_id;
+        /* 该连接上未完成的命令均已无法完成 */
+        xf_ble_async_result_t lost = {.result = XF_ERR_INVALID_STATE, .conn_id = result.conn_id};
+        for (uint8_t i = 0; i < XF_BLE_ASYNC_REQ_MAX; i++) {
+            async_req_t *req = &s_async_req_set[i];
+            XF_BLE_ENTER_CRITICAL();
+            bool is_lost = (req->state == ASYNC_STATE_PENDING)
+                           && (req->op != XF_BLE_ASYNC_OP_GAP_CONNECT)
+                           && (req->op != XF_BLE_ASYNC_OP_GAP_DISCONNECT)
+                           && (req->conn_id == result.conn_id);
+            uint32_t lost_gen = req->gen;
+            lost.handle = req->handle;
+            XF_BLE_EXIT_CRITICAL();
+            if (is_lost) {
+                async_req_finish(i, lost_gen, &lost);
+            }
+        }
+        if (param->disconnect.addr != NULL) {
+            index = async_req_find(XF_BLE_ASYNC_OP_GAP_DISCONNECT, 0, 0, param->disconnect.addr, &gen);
+        }
+    } break;
+    case XF_BLE_GAP_EVT_CONN_PARAM_UPDATE:
+        result.conn_id = param->conn_param_upd.conn_id;
+        index = async_req_find(XF_BLE_ASYNC_OP_GAP_UPDATE_CONN_PARAM, result.conn_id, 0, NULL, &gen);
+        break;
+    case XF_BLE_GAP_EVT_PAIR_END:
+        result.conn_id = param->pair_end.conn_id;
+        result.result = param->pair_end.is_succ ? XF_OK : XF_FAIL;
+        index = async_req_find(XF_BLE_ASYNC_OP_GAP_REQUEST_PAIR, result.conn_id, 0, NULL, &gen);
+        break;
+    case XF_BLE_GAP_EVT_PHY_UPDATE:
+        result.conn_id = param->phy_upd.conn_id;
+        result.result = param->phy_upd.status;
+        result.tx_phy = param->phy_upd.tx_phy;
+        result.rx_phy = param->phy_upd.rx_phy;
+        index = async_req_find(XF_BLE_ASYNC_OP_GAP_SET_PHY, result.conn_id, 0, NULL, &gen);
+        break;
+    case XF_BLE_GAP_EVT_DATA_LEN_CHANGE:
+        result.conn_id = param->data_len.conn_id;
+        result.max_tx_octets = param->data_len.max_tx_octets;
+        result.max_rx_octets = param->data_len.max_rx_octets;
+        index = async_req_find(XF_BLE_ASYNC_OP_GAP_SET_DATA_LEN, result.conn_id, 0, NULL, &gen);
+        break;
+    default:
+        break;
+    }
+    if (index >= 0) {
+        async_req_finish((uint8_t)index, gen, &result);
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+xf_ble_evt_res_t xf_ble_async_gattc_event_handler(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param)
+{
+    if (param == NULL) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+
+    xf_ble_async_result_t result = {.result = XF_OK};
+    uint32_t gen = 0;
+    int index = -1;
+
+    switch (event) {
+    case XF_BLE_GATTC_EVT_READ_CFM: {
+        xf_ble_gattc_evt_param_read_cfm_t *read_cfm = &param->read_cfm;
+        result.conn_id = read_cfm->conn_id;
+        result.handle = read_cfm->handle;
+        result.value_len = read_cfm->value_len;
+        if (read_cfm->value != NULL) {
+            uint16_t copy_len = (read_cfm->value_len > XF_BLE_ASYNC_VALUE_MAX)
+                                ? XF_BLE_ASYNC_VALUE_MAX : read_cfm->value_len;
+            xf_memcpy(result.value, read_cfm->value, copy_len);
+        }
+        index = async_req_find(XF_BLE_ASYNC_OP_GATTC_READ,
+                               result.conn_id, result.handle, NULL, &gen);
+        if (index < 0) {
+            index = async_req_find(XF_BLE_ASYNC_OP_GATTC_READ_BY_UUID,
+                                   result.conn_id, 0, NULL, &gen);
+        }
+    } break;
+    case XF_BLE_GATTC_EVT_WRITE_CFM:
+        result.conn_id = param->write_cfm.conn_id;
+        result.handle = param->write_cfm.handle;
+        index = async_req_find(XF_BLE_ASYNC_OP_GATTC_WRITE,
+                               result.conn_id, result.handle, NULL, &gen);
+        break;
+    case XF_BLE_GATTC_EVT_EXCHANGE_MTU:
+        result.conn_id = param->mtu.conn_id;
+        result.mtu = param->mtu.mtu;
+        index = async_req_find(XF_BLE_ASYNC_OP_GATTC_EXCHANGE_MTU,
+                               result.conn_id, 0, NULL, &gen);
+        break;
+    default:
+        break;
+    }
+    if (index >= 0) {
+        async_req_finish((uint8_t)index, gen, &result);
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+xf_ble_evt_res_t xf_ble_async_gatts_event_handler(
+    xf_ble_gatts_evt_t event,
+    xf_ble_gatts_evt_cb_param_t *param)
+{
+    if ((param == NULL) || (event != XF_BLE_GATTS_EVT_IND_CFM)) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+
+    xf_ble_async_result_t result = {
+        .result = param->ind_cfm.status,
+        .conn_id = param->ind_cfm.conn_id,
+        .handle = param->ind_cfm.handle,
+    };
+    uint32_t gen = 0;
+    int index = async_req_find(XF_BLE_ASYNC_OP_GATTS_SEND_INDICATION,
+                               result.conn_id, result.handle, NULL, &gen);
+    if (index >= 0) {
+        async_req_finish((uint8_t)index, gen, &result);
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 在发出命令前分配请求，以免完成事件先于分配到达
+ */
+static async_req_t *async_req_alloc(xf_ble_async_op_t op, xf_ble_async_cb_t cb, void *user_data)
+{
+    XF_BLE_ENTER_CRITICAL();
+    for (uint8_t i = 0; i < XF_BLE_ASYNC_REQ_MAX; i++) {
+        async_req_t *req = &s_async_req_set[i];
+        if (req->state != ASYNC_STATE_FREE) {
+            continue;
+        }
+        xf_memset(req, 0, sizeof(async_req_t));
+        s_async_gen = (s_async_gen + 1) & ASYNC_GEN_MASK;
+        if (s_async_gen == 0) {
+            s_async_gen = 1;
+        }
+        req->gen = s_async_gen;
+        req->seq = ++s_async_seq;
+        req->op = op;
+        req->cb = cb;
+        req->user_data = user_data;
+        req->deadline_us = xf_sys_time_get_us() + (uint64_t)s_async_timeout_ms * 1000;
+        req->state = ASYNC_STATE_PENDING;
+        XF_BLE_EXIT_CRITICAL();
+        return req;
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return NULL;
+}
+
+/**
+ * @brief 命令发出后处理: 失败时释放请求，成功时传出令牌
+ */
+static void async_req_submitted(async_req_t *req, xf_err_t ret, xf_ble_async_token_t *token)
+{
+    uint8_t index = (uint8_t)(req - s_async_req_set);
+    if (ret != XF_OK) {
+        XF_BLE_ENTER_CRITICAL();
+        req->state = ASYNC_STATE_FREE;
+        XF_BLE_EXIT_CRITICAL();
+        if (token != NULL) {
+            *token = XF_BLE_ASYNC_TOKEN_INVALID;
+        }
+        return;
+    }
+    if (token != NULL) {
+        *token = async_token(index, req->gen);
+    }
+}
+
+static async_req_t *async_req_get(xf_ble_async_token_t token)
+{
+    uint32_t index = token & ASYNC_TOKEN_INDEX_MASK;
+    uint32_t gen = token >> ASYNC_TOKEN_INDEX_BITS;
+    if ((token == XF_BLE_ASYNC_TOKEN_INVALID) || (index >= XF_BLE_ASYNC_REQ_MAX)) {
+        return NULL;
+    }
+    async_req_t *req = &s_async_req_set[index];
+    if ((req->state == ASYNC_STATE_FREE) || (req->gen != gen)) {
+        return NULL;
+    }
+    return req;
+}
+
+static bool async_req_match(
+    const async_req_t *req, xf_ble_async_op_t op,
+    xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle, const xf_ble_addr_t *addr)
+{
+    if ((req->state != ASYNC_STATE_PENDING) || (req->op != op)) {
+        return false;
+    }
+    switch (op) {
+    case XF_BLE_ASYNC_OP_GAP_CONNECT:
+    case XF_BLE_ASYNC_OP_GAP_DISCONNECT:
+        return xf_ble_addr_is_equal(&req->addr, addr);
+    case XF_BLE_ASYNC_OP_GATTC_READ:
+    case XF_BLE_ASYNC_OP_GATTC_WRITE:
+    case XF_BLE_ASYNC_OP_GATTS_SEND_INDICATION:
+        return (req->conn_id == conn_id) && (req->handle == handle);
+    default:
+        return req->conn_id == conn_id;
+    }
+}
+
+/**
+ * @brief 查找与事件关联的请求，有多个时返回最先发起的
+ *
+ * @return int 请求下标，不存在时返回 -1
+ */
+static int async_req_find(
+    xf_ble_async_op_t op, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t handle, const xf_ble_addr_t *addr, uint32_t *gen)
+{
+    int index = -1;
+    XF_BLE_ENTER_CRITICAL();
+    for (uint8_t i = 0; i < XF_BLE_ASYNC_REQ_MAX; i++) {
+        const async_req_t *req = &s_async_req_set[i];
+        if (!async_req_match(req, op, conn_id, handle, addr)) {
+            continue;
+        }
+        if ((index < 0) || ((int32_t)(req->seq - s_async_req_set[index].seq) < 0)) {
+            index = i;
+        }
+    }
+    if (index >= 0) {
+        *gen = s_async_req_set[index].gen;
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return index;
+}
+
+/**
+ * @brief 完成请求: 有回调时调用回调并释放，否则保留结果等待轮询
+ *
+ * @note 通过 gen 确认请求在查找后未被取消或复用
+ */
+static void async_req_finish(uint8_t index, uint32_t gen, const xf_ble_async_result_t *result)
+{
+    async_req_t *req = &s_async_req_set[index];
+
+    XF_BLE_ENTER_CRITICAL();
+    if ((req->state != ASYNC_STATE_PENDING) || (req->gen != gen)) {
+        XF_BLE_EXIT_CRITICAL();
+        return;
+    }
+    req->result = *result;
+    req->result.op = req->op;
+    if (req->cb == NULL) {
+        req->state = ASYNC_STATE_DONE;
+        XF_BLE_EXIT_CRITICAL();
+        return;
+    }
+    xf_ble_async_cb_t cb = req->cb;
+    void *user_data = req->user_data;
+    xf_ble_async_result_t cb_result = req->result;
+    req->state = ASYNC_STATE_FREE;
+    XF_BLE_EXIT_CRITICAL();
+
+    cb(async_token(index, gen), &cb_result, user_data);
+}
+
+static xf_ble_async_token_t async_token(uint8_t index, uint32_t gen)
+{
+    return (gen << ASYNC_TOKEN_INDEX_BITS) | index;
+}
+
+#endif /* XF_BLE_IS_ENABLE */
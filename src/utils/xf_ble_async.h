@@ -0,0 +1,583 @@
+/**
+ * @file xf_ble_async.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 异步命令。
+ *  每个命令返回一个请求令牌 (token)，完成时通过回调 (附带用户数据) 通知，
+ *  或通过令牌轮询 / 等待结果，用于同时发起多个操作并关联各自的结果。
+ *  仅覆盖有完成事件的命令；广播及扫描的开启/关闭、服务搜寻等无完成事件，
+ *  无响应写 (写命令，见 xf_ble_gattc_stream.h) 及通知无对端确认，均不提供异步命令。
+ *  C++20 下另提供基于回调方式的协程等待体 (xf_ble_async_co_*())。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_ASYNC_H__
+#define __XF_BLE_ASYNC_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gap_types.h"
+#include "xf_ble_gatt_server_types.h"
+#include "xf_ble_gatt_client_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief BLE 异步命令令牌无效值
+ */
+#define XF_BLE_ASYNC_TOKEN_INVALID      (0)
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE 异步命令令牌
+ *
+ * @note 由槽位下标及代数组成，槽位被复用后旧令牌自动失效
+ */
+typedef uint32_t xf_ble_async_token_t;
+
+/**
+ * @brief BLE 异步命令类型
+ */
+typedef uint8_t xf_ble_async_op_t;
+enum _xf_ble_async_op_t {
+    XF_BLE_ASYNC_OP_GAP_CONNECT = 0,        /*!< 发起连接，完成于 XF_BLE_GAP_EVT_CONNECT (按地址关联) */
+    XF_BLE_ASYNC_OP_GAP_DISCONNECT,         /*!< 断开连接，完成于 XF_BLE_GAP_EVT_DISCONNECT (按地址关联) */
+    XF_BLE_ASYNC_OP_GAP_UPDATE_CONN_PARAM,  /*!< 更新连接参数，完成于 XF_BLE_GAP_EVT_CONN_PARAM_UPDATE */
+    XF_BLE_ASYNC_OP_GAP_REQUEST_PAIR,       /*!< 请求配对，完成于 XF_BLE_GAP_EVT_PAIR_END */
+    XF_BLE_ASYNC_OP_GATTC_READ,             /*!< 读请求，完成于 XF_BLE_GATTC_EVT_READ_CFM */
+    XF_BLE_ASYNC_OP_GATTC_WRITE,            /*!< 写请求，完成于 XF_BLE_GATTC_EVT_WRITE_CFM */
+    XF_BLE_ASYNC_OP_GATTC_EXCHANGE_MTU,     /*!< MTU 协商，完成于 XF_BLE_GATTC_EVT_EXCHANGE_MTU */
+    XF_BLE_ASYNC_OP_GATTC_READ_BY_UUID,     /*!< 通过 UUID 读，完成于 XF_BLE_GATTC_EVT_READ_CFM (按连接关联) */
+    XF_BLE_ASYNC_OP_GAP_SET_PHY,            /*!< 设置 PHY ，完成于 XF_BLE_GAP_EVT_PHY_UPDATE */
+    XF_BLE_ASYNC_OP_GAP_SET_DATA_LEN,       /*!< 设置数据长度，完成于 XF_BLE_GAP_EVT_DATA_LEN_CHANGE */
+    XF_BLE_ASYNC_OP_GATTS_SEND_INDICATION,  /*!< 发送指示，完成于 XF_BLE_GATTS_EVT_IND_CFM */
+    _XF_BLE_ASYNC_OP_MAX,
+};
+
+/**
+ * @brief BLE 异步命令结果
+ */
+typedef struct {
+    xf_ble_async_op_t op;                   /*!< 命令类型，见 @ref xf_ble_async_op_t */
+    xf_err_t result;                        /*!< 结果
+                                             *  - XF_OK                 成功
+                                             *  - XF_FAIL               对端或协议栈报告失败 (如配对失败)
+                                             *  - (OTHER)               事件中的状态 (PHY 更新、指示确认)
+                                             *  - XF_ERR_TIMEOUT        超时
+                                             *  - XF_ERR_INVALID_STATE  完成前连接已断开
+                                             */
+    xf_ble_conn_id_t conn_id;               /*!< 连接 ID (链接 ID ) */
+    xf_ble_attr_handle_t handle;            /*!< 读写或指示的句柄 (GATTC 读写、 GATTS 指示) */
+    uint16_t mtu;                           /*!< 协商后的 MTU (MTU 协商) */
+    xf_ble_gap_phy_type_t tx_phy;           /*!< 当前发送 PHY (设置 PHY) */
+    xf_ble_gap_phy_type_t rx_phy;           /*!< 当前接收 PHY (设置 PHY) */
+    uint16_t max_tx_octets;                 /*!< 单包发送的最大有效载荷 (设置数据长度) */
+    uint16_t max_rx_octets;                 /*!< 单包接收的最大有效载荷 (设置数据长度) */
+    uint16_t value_len;                     /*!< 属性值长度 (读请求)，可能大于 XF_BLE_ASYNC_VALUE_MAX */
+    uint8_t value[XF_BLE_ASYNC_VALUE_MAX];  /*!< 属性值 (读请求)，超出部分截断 */
+} xf_ble_async_result_t;
+
+/**
+ * @brief BLE 异步命令完成回调
+ *
+ * @note 在协议栈事件上下文 (或超时处理上下文) 中调用，回调返回后令牌即失效
+ * @param token 令牌，见 @ref xf_ble_async_token_t
+ * @param result 结果，见 @ref xf_ble_async_result_t
+ * @param user_data 发起命令时传入的用户数据
+ */
+typedef void (*xf_ble_async_cb_t)(
+    xf_ble_async_token_t token, const xf_ble_async_result_t *result, void *user_data);
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE 异步发起连接
+ *
+ * @param addr 要连接的地址，见 @ref xf_ble_addr_t
+ * @param cb 完成回调，见 @ref xf_ble_async_cb_t ，
+ *  为 NULL 时结果保留至通过 xf_ble_async_poll() 或 xf_ble_async_wait() 取出
+ * @param user_data 用户数据
+ * @param[out] token 令牌，见 @ref xf_ble_async_token_t ，可为 NULL
+ * @return xf_err_t
+ *      - XF_OK                 成功 (命令已发出)
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NO_MEM         同时进行的请求数已达上限
+ *      - (OTHER)               发出命令失败，见 @ref xf_err_t
+ */
+xf_err_t xf_ble_async_gap_connect(
+    const xf_ble_addr_t *addr,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token);
+
+/**
+ * @brief BLE 异步断开连接
+ *
+ * @note 参数及返回值同 xf_ble_async_gap_connect()
+ */
+xf_err_t xf_ble_async_gap_disconnect(
+    const xf_ble_addr_t *addr,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token);
+
+/**
+ * @brief BLE 异步更新连接参数
+ *
+ * @note 其余参数及返回值同 xf_ble_async_gap_connect()
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param param 连接参数，见 @ref xf_ble_gap_conn_param_update_t
+ */
+xf_err_t xf_ble_async_gap_update_conn_param(
+    xf_ble_conn_id_t conn_id, xf_ble_gap_conn_param_update_t *param,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token);
+
+/**
+ * @brief BLE 异步请求配对
+ *
+ * @note 配对失败时结果为 XF_FAIL ，其余参数及返回值同 xf_ble_async_gap_connect()
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ */
+xf_err_t xf_ble_async_gap_request_pair(
+    xf_ble_conn_id_t conn_id,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token);
+
+/**
+ * @brief BLE 异步通过句柄读
+ *
+ * @note 其余参数及返回值同 xf_ble_async_gap_connect()
+ * @param app_id 客户端 ID (应用 ID)，见 @ref xf_ble_app_id_t
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param handle 句柄
+ */
+xf_err_t xf_ble_async_gattc_read(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token);
+
+/**
+ * @brief BLE 异步写 (写请求，需要对端响应)
+ *
+ * @note 其余参数及返回值同 xf_ble_async_gap_connect()
+ * @param app_id 客户端 ID (应用 ID)，见 @ref xf_ble_app_id_t
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param handle 句柄
+ * @param value 写入的值
+ * @param value_len 写入的值的长度
+ */
+xf_err_t xf_ble_async_gattc_write(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle,
+    uint8_t *value, uint16_t value_len,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token);
+
+/**
+ * @brief BLE 异步 MTU 协商
+ *
+ * @note 其余参数及返回值同 xf_ble_async_gap_connect()
+ * @param app_id 客户端 ID (应用 ID)，见 @ref xf_ble_app_id_t
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param mtu_size 期望的 MTU
+ */
+xf_err_t xf_ble_async_gattc_exchange_mtu(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id, uint16_t mtu_size,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token);
+
+/**
+ * @brief BLE 异步通过 UUID 读
+ *
+ * @note 按连接关联读确认 (同一连接上先匹配通过句柄读的请求)，结果的 handle 为读确认中的句柄，
+ *  其余参数及返回值同 xf_ble_async_gap_connect()
+ * @param app_id 客户端 ID (应用 ID)，见 @ref xf_ble_app_id_t
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param start_handle 起始句柄
+ * @param end_handle 结束句柄
+ * @param uuid 指定的 UUID
+ */
+xf_err_t xf_ble_async_gattc_read_by_uuid(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t start_handle, xf_ble_attr_handle_t end_handle,
+    const xf_ble_uuid_info_t *uuid,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token);
+
+/**
+ * @brief BLE 异步设置 PHY
+ *
+ * @note 结果为 PHY 更新事件中的状态，其余参数及返回值同 xf_ble_async_gap_connect()
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param tx_phys 期望的发送 PHY ，见 @ref xf_ble_gap_phy_mask_t
+ * @param rx_phys 期望的接收 PHY ，见 @ref xf_ble_gap_phy_mask_t
+ * @param coded_opts Coded PHY 编码选项，见 @ref xf_ble_gap_phy_coded_opt_t
+ */
+xf_err_t xf_ble_async_gap_set_phy(
+    xf_ble_conn_id_t conn_id,
+    xf_ble_gap_phy_mask_t tx_phys, xf_ble_gap_phy_mask_t rx_phys,
+    xf_ble_gap_phy_coded_opt_t coded_opts,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token);
+
+/**
+ * @brief BLE 异步设置数据长度
+ *
+ * @note 数据长度未变化时控制器不上报事件，命令将以 XF_ERR_TIMEOUT 完成，
+ *  其余参数及返回值同 xf_ble_async_gap_connect()
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param tx_octets 期望的单包发送最大有效载荷 (字节)
+ * @param tx_time 期望的单包发送最大时间 (us)
+ */
+xf_err_t xf_ble_async_gap_set_data_len(
+    xf_ble_conn_id_t conn_id, uint16_t tx_octets, uint16_t tx_time,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token);
+
+/**
+ * @brief BLE 异步发送指示
+ *
+ * @note 结果为指示确认事件中的状态，其余参数及返回值同 xf_ble_async_gap_connect()
+ * @param app_id 服务端 ID (应用 ID)，见 @ref xf_ble_app_id_t
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param param 指示的信息，见 @ref xf_ble_gatts_ind_t
+ */
+xf_err_t xf_ble_async_gatts_send_indication(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id, xf_ble_gatts_ind_t *param,
+    xf_ble_async_cb_t cb, void *user_data, xf_ble_async_token_t *token);
+
+/**
+ * @brief BLE 设置之后发起的异步命令的超时时间
+ *
+ * @param timeout_ms 超时时间，单位 ms ，默认为 XF_BLE_ASYNC_TIMEOUT_MS_DEFAULT
+ */
+void xf_ble_async_set_timeout(uint32_t timeout_ms);
+
+/**
+ * @brief BLE 轮询异步命令的结果
+ *
+ * @param token 令牌，见 @ref xf_ble_async_token_t
+ * @param[out] result 结果，见 @ref xf_ble_async_result_t ，可为 NULL
+ * @return xf_err_t
+ *      - XF_OK                 已完成，结果已取出，令牌随即失效
+ *      - XF_ERR_BUSY           未完成
+ *      - XF_ERR_NOT_FOUND      令牌无效 (已取出、已取消或使用回调方式)
+ */
+xf_err_t xf_ble_async_poll(xf_ble_async_token_t token, xf_ble_async_result_t *result);
+
+/**
+ * @brief BLE 等待异步命令完成
+ *
+ * @note 会阻塞当前上下文 (每次轮询间调用 XF_BLE_ASYNC_WAIT_YIELD() )，
+ *  不可在协议栈事件回调中调用
+ * @param token 令牌，见 @ref xf_ble_async_token_t
+ * @param timeout_ms 最长等待时间，单位 ms
+ * @param[out] result 结果，见 @ref xf_ble_async_result_t ，可为 NULL
+ * @return xf_err_t
+ *      - XF_OK                 已完成，结果已取出，令牌随即失效
+ *      - XF_ERR_TIMEOUT        等待超时 (命令仍在进行)
+ *      - XF_ERR_NOT_FOUND      令牌无效
+ */
+xf_err_t xf_ble_async_wait(
+    xf_ble_async_token_t token, uint32_t timeout_ms, xf_ble_async_result_t *result);
+
+/**
+ * @brief BLE 取消异步命令
+ *
+ * @note 仅丢弃结果，不会撤回已发出的命令，也不会触发回调
+ * @param token 令牌，见 @ref xf_ble_async_token_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      令牌无效
+ */
+xf_err_t xf_ble_async_cancel(xf_ble_async_token_t token);
+
+/**
+ * @brief BLE 异步命令超时处理
+ *
+ * @note 需周期性调用，超时的命令以 XF_ERR_TIMEOUT 完成
+ */
+void xf_ble_async_process(void);
+
+/**
+ * @brief BLE 异步命令的 GAP 事件处理
+ *
+ * @note 需在 GAP 事件回调中调用
+ * @param event 事件，见 @ref xf_ble_gap_evt_t
+ * @param param 事件回调参数，见 @ref xf_ble_gap_evt_cb_param_t
+ * @return xf_ble_evt_res_t 事件处理结果，固定返回 XF_BLE_EVT_RES_NOT_HANDLED ，
+ *  不影响其他模块对同一事件的处理
+ */
+xf_ble_evt_res_t xf_ble_async_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param);
+
+/**
+ * @brief BLE 异步命令的 GATTC 事件处理
+ *
+ * @note 需在 GATTC 事件回调中调用
+ * @param event 事件，见 @ref xf_ble_gattc_evt_t
+ * @param param 事件回调参数，见 @ref xf_ble_gattc_evt_cb_param_t
+ * @return xf_ble_evt_res_t 事件处理结果，固定返回 XF_BLE_EVT_RES_NOT_HANDLED ，
+ *  不影响其他模块对同一事件的处理
+ */
+xf_ble_evt_res_t xf_ble_async_gattc_event_handler(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param);
+
+/**
+ * @brief BLE 异步命令的 GATTS 事件处理
+ *
+ * @note 需在 GATTS 事件回调中调用
+ * @param event 事件，见 @ref xf_ble_gatts_evt_t
+ * @param param 事件回调参数，见 @ref xf_ble_gatts_evt_cb_param_t
+ * @return xf_ble_evt_res_t 事件处理结果，固定返回 XF_BLE_EVT_RES_NOT_HANDLED ，
+ *  不影响其他模块对同一事件的处理
+ */
+xf_ble_evt_res_t xf_ble_async_gatts_event_handler(
+    xf_ble_gatts_evt_t event,
+    xf_ble_gatts_evt_cb_param_t *param);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#if (defined(__cplusplus) && (__cplusplus >= 202002L)) || defined(__DOXYGEN__)
+
+#include <coroutine>
+
+/**
+ * @brief BLE 异步命令的 C++20 协程等待体 (基于回调方式的异步命令，仅头文件)
+ *
+ * @note co_await 时发出命令并挂起协程，完成回调中恢复协程，结果为 @ref xf_ble_async_result_t ；
+ *  发出命令失败时不挂起，结果的 result 为该错误码。
+ *  协程在协议栈事件上下文 (或超时处理上下文) 中恢复，与 @ref xf_ble_async_cb_t 相同。
+ *  通常通过 xf_ble_async_co_gap_connect() 等函数构造。
+ * @tparam start_fn_t 发出命令的函数，形如 xf_err_t (xf_ble_async_cb_t cb, void *user_data)
+ */
+template <typename start_fn_t>
+class xf_ble_async_awaitable_t
+{
+public:
+    xf_ble_async_awaitable_t(xf_ble_async_op_t op, start_fn_t start_fn)
+        : m_start_fn(start_fn)
+    {
+        m_result.op = op;
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        m_handle = handle;
+        xf_err_t ret = m_start_fn(&xf_ble_async_awaitable_t::on_done, this);
+        bool is_suspend = false;
+        XF_BLE_ENTER_CRITICAL();
+        if (ret != XF_OK) {
+            m_result.result = ret;
+        } else {
+            /* 部分平台会在命令接口内同步上报完成事件，此时不挂起 */
+            is_suspend = !m_is_done;
+            m_is_suspended = is_suspend;
+        }
+        XF_BLE_EXIT_CRITICAL();
+        return is_suspend;
+    }
+
+    xf_ble_async_result_t await_resume() const noexcept
+    {
+        return m_result;
+    }
+
+private:
+    static void on_done(xf_ble_async_token_t token,
+                        const xf_ble_async_result_t *result, void *user_data)
+    {
+        (void)token;
+        xf_ble_async_awaitable_t *self = static_cast<xf_ble_async_awaitable_t *>(user_data);
+        self->m_result = *result;
+        XF_BLE_ENTER_CRITICAL();
+        bool is_resume = self->m_is_suspended;
+        self->m_is_done = true;
+        XF_BLE_EXIT_CRITICAL();
+        if (is_resume) {
+            self->m_handle.resume();
+        }
+    }
+
+    start_fn_t m_start_fn;
+    std::coroutine_handle<> m_handle = {};
+    xf_ble_async_result_t m_result = {};
+    bool m_is_done = false;
+    bool m_is_suspended = false;
+};
+
+/**
+ * @brief BLE 异步发起连接 (C++20 协程)，见 xf_ble_async_gap_connect()
+ *
+ * @note 示例: xf_ble_async_result_t res = co_await xf_ble_async_co_gap_connect(&addr);
+ */
+inline auto xf_ble_async_co_gap_connect(const xf_ble_addr_t *addr)
+{
+    auto start_fn = [addr](xf_ble_async_cb_t cb, void *user_data) {
+        return xf_ble_async_gap_connect(addr, cb, user_data, nullptr);
+    };
+    return xf_ble_async_awaitable_t<decltype(start_fn)>(XF_BLE_ASYNC_OP_GAP_CONNECT, start_fn);
+}
+
+/**
+ * @brief BLE 异步断开连接 (C++20 协程)，见 xf_ble_async_gap_disconnect()
+ */
+inline auto xf_ble_async_co_gap_disconnect(const xf_ble_addr_t *addr)
+{
+    auto start_fn = [addr](xf_ble_async_cb_t cb, void *user_data) {
+        return xf_ble_async_gap_disconnect(addr, cb, user_data, nullptr);
+    };
+    return xf_ble_async_awaitable_t<decltype(start_fn)>(XF_BLE_ASYNC_OP_GAP_DISCONNECT, start_fn);
+}
+
+/**
+ * @brief BLE 异步更新连接参数 (C++20 协程)，见 xf_ble_async_gap_update_conn_param()
+ */
+inline auto xf_ble_async_co_gap_update_conn_param(
+    xf_ble_conn_id_t conn_id, xf_ble_gap_conn_param_update_t *param)
+{
+    auto start_fn = [conn_id, param](xf_ble_async_cb_t cb, void *user_data) {
+        return xf_ble_async_gap_update_conn_param(conn_id, param, cb, user_data, nullptr);
+    };
+    return xf_ble_async_awaitable_t<decltype(start_fn)>(
+               XF_BLE_ASYNC_OP_GAP_UPDATE_CONN_PARAM, start_fn);
+}
+
+/**
+ * @brief BLE 异步请求配对 (C++20 协程)，见 xf_ble_async_gap_request_pair()
+ */
+inline auto xf_ble_async_co_gap_request_pair(xf_ble_conn_id_t conn_id)
+{
+    auto start_fn = [conn_id](xf_ble_async_cb_t cb, void *user_data) {
+        return xf_ble_async_gap_request_pair(conn_id, cb, user_data, nullptr);
+    };
+    return xf_ble_async_awaitable_t<decltype(start_fn)>(XF_BLE_ASYNC_OP_GAP_REQUEST_PAIR, start_fn);
+}
+
+/**
+ * @brief BLE 异步通过句柄读 (C++20 协程)，见 xf_ble_async_gattc_read()
+ */
+inline auto xf_ble_async_co_gattc_read(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle)
+{
+    auto start_fn = [app_id, conn_id, handle](xf_ble_async_cb_t cb, void *user_data) {
+        return xf_ble_async_gattc_read(app_id, conn_id, handle, cb, user_data, nullptr);
+    };
+    return xf_ble_async_awaitable_t<decltype(start_fn)>(XF_BLE_ASYNC_OP_GATTC_READ, start_fn);
+}
+
+/**
+ * @brief BLE 异步写 (C++20 协程)，见 xf_ble_async_gattc_write()
+ *
+ * @note value 需在 co_await 返回前保持有效
+ */
+inline auto xf_ble_async_co_gattc_write(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle,
+    uint8_t *value, uint16_t value_len)
+{
+    auto start_fn = [app_id, conn_id, handle, value, value_len]
+                    (xf_ble_async_cb_t cb, void *user_data) {
+        return xf_ble_async_gattc_write(app_id, conn_id, handle, value, value_len,
+                                        cb, user_data, nullptr);
+    };
+    return xf_ble_async_awaitable_t<decltype(start_fn)>(XF_BLE_ASYNC_OP_GATTC_WRITE, start_fn);
+}
+
+/**
+ * @brief BLE 异步 MTU 协商 (C++20 协程)，见 xf_ble_async_gattc_exchange_mtu()
+ */
+inline auto xf_ble_async_co_gattc_exchange_mtu(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id, uint16_t mtu_size)
+{
+    auto start_fn = [app_id, conn_id, mtu_size](xf_ble_async_cb_t cb, void *user_data) {
+        return xf_ble_async_gattc_exchange_mtu(app_id, conn_id, mtu_size, cb, user_data, nullptr);
+    };
+    return xf_ble_async_awaitable_t<decltype(start_fn)>(XF_BLE_ASYNC_OP_GATTC_EXCHANGE_MTU, start_fn);
+}
+
+/**
+ * @brief BLE 异步通过 UUID 读 (C++20 协程)，见 xf_ble_async_gattc_read_by_uuid()
+ *
+ * @note uuid 需在 co_await 返回前保持有效
+ */
+inline auto xf_ble_async_co_gattc_read_by_uuid(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t start_handle, xf_ble_attr_handle_t end_handle,
+    const xf_ble_uuid_info_t *uuid)
+{
+    auto start_fn = [app_id, conn_id, start_handle, end_handle, uuid]
+                    (xf_ble_async_cb_t cb, void *user_data) {
+        return xf_ble_async_gattc_read_by_uuid(app_id, conn_id, start_handle, end_handle, uuid,
+                                               cb, user_data, nullptr);
+    };
+    return xf_ble_async_awaitable_t<decltype(start_fn)>(XF_BLE_ASYNC_OP_GATTC_READ_BY_UUID, start_fn);
+}
+
+/**
+ * @brief BLE 异步设置 PHY (C++20 协程)，见 xf_ble_async_gap_set_phy()
+ */
+inline auto xf_ble_async_co_gap_set_phy(
+    xf_ble_conn_id_t conn_id,
+    xf_ble_gap_phy_mask_t tx_phys, xf_ble_gap_phy_mask_t rx_phys,
+    xf_ble_gap_phy_coded_opt_t coded_opts)
+{
+    auto start_fn = [conn_id, tx_phys, rx_phys, coded_opts](xf_ble_async_cb_t cb, void *user_data) {
+        return xf_ble_async_gap_set_phy(conn_id, tx_phys, rx_phys, coded_opts, cb, user_data, nullptr);
+    };
+    return xf_ble_async_awaitable_t<decltype(start_fn)>(XF_BLE_ASYNC_OP_GAP_SET_PHY, start_fn);
+}
+
+/**
+ * @brief BLE 异步设置数据长度 (C++20 协程)，见 xf_ble_async_gap_set_data_len()
+ */
+inline auto xf_ble_async_co_gap_set_data_len(
+    xf_ble_conn_id_t conn_id, uint16_t tx_octets, uint16_t tx_time)
+{
+    auto start_fn = [conn_id, tx_octets, tx_time](xf_ble_async_cb_t cb, void *user_data) {
+        return xf_ble_async_gap_set_data_len(conn_id, tx_octets, tx_time, cb, user_data, nullptr);
+    };
+    return xf_ble_async_awaitable_t<decltype(start_fn)>(XF_BLE_ASYNC_OP_GAP_SET_DATA_LEN, start_fn);
+}
+
+/**
+ * @brief BLE 异步发送指示 (C++20 协程)，见 xf_ble_async_gatts_send_indication()
+ *
+ * @note param 需在 co_await 返回前保持有效
+ */
+inline auto xf_ble_async_co_gatts_send_indication(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id, xf_ble_gatts_ind_t *param)
+{
+    auto start_fn = [app_id, conn_id, param](xf_ble_async_cb_t cb, void *user_data) {
+        return xf_ble_async_gatts_send_indication(app_id, conn_id, param, cb, user_data, nullptr);
+    };
+    return xf_ble_async_awaitable_t<decltype(start_fn)>(
+               XF_BLE_ASYNC_OP_GATTS_SEND_INDICATION, start_fn);
+}
+
+#endif /* __cplusplus >= 202002L */
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_ASYNC_H__ */
@@ -0,0 +1,834 @@
+/**
+ * @file xf_ble_bond_store.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 绑定信息存储。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_ble_utils.h"
+#include "xf_ble_bond_store.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_bond_store"
+
+/*
+ * 区布局:
+ *  [区头 16 字节: magic(4) version(1) 保留(3) seq(4) crc32(4)]
+ *  [记录] [记录] ... [0xFF (已擦除)]
+ * 记录布局 (按 XF_BLE_BOND_STORE_WRITE_ALIGN 对齐，填充 0xFF):
+ *  [magic(1) type(1) len(2) crc32(4)] [载荷 len 字节]
+ * 多字节字段均为小端。
+ */
+#define BOND_BANK_MAGIC         (0x53424658UL)  /* "XFBS" */
+#define BOND_BANK_HDR_SIZE      (16)
+#define BOND_REC_MAGIC          (0xA5)
+#define BOND_REC_HDR_SIZE       (8)
+#define BOND_REC_TYPE_PUT       (1)             /*!< 载荷: 绑定信息 (见 bond_encode()) */
+#define BOND_REC_TYPE_DEL       (2)             /*!< 载荷: 身份地址 */
+
+#define BOND_ALIGN_UP(x)        ((((x) + XF_BLE_BOND_STORE_WRITE_ALIGN - 1) \
+                                  / XF_BLE_BOND_STORE_WRITE_ALIGN) * XF_BLE_BOND_STORE_WRITE_ALIGN)
+#define BOND_REC_FIRST_OFF      BOND_ALIGN_UP(BOND_BANK_HDR_SIZE)
+
+/* 身份地址在载荷中的编码长度: type(1) + addr(6) */
+#define BOND_ADDR_ENC_SIZE      (1 + XF_BLE_ADDR_LEN)
+
+/* 载荷标志 */
+#define BOND_FLAG_LTK           (1 << 0)
+#define BOND_FLAG_IRK           (1 << 1)
+#define BOND_FLAG_CSRK          (1 << 2)
+#define BOND_FLAG_EDIV_RAND     (1 << 3)
+
+#define BOND_PAYLOAD_MAX        (1 + BOND_ADDR_ENC_SIZE + 1 + 1 \
+                                 + 1 + XF_BLE_SM_KEY_SIZE_MAX + 2 + 8 \
+                                 + XF_BLE_SM_KEY_SIZE_MAX + XF_BLE_SM_KEY_SIZE_MAX \
+                                 + 1 + 4 * XF_BLE_BOND_STORE_CCCD_NUM)
+#define BOND_REC_SIZE_MAX       BOND_ALIGN_UP(BOND_REC_HDR_SIZE + BOND_PAYLOAD_MAX)
+
+/* 哈希索引 (线性探测)，负载不超过 1/2 */
+#define BOND_INDEX_SIZE         (XF_BLE_BOND_STORE_BOND_NUM * 2)
+/* 记录从 BOND_REC_FIRST_OFF 开始，偏移 0 不会是记录，零初始化的索引即为空 */
+#define BOND_INDEX_OFF_NONE     (0)
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct {
+    xf_ble_addr_t id_addr;
+    uint16_t rec_size;                      /*!< 记录大小 (含头及填充) */
+    uint32_t off;                           /*!< 记录在当前区内的偏移， BOND_INDEX_OFF_NONE 表示空 */
+} bond_index_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static xf_err_t bond_format(uint8_t bank, uint32_t seq);
+static xf_err_t bond_bank_hdr_write(uint8_t bank, uint32_t seq);
+static bool bond_bank_hdr_read(uint8_t bank, uint32_t *seq);
+static xf_err_t bond_replay(void);
+static xf_err_t bond_append(uint8_t type, const uint8_t *payload, uint16_t len,
+                            uint32_t *off, uint16_t *rec_size);
+static xf_err_t bond_compact(void);
+static xf_err_t bond_rec_read(uint32_t off, uint16_t rec_size, uint8_t *type, uint16_t *len);
+static uint16_t bond_encode(const xf_ble_bond_t *bond, uint8_t *buf);
+static xf_err_t bond_decode(const uint8_t *buf, uint16_t len, xf_ble_bond_t *bond);
+static void bond_addr_encode(const xf_ble_addr_t *addr, uint8_t *buf);
+static void bond_addr_decode(const uint8_t *buf, xf_ble_addr_t *addr);
+static uint16_t bond_index_hash(const xf_ble_addr_t *id_addr);
+static int bond_index_find(const xf_ble_addr_t *id_addr);
+static xf_err_t bond_index_put(const xf_ble_addr_t *id_addr, uint32_t off, uint16_t rec_size);
+static void bond_index_del(int slot);
+static void bond_index_reset(void);
+static uint32_t bond_crc32(uint32_t crc, const uint8_t *data, uint32_t len);
+
+/* ==================== [Static Variables] ================================== */
+
+static const uint32_t s_crc32_tbl[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+
+static bool s_is_inited = false;
+static xf_ble_bond_store_backend_t s_backend = {0};
+static uint8_t s_bank = 0;
+static uint32_t s_seq = 0;
+static uint32_t s_write_off = 0;            /*!< 当前区的下一个写入偏移 */
+static uint32_t s_live_size = 0;
+static bool s_need_compact = false;         /*!< 发现损坏 (如掉电中断的写入) 的记录，下次写入前整理 */
+static uint32_t s_compact_cnt = 0;
+
+static bond_index_t s_index[BOND_INDEX_SIZE] = {0};
+static uint16_t s_bond_num = 0;
+
+static uint8_t s_rec_buf[BOND_REC_SIZE_MAX] = {0};
+
+/* ==================== [Macros] ============================================ */
+
+#define BOND_BANK_BASE(bank)    ((uint32_t)(bank) * s_backend.bank_size)
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_ble_bond_store_init(const xf_ble_bond_store_backend_t *backend)
+{
+    XF_CHECK(backend == NULL, XF_ERR_INVALID_ARG, TAG, "backend == NULL");
+    XF_CHECK((backend->read == NULL) || (backend->write == NULL) || (backend->erase == NULL),
+             XF_ERR_INVALID_ARG, TAG, "backend ops == NULL");
+    XF_CHECK(backend->bank_size < (BOND_REC_FIRST_OFF + BOND_REC_SIZE_MAX),
+             XF_ERR_INVALID_ARG, TAG, "bank_size(%u) too small", (unsigned)backend->bank_size);
+
+    s_backend = *backend;
+    s_is_inited = false;
+    s_need_compact = false;
+    bond_index_reset();
+
+    uint32_t seq_set[2] = {0};
+    bool is_valid_set[2];
+    is_valid_set[0] = bond_bank_hdr_read(0, &seq_set[0]);
+    is_valid_set[1] = bond_bank_hdr_read(1, &seq_set[1]);
+
+    xf_err_t ret = XF_OK;
+    if (!is_valid_set[0] && !is_valid_set[1]) {
+        XF_LOGI(TAG, "empty, format");
+        ret = bond_format(0, 1);
+        XF_CHECK(ret != XF_OK, ret, TAG, "format failed: %d", ret);
+        s_bank = 0;
+        s_seq = 1;
+        s_write_off = BOND_REC_FIRST_OFF;
+    } else {
+        /* 两区均有效说明整理后擦除旧区前掉电，以序号较新者为准 */
+        if (is_valid_set[0] && is_valid_set[1]) {
+            s_bank = ((int32_t)(seq_set[1] - seq_set[0]) > 0) ? 1 : 0;
+        } else {
+            s_bank = is_valid_set[1] ? 1 : 0;
+        }
+        s_seq = seq_set[s_bank];
+        ret = bond_replay();
+        XF_CHECK(ret != XF_OK, ret, TAG, "replay failed: %d", ret);
+    }
+    s_is_inited = true;
+    XF_LOGD(TAG, "bank %d seq %u: %d bond, %u/%u", s_bank, (unsigned)s_seq, s_bond_num,
+            (unsigned)s_live_size, (unsigned)s_write_off);
+    return XF_OK;
+}
+
+xf_err_t xf_ble_bond_store_put(const xf_ble_bond_t *bond)
+{
+    XF_CHECK(bond == NULL, XF_ERR_INVALID_ARG, TAG, "bond == NULL");
+    XF_CHECK((bond->key_mask & XF_BLE_BOND_KEY_LTK)
+             && ((bond->ltk_size < 7) || (bond->ltk_size > XF_BLE_SM_KEY_SIZE_MAX)),
+             XF_ERR_INVALID_ARG, TAG, "invalid ltk_size: %d", bond->ltk_size);
+    XF_CHECK(bond->cccd_num > XF_BLE_BOND_STORE_CCCD_NUM, XF_ERR_INVALID_ARG,
+             TAG, "cccd_num(%d) exceeds max: %d", bond->cccd_num, XF_BLE_BOND_STORE_CCCD_NUM);
+    XF_CHECK(!s_is_inited, XF_ERR_INVALID_STATE, TAG, "not inited");
+
+    int slot = bond_index_find(&bond->id_addr);
+    XF_CHECK((slot < 0) && (s_bond_num >= XF_BLE_BOND_STORE_BOND_NUM), XF_ERR_NO_MEM,
+             TAG, "bond num exceeds max: %d", XF_BLE_BOND_STORE_BOND_NUM);
+
+    uint8_t payload[BOND_PAYLOAD_MAX];
+    uint16_t len = bond_encode(bond, payload);
+    uint32_t off = 0;
+    uint16_t rec_size = 0;
+    xf_err_t ret = bond_append(BOND_REC_TYPE_PUT, payload, len, &off, &rec_size);
+    XF_CHECK(ret != XF_OK, ret, TAG, "append failed: %d", ret);
+
+    /* 整理可能已移动记录，重新查找 */
+    slot = bond_index_find(&bond->id_addr);
+    if (slot >= 0) {
+        s_live_size -= s_index[slot].rec_size;
+        s_index[slot].off = off;
+        s_index[slot].rec_size = rec_size;
+    } else {
+        bond_index_put(&bond->id_addr, off, rec_size);
+    }
+    s_live_size += rec_size;
+    return XF_OK;
+}
+
+xf_err_t xf_ble_bond_store_get(const xf_ble_addr_t *id_addr, xf_ble_bond_t *bond)
+{
+    XF_CHECK((id_addr == NULL) || (bond == NULL), XF_ERR_INVALID_ARG,
+             TAG, "id_addr or bond == NULL");
+
+    int slot = s_is_inited ? bond_index_find(id_addr) : -1;
+    if (slot < 0) {
+        return XF_ERR_NOT_FOUND;
+    }
+    uint8_t type = 0;
+    uint16_t len = 0;
+    xf_err_t ret = bond_rec_read(s_index[slot].off, s_index[slot].rec_size, &type, &len);
+    XF_CHECK(ret != XF_OK, ret, TAG, "read record failed: %d", ret);
+    return bond_decode(&s_rec_buf[BOND_REC_HDR_SIZE], len, bond);
+}
+
+bool xf_ble_bond_store_is_exist(const xf_ble_addr_t *id_addr)
+{
+    return (id_addr != NULL) && s_is_inited && (bond_index_find(id_addr) >= 0);
+}
+
+xf_err_t xf_ble_bond_store_del(const xf_ble_addr_t *id_addr)
+{
+    XF_CHECK(id_addr == NULL, XF_ERR_INVALID_ARG, TAG, "id_addr == NULL");
+
+    int slot = s_is_inited ? bond_index_find(id_addr) : -1;
+    if (slot < 0) {
+        return XF_ERR_NOT_FOUND;
+    }
+    bond_index_t entry = s_index[slot];
+    s_live_size -= entry.rec_size;
+    bond_index_del(slot);
+
+    xf_err_t ret = XF_OK;
+    if (s_need_compact
+            || ((s_write_off + BOND_ALIGN_UP(BOND_REC_HDR_SIZE + BOND_ADDR_ENC_SIZE)) > s_backend.bank_size)) {
+        /* 空间不足时直接整理，已从索引删除的记录不会被复制，无需删除记录 */
+        ret = bond_compact();
+    } else {
+        uint8_t payload[BOND_ADDR_ENC_SIZE];
+        bond_addr_encode(id_addr, payload);
+        uint32_t off = 0;
+        uint16_t rec_size = 0;
+        ret = bond_append(BOND_REC_TYPE_DEL, payload, sizeof(payload), &off, &rec_size);
+    }
+    if (ret != XF_OK) {
+        bond_index_put(&entry.id_addr, entry.off, entry.rec_size);
+        s_live_size += entry.rec_size;
+        XF_LOGE(TAG, "del failed: %d", ret);
+        return ret;
+    }
+    return XF_OK;
+}
+
+xf_err_t xf_ble_bond_store_clear(void)
+{
+    XF_CHECK(!s_is_inited, XF_ERR_INVALID_STATE, TAG, "not inited");
+
+    uint8_t other = 1 - s_bank;
+    xf_err_t ret = s_backend.erase(BOND_BANK_BASE(other), s_backend.bank_size, s_backend.user_data);
+    XF_CHECK(ret != XF_OK, ret, TAG, "erase failed: %d", ret);
+    ret = bond_format(s_bank, s_seq + 1);
+    XF_CHECK(ret != XF_OK, ret, TAG, "format failed: %d", ret);
+    s_seq++;
+    s_write_off = BOND_REC_FIRST_OFF;
+    s_need_compact = false;
+    bond_index_reset();
+    return XF_OK;
+}
+
+xf_err_t xf_ble_bond_store_set_cccd(const xf_ble_addr_t *id_addr, uint16_t handle, uint16_t value)
+{
+    XF_CHECK(id_addr == NULL, XF_ERR_INVALID_ARG, TAG, "id_addr == NULL");
+
+    xf_ble_bond_t bond;
+    xf_err_t ret = xf_ble_bond_store_get(id_addr, &bond);
+    if (ret != XF_OK) {
+        return ret;
+    }
+    uint8_t i = 0;
+    while ((i < bond.cccd_num) && (bond.cccd_set[i].handle != handle)) {
+        i++;
+    }
+    if (i < bond.cccd_num) {
+        if (bond.cccd_set[i].value == value) {
+            return XF_OK;
+        }
+        if (value != 0) {
+            bond.cccd_set[i].value = value;
+        } else {
+            bond.cccd_set[i] = bond.cccd_set[--bond.cccd_num];
+        }
+    } else {
+        if (value == 0) {
+            return XF_OK;
+        }
+        XF_CHECK(bond.cccd_num >= XF_BLE_BOND_STORE_CCCD_NUM, XF_ERR_NO_MEM,
+                 TAG, "cccd num exceeds max: %d", XF_BLE_BOND_STORE_CCCD_NUM);
+        bond.cccd_set[bond.cccd_num].handle = handle;
+        bond.cccd_set[bond.cccd_num].value = value;
+        bond.cccd_num++;
+    }
+    return xf_ble_bond_store_put(&bond);
+}
+
+xf_err_t xf_ble_bond_store_get_list(uint16_t *max_num, xf_ble_addr_t *dev_list)
+{
+    XF_CHECK((max_num == NULL) || ((dev_list == NULL) && (*max_num != 0)),
+             XF_ERR_INVALID_ARG, TAG, "max_num or dev_list == NULL");
+    if (!s_is_inited) {
+        *max_num = 0;
+        XF_LOGE(TAG, "not inited");
+        return XF_ERR_INVALID_STATE;
+    }
+
+    uint16_t num = 0;
+    for (uint16_t i = 0; (i < BOND_INDEX_SIZE) && (num < *max_num); i++) {
+        if (s_index[i].off != BOND_INDEX_OFF_NONE) {
+            dev_list[num++] = s_index[i].id_addr;
+        }
+    }
+    *max_num = num;
+    return XF_OK;
+}
+
+xf_err_t xf_ble_bond_store_compact(void)
+{
+    XF_CHECK(!s_is_inited, XF_ERR_INVALID_STATE, TAG, "not inited");
+    return bond_compact();
+}
+
+xf_err_t xf_ble_bond_store_get_stats(xf_ble_bond_store_stats_t *stats)
+{
+    XF_CHECK(stats == NULL, XF_ERR_INVALID_ARG, TAG, "stats == NULL");
+    if (!s_is_inited) {
+        xf_memset(stats, 0, sizeof(xf_ble_bond_store_stats_t));
+        XF_LOGE(TAG, "not inited");
+        return XF_ERR_INVALID_STATE;
+    }
+    stats->bond_num = s_bond_num;
+    stats->bank = s_bank;
+    stats->used_size = s_write_off;
+    stats->live_size = s_live_size;
+    stats->compact_cnt = s_compact_cnt;
+    return XF_OK;
+}
+
+xf_ble_evt_res_t xf_ble_bond_store_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param)
+{
+    if ((event != XF_BLE_GAP_EVT_PAIR_END) || (param == NULL) || !s_is_inited
+            || !param->pair_end.is_succ || (param->pair_end.addr == NULL)
+            || (param->pair_end.ltk.data == NULL) || (param->pair_end.ltk.len < 7)
+            || (param->pair_end.ltk.len > XF_BLE_SM_KEY_SIZE_MAX)) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+    /* 对端使用 RPA 时事件中的地址并非身份地址，以其为索引的记录下次连接时无法找到，需由应用保存 */
+    if (xf_ble_addr_is_rpa(param->pair_end.addr)) {
+        XF_LOGD(TAG, "conn(%d) peer addr is rpa, skip auto save", param->pair_end.conn_id);
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+
+    xf_ble_bond_t bond;
+    if (xf_ble_bond_store_get(param->pair_end.addr, &bond) != XF_OK) {
+        xf_memset(&bond, 0, sizeof(xf_ble_bond_t));
+        bond.id_addr = *param->pair_end.addr;
+    }
+    bond.key_mask |= XF_BLE_BOND_KEY_LTK;
+    bond.ltk_size = param->pair_end.ltk.len;
+    xf_memset(bond.ltk, 0, sizeof(bond.ltk));
+    xf_memcpy(bond.ltk, param->pair_end.ltk.data, param->pair_end.ltk.len);
+    bond.sec_level = xf_ble_conn_table_get_sec_level(param->pair_end.conn_id);
+    xf_err_t ret = xf_ble_bond_store_put(&bond);
+    if (ret != XF_OK) {
+        XF_LOGW(TAG, "conn(%d) save bond failed: %d", param->pair_end.conn_id, ret);
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 擦除指定区并写入区头
+ */
+static xf_err_t bond_format(uint8_t bank, uint32_t seq)
+{
+    xf_err_t ret = s_backend.erase(BOND_BANK_BASE(bank), s_backend.bank_size, s_backend.user_data);
+    if (ret != XF_OK) {
+        return ret;
+    }
+    return bond_bank_hdr_write(bank, seq);
+}
+
+static xf_err_t bond_bank_hdr_write(uint8_t bank, uint32_t seq)
+{
+    uint8_t *hdr = s_rec_buf;
+    xf_memset(hdr, 0xFF, BOND_REC_FIRST_OFF);
+    hdr[0] = (uint8_t)BOND_BANK_MAGIC;
+    hdr[1] = (uint8_t)(BOND_BANK_MAGIC >> 8);
+    hdr[2] = (uint8_t)(BOND_BANK_MAGIC >> 16);
+    hdr[3] = (uint8_t)(BOND_BANK_MAGIC >> 24);
+    hdr[4] = XF_BLE_BOND_STORE_VERSION;
+    hdr[8] = (uint8_t)seq;
+    hdr[9] = (uint8_t)(seq >> 8);
+    hdr[10] = (uint8_t)(seq >> 16);
+    hdr[11] = (uint8_t)(seq >> 24);
+    uint32_t crc = bond_crc32(0, hdr, 12);
+    hdr[12] = (uint8_t)crc;
+    hdr[13] = (uint8_t)(crc >> 8);
+    hdr[14] = (uint8_t)(crc >> 16);
+    hdr[15] = (uint8_t)(crc >> 24);
+    return s_backend.write(BOND_BANK_BASE(bank), hdr, BOND_REC_FIRST_OFF, s_backend.user_data);
+}
+
+static bool bond_bank_hdr_read(uint8_t bank, uint32_t *seq)
+{
+    uint8_t hdr[BOND_BANK_HDR_SIZE];
+    if (s_backend.read(BOND_BANK_BASE(bank), hdr, sizeof(hdr), s_backend.user_data) != XF_OK) {
+        return false;
+    }
+    uint32_t magic = hdr[0] | ((uint32_t)hdr[1] << 8) | ((uint32_t)hdr[2] << 16) | ((uint32_t)hdr[3] << 24);
+    uint32_t crc = hdr[12] | ((uint32_t)hdr[13] << 8) | ((uint32_t)hdr[14] << 16) | ((uint32_t)hdr[15] << 24);
+    if ((magic != BOND_BANK_MAGIC) || (crc != bond_crc32(0, hdr, 12))) {
+        return false;
+    }
+    /* 区头版本仅用于将来的格式迁移，当前版本按原样读取 */
+    *seq = hdr[8] | ((uint32_t)hdr[9] << 8) | ((uint32_t)hdr[10] << 16) | ((uint32_t)hdr[11] << 24);
+    return true;
+}
+
+/**
+ * @brief 回放当前区的日志，重建索引；遇到损坏记录时停止并标记待整理
+ */
+static xf_err_t bond_replay(void)
+{
+    uint32_t off = BOND_REC_FIRST_OFF;
+    while ((off + BOND_REC_HDR_SIZE) <= s_backend.bank_size) {
+        uint8_t *hdr = s_rec_buf;
+        xf_err_t ret = s_backend.read(BOND_BANK_BASE(s_bank) + off, hdr, BOND_REC_HDR_SIZE,
+                                      s_backend.user_data);
+        if (ret != XF_OK) {
+            return ret;
+        }
+        bool is_erased = true;
+        for (uint8_t i = 0; i < BOND_REC_HDR_SIZE; i++) {
+            is_erased = is_erased && (hdr[i] == 0xFF);
+        }
+        if (is_erased) {
+            break;
+        }
+        uint16_t len = hdr[2] | ((uint16_t)hdr[3] << 8);
+        uint16_t rec_size = BOND_ALIGN_UP(BOND_REC_HDR_SIZE + len);
+        uint8_t type = 0;
+        if ((hdr[0] != BOND_REC_MAGIC) || (len > BOND_PAYLOAD_MAX)
+                || ((off + rec_size) > s_backend.bank_size)
+                || (bond_rec_read(off, rec_size, &type, &len) != XF_OK)) {
+            XF_LOGW(TAG, "corrupted record at %u", (unsigned)off);
+            s_need_compact = true;
+            break;
+        }
+        const uint8_t *payload = &s_rec_buf[BOND_REC_HDR_SIZE];
+        if ((type == BOND_REC_TYPE_PUT) && (len >= (1 + BOND_ADDR_ENC_SIZE))) {
+            /* 各版本的载荷均以 version(1) + 身份地址开头 */
+            xf_ble_addr_t id_addr;
+            bond_addr_decode(&payload[1], &id_addr);
+            int slot = bond_index_find(&id_addr);
+            if (slot >= 0) {
+                s_live_size -= s_index[slot].rec_size;
+                s_index[slot].off = off;
+                s_index[slot].rec_size = rec_size;
+                s_live_size += rec_size;
+            } else if (bond_index_put(&id_addr, off, rec_size) == XF_OK) {
+                s_live_size += rec_size;
+            } else {
+                XF_LOGW(TAG, "bond num exceeds max: %d, dropped", XF_BLE_BOND_STORE_BOND_NUM);
+            }
+        } else if ((type == BOND_REC_TYPE_DEL) && (len >= BOND_ADDR_ENC_SIZE)) {
+            xf_ble_addr_t id_addr;
+            bond_addr_decode(payload, &id_addr);
+            int slot = bond_index_find(&id_addr);
+            if (slot >= 0) {
+                s_live_size -= s_index[slot].rec_size;
+                bond_index_del(slot);
+            }
+        }
+        /* 未知类型的记录 (更新的版本写入) 跳过 */
+        off += rec_size;
+    }
+    s_write_off = off;
+    return XF_OK;
+}
+
+/**
+ * @brief 追加一条记录，空间不足或有损坏记录时先整理
+ */
+static xf_err_t bond_append(uint8_t type, const uint8_t *payload, uint16_t len,
+                            uint32_t *off, uint16_t *rec_size)
+{
+    uint16_t size = BOND_ALIGN_UP(BOND_REC_HDR_SIZE + len);
+    if (s_need_compact || ((s_write_off + size) > s_backend.bank_size)) {
+        xf_err_t ret = bond_compact();
+        if (ret != XF_OK) {
+            return ret;
+        }
+        if ((s_write_off + size) > s_backend.bank_size) {
+            return XF_ERR_NO_MEM;
+        }
+    }
+
+    uint8_t *rec = s_rec_buf;
+    xf_memset(rec, 0xFF, size);
+    rec[0] = BOND_REC_MAGIC;
+    rec[1] = type;
+    rec[2] = (uint8_t)len;
+    rec[3] = (uint8_t)(len >> 8);
+    xf_memcpy(&rec[BOND_REC_HDR_SIZE], payload, len);
+    uint32_t crc = bond_crc32(bond_crc32(0, &rec[1], 3), &rec[BOND_REC_HDR_SIZE], len);
+    rec[4] = (uint8_t)crc;
+    rec[5] = (uint8_t)(crc >> 8);
+    rec[6] = (uint8_t)(crc >> 16);
+    rec[7] = (uint8_t)(crc >> 24);
+
+    /* 整条记录一次写入；掉电中断时回放会因校验失败停在此处 */
+    xf_err_t ret = s_backend.write(BOND_BANK_BASE(s_bank) + s_write_off, rec, size, s_backend.user_data);
+    if (ret != XF_OK) {
+        /* 该位置可能已部分写入，不再复用 */
+        s_need_compact = true;
+        return ret;
+    }
+    *off = s_write_off;
+    *rec_size = size;
+    s_write_off += size;
+    return XF_OK;
+}
+
+/**
+ * @brief 整理: 擦除另一区，复制有效记录，最后写入序号加一的区头 (此前掉电则旧区仍有效)，再擦除旧区
+ */
+static xf_err_t bond_compact(void)
+{
+    uint8_t new_bank = 1 - s_bank;
+    uint32_t new_base = BOND_BANK_BASE(new_bank);
+    xf_err_t ret = s_backend.erase(new_base, s_backend.bank_size, s_backend.user_data);
+    if (ret != XF_OK) {
+        return ret;
+    }
+
+    uint32_t off = BOND_REC_FIRST_OFF;
+    for (uint16_t i = 0; i < BOND_INDEX_SIZE; i++) {
+        if (s_index[i].off == BOND_INDEX_OFF_NONE) {
+            continue;
+        }
+        ret = s_backend.read(BOND_BANK_BASE(s_bank) + s_index[i].off, s_rec_buf,
+                             s_index[i].rec_size, s_backend.user_data);
+        if (ret == XF_OK) {
+            ret = s_backend.write(new_base + off, s_rec_buf, s_index[i].rec_size, s_backend.user_data);
+        }
+        if (ret != XF_OK) {
+            return ret;
+        }
+        off += s_index[i].rec_size;
+    }
+
+    /* 写入区头后新区才生效 */
+    uint32_t seq = s_seq + 1;
+    ret = bond_bank_hdr_write(new_bank, seq);
+    if (ret != XF_OK) {
+        return ret;
+    }
+
+    /* 按相同顺序重新计算偏移 */
+    off = BOND_REC_FIRST_OFF;
+    for (uint16_t i = 0; i < BOND_INDEX_SIZE; i++) {
+        if (s_index[i].off != BOND_INDEX_OFF_NONE) {
+            s_index[i].off = off;
+            off += s_index[i].rec_size;
+        }
+    }
+    uint8_t old_bank = s_bank;
+    s_bank = new_bank;
+    s_seq = seq;
+    s_write_off = off;
+    s_live_size = off - BOND_REC_FIRST_OFF;
+    s_need_compact = false;
+    s_compact_cnt++;
+
+    ret = s_backend.erase(BOND_BANK_BASE(old_bank), s_backend.bank_size, s_backend.user_data);
+    if (ret != XF_OK) {
+        /* 旧区序号较小，下次挂载时仍以新区为准 */
+        XF_LOGW(TAG, "erase old bank failed: %d", ret);
+    }
+    XF_LOGD(TAG, "compacted to bank %d: %u bytes", s_bank, (unsigned)s_write_off);
+    return XF_OK;
+}
+
+/**
+ * @brief 读取一条记录到 s_rec_buf 并校验
+ */
+static xf_err_t bond_rec_read(uint32_t off, uint16_t rec_size, uint8_t *type, uint16_t *len)
+{
+    xf_err_t ret = s_backend.read(BOND_BANK_BASE(s_bank) + off, s_rec_buf, rec_size, s_backend.user_data);
+    if (ret != XF_OK) {
+        return ret;
+    }
+    uint16_t payload_len = s_rec_buf[2] | ((uint16_t)s_rec_buf[3] << 8);
+    uint32_t crc = s_rec_buf[4] | ((uint32_t)s_rec_buf[5] << 8)
+                   | ((uint32_t)s_rec_buf[6] << 16) | ((uint32_t)s_rec_buf[7] << 24);
+    if ((s_rec_buf[0] != BOND_REC_MAGIC) || ((BOND_REC_HDR_SIZE + payload_len) > rec_size)
+            || (crc != bond_crc32(bond_crc32(0, &s_rec_buf[1], 3),
+                                  &s_rec_buf[BOND_REC_HDR_SIZE], payload_len))) {
+        return XF_FAIL;
+    }
+    *type = s_rec_buf[1];
+    *len = payload_len;
+    return XF_OK;
+}
+
+/**
+ * @brief 编码绑定信息 (仅写入有效的字段):
+ *  version(1) id_addr(7) flags(1) sec_level(1)
+ *  [ltk_size(1) ltk(ltk_size)] [ediv(2) rand(8)] [irk(16)] [csrk(16)]
+ *  cccd_num(1) [handle(2) value(2)] * cccd_num
+ */
+static uint16_t bond_encode(const xf_ble_bond_t *bond, uint8_t *buf)
+{
+    uint16_t n = 0;
+    uint8_t flags = 0;
+    if (bond->key_mask & XF_BLE_BOND_KEY_LTK) {
+        flags |= BOND_FLAG_LTK;
+        bool has_ediv_rand = (bond->ediv != 0);
+        for (uint8_t i = 0; i < sizeof(bond->rand); i++) {
+            has_ediv_rand = has_ediv_rand || (bond->rand[i] != 0);
+        }
+        flags |= has_ediv_rand ? BOND_FLAG_EDIV_RAND : 0;
+    }
+    flags |= (bond->key_mask & XF_BLE_BOND_KEY_IRK) ? BOND_FLAG_IRK : 0;
+    flags |= (bond->key_mask & XF_BLE_BOND_KEY_CSRK) ? BOND_FLAG_CSRK : 0;
+
+    buf[n++] = XF_BLE_BOND_STORE_VERSION;
+    bond_addr_encode(&bond->id_addr, &buf[n]);
+    n += BOND_ADDR_ENC_SIZE;
+    buf[n++] = flags;
+    buf[n++] = bond->sec_level;
+    if (flags & BOND_FLAG_LTK) {
+        buf[n++] = bond->ltk_size;
+        xf_memcpy(&buf[n], bond->ltk, bond->ltk_size);
+        n += bond->ltk_size;
+    }
+    if (flags & BOND_FLAG_EDIV_RAND) {
+        buf[n++] = (uint8_t)bond->ediv;
+        buf[n++] = (uint8_t)(bond->ediv >> 8);
+        xf_memcpy(&buf[n], bond->rand, sizeof(bond->rand));
+        n += sizeof(bond->rand);
+    }
+    if (flags & BOND_FLAG_IRK) {
+        xf_memcpy(&buf[n], bond->irk.irk, XF_BLE_SM_KEY_SIZE_MAX);
+        n += XF_BLE_SM_KEY_SIZE_MAX;
+    }
+    if (flags & BOND_FLAG_CSRK) {
+        xf_memcpy(&buf[n], bond->csrk.tk, XF_BLE_SM_KEY_SIZE_MAX);
+        n += XF_BLE_SM_KEY_SIZE_MAX;
+    }
+    buf[n++] = bond->cccd_num;
+    for (uint8_t i = 0; i < bond->cccd_num; i++) {
+        buf[n++] = (uint8_t)bond->cccd_set[i].handle;
+        buf[n++] = (uint8_t)(bond->cccd_set[i].handle >> 8);
+        buf[n++] = (uint8_t)bond->cccd_set[i].value;
+        buf[n++] = (uint8_t)(bond->cccd_set[i].value >> 8);
+    }
+    return n;
+}
+
+static xf_err_t bond_decode(const uint8_t *buf, uint16_t len, xf_ble_bond_t *bond)
+{
+    /* 按字段逐一检查剩余长度 */
+#define BOND_NEED(size) do { if ((n + (size)) > len) { return XF_FAIL; } } while (0)
+    uint16_t n = 0;
+    xf_memset(bond, 0, sizeof(xf_ble_bond_t));
+    BOND_NEED(1 + BOND_ADDR_ENC_SIZE + 2);
+    if (buf[n++] != XF_BLE_BOND_STORE_VERSION) {
+        return XF_ERR_NOT_SUPPORTED;
+    }
+    bond_addr_decode(&buf[n], &bond->id_addr);
+    n += BOND_ADDR_ENC_SIZE;
+    uint8_t flags = buf[n++];
+    bond->sec_level = buf[n++];
+    if (flags & BOND_FLAG_LTK) {
+        BOND_NEED(1);
+        bond->ltk_size = buf[n++];
+        if (bond->ltk_size > XF_BLE_SM_KEY_SIZE_MAX) {
+            return XF_FAIL;
+        }
+        BOND_NEED(bond->ltk_size);
+        xf_memcpy(bond->ltk, &buf[n], bond->ltk_size);
+        n += bond->ltk_size;
+        bond->key_mask |= XF_BLE_BOND_KEY_LTK;
+    }
+    if (flags & BOND_FLAG_EDIV_RAND) {
+        BOND_NEED(2 + sizeof(bond->rand));
+        bond->ediv = buf[n] | ((uint16_t)buf[n + 1] << 8);
+        n += 2;
+        xf_memcpy(bond->rand, &buf[n], sizeof(bond->rand));
+        n += sizeof(bond->rand);
+    }
+    if (flags & BOND_FLAG_IRK) {
+        BOND_NEED(XF_BLE_SM_KEY_SIZE_MAX);
+        xf_memcpy(bond->irk.irk, &buf[n], XF_BLE_SM_KEY_SIZE_MAX);
+        n += XF_BLE_SM_KEY_SIZE_MAX;
+        bond->key_mask |= XF_BLE_BOND_KEY_IRK;
+    }
+    if (flags & BOND_FLAG_CSRK) {
+        BOND_NEED(XF_BLE_SM_KEY_SIZE_MAX);
+        xf_memcpy(bond->csrk.tk, &buf[n], XF_BLE_SM_KEY_SIZE_MAX);
+        n += XF_BLE_SM_KEY_SIZE_MAX;
+        bond->key_mask |= XF_BLE_BOND_KEY_CSRK;
+    }
+    BOND_NEED(1);
+    uint8_t cccd_num = buf[n++];
+    if (cccd_num > XF_BLE_BOND_STORE_CCCD_NUM) {
+        return XF_FAIL;
+    }
+    BOND_NEED(4 * cccd_num);
+    for (uint8_t i = 0; i < cccd_num; i++) {
+        bond->cccd_set[i].handle = buf[n] | ((uint16_t)buf[n + 1] << 8);
+        bond->cccd_set[i].value = buf[n + 2] | ((uint16_t)buf[n + 3] << 8);
+        n += 4;
+    }
+    bond->cccd_num = cccd_num;
+    return XF_OK;
+#undef BOND_NEED
+}
+
+static void bond_addr_encode(const xf_ble_addr_t *addr, uint8_t *buf)
+{
+    buf[0] = addr->type;
+    xf_memcpy(&buf[1], addr->addr, XF_BLE_ADDR_LEN);
+}
+
+static void bond_addr_decode(const uint8_t *buf, xf_ble_addr_t *addr)
+{
+    addr->type = buf[0];
+    xf_memcpy(addr->addr, &buf[1], XF_BLE_ADDR_LEN);
+}
+
+/**
+ * @brief 身份地址的理想槽位 (FNV-1a 哈希)
+ */
+static uint16_t bond_index_hash(const xf_ble_addr_t *id_addr)
+{
+    uint32_t hash = 2166136261UL;
+    hash = (hash ^ id_addr->type) * 16777619UL;
+    for (uint8_t i = 0; i < XF_BLE_ADDR_LEN; i++) {
+        hash = (hash ^ id_addr->addr[i]) * 16777619UL;
+    }
+    return (uint16_t)(hash % BOND_INDEX_SIZE);
+}
+
+/**
+ * @brief 查找索引槽位
+ *
+ * @return int 找到时为槽位；未找到时为 -(可插入的空槽位 + 1)
+ */
+static int bond_index_find(const xf_ble_addr_t *id_addr)
+{
+    uint16_t slot = bond_index_hash(id_addr);
+    for (uint16_t n = 0; n < BOND_INDEX_SIZE; n++) {
+        if (s_index[slot].off == BOND_INDEX_OFF_NONE) {
+            return -(int)slot - 1;
+        }
+        if (xf_ble_addr_is_equal(&s_index[slot].id_addr, id_addr)) {
+            return slot;
+        }
+        slot = (slot + 1) % BOND_INDEX_SIZE;
+    }
+    return -(int)BOND_INDEX_SIZE - 1;
+}
+
+static xf_err_t bond_index_put(const xf_ble_addr_t *id_addr, uint32_t off, uint16_t rec_size)
+{
+    if (s_bond_num >= XF_BLE_BOND_STORE_BOND_NUM) {
+        return XF_ERR_NO_MEM;
+    }
+    /* 负载不超过 1/2 ，未找到时必有空槽位 */
+    int slot = -bond_index_find(id_addr) - 1;
+    s_index[slot].id_addr = *id_addr;
+    s_index[slot].off = off;
+    s_index[slot].rec_size = rec_size;
+    s_bond_num++;
+    return XF_OK;
+}
+
+/**
+ * @brief 删除索引槽位 (后移删除，保持探测链连续，无需墓碑)
+ */
+static void bond_index_del(int slot)
+{
+    uint16_t hole = (uint16_t)slot;
+    uint16_t cur = hole;
+    s_index[hole].off = BOND_INDEX_OFF_NONE;
+    s_bond_num--;
+    while (true) {
+        cur = (cur + 1) % BOND_INDEX_SIZE;
+        if (s_index[cur].off == BOND_INDEX_OFF_NONE) {
+            break;
+        }
+        /* cur 的理想槽位不在 (hole, cur] 区间内时可前移到 hole */
+        uint16_t ideal = bond_index_hash(&s_index[cur].id_addr);
+        bool can_move = (hole <= cur) ? ((ideal <= hole) || (ideal > cur))
+                                      : ((ideal <= hole) && (ideal > cur));
+        if (can_move) {
+            s_index[hole] = s_index[cur];
+            s_index[cur].off = BOND_INDEX_OFF_NONE;
+            hole = cur;
+        }
+    }
+}
+
+static void bond_index_reset(void)
+{
+    for (uint16_t i = 0; i < BOND_INDEX_SIZE; i++) {
+        s_index[i].off = BOND_INDEX_OFF_NONE;
+    }
+    s_bond_num = 0;
+    s_live_size = 0;
+}
+
+/**
+ * @brief CRC-32 (IEEE 802.3 ，与 zlib 一致)，半字节查表
+ */
+static uint32_t bond_crc32(uint32_t crc, const uint8_t *data, uint32_t len)
+{
+    crc = ~crc;
+    for (uint32_t i = 0; i < len; i++) {
+        crc = s_crc32_tbl[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+        crc = s_crc32_tbl[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+    }
+    return ~crc;
+}
+
+#endif /* XF_BLE_IS_ENABLE */
@@ -0,0 +1,282 @@
+/**
+ * @file xf_ble_bond_store.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 绑定信息存储。
+ *  以紧凑的带版本二进制记录保存绑定信息 (身份地址、 LTK 、 IRK 、 CSRK 、安全等级、 CCCD 状态)，
+ *  持久化为双区仅追加日志 (更新与删除均追加记录，区满时整理到另一区并擦除)，
+ *  内存中仅保留按身份地址的哈希索引 (地址 -> 记录偏移)，可保存远多于控制器绑定表的设备。
+ *  存储介质由后端 (flash 或文件) 提供。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_BOND_STORE_H__
+#define __XF_BLE_BOND_STORE_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gap_types.h"
+#include "xf_ble_sm_types.h"
+#include "xf_ble_conn_table.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief BLE 绑定信息存储: 记录格式版本
+ */
+#define XF_BLE_BOND_STORE_VERSION       (1)
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE 绑定信息中有效的密钥 (位掩码，可组合)
+ */
+typedef uint8_t xf_ble_bond_key_mask_t;
+enum _xf_ble_bond_key_mask_t {
+    XF_BLE_BOND_KEY_LTK     = (1 << 0),     /*!< LTK (及 EDIV 、 Rand) */
+    XF_BLE_BOND_KEY_IRK     = (1 << 1),     /*!< IRK */
+    XF_BLE_BOND_KEY_CSRK    = (1 << 2),     /*!< CSRK */
+};
+
+/**
+ * @brief BLE 绑定信息中的 CCCD 状态
+ */
+typedef struct {
+    uint16_t handle;                        /*!< CCCD 句柄 */
+    uint16_t value;                         /*!< CCCD 值 (通知 / 指示使能) */
+} xf_ble_bond_cccd_t;
+
+/**
+ * @brief BLE 绑定信息
+ */
+typedef struct {
+    xf_ble_addr_t id_addr;                  /*!< 对端身份地址 (索引键)，见 @ref xf_ble_addr_t */
+    xf_ble_bond_key_mask_t key_mask;        /*!< 有效的密钥，见 @ref xf_ble_bond_key_mask_t */
+    xf_ble_conn_sec_level_t sec_level;      /*!< 安全等级，见 @ref xf_ble_conn_sec_level_t */
+    uint8_t ltk_size;                       /*!< LTK 有效长度 (7 ~ 16 字节) */
+    uint8_t ltk[XF_BLE_SM_KEY_SIZE_MAX];    /*!< LTK */
+    uint16_t ediv;                          /*!< EDIV (仅传统配对，安全连接为 0) */
+    uint8_t rand[8];                        /*!< Rand (仅传统配对，安全连接为 0) */
+    xf_ble_sm_irk_t irk;                    /*!< 对端 IRK ，见 @ref xf_ble_sm_irk_t */
+    xf_ble_sm_csrk_t csrk;                  /*!< 对端 CSRK ，见 @ref xf_ble_sm_csrk_t */
+    uint8_t cccd_num;                       /*!< CCCD 数量 */
+    xf_ble_bond_cccd_t cccd_set[XF_BLE_BOND_STORE_CCCD_NUM];
+                                            /*!< CCCD 状态，见 @ref xf_ble_bond_cccd_t */
+} xf_ble_bond_t;
+
+/**
+ * @brief BLE 绑定信息存储的后端 (存储介质)
+ *
+ * @note 介质分为大小均为 bank_size 的两个区: [0, bank_size) 与 [bank_size, 2 * bank_size)；
+ *  bank_size 应为 flash 擦除单位的整数倍
+ */
+typedef struct {
+    /**
+     * @brief 读取
+     *
+     * @param addr 偏移
+     * @param[out] buf 缓冲区
+     * @param len 长度
+     * @param user_data 用户数据
+     * @return xf_err_t XF_OK 表示成功
+     */
+    xf_err_t (*read)(uint32_t addr, void *buf, uint32_t len, void *user_data);
+    /**
+     * @brief 写入 (仅写入已擦除的区域，每次写入的起始地址及长度按 XF_BLE_BOND_STORE_WRITE_ALIGN 对齐)
+     *
+     * @param addr 偏移
+     * @param buf 数据
+     * @param len 长度
+     * @param user_data 用户数据
+     * @return xf_err_t XF_OK 表示成功
+     */
+    xf_err_t (*write)(uint32_t addr, const void *buf, uint32_t len, void *user_data);
+    /**
+     * @brief 擦除 (擦除后内容为 0xFF)
+     *
+     * @param addr 偏移 (区的起始地址)
+     * @param len 长度 (bank_size)
+     * @param user_data 用户数据
+     * @return xf_err_t XF_OK 表示成功
+     */
+    xf_err_t (*erase)(uint32_t addr, uint32_t len, void *user_data);
+    uint32_t bank_size;                     /*!< 每个区的大小 (字节) */
+    void *user_data;                        /*!< 用户数据 */
+} xf_ble_bond_store_backend_t;
+
+/**
+ * @brief BLE 绑定信息存储的统计
+ */
+typedef struct {
+    uint16_t bond_num;                      /*!< 绑定数量 */
+    uint8_t bank;                           /*!< 当前使用的区 (0 或 1) */
+    uint32_t used_size;                     /*!< 当前区已使用的大小 (含已失效记录) */
+    uint32_t live_size;                     /*!< 有效记录的大小 */
+    uint32_t compact_cnt;                   /*!< 整理 (擦除) 次数 */
+} xf_ble_bond_store_stats_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE 绑定信息存储: 初始化 (挂载)，从后端回放日志重建索引；介质为空时格式化
+ *
+ * @param backend 后端，见 @ref xf_ble_bond_store_backend_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - (OTHER)               后端读写失败
+ *
+ * @note 本模块的接口涉及后端读写，均需在同一任务中调用
+ */
+xf_err_t xf_ble_bond_store_init(const xf_ble_bond_store_backend_t *backend);
+
+/**
+ * @brief BLE 绑定信息存储: 保存 (新增或覆盖) 绑定信息
+ *
+ * @param bond 绑定信息，见 @ref xf_ble_bond_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_INVALID_STATE  未初始化
+ *      - XF_ERR_NO_MEM         绑定数量已达 XF_BLE_BOND_STORE_BOND_NUM 或介质空间不足
+ *      - (OTHER)               后端读写失败
+ */
+xf_err_t xf_ble_bond_store_put(const xf_ble_bond_t *bond);
+
+/**
+ * @brief BLE 绑定信息存储: 按身份地址读取绑定信息 (哈希索引定位，读取一次后端)
+ *
+ * @param id_addr 对端身份地址
+ * @param[out] bond 绑定信息，见 @ref xf_ble_bond_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      不存在
+ *      - (OTHER)               后端读取失败或记录损坏
+ */
+xf_err_t xf_ble_bond_store_get(const xf_ble_addr_t *id_addr, xf_ble_bond_t *bond);
+
+/**
+ * @brief BLE 绑定信息存储: 是否存在指定身份地址的绑定信息 (仅查索引，不读后端)
+ *
+ * @param id_addr 对端身份地址
+ * @return bool 是否存在
+ */
+bool xf_ble_bond_store_is_exist(const xf_ble_addr_t *id_addr);
+
+/**
+ * @brief BLE 绑定信息存储: 删除绑定信息
+ *
+ * @param id_addr 对端身份地址
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      不存在
+ *      - (OTHER)               后端读写失败
+ */
+xf_err_t xf_ble_bond_store_del(const xf_ble_addr_t *id_addr);
+
+/**
+ * @brief BLE 绑定信息存储: 删除所有绑定信息 (擦除两个区并重新格式化)
+ *
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_STATE  未初始化
+ *      - (OTHER)               后端读写失败
+ */
+xf_err_t xf_ble_bond_store_clear(void);
+
+/**
+ * @brief BLE 绑定信息存储: 更新 (不存在时添加) 一个 CCCD 的状态
+ *
+ * @param id_addr 对端身份地址
+ * @param handle CCCD 句柄
+ * @param value CCCD 值， 0 表示删除该 CCCD
+ * @return xf_err_t
+ *      - XF_OK                 成功 (值未变化时不写入)
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      绑定信息不存在
+ *      - XF_ERR_NO_MEM         CCCD 数量已达 XF_BLE_BOND_STORE_CCCD_NUM
+ *      - (OTHER)               后端读写失败
+ */
+xf_err_t xf_ble_bond_store_set_cccd(const xf_ble_addr_t *id_addr, uint16_t handle, uint16_t value);
+
+/**
+ * @brief BLE 绑定信息存储: 获取已绑定设备的身份地址列表
+ *
+ * @param[in,out] max_num 输入为列表容量，输出为实际数量
+ * @param[out] dev_list 身份地址列表，见 @ref xf_ble_addr_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_INVALID_STATE  未初始化 (数量为 0)
+ */
+xf_err_t xf_ble_bond_store_get_list(uint16_t *max_num, xf_ble_addr_t *dev_list);
+
+/**
+ * @brief BLE 绑定信息存储: 立即整理 (将有效记录复制到另一区并擦除当前区)
+ *
+ * @note 通常无需调用，区满时自动整理
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_STATE  未初始化
+ *      - (OTHER)               后端读写失败
+ */
+xf_err_t xf_ble_bond_store_compact(void);
+
+/**
+ * @brief BLE 绑定信息存储: 获取统计
+ *
+ * @param[out] stats 统计，见 @ref xf_ble_bond_store_stats_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_INVALID_STATE  未初始化 (统计清零)
+ */
+xf_err_t xf_ble_bond_store_get_stats(xf_ble_bond_store_stats_t *stats);
+
+/**
+ * @brief BLE 绑定信息存储的 GAP 事件处理 (配对结束)
+ *
+ * @note 配对成功且平台侧上报 LTK 时，以对端地址保存 (或更新) LTK 及安全等级 (取自连接状态表)，
+ *  此时会写入后端；需在 GAP 事件回调中调用 (应在 xf_ble_conn_table_gap_event_handler() 之后)；
+ *  仅观察事件，固定返回 XF_BLE_EVT_RES_NOT_HANDLED
+ * @note 对端地址为 RPA (见 xf_ble_addr_is_rpa()) 时不会自动保存：事件中的地址并非身份地址。
+ *  此时应用需在收到对端的身份地址及 IRK 后，以身份地址为 id_addr 、置位 XF_BLE_BOND_KEY_IRK
+ *  调用 xf_ble_bond_store_put() 保存
+ */
+xf_ble_evt_res_t xf_ble_bond_store_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_BOND_STORE_H__ */
@@ -0,0 +1,413 @@
+/**
+ * @file xf_ble_conn_mgr.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 主机 (中心设备) 连接管理。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_sys.h"
+#include "xf_ble_gap.h"
+#include "xf_ble_trace.h"
+#include "xf_ble_conn_table.h"
+#include "xf_ble_utils.h"
+#include "xf_ble_conn_mgr.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_conn_mgr"
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct {
+    bool is_used;
+    bool is_in_attempt;                     /*!< 属于当前的连接尝试 */
+    uint64_t wait_start_us;                 /*!< 开始等待连接的时间，用于统计连接耗时 */
+    uint64_t next_try_us;                   /*!< 退避结束时间 */
+    uint64_t connected_us;                  /*!< 连接建立时间 */
+    xf_ble_conn_mgr_peer_info_t info;
+} conn_mgr_peer_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static conn_mgr_peer_t *conn_mgr_peer_find(const xf_ble_addr_t *addr);
+static void conn_mgr_attempt_end(uint64_t now_us, bool is_failed);
+static void conn_mgr_backoff(conn_mgr_peer_t *peer, uint64_t now_us);
+static uint32_t conn_mgr_rand(void);
+
+/* ==================== [Static Variables] ================================== */
+
+static conn_mgr_peer_t s_peer_set[XF_BLE_CONN_MGR_PEER_NUM] = {0};
+
+static bool s_is_attempting = false;
+static uint64_t s_attempt_deadline_us = 0;
+
+static bool s_has_fal_ops = false;
+static xf_ble_conn_mgr_fal_ops_t s_fal_ops = {0};
+
+static xf_ble_conn_mgr_evt_cb_t s_evt_cb = NULL;
+static void *s_evt_cb_user_data = NULL;
+
+static uint32_t s_rand_state = 0;
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_ble_conn_mgr_add(const xf_ble_addr_t *addr, uint8_t priority)
+{
+    XF_CHECK(addr == NULL, XF_ERR_INVALID_ARG, TAG, "addr == NULL");
+
+    /* 对端可能已由其他途径连接 (如作为从机被连接) */
+    xf_ble_conn_id_t conn_id = 0;
+    bool is_connected = (xf_ble_conn_table_find_by_addr(addr, &conn_id) == XF_OK);
+
+    xf_err_t ret = XF_OK;
+    XF_BLE_ENTER_CRITICAL();
+    conn_mgr_peer_t *peer = conn_mgr_peer_find(addr);
+    if (peer != NULL) {
+        peer->info.priority = priority;
+    } else {
+        for (uint8_t i = 0; i < XF_BLE_CONN_MGR_PEER_NUM; i++) {
+            if (!s_peer_set[i].is_used) {
+                peer = &s_peer_set[i];
+                break;
+            }
+        }
+        if (peer == NULL) {
+            ret = XF_ERR_NO_MEM;
+        } else {
+            uint64_t now_us = xf_sys_time_get_us();
+            xf_memset(peer, 0, sizeof(conn_mgr_peer_t));
+            peer->is_used = true;
+            peer->wait_start_us = now_us;
+            peer->next_try_us = now_us;
+            peer->info.addr = *addr;
+            peer->info.priority = priority;
+            peer->info.state = XF_BLE_CONN_MGR_STATE_WAITING;
+            if (is_connected) {
+                peer->connected_us = now_us;
+                peer->info.state = XF_BLE_CONN_MGR_STATE_CONNECTED;
+                peer->info.conn_id = conn_id;
+            }
+        }
+    }
+    XF_BLE_EXIT_CRITICAL();
+    XF_CHECK(ret != XF_OK, ret, TAG, "peer set is full: %d", XF_BLE_CONN_MGR_PEER_NUM);
+    return XF_OK;
+}
+
+xf_err_t xf_ble_conn_mgr_remove(const xf_ble_addr_t *addr)
+{
+    XF_CHECK(addr == NULL, XF_ERR_INVALID_ARG, TAG, "addr == NULL");
+
+    XF_BLE_ENTER_CRITICAL();
+    conn_mgr_peer_t *peer = conn_mgr_peer_find(addr);
+    if (peer != NULL) {
+        peer->is_used = false;
+        peer->is_in_attempt = false;
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return (peer != NULL) ? XF_OK : XF_ERR_NOT_FOUND;
+}
+
+void xf_ble_conn_mgr_set_cb(xf_ble_conn_mgr_evt_cb_t cb, void *user_data)
+{
+    XF_BLE_ENTER_CRITICAL();
+    s_evt_cb = cb;
+    s_evt_cb_user_data = user_data;
+    XF_BLE_EXIT_CRITICAL();
+}
+
+xf_err_t xf_ble_conn_mgr_set_fal_ops(const xf_ble_conn_mgr_fal_ops_t *ops)
+{
+    XF_CHECK((ops != NULL)
+             && ((ops->update == NULL) || (ops->connect == NULL) || (ops->capacity == 0)),
+             XF_ERR_INVALID_ARG, TAG, "invalid fal ops");
+
+    bool is_busy = false;
+    XF_BLE_ENTER_CRITICAL();
+    is_busy = s_is_attempting;
+    if (!is_busy) {
+        s_has_fal_ops = (ops != NULL);
+        if (ops != NULL) {
+            s_fal_ops = *ops;
+        }
+    }
+    XF_BLE_EXIT_CRITICAL();
+    XF_CHECK(is_busy, XF_ERR_BUSY, TAG, "connecting");
+    return XF_OK;
+}
+
+xf_err_t xf_ble_conn_mgr_get_peer_info(const xf_ble_addr_t *addr,
+                                       xf_ble_conn_mgr_peer_info_t *info)
+{
+    XF_CHECK((addr == NULL) || (info == NULL), XF_ERR_INVALID_ARG, TAG, "addr or info == NULL");
+
+    XF_BLE_ENTER_CRITICAL();
+    conn_mgr_peer_t *peer = conn_mgr_peer_find(addr);
+    if (peer != NULL) {
+        *info = peer->info;
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return (peer != NULL) ? XF_OK : XF_ERR_NOT_FOUND;
+}
+
+void xf_ble_conn_mgr_process(void)
+{
+    uint64_t now_us = xf_sys_time_get_us();
+    bool need_cancel = false;
+    bool is_fal = false;
+    xf_ble_conn_mgr_fal_ops_t fal_ops;
+    xf_ble_addr_t addr_set[XF_BLE_CONN_MGR_PEER_NUM];
+    uint8_t num = 0;
+
+    XF_BLE_ENTER_CRITICAL();
+    if (s_is_attempting) {
+        bool has_peer = false;
+        for (uint8_t i = 0; i < XF_BLE_CONN_MGR_PEER_NUM; i++) {
+            has_peer = has_peer || s_peer_set[i].is_in_attempt;
+        }
+        if (!has_peer || (now_us >= s_attempt_deadline_us)) {
+            conn_mgr_attempt_end(now_us, true);
+            need_cancel = true;
+            is_fal = s_has_fal_ops;
+            fal_ops = s_fal_ops;
+        }
+    } else {
+        /* 选出退避已结束的等待对端，按 (优先级, 退避结束时间) 升序，同优先级者轮流尝试 */
+        uint8_t idx_set[XF_BLE_CONN_MGR_PEER_NUM];
+        for (uint8_t i = 0; i < XF_BLE_CONN_MGR_PEER_NUM; i++) {
+            const conn_mgr_peer_t *peer = &s_peer_set[i];
+            if (!peer->is_used || (peer->info.state != XF_BLE_CONN_MGR_STATE_WAITING)
+                    || (now_us < peer->next_try_us)) {
+                continue;
+            }
+            uint8_t pos = num++;
+            while ((pos > 0)
+                    && ((s_peer_set[idx_set[pos - 1]].info.priority > peer->info.priority)
+                        || ((s_peer_set[idx_set[pos - 1]].info.priority == peer->info.priority)
+                            && (s_peer_set[idx_set[pos - 1]].next_try_us > peer->next_try_us)))) {
+                idx_set[pos] = idx_set[pos - 1];
+                pos--;
+            }
+            idx_set[pos] = i;
+        }
+        is_fal = s_has_fal_ops;
+        fal_ops = s_fal_ops;
+        if (num > (is_fal ? fal_ops.capacity : 1)) {
+            num = is_fal ? fal_ops.capacity : 1;
+        }
+        for (uint8_t i = 0; i < num; i++) {
+            conn_mgr_peer_t *peer = &s_peer_set[idx_set[i]];
+            peer->is_in_attempt = true;
+            peer->info.state = XF_BLE_CONN_MGR_STATE_CONNECTING;
+            peer->info.attempt_cnt++;
+            addr_set[i] = peer->info.addr;
+        }
+        if (num > 0) {
+            /* 先登记，部分平台会在连接接口内同步上报连接事件 */
+            s_is_attempting = true;
+            s_attempt_deadline_us = now_us + (uint64_t)XF_BLE_CONN_MGR_CONNECT_TIMEOUT_MS * 1000;
+        }
+    }
+    XF_BLE_EXIT_CRITICAL();
+
+    if (need_cancel) {
+        XF_LOGD(TAG, "attempt timeout or no peer left, cancel");
+        xf_err_t ret = XF_OK;
+        if (is_fal && (fal_ops.cancel != NULL)) {
+            ret = fal_ops.cancel(fal_ops.user_data);
+        } else {
+            XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_CANCEL_CONNECT, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                                  xf_ble_gap_cancel_connect());
+        }
+        if (ret != XF_OK) {
+            XF_LOGW(TAG, "cancel connect failed: %d", ret);
+        }
+        return;
+    }
+    if (num == 0) {
+        return;
+    }
+
+    xf_err_t ret = XF_OK;
+    if (is_fal) {
+        ret = fal_ops.update(addr_set, num, fal_ops.user_data);
+        if (ret == XF_OK) {
+            ret = fal_ops.connect(fal_ops.user_data);
+        }
+    } else {
+        XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_CONNECT, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                              xf_ble_gap_connect(&addr_set[0]));
+    }
+    if (ret != XF_OK) {
+        XF_LOGW(TAG, "start connect(%d peer) failed: %d", num, ret);
+        XF_BLE_ENTER_CRITICAL();
+        if (s_is_attempting) {
+            conn_mgr_attempt_end(xf_sys_time_get_us(), true);
+        }
+        XF_BLE_EXIT_CRITICAL();
+    }
+}
+
+xf_ble_evt_res_t xf_ble_conn_mgr_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param)
+{
+    if (param == NULL) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+
+    xf_ble_conn_mgr_evt_t cb_event;
+    xf_ble_conn_mgr_peer_info_t info;
+    xf_ble_conn_mgr_evt_cb_t cb = NULL;
+    void *cb_user_data = NULL;
+    uint64_t now_us = xf_sys_time_get_us();
+
+    switch (event) {
+    case XF_BLE_GAP_EVT_CONNECT: {
+        if (param->connect.addr == NULL) {
+            break;
+        }
+        XF_BLE_ENTER_CRITICAL();
+        conn_mgr_peer_t *peer = conn_mgr_peer_find(param->connect.addr);
+        if ((peer != NULL) && (peer->info.state != XF_BLE_CONN_MGR_STATE_CONNECTED)) {
+            uint32_t ttc_ms = (uint32_t)((now_us - peer->wait_start_us) / 1000);
+            /* 控制器建立连接后即停止发起，本次尝试结束，其余对端无需退避 */
+            if (peer->is_in_attempt) {
+                conn_mgr_attempt_end(now_us, false);
+            }
+            peer->connected_us = now_us;
+            peer->info.state = XF_BLE_CONN_MGR_STATE_CONNECTED;
+            peer->info.conn_id = param->connect.conn_id;
+            peer->info.connect_cnt++;
+            peer->info.last_ttc_ms = ttc_ms;
+            if ((peer->info.min_ttc_ms == 0) || (ttc_ms < peer->info.min_ttc_ms)) {
+                peer->info.min_ttc_ms = (ttc_ms != 0) ? ttc_ms : 1;
+            }
+            if (ttc_ms > peer->info.max_ttc_ms) {
+                peer->info.max_ttc_ms = ttc_ms;
+            }
+            cb_event = XF_BLE_CONN_MGR_EVT_CONNECTED;
+            info = peer->info;
+            cb = s_evt_cb;
+            cb_user_data = s_evt_cb_user_data;
+        }
+        XF_BLE_EXIT_CRITICAL();
+    } break;
+    case XF_BLE_GAP_EVT_DISCONNECT: {
+        XF_BLE_ENTER_CRITICAL();
+        for (uint8_t i = 0; i < XF_BLE_CONN_MGR_PEER_NUM; i++) {
+            conn_mgr_peer_t *peer = &s_peer_set[i];
+            if (!peer->is_used || (peer->info.state != XF_BLE_CONN_MGR_STATE_CONNECTED)
+                    || (peer->info.conn_id != param->disconnect.conn_id)) {
+                continue;
+            }
+            /* 连接维持足够久时视为正常断连，退避从最小值重新开始 */
+            if ((now_us - peer->connected_us) >= (uint64_t)XF_BLE_CONN_MGR_BACKOFF_MAX_MS * 1000) {
+                peer->info.backoff_cnt = 0;
+            }
+            peer->wait_start_us = now_us;
+            peer->info.state = XF_BLE_CONN_MGR_STATE_WAITING;
+            conn_mgr_backoff(peer, now_us);
+            cb_event = XF_BLE_CONN_MGR_EVT_DISCONNECTED;
+            info = peer->info;
+            cb = s_evt_cb;
+            cb_user_data = s_evt_cb_user_data;
+            break;
+        }
+        XF_BLE_EXIT_CRITICAL();
+    } break;
+    default:
+        break;
+    }
+
+    if (cb != NULL) {
+        cb(cb_event, &info, cb_user_data);
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 按地址查找对端 (需在临界区内调用)
+ */
+static conn_mgr_peer_t *conn_mgr_peer_find(const xf_ble_addr_t *addr)
+{
+    for (uint8_t i = 0; i < XF_BLE_CONN_MGR_PEER_NUM; i++) {
+        if (s_peer_set[i].is_used && xf_ble_addr_is_equal(&s_peer_set[i].info.addr, addr)) {
+            return &s_peer_set[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 结束当前的连接尝试 (需在临界区内调用)，仍在连接中的对端回到等待状态
+ *
+ * @param is_failed 是否失败 (超时或发起失败)，失败时这些对端进入退避
+ */
+static void conn_mgr_attempt_end(uint64_t now_us, bool is_failed)
+{
+    for (uint8_t i = 0; i < XF_BLE_CONN_MGR_PEER_NUM; i++) {
+        conn_mgr_peer_t *peer = &s_peer_set[i];
+        if (!peer->is_in_attempt) {
+            continue;
+        }
+        peer->is_in_attempt = false;
+        if (peer->info.state == XF_BLE_CONN_MGR_STATE_CONNECTING) {
+            peer->info.state = XF_BLE_CONN_MGR_STATE_WAITING;
+            if (is_failed) {
+                conn_mgr_backoff(peer, now_us);
+            }
+        }
+    }
+    s_is_attempting = false;
+}
+
+/**
+ * @brief 连续失败次数加一并安排下次尝试时间: MIN * 2^(n-1) (不超过 MAX) ，另加 [0, 1/2] 的随机抖动，
+ *  避免多个对端 (或多台主机) 同步重试
+ */
+static void conn_mgr_backoff(conn_mgr_peer_t *peer, uint64_t now_us)
+{
+    if (peer->info.backoff_cnt < UINT8_MAX) {
+        peer->info.backoff_cnt++;
+    }
+    uint32_t delay_ms = XF_BLE_CONN_MGR_BACKOFF_MIN_MS;
+    for (uint8_t i = 1; (i < peer->info.backoff_cnt) && (delay_ms < XF_BLE_CONN_MGR_BACKOFF_MAX_MS); i++) {
+        delay_ms <<= 1;
+    }
+    if (delay_ms > XF_BLE_CONN_MGR_BACKOFF_MAX_MS) {
+        delay_ms = XF_BLE_CONN_MGR_BACKOFF_MAX_MS;
+    }
+    delay_ms += conn_mgr_rand() % (delay_ms / 2 + 1);
+    peer->next_try_us = now_us + (uint64_t)delay_ms * 1000;
+}
+
+/**
+ * @brief 抖动用伪随机数 (xorshift32)，首次使用时以当前时间为种子
+ */
+static uint32_t conn_mgr_rand(void)
+{
+    uint32_t x = s_rand_state;
+    if (x == 0) {
+        uint64_t seed = xf_sys_time_get_us();
+        x = (uint32_t)(seed ^ (seed >> 32)) | 1;
+    }
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    s_rand_state = x;
+    return x;
+}
+
+#endif /* XF_BLE_IS_ENABLE */
@@ -0,0 +1,209 @@
+/**
+ * @file xf_ble_conn_mgr.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 主机 (中心设备) 连接管理。
+ *  维护一组带优先级的目标对端，串行发起连接 (同一时刻至多一次) 并在超时后取消，
+ *  断连或连接失败的对端以指数退避 (附随机抖动) 重新排队；
+ *  提供过滤接受列表 (Filter Accept List) 操作时，一次连接尝试覆盖所有待连接对端。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_CONN_MGR_H__
+#define __XF_BLE_CONN_MGR_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gap_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE 连接管理中对端的状态
+ */
+typedef uint8_t xf_ble_conn_mgr_state_t;
+enum _xf_ble_conn_mgr_state_t {
+    XF_BLE_CONN_MGR_STATE_WAITING = 0,      /*!< 等待连接 (含退避中) */
+    XF_BLE_CONN_MGR_STATE_CONNECTING,       /*!< 正在连接 */
+    XF_BLE_CONN_MGR_STATE_CONNECTED,        /*!< 已连接 */
+};
+
+/**
+ * @brief BLE 连接管理中对端的信息及统计
+ */
+typedef struct {
+    xf_ble_addr_t addr;                     /*!< 对端地址，见 @ref xf_ble_addr_t */
+    uint8_t priority;                       /*!< 优先级，值越小越优先 */
+    xf_ble_conn_mgr_state_t state;          /*!< 状态，见 @ref xf_ble_conn_mgr_state_t */
+    xf_ble_conn_id_t conn_id;               /*!< 连接 ID (仅已连接时有效) */
+    uint8_t backoff_cnt;                    /*!< 连续失败 (超时或短时断连) 次数 */
+    uint32_t attempt_cnt;                   /*!< 累计连接尝试次数 */
+    uint32_t connect_cnt;                   /*!< 累计连接成功次数 */
+    uint32_t last_ttc_ms;                   /*!< 最近一次连接耗时 (ms)，自开始等待起至连接建立 (含退避) */
+    uint32_t min_ttc_ms;                    /*!< 最短连接耗时 (ms)， 0 表示尚未连接过 */
+    uint32_t max_ttc_ms;                    /*!< 最长连接耗时 (ms) */
+} xf_ble_conn_mgr_peer_info_t;
+
+/**
+ * @brief BLE 连接管理的事件
+ */
+typedef uint8_t xf_ble_conn_mgr_evt_t;
+enum _xf_ble_conn_mgr_evt_t {
+    XF_BLE_CONN_MGR_EVT_CONNECTED = 0,      /*!< 对端已连接， info->last_ttc_ms 为本次连接耗时 */
+    XF_BLE_CONN_MGR_EVT_DISCONNECTED,       /*!< 对端已断连，已重新排队 */
+};
+
+/**
+ * @brief BLE 连接管理的事件回调
+ *
+ * @param event 事件，见 @ref xf_ble_conn_mgr_evt_t
+ * @param info 对端的信息及统计 (副本)，见 @ref xf_ble_conn_mgr_peer_info_t
+ * @param user_data 用户数据
+ */
+typedef void (*xf_ble_conn_mgr_evt_cb_t)(
+    xf_ble_conn_mgr_evt_t event, const xf_ble_conn_mgr_peer_info_t *info, void *user_data);
+
+/**
+ * @brief BLE 连接管理使用的过滤接受列表操作
+ *
+ * @note 由平台侧或过滤接受列表模块提供；未设置时逐个对端直接连接
+ */
+typedef struct {
+    /**
+     * @brief 将过滤接受列表设为指定地址集合
+     *
+     * @param addr_set 地址集合
+     * @param num 地址数量 (不超过 capacity)
+     * @param user_data 用户数据
+     * @return xf_err_t XF_OK 表示成功
+     */
+    xf_err_t (*update)(const xf_ble_addr_t *addr_set, uint8_t num, void *user_data);
+    /**
+     * @brief 以过滤接受列表发起连接 (发起者过滤策略: 使用过滤接受列表)
+     *
+     * @param user_data 用户数据
+     * @return xf_err_t XF_OK 表示成功
+     */
+    xf_err_t (*connect)(void *user_data);
+    /**
+     * @brief 取消以过滤接受列表发起的连接，可为 NULL (使用 xf_ble_gap_cancel_connect())
+     *
+     * @param user_data 用户数据
+     * @return xf_err_t XF_OK 表示成功
+     */
+    xf_err_t (*cancel)(void *user_data);
+    uint8_t capacity;                       /*!< 过滤接受列表容量 */
+    void *user_data;                        /*!< 用户数据 */
+} xf_ble_conn_mgr_fal_ops_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE 连接管理: 添加目标对端 (已存在时仅更新优先级)
+ *
+ * @param addr 对端地址
+ * @param priority 优先级，值越小越优先
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NO_MEM         对端数量已达 XF_BLE_CONN_MGR_PEER_NUM
+ */
+xf_err_t xf_ble_conn_mgr_add(const xf_ble_addr_t *addr, uint8_t priority);
+
+/**
+ * @brief BLE 连接管理: 移除目标对端
+ *
+ * @note 仅停止管理，不会断开已有连接；本次尝试的对端全部被移除时，
+ *  下次 xf_ble_conn_mgr_process() 取消连接
+ * @param addr 对端地址
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      对端不存在
+ */
+xf_err_t xf_ble_conn_mgr_remove(const xf_ble_addr_t *addr);
+
+/**
+ * @brief BLE 连接管理: 设置事件回调
+ *
+ * @param cb 事件回调，见 @ref xf_ble_conn_mgr_evt_cb_t ， NULL 表示取消
+ * @param user_data 用户数据
+ */
+void xf_ble_conn_mgr_set_cb(xf_ble_conn_mgr_evt_cb_t cb, void *user_data);
+
+/**
+ * @brief BLE 连接管理: 设置过滤接受列表操作
+ *
+ * @param ops 过滤接受列表操作，见 @ref xf_ble_conn_mgr_fal_ops_t ，
+ *  NULL 表示不使用过滤接受列表 (逐个对端直接连接)
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_BUSY           正在连接，需稍后设置
+ */
+xf_err_t xf_ble_conn_mgr_set_fal_ops(const xf_ble_conn_mgr_fal_ops_t *ops);
+
+/**
+ * @brief BLE 连接管理: 获取对端的信息及统计
+ *
+ * @param addr 对端地址
+ * @param[out] info 信息及统计，见 @ref xf_ble_conn_mgr_peer_info_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      对端不存在
+ */
+xf_err_t xf_ble_conn_mgr_get_peer_info(const xf_ble_addr_t *addr,
+                                       xf_ble_conn_mgr_peer_info_t *info);
+
+/**
+ * @brief BLE 连接管理: 周期处理
+ *
+ * @note 需周期性调用 (建议不大于 100ms)；处理连接超时，
+ *  并在空闲时向退避已结束的最高优先级对端发起下一次连接
+ */
+void xf_ble_conn_mgr_process(void);
+
+/**
+ * @brief BLE 连接管理的 GAP 事件处理 (连接、断连)
+ *
+ * @note 需在 GAP 事件回调中调用 (应在 xf_ble_conn_table_gap_event_handler() 之后)；
+ *  仅观察事件，固定返回 XF_BLE_EVT_RES_NOT_HANDLED
+ */
+xf_ble_evt_res_t xf_ble_conn_mgr_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_CONN_MGR_H__ */
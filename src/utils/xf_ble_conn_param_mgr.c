@@ -0,0 +1,380 @@
+/**
+ * @file xf_ble_conn_param_mgr.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 自适应连接参数管理。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_sys.h"
+#include "xf_ble_gap.h"
+#include "xf_ble_conn_param_mgr.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_cpm"
+
+#define CPM_BACKOFF_SHIFT_MAX   (5)     /*!< 退避时间最多翻倍 2^5 = 32 倍 */
+#define CPM_MODE_NUM            (3)
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct {
+    bool is_used;
+    bool is_enable;
+    xf_ble_conn_param_mode_t mode;
+    xf_ble_conn_param_mode_t pending_mode;
+    uint16_t interval;
+    uint8_t tx_depth;
+    uint8_t rx_depth;
+    uint8_t reject_cnt;
+    uint32_t win_bytes;                     /*!< 当前统计窗口内的收发字节数 */
+    uint32_t rate_bps;
+    uint64_t win_start_us;
+    uint64_t last_busy_us;                  /*!< 最近一次不满足空闲条件的时间 */
+    uint64_t hold_until_us;
+    uint64_t pending_deadline_us;
+    uint64_t backoff_until_us[CPM_MODE_NUM];
+    xf_ble_gap_conn_param_update_t pending_param;
+} cpm_conn_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static cpm_conn_t *cpm_conn_get(xf_ble_conn_id_t conn_id);
+static xf_ble_conn_param_mode_t cpm_decide(cpm_conn_t *c, uint64_t now_us);
+static void cpm_reject(cpm_conn_t *c, uint64_t now_us);
+static void cpm_request(xf_ble_conn_id_t conn_id, xf_ble_conn_param_mode_t mode, uint64_t now_us);
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_ble_conn_param_mgr_policy_t s_cpm_policy_default = {
+    /* 7.5 ~ 15 ms ，无从机延迟，超时 4 s */
+    .bulk_param = {.min_interval = 6, .max_interval = 12, .latency = 0, .timeout = 400},
+    /* 100 ~ 200 ms ，从机延迟 4 ，超时 6 s */
+    .idle_param = {.min_interval = 80, .max_interval = 160, .latency = 4, .timeout = 600},
+    .bulk_enter_bps = 2048,
+    .idle_below_bps = 256,
+    .bulk_enter_depth = 2,
+    .idle_timeout_ms = 3000,
+    .hold_ms = 1000,
+    .reject_backoff_ms = 5000,
+};
+
+static xf_ble_conn_param_mgr_policy_t s_cpm_policy = s_cpm_policy_default;
+static xf_ble_conn_param_mgr_hook_t s_cpm_hook = NULL;
+static void *s_cpm_hook_user_data = NULL;
+static cpm_conn_t s_cpm_conn_set[XF_BLE_CONN_PARAM_MGR_CONN_NUM] = {0};
+
+/* ==================== [Macros] ============================================ */
+
+#define CPM_MS_TO_US(ms)    ((uint64_t)(ms) * 1000)
+
+/* ==================== [Global Functions] ================================== */
+
+void xf_ble_conn_param_mgr_set_policy(const xf_ble_conn_param_mgr_policy_t *policy)
+{
+    XF_BLE_ENTER_CRITICAL();
+    s_cpm_policy = (policy != NULL) ? *policy : s_cpm_policy_default;
+    XF_BLE_EXIT_CRITICAL();
+}
+
+void xf_ble_conn_param_mgr_set_hook(xf_ble_conn_param_mgr_hook_t hook, void *user_data)
+{
+    XF_BLE_ENTER_CRITICAL();
+    s_cpm_hook = hook;
+    s_cpm_hook_user_data = user_data;
+    XF_BLE_EXIT_CRITICAL();
+}
+
+xf_err_t xf_ble_conn_param_mgr_set_enable(xf_ble_conn_id_t conn_id, bool enable)
+{
+    cpm_conn_t *c = cpm_conn_get(conn_id);
+    XF_CHECK(c == NULL, XF_ERR_NOT_FOUND, TAG, "conn(%d) not found", conn_id);
+    c->is_enable = enable;
+    return XF_OK;
+}
+
+void xf_ble_conn_param_mgr_report(xf_ble_conn_id_t conn_id, uint32_t tx_bytes, uint32_t rx_bytes)
+{
+    cpm_conn_t *c = cpm_conn_get(conn_id);
+    if (c == NULL) {
+        return;
+    }
+    XF_BLE_ENTER_CRITICAL();
+    uint64_t sum = (uint64_t)c->win_bytes + tx_bytes + rx_bytes;
+    c->win_bytes = (sum > UINT32_MAX) ? UINT32_MAX : (uint32_t)sum;
+    XF_BLE_EXIT_CRITICAL();
+}
+
+void xf_ble_conn_param_mgr_set_depth(xf_ble_conn_id_t conn_id, uint8_t tx_depth, uint8_t rx_depth)
+{
+    cpm_conn_t *c = cpm_conn_get(conn_id);
+    if (c == NULL) {
+        return;
+    }
+    XF_BLE_ENTER_CRITICAL();
+    c->tx_depth = tx_depth;
+    c->rx_depth = rx_depth;
+    XF_BLE_EXIT_CRITICAL();
+}
+
+xf_err_t xf_ble_conn_param_mgr_get_state(xf_ble_conn_id_t conn_id,
+                                         xf_ble_conn_param_mgr_state_t *state)
+{
+    XF_ASSERT(state != NULL, XF_ERR_INVALID_ARG, TAG, "state == NULL");
+    cpm_conn_t *c = cpm_conn_get(conn_id);
+    if (c == NULL) {
+        return XF_ERR_NOT_FOUND;
+    }
+    XF_BLE_ENTER_CRITICAL();
+    state->mode = c->mode;
+    state->pending_mode = c->pending_mode;
+    state->interval = c->interval;
+    state->rate_bps = c->rate_bps;
+    state->tx_depth = c->tx_depth;
+    state->rx_depth = c->rx_depth;
+    state->reject_cnt = c->reject_cnt;
+    XF_BLE_EXIT_CRITICAL();
+    return XF_OK;
+}
+
+void xf_ble_conn_param_mgr_process(void)
+{
+    uint64_t now_us = xf_sys_time_get_us();
+
+    for (uint8_t i = 0; i < XF_BLE_CONN_PARAM_MGR_CONN_NUM; i++) {
+        cpm_conn_t *c = &s_cpm_conn_set[i];
+        xf_ble_conn_param_mode_t target = XF_BLE_CONN_PARAM_MODE_UNKNOWN;
+
+        XF_BLE_ENTER_CRITICAL();
+        if (!c->is_used) {
+            XF_BLE_EXIT_CRITICAL();
+            continue;
+        }
+        /* 统计窗口结束时更新平滑速率 (EWMA, alpha = 1/2) */
+        uint64_t elapsed_us = now_us - c->win_start_us;
+        if (elapsed_us >= CPM_MS_TO_US(XF_BLE_CONN_PARAM_MGR_WINDOW_MS)) {
+            uint32_t inst_bps = (uint32_t)(((uint64_t)c->win_bytes * 1000000) / elapsed_us);
+            c->rate_bps = (uint32_t)(((uint64_t)c->rate_bps + inst_bps) / 2);
+            c->win_bytes = 0;
+            c->win_start_us = now_us;
+        }
+        if ((c->pending_mode != XF_BLE_CONN_PARAM_MODE_UNKNOWN)
+                && (now_us >= c->pending_deadline_us)) {
+            XF_LOGD(TAG, "conn(%d) mode(%d) no response", i, c->pending_mode);
+            cpm_reject(c, now_us);
+        }
+        xf_ble_conn_param_mode_t mode = cpm_decide(c, now_us);
+        if (c->is_enable
+                && (c->pending_mode == XF_BLE_CONN_PARAM_MODE_UNKNOWN)
+                && (mode != XF_BLE_CONN_PARAM_MODE_UNKNOWN) && (mode != c->mode)
+                && (now_us >= c->hold_until_us)
+                && (now_us >= c->backoff_until_us[mode])) {
+            target = mode;
+        }
+        XF_BLE_EXIT_CRITICAL();
+
+        if (target != XF_BLE_CONN_PARAM_MODE_UNKNOWN) {
+            cpm_request(i, target, now_us);
+        }
+    }
+}
+
+xf_ble_evt_res_t xf_ble_conn_param_mgr_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param)
+{
+    if (param == NULL) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+
+    switch (event) {
+    case XF_BLE_GAP_EVT_CONNECT: {
+        if (param->connect.conn_id >= XF_BLE_CONN_PARAM_MGR_CONN_NUM) {
+            break;
+        }
+        uint64_t now_us = xf_sys_time_get_us();
+        cpm_conn_t *c = &s_cpm_conn_set[param->connect.conn_id];
+        XF_BLE_ENTER_CRITICAL();
+        xf_memset(c, 0, sizeof(cpm_conn_t));
+        c->is_used = true;
+        c->is_enable = true;
+        c->win_start_us = now_us;
+        c->last_busy_us = now_us;
+        XF_BLE_EXIT_CRITICAL();
+    } break;
+    case XF_BLE_GAP_EVT_DISCONNECT: {
+        cpm_conn_t *c = cpm_conn_get(param->disconnect.conn_id);
+        if (c != NULL) {
+            c->is_used = false;
+        }
+    } break;
+    case XF_BLE_GAP_EVT_CONN_PARAM_UPDATE: {
+        cpm_conn_t *c = cpm_conn_get(param->conn_param_upd.conn_id);
+        if (c == NULL) {
+            break;
+        }
+        uint64_t now_us = xf_sys_time_get_us();
+        uint16_t interval = param->conn_param_upd.interval;
+        XF_BLE_ENTER_CRITICAL();
+        c->interval = interval;
+        if (c->pending_mode != XF_BLE_CONN_PARAM_MODE_UNKNOWN) {
+            if ((interval >= c->pending_param.min_interval)
+                    && (interval <= c->pending_param.max_interval)) {
+                c->mode = c->pending_mode;
+                c->pending_mode = XF_BLE_CONN_PARAM_MODE_UNKNOWN;
+                c->reject_cnt = 0;
+            } else {
+                /* 对端给出了其他参数，视为拒绝 */
+                cpm_reject(c, now_us);
+            }
+        } else {
+            /* 对端发起的更新: 按间隔归类，并在 hold_ms 内不再改动 */
+            if (interval <= s_cpm_policy.bulk_param.max_interval) {
+                c->mode = XF_BLE_CONN_PARAM_MODE_BULK;
+            } else if (interval >= s_cpm_policy.idle_param.min_interval) {
+                c->mode = XF_BLE_CONN_PARAM_MODE_IDLE;
+            } else {
+                c->mode = XF_BLE_CONN_PARAM_MODE_UNKNOWN;
+            }
+            c->hold_until_us = now_us + CPM_MS_TO_US(s_cpm_policy.hold_ms);
+        }
+        XF_BLE_EXIT_CRITICAL();
+    } break;
+    default:
+        break;
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+xf_ble_evt_res_t xf_ble_conn_param_mgr_gatts_event_handler(
+    xf_ble_gatts_evt_t event,
+    xf_ble_gatts_evt_cb_param_t *param)
+{
+    if ((event == XF_BLE_GATTS_EVT_WRITE_REQ) && (param != NULL)) {
+        xf_ble_conn_param_mgr_report(param->write_req.conn_id, 0, param->write_req.value_len);
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+xf_ble_evt_res_t xf_ble_conn_param_mgr_gattc_event_handler(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param)
+{
+    if (param == NULL) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+    switch (event) {
+    case XF_BLE_GATTC_EVT_NOTIFICATION:
+    case XF_BLE_GATTC_EVT_INDICATION:
+        xf_ble_conn_param_mgr_report(param->ntf.conn_id, 0, param->ntf.value_len);
+        break;
+    case XF_BLE_GATTC_EVT_READ_CFM:
+        xf_ble_conn_param_mgr_report(param->read_cfm.conn_id, 0, param->read_cfm.value_len);
+        break;
+    default:
+        break;
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static cpm_conn_t *cpm_conn_get(xf_ble_conn_id_t conn_id)
+{
+    if ((conn_id >= XF_BLE_CONN_PARAM_MGR_CONN_NUM) || !s_cpm_conn_set[conn_id].is_used) {
+        return NULL;
+    }
+    return &s_cpm_conn_set[conn_id];
+}
+
+/**
+ * @brief 按速率及队列深度判断期望的模式 (需在临界区内调用)
+ *
+ * @note 进入大量传输与判定空闲使用不同阈值，两者之间保持当前模式
+ */
+static xf_ble_conn_param_mode_t cpm_decide(cpm_conn_t *c, uint64_t now_us)
+{
+    const xf_ble_conn_param_mgr_policy_t *p = &s_cpm_policy;
+    bool is_busy = (c->rate_bps >= p->bulk_enter_bps)
+                   || ((p->bulk_enter_depth != 0)
+                       && ((c->tx_depth >= p->bulk_enter_depth) || (c->rx_depth >= p->bulk_enter_depth)));
+    bool is_quiet = (c->rate_bps < p->idle_below_bps) && (c->tx_depth == 0) && (c->rx_depth == 0);
+
+    if (!is_quiet) {
+        c->last_busy_us = now_us;
+    }
+    if (is_busy) {
+        return XF_BLE_CONN_PARAM_MODE_BULK;
+    }
+    if (is_quiet && (now_us - c->last_busy_us >= CPM_MS_TO_US(p->idle_timeout_ms))) {
+        return XF_BLE_CONN_PARAM_MODE_IDLE;
+    }
+    return c->mode;
+}
+
+/**
+ * @brief 对端拒绝 (或未响应) 等待中的请求，该模式按指数退避 (需在临界区内调用)
+ */
+static void cpm_reject(cpm_conn_t *c, uint64_t now_us)
+{
+    uint8_t shift = (c->reject_cnt < CPM_BACKOFF_SHIFT_MAX) ? c->reject_cnt : CPM_BACKOFF_SHIFT_MAX;
+    c->backoff_until_us[c->pending_mode] = now_us
+                                           + (CPM_MS_TO_US(s_cpm_policy.reject_backoff_ms) << shift);
+    c->pending_mode = XF_BLE_CONN_PARAM_MODE_UNKNOWN;
+    if (c->reject_cnt < UINT8_MAX) {
+        ++c->reject_cnt;
+    }
+}
+
+static void cpm_request(xf_ble_conn_id_t conn_id, xf_ble_conn_param_mode_t mode, uint64_t now_us)
+{
+    cpm_conn_t *c = &s_cpm_conn_set[conn_id];
+    xf_ble_gap_conn_param_update_t param;
+    xf_ble_conn_param_mgr_hook_t hook;
+    void *hook_user_data;
+
+    XF_BLE_ENTER_CRITICAL();
+    param = (mode == XF_BLE_CONN_PARAM_MODE_BULK) ? s_cpm_policy.bulk_param : s_cpm_policy.idle_param;
+    hook = s_cpm_hook;
+    hook_user_data = s_cpm_hook_user_data;
+    XF_BLE_EXIT_CRITICAL();
+
+    bool is_allowed = (hook == NULL) || hook(conn_id, mode, &param, hook_user_data);
+
+    XF_BLE_ENTER_CRITICAL();
+    c->hold_until_us = now_us + CPM_MS_TO_US(s_cpm_policy.hold_ms);
+    /* 钩子执行期间连接可能已断开或已有其他请求 */
+    is_allowed = is_allowed && c->is_used
+                 && (c->pending_mode == XF_BLE_CONN_PARAM_MODE_UNKNOWN);
+    if (is_allowed) {
+        /* 先记录，部分平台会在请求接口内同步上报更新事件 */
+        c->pending_mode = mode;
+        c->pending_param = param;
+        c->pending_deadline_us = now_us + CPM_MS_TO_US(XF_BLE_CONN_PARAM_MGR_RSP_TIMEOUT_MS);
+    }
+    XF_BLE_EXIT_CRITICAL();
+    if (!is_allowed) {
+        return;
+    }
+
+    XF_LOGD(TAG, "conn(%d) -> mode(%d) interval [%d, %d] latency %d", conn_id, mode,
+            param.min_interval, param.max_interval, param.latency);
+    xf_err_t ret = xf_ble_gap_update_conn_param(conn_id, &param);
+    if (ret != XF_OK) {
+        XF_LOGW(TAG, "conn(%d) update conn param failed: %d", conn_id, ret);
+        XF_BLE_ENTER_CRITICAL();
+        if (c->pending_mode == mode) {
+            cpm_reject(c, now_us);
+        }
+        XF_BLE_EXIT_CRITICAL();
+    }
+}
+
+#endif /* XF_BLE_IS_ENABLE */
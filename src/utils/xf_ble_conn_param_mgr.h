@@ -0,0 +1,203 @@
+/**
+ * @file xf_ble_conn_param_mgr.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 自适应连接参数管理。
+ *  按连接统计收发速率及队列深度，检测到大量数据传输时切换为短间隔、零从机延迟的参数，
+ *  空闲超时后切换回长间隔、高从机延迟的参数。
+ *  带迟滞 (进入/退出阈值分离及最短保持时间)，对端拒绝时按指数退避，并支持按链路的策略钩子。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_CONN_PARAM_MGR_H__
+#define __XF_BLE_CONN_PARAM_MGR_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gap_types.h"
+#include "xf_ble_gatt_server_types.h"
+#include "xf_ble_gatt_client_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE 连接参数模式
+ */
+typedef uint8_t xf_ble_conn_param_mode_t;
+enum _xf_ble_conn_param_mode_t {
+    XF_BLE_CONN_PARAM_MODE_UNKNOWN = 0,     /*!< 未知 (连接建立后尚未切换) */
+    XF_BLE_CONN_PARAM_MODE_BULK,            /*!< 大量传输: 短间隔、零从机延迟 */
+    XF_BLE_CONN_PARAM_MODE_IDLE,            /*!< 空闲: 长间隔、高从机延迟 */
+};
+
+/**
+ * @brief BLE 自适应连接参数的策略
+ *
+ * @note 连接参数的单位与 xf_ble_gap_update_conn_param() 相同
+ */
+typedef struct {
+    xf_ble_gap_conn_param_update_t bulk_param;  /*!< 大量传输时的连接参数 */
+    xf_ble_gap_conn_param_update_t idle_param;  /*!< 空闲时的连接参数 */
+    uint32_t bulk_enter_bps;    /*!< 收发速率 (字节/秒) 不低于此值时进入大量传输模式 */
+    uint32_t idle_below_bps;    /*!< 收发速率低于此值 (且队列为空) 视为空闲，应小于 bulk_enter_bps */
+    uint8_t bulk_enter_depth;   /*!< 收或发队列深度不低于此值时进入大量传输模式， 0 表示不使用 */
+    uint32_t idle_timeout_ms;   /*!< 持续空闲超过此时间后进入空闲模式 */
+    uint32_t hold_ms;           /*!< 两次参数更新请求的最短间隔 */
+    uint32_t reject_backoff_ms; /*!< 对端拒绝后重试同一模式的初始退避时间，之后每次翻倍 (最多 32 倍) */
+} xf_ble_conn_param_mgr_policy_t;
+
+/**
+ * @brief BLE 自适应连接参数的策略钩子，在发起参数更新请求前调用
+ *
+ * @param conn_id 连接 ID
+ * @param mode 将要切换到的模式，见 @ref xf_ble_conn_param_mode_t
+ * @param[in,out] param 将要请求的连接参数，可按链路修改
+ * @param user_data 用户数据
+ * @return bool true: 发起请求; false: 本次不切换 (保持 hold_ms 后再评估)
+ */
+typedef bool (*xf_ble_conn_param_mgr_hook_t)(
+    xf_ble_conn_id_t conn_id, xf_ble_conn_param_mode_t mode,
+    xf_ble_gap_conn_param_update_t *param, void *user_data);
+
+/**
+ * @brief BLE 自适应连接参数的链路状态
+ */
+typedef struct {
+    xf_ble_conn_param_mode_t mode;          /*!< 当前模式，见 @ref xf_ble_conn_param_mode_t */
+    xf_ble_conn_param_mode_t pending_mode;  /*!< 等待对端响应的模式， UNKNOWN 表示无 */
+    uint16_t interval;                      /*!< 当前连接间隔 (最近一次连接参数更新事件) */
+    uint32_t rate_bps;                      /*!< 平滑后的收发速率 (字节/秒) */
+    uint8_t tx_depth;                       /*!< 发送队列深度 */
+    uint8_t rx_depth;                       /*!< 接收队列深度 */
+    uint8_t reject_cnt;                     /*!< 连续被拒绝的次数 */
+} xf_ble_conn_param_mgr_state_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE 自适应连接参数: 设置策略 (对所有连接生效)
+ *
+ * @param policy 策略，见 @ref xf_ble_conn_param_mgr_policy_t ， NULL 表示恢复默认策略
+ */
+void xf_ble_conn_param_mgr_set_policy(const xf_ble_conn_param_mgr_policy_t *policy);
+
+/**
+ * @brief BLE 自适应连接参数: 设置策略钩子
+ *
+ * @param hook 策略钩子，见 @ref xf_ble_conn_param_mgr_hook_t ， NULL 表示不使用
+ * @param user_data 用户数据
+ */
+void xf_ble_conn_param_mgr_set_hook(xf_ble_conn_param_mgr_hook_t hook, void *user_data);
+
+/**
+ * @brief BLE 自适应连接参数: 开启或关闭指定链路的自适应 (连接建立时默认开启)
+ *
+ * @param conn_id 连接 ID
+ * @param enable 是否开启
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      连接不存在
+ */
+xf_err_t xf_ble_conn_param_mgr_set_enable(xf_ble_conn_id_t conn_id, bool enable);
+
+/**
+ * @brief BLE 自适应连接参数: 上报收发的数据量
+ *
+ * @note 事件处理函数已统计接收的通知、指示、读响应及写请求，流式发送已统计发送的数据，
+ *  应用自行发送通知等时调用本接口
+ * @param conn_id 连接 ID
+ * @param tx_bytes 发送的字节数
+ * @param rx_bytes 接收的字节数
+ */
+void xf_ble_conn_param_mgr_report(xf_ble_conn_id_t conn_id, uint32_t tx_bytes, uint32_t rx_bytes);
+
+/**
+ * @brief BLE 自适应连接参数: 上报收发队列深度 (在途或待处理的数据包数)
+ *
+ * @param conn_id 连接 ID
+ * @param tx_depth 发送队列深度
+ * @param rx_depth 接收队列深度
+ */
+void xf_ble_conn_param_mgr_set_depth(xf_ble_conn_id_t conn_id, uint8_t tx_depth, uint8_t rx_depth);
+
+/**
+ * @brief BLE 自适应连接参数: 获取链路状态
+ *
+ * @param conn_id 连接 ID
+ * @param[out] state 链路状态，见 @ref xf_ble_conn_param_mgr_state_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      连接不存在
+ */
+xf_err_t xf_ble_conn_param_mgr_get_state(xf_ble_conn_id_t conn_id,
+                                         xf_ble_conn_param_mgr_state_t *state);
+
+/**
+ * @brief BLE 自适应连接参数: 评估并切换
+ *
+ * @note 需周期性调用 (建议不超过 XF_BLE_CONN_PARAM_MGR_WINDOW_MS)，
+ *  在此更新速率、判断模式、检查对端响应超时并发起参数更新请求
+ */
+void xf_ble_conn_param_mgr_process(void);
+
+/**
+ * @brief BLE 自适应连接参数的 GAP 事件处理 (连接、断连、连接参数更新)
+ *
+ * @note 需在 GAP 事件回调中调用；仅观察事件，固定返回 XF_BLE_EVT_RES_NOT_HANDLED
+ */
+xf_ble_evt_res_t xf_ble_conn_param_mgr_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param);
+
+/**
+ * @brief BLE 自适应连接参数的 GATTS 事件处理 (统计写请求)
+ *
+ * @note 同 xf_ble_conn_param_mgr_gap_event_handler()
+ */
+xf_ble_evt_res_t xf_ble_conn_param_mgr_gatts_event_handler(
+    xf_ble_gatts_evt_t event,
+    xf_ble_gatts_evt_cb_param_t *param);
+
+/**
+ * @brief BLE 自适应连接参数的 GATTC 事件处理 (统计通知、指示及读响应)
+ *
+ * @note 同 xf_ble_conn_param_mgr_gap_event_handler()
+ */
+xf_ble_evt_res_t xf_ble_conn_param_mgr_gattc_event_handler(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_CONN_PARAM_MGR_H__ */
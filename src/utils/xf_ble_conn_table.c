@@ -0,0 +1,287 @@
+/**
+ * @file xf_ble_conn_table.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 连接状态表。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_ble_utils.h"
+#include "xf_ble_conn_table.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_conn"
+
+#if (XF_BLE_CONN_TABLE_SIZE < 1) || (XF_BLE_CONN_TABLE_SIZE > 32)
+#error "XF_BLE_CONN_TABLE_SIZE must be in [1, 32]"
+#endif
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void conn_table_update_mtu(xf_ble_conn_id_t conn_id, uint16_t mtu);
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_ble_conn_info_t s_conn_table[XF_BLE_CONN_TABLE_SIZE] = {0};
+static uint32_t s_conn_active_mask = 0;     /*!< 第 n 位表示连接 ID n 存在 */
+
+/* ==================== [Macros] ============================================ */
+
+#define CONN_IS_ACTIVE(conn_id) \
+    (((conn_id) < XF_BLE_CONN_TABLE_SIZE) && (s_conn_active_mask & (1UL << (conn_id))))
+
+/* ==================== [Global Functions] ================================== */
+
+xf_ble_evt_res_t xf_ble_conn_table_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param)
+{
+    if (param == NULL) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+
+    switch (event) {
+    case XF_BLE_GAP_EVT_CONNECT: {
+        xf_ble_conn_id_t conn_id = param->connect.conn_id;
+        if (conn_id >= XF_BLE_CONN_TABLE_SIZE) {
+            XF_LOGW(TAG, "conn_id(%d) exceeds table size: %d", conn_id, XF_BLE_CONN_TABLE_SIZE);
+            break;
+        }
+        XF_BLE_ENTER_CRITICAL();
+        xf_ble_conn_info_t *info = &s_conn_table[conn_id];
+        xf_memset(info, 0, sizeof(xf_ble_conn_info_t));
+        info->conn_id = conn_id;
+        info->link_role = param->connect.link_role;
+        if (param->connect.addr != NULL) {
+            info->addr = *param->connect.addr;
+        }
+        info->mtu = XF_BLE_CONN_TABLE_MTU_DEFAULT;
+        info->tx_phy = XF_BLE_GAP_PHY_1M;
+        info->rx_phy = XF_BLE_GAP_PHY_1M;
+        info->max_tx_octets = XF_BLE_GAP_DATA_LEN_TX_OCTETS_MIN;
+        info->max_rx_octets = XF_BLE_GAP_DATA_LEN_TX_OCTETS_MIN;
+        info->sec_level = XF_BLE_CONN_SEC_LEVEL_NONE;
+        s_conn_active_mask |= (1UL << conn_id);
+        XF_BLE_EXIT_CRITICAL();
+    } break;
+    case XF_BLE_GAP_EVT_DISCONNECT: {
+        xf_ble_conn_id_t conn_id = param->disconnect.conn_id;
+        if (conn_id < XF_BLE_CONN_TABLE_SIZE) {
+            XF_BLE_ENTER_CRITICAL();
+            s_conn_active_mask &= ~(1UL << conn_id);
+            XF_BLE_EXIT_CRITICAL();
+        }
+    } break;
+    case XF_BLE_GAP_EVT_CONN_PARAM_UPDATE: {
+        xf_ble_conn_id_t conn_id = param->conn_param_upd.conn_id;
+        XF_BLE_ENTER_CRITICAL();
+        if (CONN_IS_ACTIVE(conn_id)) {
+            s_conn_table[conn_id].interval = param->conn_param_upd.interval;
+            s_conn_table[conn_id].latency = param->conn_param_upd.latency;
+            s_conn_table[conn_id].timeout = param->conn_param_upd.timeout;
+        }
+        XF_BLE_EXIT_CRITICAL();
+    } break;
+    case XF_BLE_GAP_EVT_PHY_UPDATE: {
+        if (param->phy_upd.status == XF_OK) {
+            xf_ble_conn_table_set_phy(param->phy_upd.conn_id,
+                                      param->phy_upd.tx_phy, param->phy_upd.rx_phy);
+        }
+    } break;
+    case XF_BLE_GAP_EVT_DATA_LEN_CHANGE: {
+        xf_ble_conn_id_t conn_id = param->data_len.conn_id;
+        XF_BLE_ENTER_CRITICAL();
+        if (CONN_IS_ACTIVE(conn_id)) {
+            s_conn_table[conn_id].max_tx_octets = param->data_len.max_tx_octets;
+            s_conn_table[conn_id].max_rx_octets = param->data_len.max_rx_octets;
+        }
+        XF_BLE_EXIT_CRITICAL();
+    } break;
+    case XF_BLE_GAP_EVT_PAIR_END: {
+        xf_ble_conn_id_t conn_id = param->pair_end.conn_id;
+        XF_BLE_ENTER_CRITICAL();
+        if (CONN_IS_ACTIVE(conn_id) && param->pair_end.is_succ
+                && (s_conn_table[conn_id].sec_level < XF_BLE_CONN_SEC_LEVEL_ENC)) {
+            s_conn_table[conn_id].sec_level = XF_BLE_CONN_SEC_LEVEL_ENC;
+        }
+        XF_BLE_EXIT_CRITICAL();
+    } break;
+    default:
+        break;
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+xf_ble_evt_res_t xf_ble_conn_table_gatts_event_handler(
+    xf_ble_gatts_evt_t event,
+    xf_ble_gatts_evt_cb_param_t *param)
+{
+    if ((event == XF_BLE_GATTS_EVT_EXCHANGE_MTU) && (param != NULL)) {
+        conn_table_update_mtu(param->mtu.conn_id, param->mtu.mtu_size);
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+xf_ble_evt_res_t xf_ble_conn_table_gattc_event_handler(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param)
+{
+    if ((event == XF_BLE_GATTC_EVT_EXCHANGE_MTU) && (param != NULL)) {
+        conn_table_update_mtu(param->mtu.conn_id, param->mtu.mtu);
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+bool xf_ble_conn_table_is_active(xf_ble_conn_id_t conn_id)
+{
+    return CONN_IS_ACTIVE(conn_id);
+}
+
+uint8_t xf_ble_conn_table_get_num(void)
+{
+    return (uint8_t)__builtin_popcount(s_conn_active_mask);
+}
+
+xf_err_t xf_ble_conn_table_get_info(xf_ble_conn_id_t conn_id, xf_ble_conn_info_t *info)
+{
+    XF_ASSERT(info != NULL, XF_ERR_INVALID_ARG, TAG, "info == NULL");
+
+    xf_err_t ret = XF_ERR_NOT_FOUND;
+    XF_BLE_ENTER_CRITICAL();
+    if (CONN_IS_ACTIVE(conn_id)) {
+        *info = s_conn_table[conn_id];
+        ret = XF_OK;
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return ret;
+}
+
+uint16_t xf_ble_conn_table_get_mtu(xf_ble_conn_id_t conn_id)
+{
+    return CONN_IS_ACTIVE(conn_id) ? s_conn_table[conn_id].mtu : 0;
+}
+
+xf_err_t xf_ble_conn_table_get_role(xf_ble_conn_id_t conn_id,
+                                    xf_ble_gap_link_role_type_t *link_role)
+{
+    XF_ASSERT(link_role != NULL, XF_ERR_INVALID_ARG, TAG, "link_role == NULL");
+    if (!CONN_IS_ACTIVE(conn_id)) {
+        return XF_ERR_NOT_FOUND;
+    }
+    *link_role = s_conn_table[conn_id].link_role;
+    return XF_OK;
+}
+
+xf_err_t xf_ble_conn_table_get_addr(xf_ble_conn_id_t conn_id, xf_ble_addr_t *addr)
+{
+    XF_ASSERT(addr != NULL, XF_ERR_INVALID_ARG, TAG, "addr == NULL");
+
+    xf_err_t ret = XF_ERR_NOT_FOUND;
+    XF_BLE_ENTER_CRITICAL();
+    if (CONN_IS_ACTIVE(conn_id)) {
+        *addr = s_conn_table[conn_id].addr;
+        ret = XF_OK;
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return ret;
+}
+
+xf_ble_conn_sec_level_t xf_ble_conn_table_get_sec_level(xf_ble_conn_id_t conn_id)
+{
+    return CONN_IS_ACTIVE(conn_id)
+           ? s_conn_table[conn_id].sec_level : XF_BLE_CONN_SEC_LEVEL_NONE;
+}
+
+xf_err_t xf_ble_conn_table_find_by_addr(const xf_ble_addr_t *addr, xf_ble_conn_id_t *conn_id)
+{
+    XF_ASSERT(addr != NULL, XF_ERR_INVALID_ARG, TAG, "addr == NULL");
+    XF_ASSERT(conn_id != NULL, XF_ERR_INVALID_ARG, TAG, "conn_id == NULL");
+
+    xf_err_t ret = XF_ERR_NOT_FOUND;
+    XF_BLE_ENTER_CRITICAL();
+    uint32_t mask = s_conn_active_mask;
+    while (mask != 0) {
+        xf_ble_conn_id_t id = (xf_ble_conn_id_t)__builtin_ctz(mask);
+        mask &= mask - 1;
+        if (xf_ble_addr_is_equal(&s_conn_table[id].addr, addr)) {
+            *conn_id = id;
+            ret = XF_OK;
+            break;
+        }
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return ret;
+}
+
+uint8_t xf_ble_conn_table_foreach(xf_ble_conn_table_foreach_cb_t cb, void *user_data)
+{
+    XF_ASSERT(cb != NULL, 0, TAG, "cb == NULL");
+
+    uint8_t cnt = 0;
+    uint32_t mask = s_conn_active_mask;
+    while (mask != 0) {
+        xf_ble_conn_id_t id = (xf_ble_conn_id_t)__builtin_ctz(mask);
+        mask &= mask - 1;
+        xf_ble_conn_info_t info;
+        if (xf_ble_conn_table_get_info(id, &info) != XF_OK) {
+            continue;   /* 遍历过程中已断连 */
+        }
+        ++cnt;
+        if (!cb(&info, user_data)) {
+            break;
+        }
+    }
+    return cnt;
+}
+
+xf_err_t xf_ble_conn_table_set_phy(xf_ble_conn_id_t conn_id,
+                                   xf_ble_gap_phy_type_t tx_phy, xf_ble_gap_phy_type_t rx_phy)
+{
+    xf_err_t ret = XF_ERR_NOT_FOUND;
+    XF_BLE_ENTER_CRITICAL();
+    if (CONN_IS_ACTIVE(conn_id)) {
+        s_conn_table[conn_id].tx_phy = tx_phy;
+        s_conn_table[conn_id].rx_phy = rx_phy;
+        ret = XF_OK;
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return ret;
+}
+
+xf_err_t xf_ble_conn_table_set_sec_level(xf_ble_conn_id_t conn_id,
+                                         xf_ble_conn_sec_level_t sec_level)
+{
+    xf_err_t ret = XF_ERR_NOT_FOUND;
+    XF_BLE_ENTER_CRITICAL();
+    if (CONN_IS_ACTIVE(conn_id)) {
+        s_conn_table[conn_id].sec_level = sec_level;
+        ret = XF_OK;
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return ret;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void conn_table_update_mtu(xf_ble_conn_id_t conn_id, uint16_t mtu)
+{
+    if (mtu < XF_BLE_CONN_TABLE_MTU_DEFAULT) {
+        return;
+    }
+    XF_BLE_ENTER_CRITICAL();
+    if (CONN_IS_ACTIVE(conn_id)) {
+        s_conn_table[conn_id].mtu = mtu;
+    }
+    XF_BLE_EXIT_CRITICAL();
+}
+
+#endif /* XF_BLE_IS_ENABLE */
@@ -0,0 +1,249 @@
+/**
+ * @file xf_ble_conn_table.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 连接状态表。
+ *  以连接 ID 为下标直接索引，由连接、断连、连接参数更新、 MTU 协商、 PHY 更新、数据长度变化、
+ *  配对结束等事件自动维护，供上层以 O(1) 获取对端地址、角色、 MTU 、 PHY 、数据长度及安全等级。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_CONN_TABLE_H__
+#define __XF_BLE_CONN_TABLE_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gap_types.h"
+#include "xf_ble_gatt_server_types.h"
+#include "xf_ble_gatt_client_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief BLE 连接状态表: 连接建立时的默认 MTU (ATT_MTU 最小值)
+ */
+#define XF_BLE_CONN_TABLE_MTU_DEFAULT   (23)
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE 连接的安全等级 (LE 安全模式 1)
+ *
+ * @see 蓝牙核心文档 《Core_v5.4》>> Vol 3, Part C >> 10.2.1 LE security mode 1
+ */
+typedef uint8_t xf_ble_conn_sec_level_t;
+enum _xf_ble_conn_sec_level_t {
+    XF_BLE_CONN_SEC_LEVEL_NONE = 1,         /*!< 无安全 (不加密) */
+    XF_BLE_CONN_SEC_LEVEL_ENC,              /*!< 加密，未认证 (如 just works) */
+    XF_BLE_CONN_SEC_LEVEL_AUTH_ENC,         /*!< 加密，已认证 (MITM 保护) */
+    XF_BLE_CONN_SEC_LEVEL_SC_AUTH_ENC,      /*!< LE 安全连接 (LESC) 加密，已认证 */
+};
+
+/**
+ * @brief BLE 连接的状态信息
+ */
+typedef struct {
+    xf_ble_conn_id_t conn_id;               /*!< 链接 (连接) ID */
+    xf_ble_gap_link_role_type_t link_role;  /*!< 链路角色，见 @ref xf_ble_gap_link_role_type_t */
+    xf_ble_addr_t addr;                     /*!< 对端地址，见 @ref xf_ble_addr_t */
+    uint16_t mtu;                           /*!< ATT MTU */
+    uint16_t interval;                      /*!< 连接间隔，0 表示尚未上报 */
+    uint16_t latency;                       /*!< 从机延迟 */
+    uint16_t timeout;                       /*!< 连接超时 (断连) 时间 */
+    xf_ble_gap_phy_type_t tx_phy;           /*!< 发送 PHY，见 @ref xf_ble_gap_phy_type_t */
+    xf_ble_gap_phy_type_t rx_phy;           /*!< 接收 PHY，见 @ref xf_ble_gap_phy_type_t */
+    uint16_t max_tx_octets;                 /*!< 链路层单包发送的最大有效载荷 (字节) */
+    uint16_t max_rx_octets;                 /*!< 链路层单包接收的最大有效载荷 (字节) */
+    xf_ble_conn_sec_level_t sec_level;      /*!< 安全等级，见 @ref xf_ble_conn_sec_level_t */
+} xf_ble_conn_info_t;
+
+/**
+ * @brief BLE 连接状态表的遍历回调
+ *
+ * @param info 连接的状态信息 (副本)，见 @ref xf_ble_conn_info_t
+ * @param user_data 用户数据
+ * @return bool true: 继续遍历; false: 停止遍历
+ */
+typedef bool (*xf_ble_conn_table_foreach_cb_t)(const xf_ble_conn_info_t *info, void *user_data);
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE 连接状态表的 GAP 事件处理 (连接、断连、连接参数更新、 PHY 更新、数据长度变化、配对结束)
+ *
+ * @note 需在 GAP 事件回调中调用 (应先于其他依赖连接状态的模块)；
+ *  仅观察事件，固定返回 XF_BLE_EVT_RES_NOT_HANDLED
+ */
+xf_ble_evt_res_t xf_ble_conn_table_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param);
+
+/**
+ * @brief BLE 连接状态表的 GATTS 事件处理 (MTU 协商)
+ *
+ * @note 同 xf_ble_conn_table_gap_event_handler()
+ */
+xf_ble_evt_res_t xf_ble_conn_table_gatts_event_handler(
+    xf_ble_gatts_evt_t event,
+    xf_ble_gatts_evt_cb_param_t *param);
+
+/**
+ * @brief BLE 连接状态表的 GATTC 事件处理 (MTU 协商)
+ *
+ * @note 同 xf_ble_conn_table_gap_event_handler()
+ */
+xf_ble_evt_res_t xf_ble_conn_table_gattc_event_handler(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param);
+
+/**
+ * @brief BLE 连接状态表: 连接是否存在
+ *
+ * @param conn_id 连接 ID
+ * @return bool 是否存在
+ */
+bool xf_ble_conn_table_is_active(xf_ble_conn_id_t conn_id);
+
+/**
+ * @brief BLE 连接状态表: 当前连接数量
+ *
+ * @return uint8_t 连接数量
+ */
+uint8_t xf_ble_conn_table_get_num(void);
+
+/**
+ * @brief BLE 连接状态表: 获取连接的状态信息
+ *
+ * @param conn_id 连接 ID
+ * @param[out] info 状态信息，见 @ref xf_ble_conn_info_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      连接不存在
+ */
+xf_err_t xf_ble_conn_table_get_info(xf_ble_conn_id_t conn_id, xf_ble_conn_info_t *info);
+
+/**
+ * @brief BLE 连接状态表: 获取连接的 MTU
+ *
+ * @param conn_id 连接 ID
+ * @return uint16_t MTU ，连接不存在时为 0
+ */
+uint16_t xf_ble_conn_table_get_mtu(xf_ble_conn_id_t conn_id);
+
+/**
+ * @brief BLE 连接状态表: 获取连接的链路角色
+ *
+ * @param conn_id 连接 ID
+ * @param[out] link_role 链路角色，见 @ref xf_ble_gap_link_role_type_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      连接不存在
+ */
+xf_err_t xf_ble_conn_table_get_role(xf_ble_conn_id_t conn_id,
+                                    xf_ble_gap_link_role_type_t *link_role);
+
+/**
+ * @brief BLE 连接状态表: 获取连接的对端地址
+ *
+ * @param conn_id 连接 ID
+ * @param[out] addr 对端地址，见 @ref xf_ble_addr_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      连接不存在
+ */
+xf_err_t xf_ble_conn_table_get_addr(xf_ble_conn_id_t conn_id, xf_ble_addr_t *addr);
+
+/**
+ * @brief BLE 连接状态表: 获取连接的安全等级
+ *
+ * @param conn_id 连接 ID
+ * @return xf_ble_conn_sec_level_t 安全等级，连接不存在时为 XF_BLE_CONN_SEC_LEVEL_NONE
+ */
+xf_ble_conn_sec_level_t xf_ble_conn_table_get_sec_level(xf_ble_conn_id_t conn_id);
+
+/**
+ * @brief BLE 连接状态表: 按对端地址查找连接
+ *
+ * @param addr 对端地址
+ * @param[out] conn_id 连接 ID
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      连接不存在
+ */
+xf_err_t xf_ble_conn_table_find_by_addr(const xf_ble_addr_t *addr, xf_ble_conn_id_t *conn_id);
+
+/**
+ * @brief BLE 连接状态表: 遍历当前所有连接 (按连接 ID 升序)
+ *
+ * @param cb 遍历回调，见 @ref xf_ble_conn_table_foreach_cb_t
+ * @param user_data 用户数据
+ * @return uint8_t 已回调的连接数量
+ *
+ * @note 回调在临界区外调用，回调中可调用本模块的其他接口
+ */
+uint8_t xf_ble_conn_table_foreach(xf_ble_conn_table_foreach_cb_t cb, void *user_data);
+
+/**
+ * @brief BLE 连接状态表: 设置连接的 PHY
+ *
+ * @note 通常由 XF_BLE_GAP_EVT_PHY_UPDATE 事件自动更新 (连接建立时默认为 1M PHY)，
+ *  平台侧未上报该事件时可调用本接口
+ * @param conn_id 连接 ID
+ * @param tx_phy 发送 PHY，见 @ref xf_ble_gap_phy_type_t
+ * @param rx_phy 接收 PHY，见 @ref xf_ble_gap_phy_type_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      连接不存在
+ */
+xf_err_t xf_ble_conn_table_set_phy(xf_ble_conn_id_t conn_id,
+                                   xf_ble_gap_phy_type_t tx_phy, xf_ble_gap_phy_type_t rx_phy);
+
+/**
+ * @brief BLE 连接状态表: 设置连接的安全等级
+ *
+ * @note 配对结束事件仅上报是否成功，配对成功时默认记为 XF_BLE_CONN_SEC_LEVEL_ENC ，
+ *  平台侧可在得知认证方式后调用本接口修正
+ * @param conn_id 连接 ID
+ * @param sec_level 安全等级，见 @ref xf_ble_conn_sec_level_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      连接不存在
+ */
+xf_err_t xf_ble_conn_table_set_sec_level(xf_ble_conn_id_t conn_id,
+                                         xf_ble_conn_sec_level_t sec_level);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_CONN_TABLE_H__ */
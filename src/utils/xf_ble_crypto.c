@@ -0,0 +1,1067 @@
+/**
+ * @file xf_ble_crypto.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 安全管理 (SM) 加密工具箱。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_sys.h"
+#include "xf_ble_gap.h"
+#include "xf_ble_trace.h"
+#include "xf_ble_aes.h"
+#include "xf_ble_crypto.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_crypto"
+
+#define P256_WORDS              (8)
+#define P256_KEYGEN_RETRY       (8)
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void crypto_cmac(const uint8_t key[XF_BLE_CRYPTO_KEY_SIZE], const uint8_t *msg, uint32_t len,
+                        uint8_t mac[XF_BLE_CRYPTO_KEY_SIZE]);
+static void crypto_cmac_dbl(uint8_t b[XF_BLE_CRYPTO_KEY_SIZE]);
+static uint8_t crypto_addr_encode(const xf_ble_addr_t *addr, uint8_t *buf);
+static void crypto_wipe(void *buf, uint32_t len);
+static bool crypto_is_equal(const uint8_t *a, const uint8_t *b, uint32_t len);
+
+static void p256_from_bytes(uint32_t r[P256_WORDS], const uint8_t b[XF_BLE_CRYPTO_P256_SIZE]);
+static void p256_to_bytes(uint8_t b[XF_BLE_CRYPTO_P256_SIZE], const uint32_t a[P256_WORDS]);
+static bool p256_is_zero(const uint32_t a[P256_WORDS]);
+static bool p256_is_less(const uint32_t a[P256_WORDS], const uint32_t m[P256_WORDS]);
+static uint32_t p256_add_raw(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS]);
+static void p256_reduce_once(uint32_t r[P256_WORDS], const uint32_t t[P256_WORDS], uint32_t hi);
+static void p256_add(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS]);
+static void p256_sub(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS]);
+static void p256_half(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS]);
+static void p256_mul(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS]);
+static void p256_inv(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS]);
+static void p256_cswap(uint32_t a[P256_WORDS], uint32_t b[P256_WORDS], uint32_t bit);
+static void p256_apply_z(uint32_t x[P256_WORDS], uint32_t y[P256_WORDS], const uint32_t z[P256_WORDS]);
+static void p256_double_jacobian(uint32_t x1[P256_WORDS], uint32_t y1[P256_WORDS], uint32_t z1[P256_WORDS]);
+static void p256_xycz_add(uint32_t x1[P256_WORDS], uint32_t y1[P256_WORDS],
+                          uint32_t x2[P256_WORDS], uint32_t y2[P256_WORDS]);
+static void p256_xycz_addc(uint32_t x1[P256_WORDS], uint32_t y1[P256_WORDS],
+                           uint32_t x2[P256_WORDS], uint32_t y2[P256_WORDS]);
+static bool p256_point_mul(uint32_t rx[P256_WORDS], uint32_t ry[P256_WORDS],
+                           const uint32_t px[P256_WORDS], const uint32_t py[P256_WORDS],
+                           const uint32_t k[P256_WORDS]);
+static bool p256_is_on_curve(const uint32_t x[P256_WORDS], const uint32_t y[P256_WORDS]);
+
+/* ==================== [Static Variables] ================================== */
+
+/* f5 的 SALT 及 keyID ("btle") */
+static const uint8_t s_f5_salt[XF_BLE_CRYPTO_KEY_SIZE] = {
+    0x6C, 0x88, 0x83, 0x91, 0xAA, 0xF5, 0xA5, 0x38, 0x60, 0x37, 0x0B, 0xDB, 0x5A, 0x60, 0x83, 0xBE,
+};
+static const uint8_t s_f5_key_id[4] = {0x62, 0x74, 0x6C, 0x65};
+
+/* P-256 参数，32 位字小端排列 (低位字在前) */
+static const uint32_t s_p256_p[P256_WORDS] = {
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xFFFFFFFF,
+};
+static const uint32_t s_p256_n[P256_WORDS] = {
+    0xFC632551, 0xF3B9CAC2, 0xA7179E84, 0xBCE6FAAD, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0xFFFFFFFF,
+};
+static const uint32_t s_p256_b[P256_WORDS] = {
+    0x27D2604B, 0x3BCE3C3E, 0xCC53B0F6, 0x651D06B0, 0x769886BC, 0xB3EBBD55, 0xAA3A93E7, 0x5AC635D8,
+};
+static const uint32_t s_p256_gx[P256_WORDS] = {
+    0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81, 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2,
+};
+static const uint32_t s_p256_gy[P256_WORDS] = {
+    0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357, 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2,
+};
+/* R^2 mod p (R = 2^256)，用于转换到 Montgomery 域 */
+static const uint32_t s_p256_r2[P256_WORDS] = {
+    0x00000003, 0x00000000, 0xFFFFFFFF, 0xFFFFFFFB, 0xFFFFFFFE, 0xFFFFFFFF, 0xFFFFFFFD, 0x00000004,
+};
+
+/* 自检数据，取自蓝牙核心规范 (Vol 2, Part G 及 Vol 3, Part H 附录 D) 及 RFC 4493 */
+static const uint8_t s_tv_cmac_key[16] = {
+    0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C,
+};
+
+static const uint8_t s_tv_cmac_msg[64] = {
+    0x6B, 0xC1, 0xBE, 0xE2, 0x2E, 0x40, 0x9F, 0x96, 0xE9, 0x3D, 0x7E, 0x11, 0x73, 0x93, 0x17, 0x2A,
+    0xAE, 0x2D, 0x8A, 0x57, 0x1E, 0x03, 0xAC, 0x9C, 0x9E, 0xB7, 0x6F, 0xAC, 0x45, 0xAF, 0x8E, 0x51,
+    0x30, 0xC8, 0x1C, 0x46, 0xA3, 0x5C, 0xE4, 0x11, 0xE5, 0xFB, 0xC1, 0x19, 0x1A, 0x0A, 0x52, 0xEF,
+    0xF6, 0x9F, 0x24, 0x45, 0xDF, 0x4F, 0x9B, 0x17, 0xAD, 0x2B, 0x41, 0x7B, 0xE6, 0x6C, 0x37, 0x10,
+};
+
+static const uint8_t s_tv_cmac_mac0[16] = {
+    0xBB, 0x1D, 0x69, 0x29, 0xE9, 0x59, 0x37, 0x28, 0x7F, 0xA3, 0x7D, 0x12, 0x9B, 0x75, 0x67, 0x46,
+};
+
+static const uint8_t s_tv_cmac_mac16[16] = {
+    0x07, 0x0A, 0x16, 0xB4, 0x6B, 0x4D, 0x41, 0x44, 0xF7, 0x9B, 0xDD, 0x9D, 0xD0, 0x4A, 0x28, 0x7C,
+};
+
+static const uint8_t s_tv_cmac_mac40[16] = {
+    0xDF, 0xA6, 0x67, 0x47, 0xDE, 0x9A, 0xE6, 0x30, 0x30, 0xCA, 0x32, 0x61, 0x14, 0x97, 0xC8, 0x27,
+};
+
+static const uint8_t s_tv_cmac_mac64[16] = {
+    0x51, 0xF0, 0xBE, 0xBF, 0x7E, 0x3B, 0x9D, 0x92, 0xFC, 0x49, 0x74, 0x17, 0x79, 0x36, 0x3C, 0xFE,
+};
+
+static const uint8_t s_tv_v[32] = {
+    0x55, 0x18, 0x8B, 0x3D, 0x32, 0xF6, 0xBB, 0x9A, 0x90, 0x0A, 0xFC, 0xFB, 0xEE, 0xD4, 0xE7, 0x2A,
+    0x59, 0xCB, 0x9A, 0xC2, 0xF1, 0x9D, 0x7C, 0xFB, 0x6B, 0x4F, 0xDD, 0x49, 0xF4, 0x7F, 0xC5, 0xFD,
+};
+
+static const uint8_t s_tv_x[16] = {
+    0xD5, 0xCB, 0x84, 0x54, 0xD1, 0x77, 0x73, 0x3E, 0xFF, 0xFF, 0xB2, 0xEC, 0x71, 0x2B, 0xAE, 0xAB,
+};
+
+static const uint8_t s_tv_y[16] = {
+    0xA6, 0xE8, 0xE7, 0xCC, 0x25, 0xA7, 0x5F, 0x6E, 0x21, 0x65, 0x83, 0xF7, 0xFF, 0x3D, 0xC4, 0xCF,
+};
+
+static const uint8_t s_tv_f4[16] = {
+    0xF2, 0xC9, 0x16, 0xF1, 0x07, 0xA9, 0xBD, 0x1C, 0xF1, 0xED, 0xA1, 0xBE, 0xA9, 0x74, 0x87, 0x2D,
+};
+
+static const uint8_t s_tv_w[32] = {
+    0xEC, 0x02, 0x34, 0xA3, 0x57, 0xC8, 0xAD, 0x05, 0x34, 0x10, 0x10, 0xA6, 0x0A, 0x39, 0x7D, 0x9B,
+    0x99, 0x79, 0x6B, 0x13, 0xB4, 0xF8, 0x66, 0xF1, 0x86, 0x8D, 0x34, 0xF3, 0x73, 0xBF, 0xA6, 0x98,
+};
+
+static const uint8_t s_tv_mac_key[16] = {
+    0x29, 0x65, 0xF1, 0x76, 0xA1, 0x08, 0x4A, 0x02, 0xFD, 0x3F, 0x6A, 0x20, 0xCE, 0x63, 0x6E, 0x20,
+};
+
+static const uint8_t s_tv_ltk[16] = {
+    0x69, 0x86, 0x79, 0x11, 0x69, 0xD7, 0xCD, 0x23, 0x98, 0x05, 0x22, 0xB5, 0x94, 0x75, 0x0A, 0x38,
+};
+
+static const uint8_t s_tv_r[16] = {
+    0x12, 0xA3, 0x34, 0x3B, 0xB4, 0x53, 0xBB, 0x54, 0x08, 0xDA, 0x42, 0xD2, 0x0C, 0x2D, 0x0F, 0xC8,
+};
+
+static const uint8_t s_tv_f6[16] = {
+    0xE3, 0xC4, 0x73, 0x98, 0x9C, 0xD0, 0xE8, 0xC5, 0xD2, 0x6C, 0x0B, 0x09, 0xDA, 0x95, 0x8F, 0x61,
+};
+
+static const uint8_t s_tv_c1_r[16] = {
+    0x57, 0x83, 0xD5, 0x21, 0x56, 0xAD, 0x6F, 0x0E, 0x63, 0x88, 0x27, 0x4E, 0xC6, 0x70, 0x2E, 0xE0,
+};
+
+static const uint8_t s_tv_c1[16] = {
+    0x1E, 0x1E, 0x3F, 0xEF, 0x87, 0x89, 0x88, 0xEA, 0xD2, 0xA7, 0x4D, 0xC5, 0xBE, 0xF1, 0x3B, 0x86,
+};
+
+static const uint8_t s_tv_s1_r1[16] = {
+    0x00, 0x0F, 0x0E, 0x0D, 0x0C, 0x0B, 0x0A, 0x09, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88,
+};
+
+static const uint8_t s_tv_s1_r2[16] = {
+    0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF, 0x00,
+};
+
+static const uint8_t s_tv_s1[16] = {
+    0x9A, 0x1F, 0xE1, 0xF0, 0xE8, 0xB0, 0xF4, 0x9B, 0x5B, 0x42, 0x16, 0xAE, 0x79, 0x6D, 0xA0, 0x62,
+};
+
+static const uint8_t s_tv_priv_a[32] = {
+    0x3F, 0x49, 0xF6, 0xD4, 0xA3, 0xC5, 0x5F, 0x38, 0x74, 0xC9, 0xB3, 0xE3, 0xD2, 0x10, 0x3F, 0x50,
+    0x4A, 0xFF, 0x60, 0x7B, 0xEB, 0x40, 0xB7, 0x99, 0x58, 0x99, 0xB8, 0xA6, 0xCD, 0x3C, 0x1A, 0xBD,
+};
+
+static const uint8_t s_tv_pub_a[64] = {
+    0x20, 0xB0, 0x03, 0xD2, 0xF2, 0x97, 0xBE, 0x2C, 0x5E, 0x2C, 0x83, 0xA7, 0xE9, 0xF9, 0xA5, 0xB9,
+    0xEF, 0xF4, 0x91, 0x11, 0xAC, 0xF4, 0xFD, 0xDB, 0xCC, 0x03, 0x01, 0x48, 0x0E, 0x35, 0x9D, 0xE6,
+    0xDC, 0x80, 0x9C, 0x49, 0x65, 0x2A, 0xEB, 0x6D, 0x63, 0x32, 0x9A, 0xBF, 0x5A, 0x52, 0x15, 0x5C,
+    0x76, 0x63, 0x45, 0xC2, 0x8F, 0xED, 0x30, 0x24, 0x74, 0x1C, 0x8E, 0xD0, 0x15, 0x89, 0xD2, 0x8B,
+};
+
+static const uint8_t s_tv_pub_b[64] = {
+    0x1E, 0xA1, 0xF0, 0xF0, 0x1F, 0xAF, 0x1D, 0x96, 0x09, 0x59, 0x22, 0x84, 0xF1, 0x9E, 0x4C, 0x00,
+    0x47, 0xB5, 0x8A, 0xFD, 0x86, 0x15, 0xA6, 0x9F, 0x55, 0x90, 0x77, 0xB2, 0x2F, 0xAA, 0xA1, 0x90,
+    0x4C, 0x55, 0xF3, 0x3E, 0x42, 0x9D, 0xAD, 0x37, 0x73, 0x56, 0x70, 0x3A, 0x9A, 0xB8, 0x51, 0x60,
+    0x47, 0x2D, 0x11, 0x30, 0xE2, 0x8E, 0x36, 0x76, 0x5F, 0x89, 0xAF, 0xF9, 0x15, 0xB1, 0x21, 0x4A,
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_ble_crypto_e(const uint8_t key[XF_BLE_CRYPTO_KEY_SIZE],
+                         const uint8_t in[XF_BLE_CRYPTO_KEY_SIZE], uint8_t out[XF_BLE_CRYPTO_KEY_SIZE])
+{
+    XF_CHECK((key == NULL) || (in == NULL) || (out == NULL), XF_ERR_INVALID_ARG,
+             TAG, "key, in or out == NULL");
+
+    xf_ble_aes_ctx_t aes;
+    xf_ble_aes_set_key(&aes, key);
+    xf_ble_aes_encrypt(&aes, in, out);
+    crypto_wipe(&aes, sizeof(aes));
+    return XF_OK;
+}
+
+xf_err_t xf_ble_crypto_aes_cmac(const uint8_t key[XF_BLE_CRYPTO_KEY_SIZE],
+                                const uint8_t *msg, uint32_t len, uint8_t mac[XF_BLE_CRYPTO_KEY_SIZE])
+{
+    XF_CHECK((key == NULL) || (mac == NULL) || ((msg == NULL) && (len != 0)), XF_ERR_INVALID_ARG,
+             TAG, "key, msg or mac == NULL");
+
+    crypto_cmac(key, msg, len, mac);
+    return XF_OK;
+}
+
+xf_err_t xf_ble_crypto_f4(const uint8_t u[XF_BLE_CRYPTO_P256_SIZE], const uint8_t v[XF_BLE_CRYPTO_P256_SIZE],
+                          const uint8_t x[XF_BLE_CRYPTO_KEY_SIZE], uint8_t z,
+                          uint8_t out[XF_BLE_CRYPTO_KEY_SIZE])
+{
+    XF_CHECK((u == NULL) || (v == NULL) || (x == NULL) || (out == NULL), XF_ERR_INVALID_ARG,
+             TAG, "u, v, x or out == NULL");
+
+    uint8_t m[2 * XF_BLE_CRYPTO_P256_SIZE + 1];
+    xf_memcpy(&m[0], u, XF_BLE_CRYPTO_P256_SIZE);
+    xf_memcpy(&m[XF_BLE_CRYPTO_P256_SIZE], v, XF_BLE_CRYPTO_P256_SIZE);
+    m[2 * XF_BLE_CRYPTO_P256_SIZE] = z;
+    crypto_cmac(x, m, sizeof(m), out);
+    return XF_OK;
+}
+
+xf_err_t xf_ble_crypto_f5(const uint8_t w[XF_BLE_CRYPTO_P256_SIZE],
+                          const uint8_t n1[XF_BLE_CRYPTO_KEY_SIZE], const uint8_t n2[XF_BLE_CRYPTO_KEY_SIZE],
+                          const xf_ble_addr_t *a1, const xf_ble_addr_t *a2,
+                          uint8_t mac_key[XF_BLE_CRYPTO_KEY_SIZE], uint8_t ltk[XF_BLE_CRYPTO_KEY_SIZE])
+{
+    XF_CHECK((w == NULL) || (n1 == NULL) || (n2 == NULL) || (a1 == NULL) || (a2 == NULL)
+             || (mac_key == NULL) || (ltk == NULL), XF_ERR_INVALID_ARG, TAG, "param == NULL");
+
+    uint8_t t[XF_BLE_CRYPTO_KEY_SIZE];
+    crypto_cmac(s_f5_salt, w, XF_BLE_CRYPTO_P256_SIZE, t);
+
+    /* Counter || keyID || N1 || N2 || A1 || A2 || Length (256) */
+    uint8_t m[1 + 4 + 2 * XF_BLE_CRYPTO_KEY_SIZE + 2 * (1 + XF_BLE_ADDR_LEN) + 2];
+    uint8_t n = 1;
+    xf_memcpy(&m[n], s_f5_key_id, sizeof(s_f5_key_id));
+    n += sizeof(s_f5_key_id);
+    xf_memcpy(&m[n], n1, XF_BLE_CRYPTO_KEY_SIZE);
+    n += XF_BLE_CRYPTO_KEY_SIZE;
+    xf_memcpy(&m[n], n2, XF_BLE_CRYPTO_KEY_SIZE);
+    n += XF_BLE_CRYPTO_KEY_SIZE;
+    n += crypto_addr_encode(a1, &m[n]);
+    n += crypto_addr_encode(a2, &m[n]);
+    m[n++] = 0x01;
+    m[n++] = 0x00;
+
+    m[0] = 0;
+    crypto_cmac(t, m, n, mac_key);
+    m[0] = 1;
+    crypto_cmac(t, m, n, ltk);
+    crypto_wipe(t, sizeof(t));
+    return XF_OK;
+}
+
+xf_err_t xf_ble_crypto_f6(const uint8_t w[XF_BLE_CRYPTO_KEY_SIZE],
+                          const uint8_t n1[XF_BLE_CRYPTO_KEY_SIZE], const uint8_t n2[XF_BLE_CRYPTO_KEY_SIZE],
+                          const uint8_t r[XF_BLE_CRYPTO_KEY_SIZE], const uint8_t io_cap[3],
+                          const xf_ble_addr_t *a1, const xf_ble_addr_t *a2,
+                          uint8_t out[XF_BLE_CRYPTO_KEY_SIZE])
+{
+    XF_CHECK((w == NULL) || (n1 == NULL) || (n2 == NULL) || (r == NULL) || (io_cap == NULL)
+             || (a1 == NULL) || (a2 == NULL) || (out == NULL), XF_ERR_INVALID_ARG, TAG, "param == NULL");
+
+    /* N1 || N2 || R || IOcap || A1 || A2 */
+    uint8_t m[3 * XF_BLE_CRYPTO_KEY_SIZE + 3 + 2 * (1 + XF_BLE_ADDR_LEN)];
+    uint8_t n = 0;
+    xf_memcpy(&m[n], n1, XF_BLE_CRYPTO_KEY_SIZE);
+    n += XF_BLE_CRYPTO_KEY_SIZE;
+    xf_memcpy(&m[n], n2, XF_BLE_CRYPTO_KEY_SIZE);
+    n += XF_BLE_CRYPTO_KEY_SIZE;
+    xf_memcpy(&m[n], r, XF_BLE_CRYPTO_KEY_SIZE);
+    n += XF_BLE_CRYPTO_KEY_SIZE;
+    xf_memcpy(&m[n], io_cap, 3);
+    n += 3;
+    n += crypto_addr_encode(a1, &m[n]);
+    n += crypto_addr_encode(a2, &m[n]);
+    crypto_cmac(w, m, n, out);
+    return XF_OK;
+}
+
+xf_err_t xf_ble_crypto_g2(const uint8_t u[XF_BLE_CRYPTO_P256_SIZE], const uint8_t v[XF_BLE_CRYPTO_P256_SIZE],
+                          const uint8_t x[XF_BLE_CRYPTO_KEY_SIZE], const uint8_t y[XF_BLE_CRYPTO_KEY_SIZE],
+                          uint32_t *val)
+{
+    XF_CHECK((u == NULL) || (v == NULL) || (x == NULL) || (y == NULL) || (val == NULL),
+             XF_ERR_INVALID_ARG, TAG, "u, v, x, y or val == NULL");
+
+    /* U || V || Y */
+    uint8_t m[2 * XF_BLE_CRYPTO_P256_SIZE + XF_BLE_CRYPTO_KEY_SIZE];
+    xf_memcpy(&m[0], u, XF_BLE_CRYPTO_P256_SIZE);
+    xf_memcpy(&m[XF_BLE_CRYPTO_P256_SIZE], v, XF_BLE_CRYPTO_P256_SIZE);
+    xf_memcpy(&m[2 * XF_BLE_CRYPTO_P256_SIZE], y, XF_BLE_CRYPTO_KEY_SIZE);
+    uint8_t mac[XF_BLE_CRYPTO_KEY_SIZE];
+    crypto_cmac(x, m, sizeof(m), mac);
+    *val = ((uint32_t)mac[12] << 24) | ((uint32_t)mac[13] << 16) | ((uint32_t)mac[14] << 8) | mac[15];
+    return XF_OK;
+}
+
+xf_err_t xf_ble_crypto_ah(const uint8_t irk[XF_BLE_CRYPTO_KEY_SIZE], uint32_t prand, uint32_t *hash)
+{
+    XF_CHECK((irk == NULL) || (hash == NULL), XF_ERR_INVALID_ARG, TAG, "irk or hash == NULL");
+
+    xf_ble_aes_ctx_t aes;
+    xf_ble_aes_set_key(&aes, irk);
+    *hash = xf_ble_aes_ah(&aes, prand);
+    crypto_wipe(&aes, sizeof(aes));
+    return XF_OK;
+}
+
+xf_err_t xf_ble_crypto_c1(const uint8_t k[XF_BLE_CRYPTO_KEY_SIZE], const uint8_t r[XF_BLE_CRYPTO_KEY_SIZE],
+                          const uint8_t preq[7], const uint8_t pres[7],
+                          const xf_ble_addr_t *ia, const xf_ble_addr_t *ra,
+                          uint8_t out[XF_BLE_CRYPTO_KEY_SIZE])
+{
+    XF_CHECK((k == NULL) || (r == NULL) || (preq == NULL) || (pres == NULL)
+             || (ia == NULL) || (ra == NULL) || (out == NULL), XF_ERR_INVALID_ARG, TAG, "param == NULL");
+
+    /* p1 = pres || preq || rat' || iat' ， p2 = padding (4 字节 0) || ia || ra */
+    uint8_t p[XF_BLE_CRYPTO_KEY_SIZE];
+    xf_memcpy(&p[0], pres, 7);
+    xf_memcpy(&p[7], preq, 7);
+    p[14] = (ra->type == XF_BLE_ADDR_TYPE_PUBLIC_DEV) ? 0x00 : 0x01;
+    p[15] = (ia->type == XF_BLE_ADDR_TYPE_PUBLIC_DEV) ? 0x00 : 0x01;
+
+    xf_ble_aes_ctx_t aes;
+    xf_ble_aes_set_key(&aes, k);
+    uint8_t b[XF_BLE_CRYPTO_KEY_SIZE];
+    for (uint8_t i = 0; i < XF_BLE_CRYPTO_KEY_SIZE; i++) {
+        b[i] = r[i] ^ p[i];
+    }
+    xf_ble_aes_encrypt(&aes, b, b);
+
+    xf_memset(p, 0, 4);
+    xf_memcpy(&p[4], ia->addr, XF_BLE_ADDR_LEN);
+    xf_memcpy(&p[4 + XF_BLE_ADDR_LEN], ra->addr, XF_BLE_ADDR_LEN);
+    for (uint8_t i = 0; i < XF_BLE_CRYPTO_KEY_SIZE; i++) {
+        b[i] ^= p[i];
+    }
+    xf_ble_aes_encrypt(&aes, b, out);
+    crypto_wipe(&aes, sizeof(aes));
+    return XF_OK;
+}
+
+xf_err_t xf_ble_crypto_s1(const uint8_t k[XF_BLE_CRYPTO_KEY_SIZE], const uint8_t r1[XF_BLE_CRYPTO_KEY_SIZE],
+                          const uint8_t r2[XF_BLE_CRYPTO_KEY_SIZE], uint8_t out[XF_BLE_CRYPTO_KEY_SIZE])
+{
+    XF_CHECK((k == NULL) || (r1 == NULL) || (r2 == NULL) || (out == NULL), XF_ERR_INVALID_ARG,
+             TAG, "k, r1, r2 or out == NULL");
+
+    /* r' = r1 的低 64 位 || r2 的低 64 位 */
+    uint8_t b[XF_BLE_CRYPTO_KEY_SIZE];
+    xf_memcpy(&b[0], &r1[8], 8);
+    xf_memcpy(&b[8], &r2[8], 8);
+    return xf_ble_crypto_e(k, b, out);
+}
+
+xf_err_t xf_ble_crypto_p256_gen_key(uint8_t priv[XF_BLE_CRYPTO_P256_SIZE],
+                                    uint8_t pub[XF_BLE_CRYPTO_P256_PUB_SIZE])
+{
+    XF_CHECK((priv == NULL) || (pub == NULL), XF_ERR_INVALID_ARG, TAG, "priv or pub == NULL");
+
+    for (uint8_t i = 0; i < P256_KEYGEN_RETRY; i++) {
+        xf_err_t ret = XF_OK;
+        XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_GET_RAND, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                              xf_ble_gap_get_rand(priv, XF_BLE_CRYPTO_P256_SIZE));
+        XF_CHECK(ret != XF_OK, ret, TAG, "get rand failed: %d", ret);
+        /* 私钥需在 [1, n - 1] 内，否则重新生成 */
+        if (xf_ble_crypto_p256_compute_pub(priv, pub) == XF_OK) {
+            return XF_OK;
+        }
+    }
+    crypto_wipe(priv, XF_BLE_CRYPTO_P256_SIZE);
+    return XF_FAIL;
+}
+
+xf_err_t xf_ble_crypto_p256_compute_pub(const uint8_t priv[XF_BLE_CRYPTO_P256_SIZE],
+                                        uint8_t pub[XF_BLE_CRYPTO_P256_PUB_SIZE])
+{
+    XF_CHECK((priv == NULL) || (pub == NULL), XF_ERR_INVALID_ARG, TAG, "priv or pub == NULL");
+
+    uint32_t k[P256_WORDS];
+    p256_from_bytes(k, priv);
+    if (p256_is_zero(k) || !p256_is_less(k, s_p256_n)) {
+        crypto_wipe(k, sizeof(k));
+        return XF_ERR_INVALID_ARG;
+    }
+    uint32_t gx[P256_WORDS];
+    uint32_t gy[P256_WORDS];
+    p256_mul(gx, s_p256_gx, s_p256_r2);
+    p256_mul(gy, s_p256_gy, s_p256_r2);
+    uint32_t x[P256_WORDS];
+    uint32_t y[P256_WORDS];
+    bool is_ok = p256_point_mul(x, y, gx, gy, k);
+    crypto_wipe(k, sizeof(k));
+    if (!is_ok) {
+        return XF_FAIL;
+    }
+    p256_to_bytes(&pub[0], x);
+    p256_to_bytes(&pub[XF_BLE_CRYPTO_P256_SIZE], y);
+    return XF_OK;
+}
+
+bool xf_ble_crypto_p256_is_valid_pub(const uint8_t pub[XF_BLE_CRYPTO_P256_PUB_SIZE])
+{
+    if (pub == NULL) {
+        return false;
+    }
+    uint32_t x[P256_WORDS];
+    uint32_t y[P256_WORDS];
+    p256_from_bytes(x, &pub[0]);
+    p256_from_bytes(y, &pub[XF_BLE_CRYPTO_P256_SIZE]);
+    return p256_is_on_curve(x, y);
+}
+
+xf_err_t xf_ble_crypto_p256_dhkey(const uint8_t priv[XF_BLE_CRYPTO_P256_SIZE],
+                                  const uint8_t peer_pub[XF_BLE_CRYPTO_P256_PUB_SIZE],
+                                  uint8_t dhkey[XF_BLE_CRYPTO_P256_SIZE])
+{
+    XF_CHECK((priv == NULL) || (peer_pub == NULL) || (dhkey == NULL), XF_ERR_INVALID_ARG,
+             TAG, "priv, peer_pub or dhkey == NULL");
+
+    uint32_t px[P256_WORDS];
+    uint32_t py[P256_WORDS];
+    p256_from_bytes(px, &peer_pub[0]);
+    p256_from_bytes(py, &peer_pub[XF_BLE_CRYPTO_P256_SIZE]);
+    XF_CHECK(!p256_is_on_curve(px, py), XF_ERR_INVALID_ARG, TAG, "invalid peer public key");
+
+    uint32_t k[P256_WORDS];
+    p256_from_bytes(k, priv);
+    if (p256_is_zero(k) || !p256_is_less(k, s_p256_n)) {
+        crypto_wipe(k, sizeof(k));
+        return XF_ERR_INVALID_ARG;
+    }
+    p256_mul(px, px, s_p256_r2);
+    p256_mul(py, py, s_p256_r2);
+    uint32_t x[P256_WORDS];
+    uint32_t y[P256_WORDS];
+    bool is_ok = p256_point_mul(x, y, px, py, k);
+    crypto_wipe(k, sizeof(k));
+    if (!is_ok) {
+        return XF_FAIL;
+    }
+    p256_to_bytes(dhkey, x);
+    crypto_wipe(y, sizeof(y));
+    return XF_OK;
+}
+
+xf_err_t xf_ble_crypto_self_test(void)
+{
+    uint8_t out[XF_BLE_CRYPTO_P256_PUB_SIZE];
+    uint8_t out2[XF_BLE_CRYPTO_KEY_SIZE];
+    uint32_t val = 0;
+    bool is_ok = true;
+
+    xf_ble_crypto_aes_cmac(s_tv_cmac_key, NULL, 0, out);
+    is_ok = is_ok && crypto_is_equal(out, s_tv_cmac_mac0, XF_BLE_CRYPTO_KEY_SIZE);
+    xf_ble_crypto_aes_cmac(s_tv_cmac_key, s_tv_cmac_msg, 16, out);
+    is_ok = is_ok && crypto_is_equal(out, s_tv_cmac_mac16, XF_BLE_CRYPTO_KEY_SIZE);
+    xf_ble_crypto_aes_cmac(s_tv_cmac_key, s_tv_cmac_msg, 40, out);
+    is_ok = is_ok && crypto_is_equal(out, s_tv_cmac_mac40, XF_BLE_CRYPTO_KEY_SIZE);
+    xf_ble_crypto_aes_cmac(s_tv_cmac_key, s_tv_cmac_msg, 64, out);
+    is_ok = is_ok && crypto_is_equal(out, s_tv_cmac_mac64, XF_BLE_CRYPTO_KEY_SIZE);
+
+    /* A1 = 56:12:37:37:BF:CE ， A2 = A7:13:70:2D:CF:C1 ，均为公有地址 */
+    const xf_ble_addr_t a1 = {{0x56, 0x12, 0x37, 0x37, 0xBF, 0xCE}, XF_BLE_ADDR_TYPE_PUBLIC_DEV};
+    const xf_ble_addr_t a2 = {{0xA7, 0x13, 0x70, 0x2D, 0xCF, 0xC1}, XF_BLE_ADDR_TYPE_PUBLIC_DEV};
+    const uint8_t io_cap[3] = {0x01, 0x01, 0x02};
+    xf_ble_crypto_f4(s_tv_pub_a, s_tv_v, s_tv_x, 0, out);
+    is_ok = is_ok && crypto_is_equal(out, s_tv_f4, XF_BLE_CRYPTO_KEY_SIZE);
+    xf_ble_crypto_f5(s_tv_w, s_tv_x, s_tv_y, &a1, &a2, out, out2);
+    is_ok = is_ok && crypto_is_equal(out, s_tv_mac_key, XF_BLE_CRYPTO_KEY_SIZE)
+            && crypto_is_equal(out2, s_tv_ltk, XF_BLE_CRYPTO_KEY_SIZE);
+    xf_ble_crypto_f6(s_tv_mac_key, s_tv_x, s_tv_y, s_tv_r, io_cap, &a1, &a2, out);
+    is_ok = is_ok && crypto_is_equal(out, s_tv_f6, XF_BLE_CRYPTO_KEY_SIZE);
+    xf_ble_crypto_g2(s_tv_pub_a, s_tv_v, s_tv_x, s_tv_y, &val);
+    is_ok = is_ok && (val == 0x2F9ED5BA);
+
+    /* ah: IRK 取 W 的高 16 字节， prand = 0x708194 */
+    xf_ble_crypto_ah(s_tv_w, 0x708194, &val);
+    is_ok = is_ok && (val == 0x0DFBAA);
+
+    /* c1 / s1: k = 0 ， ia = A1:A2:A3:A4:A5:A6 (随机)， ra = B1:B2:B3:B4:B5:B6 (公有) */
+    const uint8_t k0[XF_BLE_CRYPTO_KEY_SIZE] = {0};
+    const uint8_t preq[7] = {0x07, 0x07, 0x10, 0x00, 0x00, 0x01, 0x01};
+    const uint8_t pres[7] = {0x05, 0x00, 0x08, 0x00, 0x00, 0x03, 0x02};
+    const xf_ble_addr_t ia = {{0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6}, XF_BLE_ADDR_TYPE_RANDOM_DEV};
+    const xf_ble_addr_t ra = {{0xB1, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6}, XF_BLE_ADDR_TYPE_PUBLIC_DEV};
+    xf_ble_crypto_c1(k0, s_tv_c1_r, preq, pres, &ia, &ra, out);
+    is_ok = is_ok && crypto_is_equal(out, s_tv_c1, XF_BLE_CRYPTO_KEY_SIZE);
+    xf_ble_crypto_s1(k0, s_tv_s1_r1, s_tv_s1_r2, out);
+    is_ok = is_ok && crypto_is_equal(out, s_tv_s1, XF_BLE_CRYPTO_KEY_SIZE);
+
+    /* P-256: 调试私钥 A 的公钥，及 A 与 B 的 DHKey (即 f5 中的 W) */
+    is_ok = is_ok && (xf_ble_crypto_p256_compute_pub(s_tv_priv_a, out) == XF_OK)
+            && crypto_is_equal(out, s_tv_pub_a, XF_BLE_CRYPTO_P256_PUB_SIZE);
+    is_ok = is_ok && (xf_ble_crypto_p256_dhkey(s_tv_priv_a, s_tv_pub_b, out) == XF_OK)
+            && crypto_is_equal(out, s_tv_w, XF_BLE_CRYPTO_P256_SIZE);
+    /* 不在曲线上的公钥需被拒绝 */
+    xf_memcpy(out, s_tv_pub_b, XF_BLE_CRYPTO_P256_PUB_SIZE);
+    out[XF_BLE_CRYPTO_P256_PUB_SIZE - 1] ^= 0x01;
+    is_ok = is_ok && !xf_ble_crypto_p256_is_valid_pub(out);
+
+    if (!is_ok) {
+        XF_LOGE(TAG, "self test failed");
+        return XF_FAIL;
+    }
+    return XF_OK;
+}
+
+#if XF_BLE_CRYPTO_BENCH_ENABLE
+
+xf_err_t xf_ble_crypto_bench(uint32_t loop_num, uint32_t dhkey_loop_num,
+                             xf_ble_crypto_bench_result_t *result)
+{
+    XF_CHECK(result == NULL, XF_ERR_INVALID_ARG, TAG, "result == NULL");
+    XF_CHECK((loop_num == 0) || (dhkey_loop_num == 0), XF_ERR_INVALID_ARG, TAG, "loop_num == 0");
+
+    uint8_t out[XF_BLE_CRYPTO_P256_SIZE];
+    uint64_t start_us = xf_sys_time_get_us();
+    xf_memcpy(out, s_tv_x, XF_BLE_CRYPTO_KEY_SIZE);
+    for (uint32_t i = 0; i < loop_num; i++) {
+        /* 输出作为下一次的输入，避免循环被优化 */
+        xf_ble_crypto_e(s_tv_y, out, out);
+    }
+    uint64_t e_us = xf_sys_time_get_us() - start_us;
+
+    start_us = xf_sys_time_get_us();
+    for (uint32_t i = 0; i < loop_num; i++) {
+        xf_ble_crypto_f4(s_tv_pub_a, s_tv_v, s_tv_x, out[0], out);
+    }
+    uint64_t f4_us = xf_sys_time_get_us() - start_us;
+
+    start_us = xf_sys_time_get_us();
+    for (uint32_t i = 0; i < dhkey_loop_num; i++) {
+        xf_ble_crypto_p256_dhkey(s_tv_priv_a, s_tv_pub_b, out);
+    }
+    uint64_t dhkey_us = xf_sys_time_get_us() - start_us;
+
+    result->e_ns = (uint32_t)(e_us * 1000 / loop_num);
+    result->f4_ns = (uint32_t)(f4_us * 1000 / loop_num);
+    result->dhkey_ns = (uint32_t)(dhkey_us * 1000 / dhkey_loop_num);
+    XF_LOGI(TAG, "bench: e %u ns, f4 %u ns, dhkey %u ns",
+            (unsigned)result->e_ns, (unsigned)result->f4_ns, (unsigned)result->dhkey_ns);
+    return XF_OK;
+}
+
+#endif /* XF_BLE_CRYPTO_BENCH_ENABLE */
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief AES-CMAC (RFC 4493)
+ */
+static void crypto_cmac(const uint8_t key[XF_BLE_CRYPTO_KEY_SIZE], const uint8_t *msg, uint32_t len,
+                        uint8_t mac[XF_BLE_CRYPTO_KEY_SIZE])
+{
+    xf_ble_aes_ctx_t aes;
+    xf_ble_aes_set_key(&aes, key);
+
+    /* 子密钥: K1 = dbl(E(K, 0)) ， K2 = dbl(K1) */
+    uint8_t k1[XF_BLE_CRYPTO_KEY_SIZE] = {0};
+    xf_ble_aes_encrypt(&aes, k1, k1);
+    crypto_cmac_dbl(k1);
+
+    uint32_t block_num = (len + XF_BLE_CRYPTO_KEY_SIZE - 1) / XF_BLE_CRYPTO_KEY_SIZE;
+    bool is_complete = (block_num > 0) && ((len % XF_BLE_CRYPTO_KEY_SIZE) == 0);
+    block_num = (block_num == 0) ? 1 : block_num;
+
+    uint8_t x[XF_BLE_CRYPTO_KEY_SIZE] = {0};
+    for (uint32_t i = 0; i + 1 < block_num; i++) {
+        for (uint8_t j = 0; j < XF_BLE_CRYPTO_KEY_SIZE; j++) {
+            x[j] ^= msg[XF_BLE_CRYPTO_KEY_SIZE * i + j];
+        }
+        xf_ble_aes_encrypt(&aes, x, x);
+    }
+
+    /* 最后一块: 完整时异或 K1 ，否则填充 10...0 后异或 K2 */
+    uint32_t off = XF_BLE_CRYPTO_KEY_SIZE * (block_num - 1);
+    uint32_t rest = len - off;
+    if (!is_complete) {
+        crypto_cmac_dbl(k1);
+    }
+    for (uint8_t j = 0; j < XF_BLE_CRYPTO_KEY_SIZE; j++) {
+        uint8_t m = (j < rest) ? msg[off + j] : ((j == rest) ? 0x80 : 0x00);
+        x[j] ^= m ^ k1[j];
+    }
+    xf_ble_aes_encrypt(&aes, x, mac);
+
+    crypto_wipe(&aes, sizeof(aes));
+    crypto_wipe(k1, sizeof(k1));
+    crypto_wipe(x, sizeof(x));
+}
+
+/**
+ * @brief GF(2^128) 中乘 x (左移一位，溢出时异或 0x87)
+ */
+static void crypto_cmac_dbl(uint8_t b[XF_BLE_CRYPTO_KEY_SIZE])
+{
+    uint8_t carry = b[0] >> 7;
+    for (uint8_t i = 0; i < XF_BLE_CRYPTO_KEY_SIZE - 1; i++) {
+        b[i] = (uint8_t)((b[i] << 1) | (b[i + 1] >> 7));
+    }
+    b[XF_BLE_CRYPTO_KEY_SIZE - 1] = (uint8_t)((b[XF_BLE_CRYPTO_KEY_SIZE - 1] << 1) ^ (0x87 & (0 - carry)));
+}
+
+/**
+ * @brief 编码 f5 / f6 中的地址: 类型 (1 字节，公有地址为 0 ，其余为 1) || 地址 (6 字节)
+ */
+static uint8_t crypto_addr_encode(const xf_ble_addr_t *addr, uint8_t *buf)
+{
+    buf[0] = (addr->type == XF_BLE_ADDR_TYPE_PUBLIC_DEV) ? 0x00 : 0x01;
+    xf_memcpy(&buf[1], addr->addr, XF_BLE_ADDR_LEN);
+    return 1 + XF_BLE_ADDR_LEN;
+}
+
+/**
+ * @brief 清除敏感数据 (经 volatile 指针写入，避免被优化掉)
+ */
+static void crypto_wipe(void *buf, uint32_t len)
+{
+    volatile uint8_t *p = (volatile uint8_t *)buf;
+    while (len--) {
+        *p++ = 0;
+    }
+}
+
+static bool crypto_is_equal(const uint8_t *a, const uint8_t *b, uint32_t len)
+{
+    uint8_t diff = 0;
+    for (uint32_t i = 0; i < len; i++) {
+        diff |= a[i] ^ b[i];
+    }
+    return diff == 0;
+}
+
+static void p256_from_bytes(uint32_t r[P256_WORDS], const uint8_t b[XF_BLE_CRYPTO_P256_SIZE])
+{
+    for (uint8_t i = 0; i < P256_WORDS; i++) {
+        const uint8_t *p = &b[4 * (P256_WORDS - 1 - i)];
+        r[i] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+    }
+}
+
+static void p256_to_bytes(uint8_t b[XF_BLE_CRYPTO_P256_SIZE], const uint32_t a[P256_WORDS])
+{
+    for (uint8_t i = 0; i < P256_WORDS; i++) {
+        uint8_t *p = &b[4 * (P256_WORDS - 1 - i)];
+        p[0] = (uint8_t)(a[i] >> 24);
+        p[1] = (uint8_t)(a[i] >> 16);
+        p[2] = (uint8_t)(a[i] >> 8);
+        p[3] = (uint8_t)a[i];
+    }
+}
+
+static bool p256_is_zero(const uint32_t a[P256_WORDS])
+{
+    uint32_t v = 0;
+    for (uint8_t i = 0; i < P256_WORDS; i++) {
+        v |= a[i];
+    }
+    return v == 0;
+}
+
+static bool p256_is_less(const uint32_t a[P256_WORDS], const uint32_t m[P256_WORDS])
+{
+    uint32_t borrow = 0;
+    for (uint8_t i = 0; i < P256_WORDS; i++) {
+        uint64_t v = (uint64_t)a[i] - m[i] - borrow;
+        borrow = (uint32_t)(v >> 32) & 1;
+    }
+    return borrow != 0;
+}
+
+/**
+ * @brief r = a + b (不取模)，返回进位
+ */
+static uint32_t p256_add_raw(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS])
+{
+    uint64_t c = 0;
+    for (uint8_t i = 0; i < P256_WORDS; i++) {
+        c += (uint64_t)a[i] + b[i];
+        r[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    return (uint32_t)c;
+}
+
+/**
+ * @brief r = (hi:t) mod p ，要求 (hi:t) < 2p (无分支)
+ */
+static void p256_reduce_once(uint32_t r[P256_WORDS], const uint32_t t[P256_WORDS], uint32_t hi)
+{
+    uint32_t d[P256_WORDS];
+    uint32_t borrow = 0;
+    for (uint8_t i = 0; i < P256_WORDS; i++) {
+        uint64_t v = (uint64_t)t[i] - s_p256_p[i] - borrow;
+        d[i] = (uint32_t)v;
+        borrow = (uint32_t)(v >> 32) & 1;
+    }
+    uint32_t mask = 0 - (hi | (borrow ^ 1));
+    for (uint8_t i = 0; i < P256_WORDS; i++) {
+        r[i] = (d[i] & mask) | (t[i] & ~mask);
+    }
+}
+
+static void p256_add(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS])
+{
+    uint32_t t[P256_WORDS];
+    uint32_t hi = p256_add_raw(t, a, b);
+    p256_reduce_once(r, t, hi);
+}
+
+static void p256_sub(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS])
+{
+    uint32_t t[P256_WORDS];
+    uint32_t borrow = 0;
+    for (uint8_t i = 0; i < P256_WORDS; i++) {
+        uint64_t v = (uint64_t)a[i] - b[i] - borrow;
+        t[i] = (uint32_t)v;
+        borrow = (uint32_t)(v >> 32) & 1;
+    }
+    /* 借位时加回 p */
+    uint32_t mask = 0 - borrow;
+    uint64_t c = 0;
+    for (uint8_t i = 0; i < P256_WORDS; i++) {
+        c += (uint64_t)t[i] + (s_p256_p[i] & mask);
+        r[i] = (uint32_t)c;
+        c >>= 32;
+    }
+}
+
+/**
+ * @brief r = a / 2 mod p (奇数时先加 p)
+ */
+static void p256_half(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS])
+{
+    uint32_t t[P256_WORDS];
+    uint32_t mask = 0 - (a[0] & 1);
+    uint64_t c = 0;
+    for (uint8_t i = 0; i < P256_WORDS; i++) {
+        c += (uint64_t)a[i] + (s_p256_p[i] & mask);
+        t[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    for (uint8_t i = 0; i < P256_WORDS - 1; i++) {
+        r[i] = (t[i] >> 1) | (t[i + 1] << 31);
+    }
+    r[P256_WORDS - 1] = (t[P256_WORDS - 1] >> 1) | ((uint32_t)c << 31);
+}
+
+/**
+ * @brief Montgomery 乘法 r = a * b / 2^256 mod p (CIOS ，32 位字)
+ *
+ * @note p ≡ -1 (mod 2^32) ，故每轮的约简因子 m = -t0 / p = t0 ，无需乘法
+ */
+static void p256_mul(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS])
+{
+    uint32_t t[P256_WORDS + 2] = {0};
+    for (uint8_t i = 0; i < P256_WORDS; i++) {
+        uint64_t c = 0;
+        for (uint8_t j = 0; j < P256_WORDS; j++) {
+            c += (uint64_t)a[j] * b[i] + t[j];
+            t[j] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[P256_WORDS];
+        t[P256_WORDS] = (uint32_t)c;
+        t[P256_WORDS + 1] = (uint32_t)(c >> 32);
+
+        uint32_t m = t[0];
+        c = ((uint64_t)m * s_p256_p[0] + t[0]) >> 32;
+        for (uint8_t j = 1; j < P256_WORDS; j++) {
+            c += (uint64_t)m * s_p256_p[j] + t[j];
+            t[j - 1] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[P256_WORDS];
+        t[P256_WORDS - 1] = (uint32_t)c;
+        t[P256_WORDS] = t[P256_WORDS + 1] + (uint32_t)(c >> 32);
+    }
+    p256_reduce_once(r, t, t[P256_WORDS]);
+}
+
+/**
+ * @brief r = a^-1 = a^(p - 2) mod p (指数公开，逐位平方乘)
+ */
+static void p256_inv(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS])
+{
+    static const uint32_t s_exp[P256_WORDS] = {
+        0xFFFFFFFD, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xFFFFFFFF,
+    };
+    uint32_t t[P256_WORDS];
+    xf_memcpy(t, a, sizeof(t));
+    for (int16_t i = 254; i >= 0; i--) {
+        p256_mul(t, t, t);
+        if ((s_exp[i / 32] >> (i % 32)) & 1) {
+            p256_mul(t, t, a);
+        }
+    }
+    xf_memcpy(r, t, sizeof(t));
+}
+
+static void p256_cswap(uint32_t a[P256_WORDS], uint32_t b[P256_WORDS], uint32_t bit)
+{
+    uint32_t mask = 0 - bit;
+    for (uint8_t i = 0; i < P256_WORDS; i++) {
+        uint32_t t = (a[i] ^ b[i]) & mask;
+        a[i] ^= t;
+        b[i] ^= t;
+    }
+}
+
+/**
+ * @brief (x, y) = (x * z^2, y * z^3)
+ */
+static void p256_apply_z(uint32_t x[P256_WORDS], uint32_t y[P256_WORDS], const uint32_t z[P256_WORDS])
+{
+    uint32_t t[P256_WORDS];
+    p256_mul(t, z, z);
+    p256_mul(x, x, t);
+    p256_mul(t, t, z);
+    p256_mul(y, y, t);
+}
+
+/**
+ * @brief 雅可比坐标倍点 (a = -3)，原地计算
+ */
+static void p256_double_jacobian(uint32_t x1[P256_WORDS], uint32_t y1[P256_WORDS], uint32_t z1[P256_WORDS])
+{
+    uint32_t t4[P256_WORDS];
+    uint32_t t5[P256_WORDS];
+    p256_mul(t4, y1, y1);       /* t4 = y1^2 */
+    p256_mul(t5, x1, t4);       /* t5 = x1 * y1^2 = A */
+    p256_mul(t4, t4, t4);       /* t4 = y1^4 */
+    p256_mul(y1, y1, z1);       /* y1 = y1 * z1 = z3 */
+    p256_mul(z1, z1, z1);       /* z1 = z1^2 */
+
+    p256_add(x1, x1, z1);       /* x1 = x1 + z1^2 */
+    p256_add(z1, z1, z1);       /* z1 = 2 * z1^2 */
+    p256_sub(z1, x1, z1);       /* z1 = x1 - z1^2 */
+    p256_mul(x1, x1, z1);       /* x1 = x1^2 - z1^4 */
+
+    p256_add(z1, x1, x1);       /* z1 = 2 * (x1^2 - z1^4) */
+    p256_add(x1, x1, z1);       /* x1 = 3 * (x1^2 - z1^4) */
+    p256_half(x1, x1);          /* x1 = 3/2 * (x1^2 - z1^4) = B */
+
+    p256_mul(z1, x1, x1);       /* z1 = B^2 */
+    p256_sub(z1, z1, t5);
+    p256_sub(z1, z1, t5);       /* z1 = B^2 - 2A = x3 */
+    p256_sub(t5, t5, z1);       /* t5 = A - x3 */
+    p256_mul(x1, x1, t5);       /* x1 = B * (A - x3) */
+    p256_sub(t4, x1, t4);       /* t4 = B * (A - x3) - y1^4 = y3 */
+
+    xf_memcpy(x1, z1, sizeof(t4));
+    xf_memcpy(z1, y1, sizeof(t4));
+    xf_memcpy(y1, t4, sizeof(t4));
+}
+
+/**
+ * @brief co-Z 加法: 输入 P = (x1, y1) 、 Q = (x2, y2) (Z 相同)，
+ *  输出 P' = (x1, y1) 与 P + Q = (x2, y2) (Z 相同)
+ */
+static void p256_xycz_add(uint32_t x1[P256_WORDS], uint32_t y1[P256_WORDS],
+                          uint32_t x2[P256_WORDS], uint32_t y2[P256_WORDS])
+{
+    uint32_t t5[P256_WORDS];
+    p256_sub(t5, x2, x1);       /* t5 = x2 - x1 */
+    p256_mul(t5, t5, t5);       /* t5 = (x2 - x1)^2 = A */
+    p256_mul(x1, x1, t5);       /* x1 = x1 * A = B */
+    p256_mul(x2, x2, t5);       /* x2 = x2 * A = C */
+    p256_sub(y2, y2, y1);       /* y2 = y2 - y1 */
+    p256_mul(t5, y2, y2);       /* t5 = (y2 - y1)^2 = D */
+
+    p256_sub(t5, t5, x1);       /* t5 = D - B */
+    p256_sub(t5, t5, x2);       /* t5 = D - B - C = x3 */
+    p256_sub(x2, x2, x1);       /* x2 = C - B */
+    p256_mul(y1, y1, x2);       /* y1 = y1 * (C - B) */
+    p256_sub(x2, x1, t5);       /* x2 = B - x3 */
+    p256_mul(y2, y2, x2);       /* y2 = (y2 - y1) * (B - x3) */
+    p256_sub(y2, y2, y1);       /* y2 = y3 */
+
+    xf_memcpy(x2, t5, sizeof(t5));
+}
+
+/**
+ * @brief co-Z 共轭加法: 输入 P = (x1, y1) 、 Q = (x2, y2) (Z 相同)，
+ *  输出 P - Q = (x1, y1) 与 P + Q = (x2, y2) (Z 相同)
+ */
+static void p256_xycz_addc(uint32_t x1[P256_WORDS], uint32_t y1[P256_WORDS],
+                           uint32_t x2[P256_WORDS], uint32_t y2[P256_WORDS])
+{
+    uint32_t t5[P256_WORDS];
+    uint32_t t6[P256_WORDS];
+    uint32_t t7[P256_WORDS];
+    p256_sub(t5, x2, x1);       /* t5 = x2 - x1 */
+    p256_mul(t5, t5, t5);       /* t5 = (x2 - x1)^2 = A */
+    p256_mul(x1, x1, t5);       /* x1 = x1 * A = B */
+    p256_mul(x2, x2, t5);       /* x2 = x2 * A = C */
+    p256_add(t5, y2, y1);       /* t5 = y2 + y1 */
+    p256_sub(y2, y2, y1);       /* y2 = y2 - y1 */
+
+    p256_sub(t6, x2, x1);       /* t6 = C - B */
+    p256_mul(y1, y1, t6);       /* y1 = y1 * (C - B) = E */
+    p256_add(t6, x1, x2);       /* t6 = B + C */
+    p256_mul(x2, y2, y2);       /* x2 = (y2 - y1)^2 = D */
+    p256_sub(x2, x2, t6);       /* x2 = D - (B + C) = x3 */
+
+    p256_sub(t7, x1, x2);       /* t7 = B - x3 */
+    p256_mul(y2, y2, t7);       /* y2 = (y2 - y1) * (B - x3) */
+    p256_sub(y2, y2, y1);       /* y2 = (y2 - y1) * (B - x3) - E = y3 */
+
+    p256_mul(t7, t5, t5);       /* t7 = (y2 + y1)^2 = F */
+    p256_sub(t7, t7, t6);       /* t7 = F - (B + C) = x3' */
+    p256_sub(t6, t7, x1);       /* t6 = x3' - B */
+    p256_mul(t6, t6, t5);       /* t6 = (y2 + y1) * (x3' - B) */
+    p256_sub(y1, t6, y1);       /* y1 = (y2 + y1) * (x3' - B) - E = y3' */
+
+    xf_memcpy(x1, t7, sizeof(t7));
+}
+
+/**
+ * @brief 标量乘法 (rx, ry) = k * (px, py) ，坐标均在 Montgomery 域
+ *
+ * @details k > (n - 1) / 2 时改算 (n - k) * P 后对 y 取负，再规整为 k + 2n 或 k + 3n 中恰为 258 位者
+ *  (结果不变)，使阶梯的迭代次数固定，且中间点不会出现无穷远点或 R0 = ±R1 的例外情形
+ *  (否则 k = 1 、 n - 2 、 n - 1 会失败)；每步按标量位条件交换 R0 、 R1 后执行相同的 co-Z 运算，
+ *  无与密钥相关的分支或访存
+ * @return bool 结果不为无穷远点
+ */
+static bool p256_point_mul(uint32_t rx[P256_WORDS], uint32_t ry[P256_WORDS],
+                           const uint32_t px[P256_WORDS], const uint32_t py[P256_WORDS],
+                           const uint32_t k[P256_WORDS])
+{
+    uint32_t s[P256_WORDS + 1];
+    uint32_t t[P256_WORDS + 1];
+    uint32_t borrow = 0;
+    for (uint8_t i = 0; i < P256_WORDS; i++) {
+        uint64_t v = (uint64_t)s_p256_n[i] - k[i] - borrow;
+        t[i] = (uint32_t)v;
+        borrow = (uint32_t)(v >> 32) & 1;
+    }
+    uint32_t neg = p256_is_less(t, k) ? 1 : 0;
+    xf_memcpy(s, k, P256_WORDS * sizeof(uint32_t));
+    p256_cswap(s, t, neg);
+
+    /* s = k + 2n ， t = k + 3n ，取第 257 位为 1 者 */
+    s[P256_WORDS] = p256_add_raw(s, s, s_p256_n);
+    s[P256_WORDS] += p256_add_raw(s, s, s_p256_n);
+    t[P256_WORDS] = s[P256_WORDS] + p256_add_raw(t, s, s_p256_n);
+    uint32_t mask = 0 - ((s[P256_WORDS] >> 1) ^ 1);
+    for (uint8_t i = 0; i <= P256_WORDS; i++) {
+        s[i] ^= (s[i] ^ t[i]) & mask;
+    }
+
+    uint32_t x[2][P256_WORDS];
+    uint32_t y[2][P256_WORDS];
+    uint32_t z[P256_WORDS] = {0};
+    /* z = 1 (Montgomery 域) = 2^256 - p */
+    z[0] = 1;
+    p256_mul(z, z, s_p256_r2);
+
+    /* R1 = 2P ， R0 = P (co-Z) */
+    xf_memcpy(x[1], px, sizeof(z));
+    xf_memcpy(y[1], py, sizeof(z));
+    xf_memcpy(x[0], px, sizeof(z));
+    xf_memcpy(y[0], py, sizeof(z));
+    p256_double_jacobian(x[1], y[1], z);
+    p256_apply_z(x[0], y[0], z);
+
+    for (int16_t i = 256; i > 0; i--) {
+        uint32_t nb = ((s[i / 32] >> (i % 32)) & 1) ^ 1;
+        p256_cswap(x[0], x[1], nb);
+        p256_cswap(y[0], y[1], nb);
+        p256_xycz_addc(x[1], y[1], x[0], y[0]);
+        p256_xycz_add(x[0], y[0], x[1], y[1]);
+        p256_cswap(x[0], x[1], nb);
+        p256_cswap(y[0], y[1], nb);
+    }
+
+    uint32_t nb = (s[0] & 1) ^ 1;
+    p256_cswap(x[0], x[1], nb);
+    p256_cswap(y[0], y[1], nb);
+    p256_xycz_addc(x[1], y[1], x[0], y[0]);
+    p256_cswap(x[0], x[1], nb);
+    p256_cswap(y[0], y[1], nb);
+
+    /* 1 / Z = Xb * yP / (xP * Yb * (X1 - X0)) ， b = 1 - nb */
+    p256_sub(z, x[1], x[0]);
+    xf_memcpy(t, y[1], sizeof(z));
+    p256_cswap(t, y[0], nb);
+    p256_mul(z, z, t);
+    p256_cswap(t, y[0], nb);
+    p256_mul(z, z, px);
+    p256_inv(z, z);
+    p256_mul(z, z, py);
+    xf_memcpy(t, x[1], sizeof(z));
+    p256_cswap(t, x[0], nb);
+    p256_mul(z, z, t);
+    p256_cswap(t, x[0], nb);
+
+    p256_cswap(x[0], x[1], nb);
+    p256_cswap(y[0], y[1], nb);
+    p256_xycz_add(x[0], y[0], x[1], y[1]);
+    p256_cswap(x[0], x[1], nb);
+    p256_cswap(y[0], y[1], nb);
+    p256_apply_z(x[0], y[0], z);
+
+    /* 转出 Montgomery 域 */
+    xf_memset(t, 0, sizeof(t));
+    t[0] = 1;
+    p256_mul(rx, x[0], t);
+    p256_mul(ry, y[0], t);
+    xf_memset(t, 0, sizeof(t));
+    p256_sub(t, t, ry);
+    p256_cswap(ry, t, neg);
+
+    crypto_wipe(s, sizeof(s));
+    crypto_wipe(t, sizeof(t));
+    crypto_wipe(x, sizeof(x));
+    crypto_wipe(y, sizeof(y));
+    crypto_wipe(z, sizeof(z));
+    return !(p256_is_zero(rx) && p256_is_zero(ry));
+}
+
+/**
+ * @brief 检查 (x, y) (普通域) 是否满足 x, y < p 且 y^2 = x^3 - 3x + b
+ */
+static bool p256_is_on_curve(const uint32_t x[P256_WORDS], const uint32_t y[P256_WORDS])
+{
+    if (!p256_is_less(x, s_p256_p) || !p256_is_less(y, s_p256_p)) {
+        return false;
+    }
+    uint32_t xm[P256_WORDS];
+    uint32_t ym[P256_WORDS];
+    uint32_t l[P256_WORDS];
+    uint32_t r[P256_WORDS];
+    p256_mul(xm, x, s_p256_r2);
+    p256_mul(ym, y, s_p256_r2);
+    p256_mul(l, ym, ym);            /* y^2 */
+    p256_mul(r, xm, xm);
+    p256_mul(r, r, xm);             /* x^3 */
+    p256_sub(r, r, xm);
+    p256_sub(r, r, xm);
+    p256_sub(r, r, xm);             /* x^3 - 3x */
+    p256_mul(xm, s_p256_b, s_p256_r2);
+    p256_add(r, r, xm);             /* x^3 - 3x + b */
+    p256_sub(r, r, l);
+    return p256_is_zero(r);
+}
+
+#endif /* XF_BLE_IS_ENABLE */
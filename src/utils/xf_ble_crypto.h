@@ -0,0 +1,309 @@
+/**
+ * @file xf_ble_crypto.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 安全管理 (SM) 加密工具箱。
+ *  供控制器或协议栈不提供加密功能的平台使用，与密钥相关的运算均为常数时间:
+ *  - AES-128 (安全函数 e)：使用 xf_ble_aes.h 的位切片实现 (无查表)；主机构建可使用 x86 AES-NI
+ *  - AES-CMAC 及 LE 安全连接的 f4 、 f5 、 f6 、 g2 ，传统配对的 c1 、 s1 ，随机地址哈希 ah
+ *  - P-256 ECDH 密钥生成及共享密钥 (DHKey)：32 位字 Montgomery 乘法，
+ *    co-Z Montgomery 阶梯 (标量预先规整为固定位数，条件交换无分支)
+ *
+ * @note 所有多字节参数 (密钥、随机数、地址、公钥坐标等) 均为 MSB 在前，
+ *  与蓝牙核心规范中安全函数的定义一致；空口及 HCI 中为 LSB 在前，对接层需自行转换
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_CRYPTO_H__
+#define __XF_BLE_CRYPTO_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief BLE 加密工具箱: AES-128 分组及密钥长度 (字节)
+ */
+#define XF_BLE_CRYPTO_KEY_SIZE          (16)
+
+/**
+ * @brief BLE 加密工具箱: P-256 私钥、坐标及 DHKey 长度 (字节)
+ */
+#define XF_BLE_CRYPTO_P256_SIZE         (32)
+
+/**
+ * @brief BLE 加密工具箱: P-256 公钥长度 (字节)， X 坐标 || Y 坐标
+ */
+#define XF_BLE_CRYPTO_P256_PUB_SIZE     (64)
+
+/* ==================== [Typedefs] ========================================== */
+
+#if XF_BLE_CRYPTO_BENCH_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @brief BLE 加密工具箱: 性能测试结果 (单次调用的平均耗时，纳秒)
+ */
+typedef struct {
+    uint32_t e_ns;          /*!< 安全函数 e (含密钥扩展) */
+    uint32_t f4_ns;         /*!< f4 (AES-CMAC ， 65 字节消息) */
+    uint32_t dhkey_ns;      /*!< P-256 DHKey (含对端公钥检查) */
+} xf_ble_crypto_bench_result_t;
+
+#endif /* XF_BLE_CRYPTO_BENCH_ENABLE */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE 加密工具箱: 安全函数 e (AES-128 加密)
+ *
+ * @param key 密钥
+ * @param in 明文
+ * @param[out] out 密文，可与 in 相同
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *
+ * @see 蓝牙核心文档 《Core_v5.4》>> Vol 3, Part H >> 2.2.1 Security function e
+ */
+xf_err_t xf_ble_crypto_e(const uint8_t key[XF_BLE_CRYPTO_KEY_SIZE],
+                         const uint8_t in[XF_BLE_CRYPTO_KEY_SIZE], uint8_t out[XF_BLE_CRYPTO_KEY_SIZE]);
+
+/**
+ * @brief BLE 加密工具箱: AES-CMAC (RFC 4493)
+ *
+ * @param key 密钥
+ * @param msg 消息， len 为 0 时可为 NULL
+ * @param len 消息长度
+ * @param[out] mac 消息认证码 (16 字节)
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_ble_crypto_aes_cmac(const uint8_t key[XF_BLE_CRYPTO_KEY_SIZE],
+                                const uint8_t *msg, uint32_t len, uint8_t mac[XF_BLE_CRYPTO_KEY_SIZE]);
+
+/**
+ * @brief BLE 加密工具箱: LE 安全连接确认值生成函数 f4 = AES-CMAC_X(U || V || Z)
+ *
+ * @param u 公钥 X 坐标 (32 字节)
+ * @param v 公钥 X 坐标 (32 字节)
+ * @param x 随机数 (16 字节)
+ * @param z 0 或 passkey 的一位 (0x80 | bit)
+ * @param[out] out 确认值 (16 字节)
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_ble_crypto_f4(const uint8_t u[XF_BLE_CRYPTO_P256_SIZE], const uint8_t v[XF_BLE_CRYPTO_P256_SIZE],
+                          const uint8_t x[XF_BLE_CRYPTO_KEY_SIZE], uint8_t z,
+                          uint8_t out[XF_BLE_CRYPTO_KEY_SIZE]);
+
+/**
+ * @brief BLE 加密工具箱: LE 安全连接密钥生成函数 f5
+ *
+ * @param w DHKey (32 字节)
+ * @param n1 随机数 (16 字节)
+ * @param n2 随机数 (16 字节)
+ * @param a1 地址 (公有地址类型值为 0 ，其余为 1)
+ * @param a2 地址 (公有地址类型值为 0 ，其余为 1)
+ * @param[out] mac_key MacKey (16 字节)
+ * @param[out] ltk LTK (16 字节)
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_ble_crypto_f5(const uint8_t w[XF_BLE_CRYPTO_P256_SIZE],
+                          const uint8_t n1[XF_BLE_CRYPTO_KEY_SIZE], const uint8_t n2[XF_BLE_CRYPTO_KEY_SIZE],
+                          const xf_ble_addr_t *a1, const xf_ble_addr_t *a2,
+                          uint8_t mac_key[XF_BLE_CRYPTO_KEY_SIZE], uint8_t ltk[XF_BLE_CRYPTO_KEY_SIZE]);
+
+/**
+ * @brief BLE 加密工具箱: LE 安全连接检查值生成函数 f6 = AES-CMAC_W(N1 || N2 || R || IOcap || A1 || A2)
+ *
+ * @param w MacKey (16 字节)
+ * @param n1 随机数 (16 字节)
+ * @param n2 随机数 (16 字节)
+ * @param r 随机数或 passkey / OOB 值 (16 字节)
+ * @param io_cap IO 能力 (3 字节: AuthReq || OOB 标志 || IO 能力)
+ * @param a1 地址
+ * @param a2 地址
+ * @param[out] out 检查值 (16 字节)
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_ble_crypto_f6(const uint8_t w[XF_BLE_CRYPTO_KEY_SIZE],
+                          const uint8_t n1[XF_BLE_CRYPTO_KEY_SIZE], const uint8_t n2[XF_BLE_CRYPTO_KEY_SIZE],
+                          const uint8_t r[XF_BLE_CRYPTO_KEY_SIZE], const uint8_t io_cap[3],
+                          const xf_ble_addr_t *a1, const xf_ble_addr_t *a2,
+                          uint8_t out[XF_BLE_CRYPTO_KEY_SIZE]);
+
+/**
+ * @brief BLE 加密工具箱: LE 安全连接数值比较值生成函数 g2
+ *
+ * @param u 公钥 X 坐标 (32 字节)
+ * @param v 公钥 X 坐标 (32 字节)
+ * @param x 随机数 (16 字节)
+ * @param y 随机数 (16 字节)
+ * @param[out] val 32 位结果，显示的比较值为 val % 1000000
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_ble_crypto_g2(const uint8_t u[XF_BLE_CRYPTO_P256_SIZE], const uint8_t v[XF_BLE_CRYPTO_P256_SIZE],
+                          const uint8_t x[XF_BLE_CRYPTO_KEY_SIZE], const uint8_t y[XF_BLE_CRYPTO_KEY_SIZE],
+                          uint32_t *val);
+
+/**
+ * @brief BLE 加密工具箱: 随机地址哈希函数 ah (常数时间；批量解析 RPA 见 xf_ble_rpa_resolve())
+ *
+ * @param irk IRK (16 字节)
+ * @param prand 24 位随机数 (低 24 位有效)
+ * @param[out] hash 24 位哈希值
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_ble_crypto_ah(const uint8_t irk[XF_BLE_CRYPTO_KEY_SIZE], uint32_t prand, uint32_t *hash);
+
+/**
+ * @brief BLE 加密工具箱: 传统配对确认值生成函数 c1
+ *
+ * @param k TK (16 字节)
+ * @param r 随机数 (16 字节)
+ * @param preq 配对请求命令 (7 字节)
+ * @param pres 配对响应命令 (7 字节)
+ * @param ia 发起方地址 (公有地址类型值为 0 ，其余为 1)
+ * @param ra 响应方地址
+ * @param[out] out 确认值 (16 字节)
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_ble_crypto_c1(const uint8_t k[XF_BLE_CRYPTO_KEY_SIZE], const uint8_t r[XF_BLE_CRYPTO_KEY_SIZE],
+                          const uint8_t preq[7], const uint8_t pres[7],
+                          const xf_ble_addr_t *ia, const xf_ble_addr_t *ra,
+                          uint8_t out[XF_BLE_CRYPTO_KEY_SIZE]);
+
+/**
+ * @brief BLE 加密工具箱: 传统配对 STK 生成函数 s1
+ *
+ * @param k TK (16 字节)
+ * @param r1 随机数 (16 字节)
+ * @param r2 随机数 (16 字节)
+ * @param[out] out STK (16 字节)
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_ble_crypto_s1(const uint8_t k[XF_BLE_CRYPTO_KEY_SIZE], const uint8_t r1[XF_BLE_CRYPTO_KEY_SIZE],
+                          const uint8_t r2[XF_BLE_CRYPTO_KEY_SIZE], uint8_t out[XF_BLE_CRYPTO_KEY_SIZE]);
+
+/**
+ * @brief BLE 加密工具箱: 生成 P-256 密钥对 (随机数取自 xf_ble_gap_get_rand())
+ *
+ * @param[out] priv 私钥 (32 字节)
+ * @param[out] pub 公钥 (64 字节)
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - (OTHER)               获取随机数失败
+ */
+xf_err_t xf_ble_crypto_p256_gen_key(uint8_t priv[XF_BLE_CRYPTO_P256_SIZE],
+                                    uint8_t pub[XF_BLE_CRYPTO_P256_PUB_SIZE]);
+
+/**
+ * @brief BLE 加密工具箱: 由 P-256 私钥计算公钥 (如使用调试密钥时)
+ *
+ * @param priv 私钥 (32 字节，取值 [1, n - 1])
+ * @param[out] pub 公钥 (64 字节)
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_ble_crypto_p256_compute_pub(const uint8_t priv[XF_BLE_CRYPTO_P256_SIZE],
+                                        uint8_t pub[XF_BLE_CRYPTO_P256_PUB_SIZE]);
+
+/**
+ * @brief BLE 加密工具箱: 检查 P-256 公钥是否在曲线上
+ *
+ * @param pub 公钥 (64 字节)
+ * @return bool 是否有效
+ */
+bool xf_ble_crypto_p256_is_valid_pub(const uint8_t pub[XF_BLE_CRYPTO_P256_PUB_SIZE]);
+
+/**
+ * @brief BLE 加密工具箱: 计算 P-256 ECDH 共享密钥 (DHKey)
+ *
+ * @param priv 本端私钥 (32 字节)
+ * @param peer_pub 对端公钥 (64 字节)，先检查是否在曲线上 (防止无效曲线攻击)
+ * @param[out] dhkey DHKey (32 字节，共享点的 X 坐标)
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数 (含对端公钥无效)
+ */
+xf_err_t xf_ble_crypto_p256_dhkey(const uint8_t priv[XF_BLE_CRYPTO_P256_SIZE],
+                                  const uint8_t peer_pub[XF_BLE_CRYPTO_P256_PUB_SIZE],
+                                  uint8_t dhkey[XF_BLE_CRYPTO_P256_SIZE]);
+
+/**
+ * @brief BLE 加密工具箱: 自检，以蓝牙核心规范及 RFC 4493 中的示例数据验证所有函数
+ *
+ * @note 含两次 P-256 标量乘法，耗时较长，建议仅在启动或调试时调用
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               结果与示例数据不一致
+ */
+xf_err_t xf_ble_crypto_self_test(void);
+
+#if XF_BLE_CRYPTO_BENCH_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @brief BLE 加密工具箱: 性能测试，以示例数据分别循环调用 e 、 f4 及 DHKey 并计时
+ *
+ * @note 由 XF_BLE_CRYPTO_BENCH_ENABLE 开启；阻塞执行，计时使用 xf_sys_time_get_us() ，
+ *  耗时约为 loop_num 次 e 与 f4 加上 dhkey_loop_num 次 DHKey
+ * @param loop_num e 及 f4 的调用次数
+ * @param dhkey_loop_num DHKey 的调用次数
+ * @param[out] result 结果，见 @ref xf_ble_crypto_bench_result_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数 (次数为 0)
+ */
+xf_err_t xf_ble_crypto_bench(uint32_t loop_num, uint32_t dhkey_loop_num,
+                             xf_ble_crypto_bench_result_t *result);
+
+#endif /* XF_BLE_CRYPTO_BENCH_ENABLE */
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_CRYPTO_H__ */
@@ -0,0 +1,268 @@
+/**
+ * @file xf_ble_evt_disp.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 事件分发器 (多订阅者)。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_ble_trace.h"
+#include "xf_ble_evt_disp.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_evt_disp"
+
+#if (_XF_BLE_GAP_EVT_MAX > 32) || (_XF_BLE_GATTS_EVT_MAX > 32) || (_XF_BLE_GATTC_EVT_MAX > 32)
+#error "xf_ble_evt_mask_t is too narrow for the event enum"
+#endif
+
+#if XF_BLE_EVT_DISP_HANDLER_MAX >= XF_BLE_EVT_DISP_ID_INVALID
+#error "XF_BLE_EVT_DISP_HANDLER_MAX is too large"
+#endif
+
+/* 所有模块的事件在处理函数链表中连续排列: GAP | GATTS | GATTC */
+#define DISP_CHAIN_OFFSET_GAP       (0)
+#define DISP_CHAIN_OFFSET_GATTS     (DISP_CHAIN_OFFSET_GAP + _XF_BLE_GAP_EVT_MAX)
+#define DISP_CHAIN_OFFSET_GATTC     (DISP_CHAIN_OFFSET_GATTS + _XF_BLE_GATTS_EVT_MAX)
+#define DISP_CHAIN_NUM              (DISP_CHAIN_OFFSET_GATTC + _XF_BLE_GATTC_EVT_MAX)
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef uint8_t disp_type_t;
+enum {
+    DISP_TYPE_GAP = 0,
+    DISP_TYPE_GATTS,
+    DISP_TYPE_GATTC,
+    _DISP_TYPE_MAX,
+};
+
+typedef struct {
+    bool is_used;
+    disp_type_t type;
+    uint8_t priority;
+    uint32_t seq;                           /*!< 注册序号，相同优先级按此排序 */
+    xf_ble_evt_mask_t events;
+    union {
+        xf_ble_evt_disp_gap_cb_t gap;
+        xf_ble_evt_disp_gatts_cb_t gatts;
+        xf_ble_evt_disp_gattc_cb_t gattc;
+    } cb;
+    void *user_data;
+} disp_handler_t;
+
+/**
+ * @brief 单个事件的处理函数链表 (预先按优先级排序的处理函数下标)
+ */
+typedef struct {
+    uint8_t cnt;
+    uint8_t index_set[XF_BLE_EVT_DISP_HANDLER_MAX];
+} disp_chain_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static xf_err_t disp_register(disp_type_t type, const void *cb, xf_ble_evt_mask_t events,
+                              uint8_t priority, void *user_data, xf_ble_evt_disp_id_t *id);
+static xf_ble_evt_res_t disp_dispatch(disp_type_t type, uint8_t event, void *param);
+static void disp_chain_rebuild(disp_type_t type);
+static bool disp_handler_is_before(const disp_handler_t *a, const disp_handler_t *b);
+
+/* ==================== [Static Variables] ================================== */
+
+static disp_handler_t s_disp_handler_set[XF_BLE_EVT_DISP_HANDLER_MAX] = {0};
+static disp_chain_t s_disp_chain_set[DISP_CHAIN_NUM] = {0};
+static uint32_t s_disp_seq = 0;
+
+static const uint8_t s_disp_chain_offset[_DISP_TYPE_MAX] = {
+    DISP_CHAIN_OFFSET_GAP, DISP_CHAIN_OFFSET_GATTS, DISP_CHAIN_OFFSET_GATTC,
+};
+static const uint8_t s_disp_evt_num[_DISP_TYPE_MAX] = {
+    _XF_BLE_GAP_EVT_MAX, _XF_BLE_GATTS_EVT_MAX, _XF_BLE_GATTC_EVT_MAX,
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_ble_evt_disp_gap_register(
+    xf_ble_evt_disp_gap_cb_t cb, xf_ble_evt_mask_t events,
+    uint8_t priority, void *user_data, xf_ble_evt_disp_id_t *id)
+{
+    XF_ASSERT(cb != NULL, XF_ERR_INVALID_ARG, TAG, "cb == NULL");
+    disp_handler_t handler = {.cb.gap = cb};
+    return disp_register(DISP_TYPE_GAP, &handler.cb, events, priority, user_data, id);
+}
+
+xf_err_t xf_ble_evt_disp_gatts_register(
+    xf_ble_evt_disp_gatts_cb_t cb, xf_ble_evt_mask_t events,
+    uint8_t priority, void *user_data, xf_ble_evt_disp_id_t *id)
+{
+    XF_ASSERT(cb != NULL, XF_ERR_INVALID_ARG, TAG, "cb == NULL");
+    disp_handler_t handler = {.cb.gatts = cb};
+    return disp_register(DISP_TYPE_GATTS, &handler.cb, events, priority, user_data, id);
+}
+
+xf_err_t xf_ble_evt_disp_gattc_register(
+    xf_ble_evt_disp_gattc_cb_t cb, xf_ble_evt_mask_t events,
+    uint8_t priority, void *user_data, xf_ble_evt_disp_id_t *id)
+{
+    XF_ASSERT(cb != NULL, XF_ERR_INVALID_ARG, TAG, "cb == NULL");
+    disp_handler_t handler = {.cb.gattc = cb};
+    return disp_register(DISP_TYPE_GATTC, &handler.cb, events, priority, user_data, id);
+}
+
+xf_err_t xf_ble_evt_disp_unregister(xf_ble_evt_disp_id_t id)
+{
+    XF_CHECK((id >= XF_BLE_EVT_DISP_HANDLER_MAX) || !s_disp_handler_set[id].is_used,
+             XF_ERR_NOT_FOUND, TAG, "handler(%d) not registered", id);
+
+    XF_BLE_ENTER_CRITICAL();
+    disp_type_t type = s_disp_handler_set[id].type;
+    xf_memset(&s_disp_handler_set[id], 0, sizeof(disp_handler_t));
+    disp_chain_rebuild(type);
+    XF_BLE_EXIT_CRITICAL();
+    return XF_OK;
+}
+
+xf_ble_evt_res_t xf_ble_evt_disp_gap_event_cb(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param)
+{
+    return disp_dispatch(DISP_TYPE_GAP, event, param);
+}
+
+xf_ble_evt_res_t xf_ble_evt_disp_gatts_event_cb(
+    xf_ble_gatts_evt_t event,
+    xf_ble_gatts_evt_cb_param_t *param)
+{
+    return disp_dispatch(DISP_TYPE_GATTS, event, param);
+}
+
+xf_ble_evt_res_t xf_ble_evt_disp_gattc_event_cb(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param)
+{
+    return disp_dispatch(DISP_TYPE_GATTC, event, param);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static xf_err_t disp_register(disp_type_t type, const void *cb, xf_ble_evt_mask_t events,
+                              uint8_t priority, void *user_data, xf_ble_evt_disp_id_t *id)
+{
+    xf_ble_evt_disp_id_t index = XF_BLE_EVT_DISP_ID_INVALID;
+
+    XF_BLE_ENTER_CRITICAL();
+    for (uint8_t i = 0; i < XF_BLE_EVT_DISP_HANDLER_MAX; i++) {
+        if (!s_disp_handler_set[i].is_used) {
+            index = i;
+            break;
+        }
+    }
+    if (index != XF_BLE_EVT_DISP_ID_INVALID) {
+        disp_handler_t *handler = &s_disp_handler_set[index];
+        handler->is_used = true;
+        handler->type = type;
+        handler->priority = priority;
+        handler->seq = s_disp_seq++;
+        handler->events = events;
+        xf_memcpy(&handler->cb, cb, sizeof(handler->cb));
+        handler->user_data = user_data;
+        disp_chain_rebuild(type);
+    }
+    XF_BLE_EXIT_CRITICAL();
+
+    XF_CHECK(index == XF_BLE_EVT_DISP_ID_INVALID, XF_ERR_NO_MEM, TAG,
+             "handler num reached max: %d", XF_BLE_EVT_DISP_HANDLER_MAX);
+    if (id != NULL) {
+        *id = index;
+    }
+    return XF_OK;
+}
+
+static xf_ble_evt_res_t disp_dispatch(disp_type_t type, uint8_t event, void *param)
+{
+    if (event >= s_disp_evt_num[type]) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+
+    /* 拷贝链表，允许处理函数中注册、注销 */
+    disp_chain_t chain;
+    XF_BLE_ENTER_CRITICAL();
+    chain = s_disp_chain_set[s_disp_chain_offset[type] + event];
+    XF_BLE_EXIT_CRITICAL();
+
+    /* 追踪模块的事件类型与 disp_type_t 顺序相同 */
+    XF_BLE_TRACE_EVT_ENTER(XF_BLE_TRACE_MODULE_GAP + type, event, param);
+    xf_ble_evt_res_t res = XF_BLE_EVT_RES_NOT_HANDLED;
+    for (uint8_t i = 0; i < chain.cnt; i++) {
+        disp_handler_t handler = s_disp_handler_set[chain.index_set[i]];
+        if (!handler.is_used || (handler.type != type)) {
+            continue;   /* 分发过程中已被注销 */
+        }
+        xf_ble_evt_res_t ret;
+        switch (type) {
+        case DISP_TYPE_GAP:
+            ret = handler.cb.gap(event, param, handler.user_data);
+            break;
+        case DISP_TYPE_GATTS:
+            ret = handler.cb.gatts(event, param, handler.user_data);
+            break;
+        default:
+            ret = handler.cb.gattc(event, param, handler.user_data);
+            break;
+        }
+        if (ret == XF_BLE_EVT_RES_HANDLED) {
+            res = XF_BLE_EVT_RES_HANDLED;
+            break;
+        }
+        if (ret == XF_BLE_EVT_RES_ERR) {
+            res = XF_BLE_EVT_RES_ERR;
+        }
+    }
+    XF_BLE_TRACE_EVT_EXIT(XF_BLE_TRACE_MODULE_GAP + type, event, param, res);
+    return res;
+}
+
+/**
+ * @brief 重建指定模块所有事件的处理函数链表 (需在临界区内调用)
+ */
+static void disp_chain_rebuild(disp_type_t type)
+{
+    for (uint8_t event = 0; event < s_disp_evt_num[type]; event++) {
+        disp_chain_t *chain = &s_disp_chain_set[s_disp_chain_offset[type] + event];
+        chain->cnt = 0;
+        for (uint8_t i = 0; i < XF_BLE_EVT_DISP_HANDLER_MAX; i++) {
+            const disp_handler_t *handler = &s_disp_handler_set[i];
+            if (!handler->is_used || (handler->type != type)
+                    || !(handler->events & XF_BLE_EVT_MASK(event))) {
+                continue;
+            }
+            /* 插入排序 */
+            uint8_t pos = chain->cnt;
+            while ((pos > 0)
+                    && disp_handler_is_before(handler, &s_disp_handler_set[chain->index_set[pos - 1]])) {
+                chain->index_set[pos] = chain->index_set[pos - 1];
+                --pos;
+            }
+            chain->index_set[pos] = i;
+            ++chain->cnt;
+        }
+    }
+}
+
+static bool disp_handler_is_before(const disp_handler_t *a, const disp_handler_t *b)
+{
+    if (a->priority != b->priority) {
+        return a->priority < b->priority;
+    }
+    return (int32_t)(a->seq - b->seq) < 0;
+}
+
+#endif /* XF_BLE_IS_ENABLE */
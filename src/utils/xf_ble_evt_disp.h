@@ -0,0 +1,193 @@
+/**
+ * @file xf_ble_evt_disp.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 事件分发器 (多订阅者)。
+ *  各模块 (如电池服务、设备信息服务、厂商服务) 可各自注册处理函数，
+ *  按事件掩码过滤、按优先级依次调用，任一处理函数返回已处理即停止。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_EVT_DISP_H__
+#define __XF_BLE_EVT_DISP_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gap_types.h"
+#include "xf_ble_gatt_server_types.h"
+#include "xf_ble_gatt_client_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief BLE 事件分发器无效的处理函数 ID
+ */
+#define XF_BLE_EVT_DISP_ID_INVALID  (0xFF)
+
+/**
+ * @brief BLE 事件掩码: 全部事件
+ */
+#define XF_BLE_EVT_MASK_ALL         (~(xf_ble_evt_mask_t)0)
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE 事件分发器的处理函数 ID
+ */
+typedef uint8_t xf_ble_evt_disp_id_t;
+
+/**
+ * @brief BLE 事件掩码，每个事件占一位，见 XF_BLE_EVT_MASK()
+ */
+typedef uint32_t xf_ble_evt_mask_t;
+
+/**
+ * @brief BLE 事件分发器 GAP 事件处理函数原型
+ *
+ * @param event 事件，见 @ref xf_ble_gap_evt_t
+ * @param param 事件回调参数，见 @ref xf_ble_gap_evt_cb_param_t
+ * @param user_data 注册时传入的用户数据
+ * @return xf_ble_evt_res_t 事件处理结果，返回 XF_BLE_EVT_RES_HANDLED 时不再调用后续的处理函数
+ */
+typedef xf_ble_evt_res_t (*xf_ble_evt_disp_gap_cb_t)(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param,
+    void *user_data);
+
+/**
+ * @brief BLE 事件分发器 GATTS 事件处理函数原型
+ *
+ * @note 同 xf_ble_evt_disp_gap_cb_t
+ */
+typedef xf_ble_evt_res_t (*xf_ble_evt_disp_gatts_cb_t)(
+    xf_ble_gatts_evt_t event,
+    xf_ble_gatts_evt_cb_param_t *param,
+    void *user_data);
+
+/**
+ * @brief BLE 事件分发器 GATTC 事件处理函数原型
+ *
+ * @note 同 xf_ble_evt_disp_gap_cb_t
+ */
+typedef xf_ble_evt_res_t (*xf_ble_evt_disp_gattc_cb_t)(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param,
+    void *user_data);
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE 事件分发器注册 GAP 事件处理函数
+ *
+ * @param cb 处理函数，见 @ref xf_ble_evt_disp_gap_cb_t
+ * @param events 关注的事件掩码，如 XF_BLE_EVT_MASK(XF_BLE_GAP_EVT_CONNECT) ，
+ *  或 XF_BLE_EVT_MASK_ALL
+ * @param priority 优先级，数值越小越先调用，相同优先级按注册顺序调用
+ * @param user_data 用户数据，调用处理函数时传入
+ * @param[out] id 处理函数 ID ，用于注销，可为 NULL
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NO_MEM         处理函数数量已达上限 XF_BLE_EVT_DISP_HANDLER_MAX
+ */
+xf_err_t xf_ble_evt_disp_gap_register(
+    xf_ble_evt_disp_gap_cb_t cb, xf_ble_evt_mask_t events,
+    uint8_t priority, void *user_data, xf_ble_evt_disp_id_t *id);
+
+/**
+ * @brief BLE 事件分发器注册 GATTS 事件处理函数
+ *
+ * @note 同 xf_ble_evt_disp_gap_register()
+ */
+xf_err_t xf_ble_evt_disp_gatts_register(
+    xf_ble_evt_disp_gatts_cb_t cb, xf_ble_evt_mask_t events,
+    uint8_t priority, void *user_data, xf_ble_evt_disp_id_t *id);
+
+/**
+ * @brief BLE 事件分发器注册 GATTC 事件处理函数
+ *
+ * @note 同 xf_ble_evt_disp_gap_register()
+ */
+xf_err_t xf_ble_evt_disp_gattc_register(
+    xf_ble_evt_disp_gattc_cb_t cb, xf_ble_evt_mask_t events,
+    uint8_t priority, void *user_data, xf_ble_evt_disp_id_t *id);
+
+/**
+ * @brief BLE 事件分发器注销处理函数
+ *
+ * @note 可在处理函数中调用，本次分发中尚未调用的已注销处理函数不会再被调用
+ * @param id 处理函数 ID
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      未注册
+ */
+xf_err_t xf_ble_evt_disp_unregister(xf_ble_evt_disp_id_t id);
+
+/**
+ * @brief BLE 事件分发器的 GAP 事件回调 (分发)
+ *
+ * @note 注册为协议栈的 GAP 事件回调 (见 xf_ble_gap_event_cb_register() )，
+ *  或作为事件队列的处理函数 (见 xf_ble_evtq_set_handlers() )
+ * @return xf_ble_evt_res_t 有处理函数返回已处理时为 XF_BLE_EVT_RES_HANDLED ，
+ *  否则有处理函数返回错误时为 XF_BLE_EVT_RES_ERR ，否则为 XF_BLE_EVT_RES_NOT_HANDLED
+ */
+xf_ble_evt_res_t xf_ble_evt_disp_gap_event_cb(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param);
+
+/**
+ * @brief BLE 事件分发器的 GATTS 事件回调 (分发)
+ *
+ * @note 同 xf_ble_evt_disp_gap_event_cb()
+ */
+xf_ble_evt_res_t xf_ble_evt_disp_gatts_event_cb(
+    xf_ble_gatts_evt_t event,
+    xf_ble_gatts_evt_cb_param_t *param);
+
+/**
+ * @brief BLE 事件分发器的 GATTC 事件回调 (分发)
+ *
+ * @note 同 xf_ble_evt_disp_gap_event_cb()
+ */
+xf_ble_evt_res_t xf_ble_evt_disp_gattc_event_cb(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param);
+
+/* ==================== [Macros] ============================================ */
+
+/**
+ * @brief BLE 事件掩码: 单个事件
+ *
+ * @param evt 事件，如 XF_BLE_GAP_EVT_CONNECT
+ */
+#define XF_BLE_EVT_MASK(evt)        ((xf_ble_evt_mask_t)1 << (evt))
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_EVT_DISP_H__ */
@@ -0,0 +1,419 @@
+/**
+ * @file xf_ble_evtq.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 事件队列 (延迟分发)。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_ble_pbuf.h"
+#include "xf_ble_trace.h"
+#include "xf_ble_evtq.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_evtq"
+
+#if (XF_BLE_EVTQ_DEPTH & (XF_BLE_EVTQ_DEPTH - 1)) != 0
+#error "XF_BLE_EVTQ_DEPTH must be a power of 2"
+#endif
+
+#if (XF_BLE_EVTQ_LANE_NUM == 0) || (XF_BLE_EVTQ_LANE_NUM >= XF_BLE_EVTQ_LANE_DIRECT)
+#error "invalid XF_BLE_EVTQ_LANE_NUM"
+#endif
+
+#define EVTQ_MASK               (XF_BLE_EVTQ_DEPTH - 1)
+
+/* 通道映射表中的值: 0 表示使用默认通道，其余为 通道 + 1 或 XF_BLE_EVTQ_LANE_DIRECT */
+#define EVTQ_LANE_MAP_DEFAULT   (0)
+
+/* 环形队列下标的原子访问，生产者 release 发布，消费者 acquire 读取 */
+#define EVTQ_LOAD_ACQ(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define EVTQ_STORE_REL(p, v)    __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define EVTQ_CAS(p, expect, v)  __atomic_compare_exchange_n((p), (expect), (v), false, \
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct {
+    xf_ble_evtq_type_t type;
+    uint8_t event;
+    bool has_addr;
+    bool has_data;
+    bool has_pbuf;                              /*!< 数据位于持有的 pbuf 中，未拷贝 */
+    uint16_t data_len;
+    union {
+        xf_ble_gap_evt_cb_param_t gap;
+        xf_ble_gatts_evt_cb_param_t gatts;
+        xf_ble_gattc_evt_cb_param_t gattc;
+    } param;
+    xf_ble_addr_t addr;                         /*!< param 中 addr 指向的数据的拷贝 */
+    uint8_t data[XF_BLE_EVTQ_PAYLOAD_MAX];      /*!< param 中 value 等指向的数据的拷贝 */
+} evtq_item_t;
+
+/**
+ * @brief 事件参数中指针成员的位置
+ */
+typedef struct {
+    xf_ble_addr_t **addr;
+    void **data;
+    uint16_t data_len;
+    xf_ble_pbuf_t **pbuf;
+} evtq_ref_t;
+
+typedef struct {
+    uint32_t head;                              /*!< 仅生产者写 */
+    uint32_t tail;                              /*!< 消费者 CAS 推进 */
+    uint32_t push_cnt;
+    uint32_t drop_cnt;
+    uint16_t max_depth;
+    evtq_item_t item_set[XF_BLE_EVTQ_DEPTH];
+} evtq_lane_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static xf_ble_evt_res_t evtq_push(xf_ble_evtq_type_t type, uint8_t event, const void *param);
+static bool evtq_pop(evtq_lane_t *lane, evtq_item_t *item);
+static xf_ble_evt_res_t evtq_dispatch(evtq_item_t *item);
+static void evtq_item_ref_get(evtq_item_t *item, evtq_ref_t *ref);
+static uint8_t evtq_lane_get(xf_ble_evtq_type_t type, uint8_t event);
+static uint8_t *evtq_lane_map_get(xf_ble_evtq_type_t type, uint8_t event);
+
+/* ==================== [Static Variables] ================================== */
+
+static evtq_lane_t s_evtq_lane_set[XF_BLE_EVTQ_LANE_NUM] = {0};
+
+static uint8_t s_evtq_lane_map_gap[_XF_BLE_GAP_EVT_MAX] = {0};
+static uint8_t s_evtq_lane_map_gatts[_XF_BLE_GATTS_EVT_MAX] = {0};
+static uint8_t s_evtq_lane_map_gattc[_XF_BLE_GATTC_EVT_MAX] = {0};
+
+static xf_ble_gap_evt_cb_t s_evtq_gap_cb = NULL;
+static xf_ble_gatts_evt_cb_t s_evtq_gatts_cb = NULL;
+static xf_ble_gattc_evt_cb_t s_evtq_gattc_cb = NULL;
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void xf_ble_evtq_set_handlers(
+    xf_ble_gap_evt_cb_t gap_cb,
+    xf_ble_gatts_evt_cb_t gatts_cb,
+    xf_ble_gattc_evt_cb_t gattc_cb)
+{
+    s_evtq_gap_cb = gap_cb;
+    s_evtq_gatts_cb = gatts_cb;
+    s_evtq_gattc_cb = gattc_cb;
+}
+
+xf_err_t xf_ble_evtq_set_lane(xf_ble_evtq_type_t type, uint8_t event, uint8_t lane)
+{
+    uint8_t *map = evtq_lane_map_get(type, event);
+    XF_CHECK(map == NULL, XF_ERR_INVALID_ARG, TAG, "invalid event: %d-%d", type, event);
+    XF_CHECK((lane >= XF_BLE_EVTQ_LANE_NUM) && (lane != XF_BLE_EVTQ_LANE_DIRECT),
+             XF_ERR_INVALID_ARG, TAG, "invalid lane: %d", lane);
+    *map = (lane == XF_BLE_EVTQ_LANE_DIRECT) ? XF_BLE_EVTQ_LANE_DIRECT : (uint8_t)(lane + 1);
+    return XF_OK;
+}
+
+xf_ble_evt_res_t xf_ble_evtq_gap_event_cb(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param)
+{
+    xf_ble_evt_res_t res = evtq_push(XF_BLE_EVTQ_TYPE_GAP, event, param);
+    XF_BLE_TRACE_EVT_QUEUE(XF_BLE_TRACE_MODULE_GAP, event, param, res);
+    return res;
+}
+
+xf_ble_evt_res_t xf_ble_evtq_gatts_event_cb(
+    xf_ble_gatts_evt_t event,
+    xf_ble_gatts_evt_cb_param_t *param)
+{
+    xf_ble_evt_res_t res = evtq_push(XF_BLE_EVTQ_TYPE_GATTS, event, param);
+    XF_BLE_TRACE_EVT_QUEUE(XF_BLE_TRACE_MODULE_GATTS, event, param, res);
+    return res;
+}
+
+xf_ble_evt_res_t xf_ble_evtq_gattc_event_cb(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param)
+{
+    xf_ble_evt_res_t res = evtq_push(XF_BLE_EVTQ_TYPE_GATTC, event, param);
+    XF_BLE_TRACE_EVT_QUEUE(XF_BLE_TRACE_MODULE_GATTC, event, param, res);
+    return res;
+}
+
+uint16_t xf_ble_evtq_process(uint16_t max_cnt)
+{
+    uint16_t cnt = 0;
+    evtq_item_t item;
+
+    while ((max_cnt == 0) || (cnt < max_cnt)) {
+        bool is_popped = false;
+        /* 每次都从最高优先级通道开始取 */
+        for (uint8_t i = 0; i < XF_BLE_EVTQ_LANE_NUM; i++) {
+            if (evtq_pop(&s_evtq_lane_set[i], &item)) {
+                is_popped = true;
+                break;
+            }
+        }
+        if (!is_popped) {
+            break;
+        }
+        evtq_dispatch(&item);
+        if (item.has_pbuf) {
+            evtq_ref_t ref;
+            evtq_item_ref_get(&item, &ref);
+            xf_ble_pbuf_release(*ref.pbuf);
+        }
+        ++cnt;
+    }
+    return cnt;
+}
+
+xf_err_t xf_ble_evtq_get_stats(uint8_t lane, xf_ble_evtq_stats_t *stats)
+{
+    XF_ASSERT(lane < XF_BLE_EVTQ_LANE_NUM, XF_ERR_INVALID_ARG, TAG, "invalid lane: %d", lane);
+    XF_ASSERT(stats != NULL, XF_ERR_INVALID_ARG, TAG, "stats == NULL");
+
+    evtq_lane_t *l = &s_evtq_lane_set[lane];
+    stats->depth = (uint16_t)(EVTQ_LOAD_ACQ(&l->head) - EVTQ_LOAD_ACQ(&l->tail));
+    stats->max_depth = l->max_depth;
+    stats->push_cnt = l->push_cnt;
+    stats->drop_cnt = l->drop_cnt;
+    return XF_OK;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 事件入队 (仅在协议栈单一上下文中调用)
+ *
+ * @note 直接在队列槽位中构造事件，完成后再发布 head ，无需额外拷贝
+ */
+static xf_ble_evt_res_t evtq_push(xf_ble_evtq_type_t type, uint8_t event, const void *param)
+{
+    if (param == NULL) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+    uint8_t lane_index = evtq_lane_get(type, event);
+    if (lane_index == XF_BLE_EVTQ_LANE_DIRECT) {
+        switch (type) {
+        case XF_BLE_EVTQ_TYPE_GAP:
+            return (s_evtq_gap_cb == NULL) ? XF_BLE_EVT_RES_NOT_HANDLED
+                   : s_evtq_gap_cb(event, (xf_ble_gap_evt_cb_param_t *)param);
+        case XF_BLE_EVTQ_TYPE_GATTS:
+            return (s_evtq_gatts_cb == NULL) ? XF_BLE_EVT_RES_NOT_HANDLED
+                   : s_evtq_gatts_cb(event, (xf_ble_gatts_evt_cb_param_t *)param);
+        default:
+            return (s_evtq_gattc_cb == NULL) ? XF_BLE_EVT_RES_NOT_HANDLED
+                   : s_evtq_gattc_cb(event, (xf_ble_gattc_evt_cb_param_t *)param);
+        }
+    }
+
+    evtq_lane_t *lane = &s_evtq_lane_set[lane_index];
+    uint32_t head = lane->head;
+    uint32_t depth = head - EVTQ_LOAD_ACQ(&lane->tail);
+    if (depth >= XF_BLE_EVTQ_DEPTH) {
+        ++lane->drop_cnt;
+        return XF_BLE_EVT_RES_ERR;
+    }
+
+    evtq_item_t *item = &lane->item_set[head & EVTQ_MASK];
+    item->type = type;
+    item->event = event;
+    switch (type) {
+    case XF_BLE_EVTQ_TYPE_GAP:
+        item->param.gap = *(const xf_ble_gap_evt_cb_param_t *)param;
+        break;
+    case XF_BLE_EVTQ_TYPE_GATTS:
+        item->param.gatts = *(const xf_ble_gatts_evt_cb_param_t *)param;
+        break;
+    default:
+        item->param.gattc = *(const xf_ble_gattc_evt_cb_param_t *)param;
+        break;
+    }
+
+    evtq_ref_t ref;
+    evtq_item_ref_get(item, &ref);
+    item->has_addr = (ref.addr != NULL) && (*ref.addr != NULL);
+    item->has_data = (ref.data != NULL) && (*ref.data != NULL);
+    item->has_pbuf = item->has_data && (ref.pbuf != NULL) && (*ref.pbuf != NULL);
+    item->data_len = ref.data_len;
+    if (item->has_addr) {
+        item->addr = **ref.addr;
+    }
+    if (item->has_pbuf) {
+        /* 数据已在 pbuf 中，持有即可，无需拷贝 */
+        xf_ble_pbuf_take(*ref.pbuf);
+    } else if (item->has_data) {
+        if (ref.data_len > XF_BLE_EVTQ_PAYLOAD_MAX) {
+            ++lane->drop_cnt;
+            XF_LOGW(TAG, "evt(%d-%d) payload too long: %u", type, event, ref.data_len);
+            return XF_BLE_EVT_RES_ERR;
+        }
+        xf_memcpy(item->data, *ref.data, ref.data_len);
+    }
+
+    EVTQ_STORE_REL(&lane->head, head + 1);
+    ++lane->push_cnt;
+    if (depth + 1 > lane->max_depth) {
+        lane->max_depth = (uint16_t)(depth + 1);
+    }
+    return XF_BLE_EVT_RES_HANDLED;
+}
+
+/**
+ * @brief 事件出队 (可在多个上下文中同时调用)
+ *
+ * @note 先将槽位拷贝出来再 CAS 推进 tail ，CAS 失败说明该槽位已被其他消费者取走
+ *  (期间可能已被生产者覆盖)，丢弃拷贝重试即可
+ */
+static bool evtq_pop(evtq_lane_t *lane, evtq_item_t *item)
+{
+    uint32_t tail = EVTQ_LOAD_ACQ(&lane->tail);
+    while (1) {
+        if (tail == EVTQ_LOAD_ACQ(&lane->head)) {
+            return false;
+        }
+        *item = lane->item_set[tail & EVTQ_MASK];
+        if (EVTQ_CAS(&lane->tail, &tail, tail + 1)) {
+            break;
+        }
+    }
+
+    /* 将参数中的指针指向拷贝出来的数据 */
+    evtq_ref_t ref;
+    evtq_item_ref_get(item, &ref);
+    if (ref.addr != NULL) {
+        *ref.addr = item->has_addr ? &item->addr : NULL;
+    }
+    if ((ref.data != NULL) && !item->has_pbuf) {
+        *ref.data = item->has_data ? item->data : NULL;
+    }
+    return true;
+}
+
+static xf_ble_evt_res_t evtq_dispatch(evtq_item_t *item)
+{
+    switch (item->type) {
+    case XF_BLE_EVTQ_TYPE_GAP:
+        return (s_evtq_gap_cb == NULL) ? XF_BLE_EVT_RES_NOT_HANDLED
+               : s_evtq_gap_cb(item->event, &item->param.gap);
+    case XF_BLE_EVTQ_TYPE_GATTS:
+        return (s_evtq_gatts_cb == NULL) ? XF_BLE_EVT_RES_NOT_HANDLED
+               : s_evtq_gatts_cb(item->event, &item->param.gatts);
+    default:
+        return (s_evtq_gattc_cb == NULL) ? XF_BLE_EVT_RES_NOT_HANDLED
+               : s_evtq_gattc_cb(item->event, &item->param.gattc);
+    }
+}
+
+/**
+ * @brief 获取事件参数中需要深拷贝的指针成员
+ */
+static void evtq_item_ref_get(evtq_item_t *item, evtq_ref_t *ref)
+{
+    ref->addr = NULL;
+    ref->data = NULL;
+    ref->data_len = 0;
+    ref->pbuf = NULL;
+
+    if (item->type == XF_BLE_EVTQ_TYPE_GAP) {
+        xf_ble_gap_evt_cb_param_t *gap = &item->param.gap;
+        switch (item->event) {
+        case XF_BLE_GAP_EVT_CONNECT_REQ:
+            ref->addr = &gap->conn_req.addr;
+            break;
+        case XF_BLE_GAP_EVT_CONNECT:
+            ref->addr = &gap->connect.addr;
+            break;
+        case XF_BLE_GAP_EVT_DISCONNECT:
+            ref->addr = &gap->disconnect.addr;
+            break;
+        case XF_BLE_GAP_EVT_SCAN_RESULT:
+            ref->addr = &gap->scan_result.addr;
+            ref->data = (void **)&gap->scan_result.adv_data;
+            ref->data_len = gap->scan_result.adv_data_len;
+#if XF_BLE_EVT_PBUF_ENABLE
+            ref->pbuf = &gap->scan_result.pbuf;
+#endif
+            break;
+        case XF_BLE_GAP_EVT_PAIR_END:
+            ref->addr = &gap->pair_end.addr;
+            ref->data = &gap->pair_end.ltk.data;
+            ref->data_len = gap->pair_end.ltk.len;
+            break;
+        default:
+            break;
+        }
+    } else if (item->type == XF_BLE_EVTQ_TYPE_GATTS) {
+        if (item->event == XF_BLE_GATTS_EVT_WRITE_REQ) {
+            ref->data = (void **)&item->param.gatts.write_req.value;
+            ref->data_len = item->param.gatts.write_req.value_len;
+#if XF_BLE_EVT_PBUF_ENABLE
+            ref->pbuf = &item->param.gatts.write_req.pbuf;
+#endif
+        }
+    } else {
+        xf_ble_gattc_evt_cb_param_t *gattc = &item->param.gattc;
+        switch (item->event) {
+        case XF_BLE_GATTC_EVT_READ_CFM:
+            ref->data = (void **)&gattc->read_cfm.value;
+            ref->data_len = gattc->read_cfm.value_len;
+#if XF_BLE_EVT_PBUF_ENABLE
+            ref->pbuf = &gattc->read_cfm.pbuf;
+#endif
+            break;
+        case XF_BLE_GATTC_EVT_NOTIFICATION:
+        case XF_BLE_GATTC_EVT_INDICATION:
+            ref->addr = &gattc->ntf.addr;
+            ref->data = (void **)&gattc->ntf.value;
+            ref->data_len = gattc->ntf.value_len;
+#if XF_BLE_EVT_PBUF_ENABLE
+            ref->pbuf = &gattc->ntf.pbuf;
+#endif
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+static uint8_t evtq_lane_get(xf_ble_evtq_type_t type, uint8_t event)
+{
+    uint8_t *map = evtq_lane_map_get(type, event);
+    if ((map != NULL) && (*map != EVTQ_LANE_MAP_DEFAULT)) {
+        return (*map == XF_BLE_EVTQ_LANE_DIRECT) ? XF_BLE_EVTQ_LANE_DIRECT : (uint8_t)(*map - 1);
+    }
+    /* 默认: 连接状态变化及需要响应对端的请求优先 */
+    bool is_urgent = false;
+    if (type == XF_BLE_EVTQ_TYPE_GAP) {
+        is_urgent = (event == XF_BLE_GAP_EVT_CONNECT) || (event == XF_BLE_GAP_EVT_DISCONNECT)
+                    || (event == XF_BLE_GAP_EVT_CONN_PARAM_UPDATE);
+    } else if (type == XF_BLE_EVTQ_TYPE_GATTS) {
+        is_urgent = (event == XF_BLE_GATTS_EVT_READ_REQ) || (event == XF_BLE_GATTS_EVT_WRITE_REQ);
+    }
+    return is_urgent ? 0 : (XF_BLE_EVTQ_LANE_NUM - 1);
+}
+
+static uint8_t *evtq_lane_map_get(xf_ble_evtq_type_t type, uint8_t event)
+{
+    switch (type) {
+    case XF_BLE_EVTQ_TYPE_GAP:
+        return (event < _XF_BLE_GAP_EVT_MAX) ? &s_evtq_lane_map_gap[event] : NULL;
+    case XF_BLE_EVTQ_TYPE_GATTS:
+        return (event < _XF_BLE_GATTS_EVT_MAX) ? &s_evtq_lane_map_gatts[event] : NULL;
+    case XF_BLE_EVTQ_TYPE_GATTC:
+        return (event < _XF_BLE_GATTC_EVT_MAX) ? &s_evtq_lane_map_gattc[event] : NULL;
+    default:
+        return NULL;
+    }
+}
+
+#endif /* XF_BLE_IS_ENABLE */
@@ -0,0 +1,164 @@
+/**
+ * @file xf_ble_evtq.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 事件队列 (延迟分发)。
+ *  在协议栈上下文中将事件 (包括地址、属性值等指向的数据) 深拷贝至预分配的无锁环形队列，
+ *  再由应用的工作线程取出并分发，避免耗时的事件处理阻塞协议栈。
+ *  事件参数带有 pbuf 时 (见 XF_BLE_EVT_PBUF_ENABLE) 仅持有该缓冲区，不拷贝数据。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_EVTQ_H__
+#define __XF_BLE_EVTQ_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gap_types.h"
+#include "xf_ble_gatt_server_types.h"
+#include "xf_ble_gatt_client_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief BLE 事件队列通道: 不入队，直接在协议栈上下文中分发
+ *
+ * @note 用于需要同步处理结果的事件 (如依赖协议栈默认处理的事件)
+ */
+#define XF_BLE_EVTQ_LANE_DIRECT     (0xFF)
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE 事件队列的事件来源类型
+ */
+typedef uint8_t xf_ble_evtq_type_t;
+enum _xf_ble_evtq_type_t {
+    XF_BLE_EVTQ_TYPE_GAP = 0,       /*!< GAP 事件 */
+    XF_BLE_EVTQ_TYPE_GATTS,         /*!< GATTS 事件 */
+    XF_BLE_EVTQ_TYPE_GATTC,         /*!< GATTC 事件 */
+    _XF_BLE_EVTQ_TYPE_MAX,
+};
+
+/**
+ * @brief BLE 事件队列单个通道的统计
+ */
+typedef struct {
+    uint16_t depth;         /*!< 当前缓存的事件数 */
+    uint16_t max_depth;     /*!< 缓存事件数的历史最大值 */
+    uint32_t push_cnt;      /*!< 入队的事件数 */
+    uint32_t drop_cnt;      /*!< 丢弃的事件数 (队列已满或数据过长) */
+} xf_ble_evtq_stats_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE 设置事件队列分发时调用的事件回调
+ *
+ * @param gap_cb GAP 事件回调，见 @ref xf_ble_gap_evt_cb_t ，可为 NULL
+ * @param gatts_cb GATTS 事件回调，见 @ref xf_ble_gatts_evt_cb_t ，可为 NULL
+ * @param gattc_cb GATTC 事件回调，见 @ref xf_ble_gattc_evt_cb_t ，可为 NULL
+ *
+ * @note 开启延迟分发: 调用本函数设置应用的事件回调，
+ *  再将 xf_ble_evtq_gap_event_cb() 等注册为协议栈的事件回调，
+ *  并在工作线程中循环调用 xf_ble_evtq_process()
+ */
+void xf_ble_evtq_set_handlers(
+    xf_ble_gap_evt_cb_t gap_cb,
+    xf_ble_gatts_evt_cb_t gatts_cb,
+    xf_ble_gattc_evt_cb_t gattc_cb);
+
+/**
+ * @brief BLE 设置事件使用的优先级通道
+ *
+ * @note 默认连接、断连、连接参数更新及 GATTS 读写请求使用通道 0 ，其余使用最后一个通道
+ * @param type 事件来源类型，见 @ref xf_ble_evtq_type_t
+ * @param event 事件，见 @ref xf_ble_gap_evt_t 等
+ * @param lane 通道，小于 XF_BLE_EVTQ_LANE_NUM ，或 XF_BLE_EVTQ_LANE_DIRECT
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_ble_evtq_set_lane(xf_ble_evtq_type_t type, uint8_t event, uint8_t lane);
+
+/**
+ * @brief BLE 事件队列的 GAP 事件回调 (入队)
+ *
+ * @note 注册为协议栈的 GAP 事件回调，见 xf_ble_gap_event_cb_register() ；
+ *  入队的事件固定返回 XF_BLE_EVT_RES_HANDLED
+ */
+xf_ble_evt_res_t xf_ble_evtq_gap_event_cb(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param);
+
+/**
+ * @brief BLE 事件队列的 GATTS 事件回调 (入队)
+ *
+ * @note 同 xf_ble_evtq_gap_event_cb()
+ */
+xf_ble_evt_res_t xf_ble_evtq_gatts_event_cb(
+    xf_ble_gatts_evt_t event,
+    xf_ble_gatts_evt_cb_param_t *param);
+
+/**
+ * @brief BLE 事件队列的 GATTC 事件回调 (入队)
+ *
+ * @note 同 xf_ble_evtq_gap_event_cb()
+ */
+xf_ble_evt_res_t xf_ble_evtq_gattc_event_cb(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param);
+
+/**
+ * @brief BLE 取出并分发事件队列中的事件
+ *
+ * @note 优先取出高优先级通道的事件。
+ *  入队一侧仅限协议栈单一上下文；取出一侧可在多个工作线程中同时调用 (无锁)，
+ *  此时不同线程分发的事件之间不保证先后顺序
+ * @param max_cnt 本次最多分发的事件数， 0 表示直到队列为空
+ * @return uint16_t 本次分发的事件数
+ */
+uint16_t xf_ble_evtq_process(uint16_t max_cnt);
+
+/**
+ * @brief BLE 获取事件队列通道的统计
+ *
+ * @param lane 通道，小于 XF_BLE_EVTQ_LANE_NUM
+ * @param[out] stats 统计，见 @ref xf_ble_evtq_stats_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_ble_evtq_get_stats(uint8_t lane, xf_ble_evtq_stats_t *stats);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_EVTQ_H__ */
@@ -0,0 +1,631 @@
+/**
+ * @file xf_ble_filter_list.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 过滤接受列表 (白名单) 及解析列表管理。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_ble_gap.h"
+#include "xf_ble_trace.h"
+#include "xf_ble_utils.h"
+#include "xf_ble_filter_list.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_filter_list"
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 一个列表的提交计划
+ */
+typedef struct {
+    bool is_clear;                          /*!< 先清空 (此时 add 为期望的全部内容) */
+    uint8_t del_num;
+    uint8_t add_num;
+    uint8_t del_idx_set[XF_BLE_FILTER_LIST_RESOLVING_NUM > XF_BLE_FILTER_LIST_ACCEPT_NUM
+                        ? XF_BLE_FILTER_LIST_RESOLVING_NUM : XF_BLE_FILTER_LIST_ACCEPT_NUM];
+                                            /*!< 待删除项在已生效列表中的下标 */
+    uint8_t add_idx_set[XF_BLE_FILTER_LIST_RESOLVING_NUM > XF_BLE_FILTER_LIST_ACCEPT_NUM
+                        ? XF_BLE_FILTER_LIST_RESOLVING_NUM : XF_BLE_FILTER_LIST_ACCEPT_NUM];
+                                            /*!< 待添加项在期望列表中的下标 */
+} filter_list_plan_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void filter_list_plan(filter_list_plan_t *plan, uint8_t cur_num, uint8_t want_num,
+                             bool (*is_equal)(uint8_t cur_idx, uint8_t want_idx));
+static bool filter_list_fal_is_equal(uint8_t cur_idx, uint8_t want_idx);
+static bool filter_list_rl_is_equal(uint8_t cur_idx, uint8_t want_idx);
+static xf_err_t filter_list_fal_apply(const filter_list_plan_t *plan,
+                                      const xf_ble_addr_t *want_set, uint8_t want_num);
+static xf_err_t filter_list_rl_apply(const filter_list_plan_t *plan,
+                                     const xf_ble_filter_list_rl_entry_t *want_set, uint8_t want_num);
+static void filter_list_cmd_done(xf_err_t ret);
+static bool filter_list_scan_uses_fal(xf_ble_gap_scan_filter_policy_t policy);
+static int filter_list_fal_find(const xf_ble_addr_t *set, uint8_t num, const xf_ble_addr_t *addr);
+static int filter_list_rl_find(const xf_ble_filter_list_rl_entry_t *set, uint8_t num,
+                               const xf_ble_addr_t *id_addr);
+static xf_err_t filter_list_conn_mgr_update(const xf_ble_addr_t *addr_set, uint8_t num, void *user_data);
+static xf_err_t filter_list_conn_mgr_connect(void *user_data);
+static xf_err_t filter_list_conn_mgr_cancel(void *user_data);
+static bool filter_list_irk_is_equal(const xf_ble_sm_irk_t *a, const xf_ble_sm_irk_t *b);
+
+/* ==================== [Static Variables] ================================== */
+
+/* 期望状态 */
+static xf_ble_addr_t s_fal_want_set[XF_BLE_FILTER_LIST_ACCEPT_NUM] = {0};
+static uint8_t s_fal_want_num = 0;
+static xf_ble_filter_list_rl_entry_t s_rl_want_set[XF_BLE_FILTER_LIST_RESOLVING_NUM] = {0};
+static uint8_t s_rl_want_num = 0;
+
+/* 控制器中的实际内容 (镜像)，仅在提交时访问 */
+static xf_ble_addr_t s_fal_cur_set[XF_BLE_FILTER_LIST_ACCEPT_NUM] = {0};
+static uint8_t s_fal_cur_num = 0;
+static xf_ble_filter_list_rl_entry_t s_rl_cur_set[XF_BLE_FILTER_LIST_RESOLVING_NUM] = {0};
+static uint8_t s_rl_cur_num = 0;
+
+/* 提交时期望状态的快照 (较大，不放在栈上) */
+static xf_ble_addr_t s_fal_snap_set[XF_BLE_FILTER_LIST_ACCEPT_NUM] = {0};
+static xf_ble_filter_list_rl_entry_t s_rl_snap_set[XF_BLE_FILTER_LIST_RESOLVING_NUM] = {0};
+
+/* 控制器活动 */
+static bool s_is_scanning = false;
+static xf_ble_gap_scan_param_t s_scan_param = {0};
+static uint32_t s_adv_active_mask = 0;
+static uint32_t s_adv_fal_mask = 0;         /*!< 使用过滤接受列表的广播 */
+static uint16_t s_adv_duration_set[XF_BLE_FILTER_LIST_ADV_NUM] = {0};
+static bool s_is_initiating = false;
+
+static bool s_is_committing = false;
+static xf_ble_filter_list_stats_t s_stats = {0};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_ble_filter_list_set_accept(const xf_ble_addr_t *addr_set, uint8_t num)
+{
+    XF_CHECK((addr_set == NULL) && (num != 0), XF_ERR_INVALID_ARG, TAG, "addr_set == NULL");
+    XF_CHECK(num > XF_BLE_FILTER_LIST_ACCEPT_NUM, XF_ERR_NO_MEM,
+             TAG, "num(%d) exceeds max: %d", num, XF_BLE_FILTER_LIST_ACCEPT_NUM);
+
+    XF_BLE_ENTER_CRITICAL();
+    s_fal_want_num = 0;
+    for (uint8_t i = 0; i < num; i++) {
+        if (filter_list_fal_find(s_fal_want_set, s_fal_want_num, &addr_set[i]) < 0) {
+            s_fal_want_set[s_fal_want_num++] = addr_set[i];
+        }
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return XF_OK;
+}
+
+xf_err_t xf_ble_filter_list_add_accept(const xf_ble_addr_t *addr)
+{
+    XF_CHECK(addr == NULL, XF_ERR_INVALID_ARG, TAG, "addr == NULL");
+
+    xf_err_t ret = XF_OK;
+    XF_BLE_ENTER_CRITICAL();
+    if (filter_list_fal_find(s_fal_want_set, s_fal_want_num, addr) < 0) {
+        if (s_fal_want_num >= XF_BLE_FILTER_LIST_ACCEPT_NUM) {
+            ret = XF_ERR_NO_MEM;
+        } else {
+            s_fal_want_set[s_fal_want_num++] = *addr;
+        }
+    }
+    XF_BLE_EXIT_CRITICAL();
+    XF_CHECK(ret != XF_OK, ret, TAG, "accept list is full: %d", XF_BLE_FILTER_LIST_ACCEPT_NUM);
+    return XF_OK;
+}
+
+xf_err_t xf_ble_filter_list_del_accept(const xf_ble_addr_t *addr)
+{
+    XF_CHECK(addr == NULL, XF_ERR_INVALID_ARG, TAG, "addr == NULL");
+
+    XF_BLE_ENTER_CRITICAL();
+    int idx = filter_list_fal_find(s_fal_want_set, s_fal_want_num, addr);
+    if (idx >= 0) {
+        s_fal_want_set[idx] = s_fal_want_set[--s_fal_want_num];
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return (idx >= 0) ? XF_OK : XF_ERR_NOT_FOUND;
+}
+
+xf_err_t xf_ble_filter_list_set_resolving(
+    const xf_ble_filter_list_rl_entry_t *entry_set, uint8_t num)
+{
+    XF_CHECK((entry_set == NULL) && (num != 0), XF_ERR_INVALID_ARG, TAG, "entry_set == NULL");
+    XF_CHECK(num > XF_BLE_FILTER_LIST_RESOLVING_NUM, XF_ERR_NO_MEM,
+             TAG, "num(%d) exceeds max: %d", num, XF_BLE_FILTER_LIST_RESOLVING_NUM);
+
+    XF_BLE_ENTER_CRITICAL();
+    s_rl_want_num = 0;
+    for (uint8_t i = 0; i < num; i++) {
+        int idx = filter_list_rl_find(s_rl_want_set, s_rl_want_num, &entry_set[i].id_addr);
+        s_rl_want_set[(idx >= 0) ? (uint8_t)idx : s_rl_want_num++] = entry_set[i];
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return XF_OK;
+}
+
+xf_err_t xf_ble_filter_list_add_resolving(const xf_ble_filter_list_rl_entry_t *entry)
+{
+    XF_CHECK(entry == NULL, XF_ERR_INVALID_ARG, TAG, "entry == NULL");
+
+    xf_err_t ret = XF_OK;
+    XF_BLE_ENTER_CRITICAL();
+    int idx = filter_list_rl_find(s_rl_want_set, s_rl_want_num, &entry->id_addr);
+    if (idx >= 0) {
+        s_rl_want_set[idx] = *entry;
+    } else if (s_rl_want_num >= XF_BLE_FILTER_LIST_RESOLVING_NUM) {
+        ret = XF_ERR_NO_MEM;
+    } else {
+        s_rl_want_set[s_rl_want_num++] = *entry;
+    }
+    XF_BLE_EXIT_CRITICAL();
+    XF_CHECK(ret != XF_OK, ret, TAG, "resolving list is full: %d", XF_BLE_FILTER_LIST_RESOLVING_NUM);
+    return XF_OK;
+}
+
+xf_err_t xf_ble_filter_list_del_resolving(const xf_ble_addr_t *id_addr)
+{
+    XF_CHECK(id_addr == NULL, XF_ERR_INVALID_ARG, TAG, "id_addr == NULL");
+
+    XF_BLE_ENTER_CRITICAL();
+    int idx = filter_list_rl_find(s_rl_want_set, s_rl_want_num, id_addr);
+    if (idx >= 0) {
+        s_rl_want_set[idx] = s_rl_want_set[--s_rl_want_num];
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return (idx >= 0) ? XF_OK : XF_ERR_NOT_FOUND;
+}
+
+xf_err_t xf_ble_filter_list_commit(void)
+{
+    bool is_busy = false;
+    uint8_t fal_want_num = 0;
+    uint8_t rl_want_num = 0;
+    XF_BLE_ENTER_CRITICAL();
+    is_busy = s_is_committing;
+    if (!is_busy) {
+        s_is_committing = true;
+        s_stats.commit_cnt++;
+        fal_want_num = s_fal_want_num;
+        rl_want_num = s_rl_want_num;
+        xf_memcpy(s_fal_snap_set, s_fal_want_set, sizeof(xf_ble_addr_t) * fal_want_num);
+        xf_memcpy(s_rl_snap_set, s_rl_want_set, sizeof(xf_ble_filter_list_rl_entry_t) * rl_want_num);
+    }
+    XF_BLE_EXIT_CRITICAL();
+    XF_CHECK(is_busy, XF_ERR_BUSY, TAG, "committing");
+
+    filter_list_plan_t fal_plan;
+    filter_list_plan_t rl_plan;
+    filter_list_plan(&fal_plan, s_fal_cur_num, fal_want_num, filter_list_fal_is_equal);
+    filter_list_plan(&rl_plan, s_rl_cur_num, rl_want_num, filter_list_rl_is_equal);
+    bool is_fal_changed = fal_plan.is_clear || (fal_plan.del_num != 0) || (fal_plan.add_num != 0);
+    bool is_rl_changed = rl_plan.is_clear || (rl_plan.del_num != 0) || (rl_plan.add_num != 0);
+    if (!is_fal_changed && !is_rl_changed) {
+        XF_BLE_ENTER_CRITICAL();
+        s_is_committing = false;
+        XF_BLE_EXIT_CRITICAL();
+        return XF_OK;
+    }
+
+    /*
+     * 控制器不允许修改正在使用的列表:
+     * 过滤接受列表 —— 以其过滤的扫描、广播及发起连接；
+     * 解析列表 —— (地址解析使能时) 任何扫描、广播及发起连接。
+     * 仅暂停受影响的活动。
+     */
+    XF_BLE_ENTER_CRITICAL();
+    bool pause_scan = s_is_scanning
+                      && (is_rl_changed || filter_list_scan_uses_fal(s_scan_param.filter_policy));
+    xf_ble_gap_scan_param_t scan_param = s_scan_param;
+    uint32_t pause_adv_mask = is_rl_changed ? s_adv_active_mask : (s_adv_active_mask & s_adv_fal_mask);
+    bool pause_init = s_is_initiating;
+    XF_BLE_EXIT_CRITICAL();
+
+    if (pause_scan || (pause_adv_mask != 0) || pause_init) {
+        s_stats.pause_cnt++;
+        XF_LOGD(TAG, "pause scan(%d) adv(0x%x) init(%d)", pause_scan, (unsigned)pause_adv_mask, pause_init);
+    }
+    if (pause_scan) {
+        xf_err_t ret = XF_OK;
+        XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_STOP_SCAN, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                              xf_ble_gap_stop_scan());
+        pause_scan = (ret == XF_OK);
+    }
+    for (uint32_t mask = pause_adv_mask; mask != 0; mask &= mask - 1) {
+        xf_ble_adv_id_t adv_id = (xf_ble_adv_id_t)__builtin_ctz(mask);
+        xf_err_t ret = XF_OK;
+        XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_STOP_ADV, XF_BLE_TRACE_CONN_ID_NONE, adv_id,
+                              xf_ble_gap_stop_adv(adv_id));
+        if (ret != XF_OK) {
+            pause_adv_mask &= ~(1UL << adv_id);
+        }
+    }
+    if (pause_init) {
+        xf_err_t ret = XF_OK;
+        XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_CANCEL_CONNECT, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                              xf_ble_gap_cancel_connect());
+        pause_init = (ret == XF_OK);
+    }
+
+    xf_err_t ret = XF_OK;
+    if (is_fal_changed) {
+        ret = filter_list_fal_apply(&fal_plan, s_fal_snap_set, fal_want_num);
+    }
+    if (is_rl_changed) {
+        xf_err_t rl_ret = filter_list_rl_apply(&rl_plan, s_rl_snap_set, rl_want_num);
+        ret = (ret == XF_OK) ? rl_ret : ret;
+    }
+
+    /* 恢复已暂停的活动；期间连接已建立等导致活动已结束的，不再恢复 */
+    XF_BLE_ENTER_CRITICAL();
+    pause_scan = pause_scan && s_is_scanning;
+    pause_adv_mask &= s_adv_active_mask;
+    pause_init = pause_init && s_is_initiating && (s_fal_cur_num != 0);
+    XF_BLE_EXIT_CRITICAL();
+    if (pause_scan) {
+        xf_err_t resume_ret = XF_OK;
+        XF_BLE_TRACE_API_CALL(resume_ret, XF_BLE_TRACE_API_GAP_START_SCAN, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                              xf_ble_gap_start_scan(&scan_param));
+        if (resume_ret != XF_OK) {
+            XF_LOGW(TAG, "resume scan failed: %d", resume_ret);
+        }
+    }
+    for (uint32_t mask = pause_adv_mask; mask != 0; mask &= mask - 1) {
+        xf_ble_adv_id_t adv_id = (xf_ble_adv_id_t)__builtin_ctz(mask);
+        xf_err_t resume_ret = XF_OK;
+        XF_BLE_TRACE_API_CALL(resume_ret, XF_BLE_TRACE_API_GAP_START_ADV, XF_BLE_TRACE_CONN_ID_NONE, adv_id,
+                              xf_ble_gap_start_adv(adv_id, s_adv_duration_set[adv_id]));
+        if (resume_ret != XF_OK) {
+            XF_LOGW(TAG, "resume adv(%d) failed: %d", adv_id, resume_ret);
+        }
+    }
+    if (pause_init) {
+        xf_err_t resume_ret = XF_OK;
+        XF_BLE_TRACE_API_CALL(resume_ret, XF_BLE_TRACE_API_GAP_CONNECT_BY_ACCEPT_LIST, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                              xf_ble_gap_connect_by_accept_list());
+        if (resume_ret != XF_OK) {
+            XF_LOGW(TAG, "resume connect failed: %d", resume_ret);
+            XF_BLE_ENTER_CRITICAL();
+            s_is_initiating = false;
+            XF_BLE_EXIT_CRITICAL();
+        }
+    } else {
+        XF_BLE_ENTER_CRITICAL();
+        s_is_initiating = s_is_initiating && (s_fal_cur_num != 0);
+        XF_BLE_EXIT_CRITICAL();
+    }
+
+    XF_BLE_ENTER_CRITICAL();
+    s_is_committing = false;
+    XF_BLE_EXIT_CRITICAL();
+    return ret;
+}
+
+xf_err_t xf_ble_filter_list_get_stats(xf_ble_filter_list_stats_t *stats)
+{
+    XF_CHECK(stats == NULL, XF_ERR_INVALID_ARG, TAG, "stats == NULL");
+    XF_BLE_ENTER_CRITICAL();
+    *stats = s_stats;
+    XF_BLE_EXIT_CRITICAL();
+    return XF_OK;
+}
+
+xf_err_t xf_ble_filter_list_start_scan(const xf_ble_gap_scan_param_t *param)
+{
+    XF_CHECK(param == NULL, XF_ERR_INVALID_ARG, TAG, "param == NULL");
+
+    xf_err_t ret = XF_OK;
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_START_SCAN, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                          xf_ble_gap_start_scan(param));
+    if (ret == XF_OK) {
+        XF_BLE_ENTER_CRITICAL();
+        s_is_scanning = true;
+        s_scan_param = *param;
+        XF_BLE_EXIT_CRITICAL();
+    }
+    return ret;
+}
+
+xf_err_t xf_ble_filter_list_stop_scan(void)
+{
+    xf_err_t ret = XF_OK;
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_STOP_SCAN, XF_BLE_TRACE_CONN_ID_NONE, 0, xf_ble_gap_stop_scan());
+    XF_BLE_ENTER_CRITICAL();
+    s_is_scanning = false;
+    XF_BLE_EXIT_CRITICAL();
+    return ret;
+}
+
+xf_err_t xf_ble_filter_list_start_adv(xf_ble_adv_id_t adv_id, uint16_t duration,
+                                      xf_ble_gap_adv_filter_policy_t filter_policy)
+{
+    XF_CHECK(adv_id >= XF_BLE_FILTER_LIST_ADV_NUM, XF_ERR_INVALID_ARG,
+             TAG, "adv_id(%d) exceeds max: %d", adv_id, XF_BLE_FILTER_LIST_ADV_NUM);
+
+    xf_err_t ret = XF_OK;
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_START_ADV, XF_BLE_TRACE_CONN_ID_NONE, adv_id,
+                          xf_ble_gap_start_adv(adv_id, duration));
+    if (ret == XF_OK) {
+        XF_BLE_ENTER_CRITICAL();
+        s_adv_active_mask |= (1UL << adv_id);
+        if (filter_policy != XF_BLE_GAP_ADV_FILTER_POLICY_ANY_SCAN_ANY_CONN) {
+            s_adv_fal_mask |= (1UL << adv_id);
+        } else {
+            s_adv_fal_mask &= ~(1UL << adv_id);
+        }
+        s_adv_duration_set[adv_id] = duration;
+        XF_BLE_EXIT_CRITICAL();
+    }
+    return ret;
+}
+
+xf_err_t xf_ble_filter_list_stop_adv(xf_ble_adv_id_t adv_id)
+{
+    xf_err_t ret = XF_OK;
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_STOP_ADV, XF_BLE_TRACE_CONN_ID_NONE, adv_id,
+                          xf_ble_gap_stop_adv(adv_id));
+    if (adv_id < XF_BLE_FILTER_LIST_ADV_NUM) {
+        XF_BLE_ENTER_CRITICAL();
+        s_adv_active_mask &= ~(1UL << adv_id);
+        XF_BLE_EXIT_CRITICAL();
+    }
+    return ret;
+}
+
+xf_err_t xf_ble_filter_list_connect(void)
+{
+    /* 先登记，部分平台会在连接接口内同步上报连接事件 */
+    XF_BLE_ENTER_CRITICAL();
+    s_is_initiating = true;
+    XF_BLE_EXIT_CRITICAL();
+    xf_err_t ret = XF_OK;
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_CONNECT_BY_ACCEPT_LIST, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                          xf_ble_gap_connect_by_accept_list());
+    if (ret != XF_OK) {
+        XF_BLE_ENTER_CRITICAL();
+        s_is_initiating = false;
+        XF_BLE_EXIT_CRITICAL();
+    }
+    return ret;
+}
+
+xf_err_t xf_ble_filter_list_cancel_connect(void)
+{
+    xf_err_t ret = XF_OK;
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_CANCEL_CONNECT, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                          xf_ble_gap_cancel_connect());
+    XF_BLE_ENTER_CRITICAL();
+    s_is_initiating = false;
+    XF_BLE_EXIT_CRITICAL();
+    return ret;
+}
+
+void xf_ble_filter_list_get_conn_mgr_ops(xf_ble_conn_mgr_fal_ops_t *ops)
+{
+    if (ops == NULL) {
+        return;
+    }
+    ops->update = filter_list_conn_mgr_update;
+    ops->connect = filter_list_conn_mgr_connect;
+    ops->cancel = filter_list_conn_mgr_cancel;
+    ops->capacity = XF_BLE_FILTER_LIST_ACCEPT_NUM;
+    ops->user_data = NULL;
+}
+
+xf_ble_evt_res_t xf_ble_filter_list_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param)
+{
+    if ((event == XF_BLE_GAP_EVT_CONNECT) && (param != NULL)
+            && (param->connect.link_role == XF_BLE_GAP_LINK_ROLE_MASTER)) {
+        /* 作为主机建立连接后控制器即停止发起连接 */
+        XF_BLE_ENTER_CRITICAL();
+        s_is_initiating = false;
+        XF_BLE_EXIT_CRITICAL();
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 计算已生效列表 (cur) 到期望列表 (want) 的最少命令:
+ *  逐项删除 del 个与 "清空 + 重新添加保留的 keep 个" 中取命令数较少者
+ */
+static void filter_list_plan(filter_list_plan_t *plan, uint8_t cur_num, uint8_t want_num,
+                             bool (*is_equal)(uint8_t cur_idx, uint8_t want_idx))
+{
+    uint8_t keep_num = 0;
+    xf_memset(plan, 0, sizeof(filter_list_plan_t));
+    for (uint8_t i = 0; i < cur_num; i++) {
+        bool is_keep = false;
+        for (uint8_t j = 0; (j < want_num) && !is_keep; j++) {
+            is_keep = is_equal(i, j);
+        }
+        if (is_keep) {
+            keep_num++;
+        } else {
+            plan->del_idx_set[plan->del_num++] = i;
+        }
+    }
+    for (uint8_t j = 0; j < want_num; j++) {
+        bool is_exist = false;
+        for (uint8_t i = 0; (i < cur_num) && !is_exist; i++) {
+            is_exist = is_equal(i, j);
+        }
+        if (!is_exist) {
+            plan->add_idx_set[plan->add_num++] = j;
+        }
+    }
+    if ((plan->del_num > 1) && ((1 + keep_num) < plan->del_num)) {
+        plan->is_clear = true;
+        plan->del_num = 0;
+        plan->add_num = want_num;
+        for (uint8_t j = 0; j < want_num; j++) {
+            plan->add_idx_set[j] = j;
+        }
+    }
+}
+
+static bool filter_list_fal_is_equal(uint8_t cur_idx, uint8_t want_idx)
+{
+    return xf_ble_addr_is_equal(&s_fal_cur_set[cur_idx], &s_fal_snap_set[want_idx]);
+}
+
+static bool filter_list_rl_is_equal(uint8_t cur_idx, uint8_t want_idx)
+{
+    const xf_ble_filter_list_rl_entry_t *a = &s_rl_cur_set[cur_idx];
+    const xf_ble_filter_list_rl_entry_t *b = &s_rl_snap_set[want_idx];
+    return xf_ble_addr_is_equal(&a->id_addr, &b->id_addr)
+           && filter_list_irk_is_equal(&a->peer_irk, &b->peer_irk)
+           && filter_list_irk_is_equal(&a->local_irk, &b->local_irk);
+}
+
+/**
+ * @brief 执行过滤接受列表的命令 (先删后加以腾出容量)，每条成功的命令同步更新镜像
+ */
+static xf_err_t filter_list_fal_apply(const filter_list_plan_t *plan,
+                                      const xf_ble_addr_t *want_set, uint8_t want_num)
+{
+    xf_err_t ret = XF_OK;
+    if (plan->is_clear) {
+        XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_CLEAR_ACCEPT_LIST, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                              xf_ble_gap_clear_accept_list());
+        filter_list_cmd_done(ret);
+        XF_CHECK(ret != XF_OK, ret, TAG, "clear accept list failed: %d", ret);
+        s_fal_cur_num = 0;
+    }
+    /* 删除下标升序排列，从后往前删除并以末项填补，不影响尚未处理的下标 */
+    for (uint8_t k = plan->del_num; k > 0; k--) {
+        uint8_t idx = plan->del_idx_set[k - 1];
+        XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_DEL_ACCEPT_LIST, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                              xf_ble_gap_del_accept_list(&s_fal_cur_set[idx]));
+        filter_list_cmd_done(ret);
+        XF_CHECK(ret != XF_OK, ret, TAG, "del accept list failed: %d", ret);
+        s_fal_cur_set[idx] = s_fal_cur_set[--s_fal_cur_num];
+    }
+    for (uint8_t k = 0; k < plan->add_num; k++) {
+        const xf_ble_addr_t *addr = &want_set[plan->add_idx_set[k]];
+        XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_ADD_ACCEPT_LIST, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                              xf_ble_gap_add_accept_list(addr));
+        filter_list_cmd_done(ret);
+        XF_CHECK(ret != XF_OK, ret, TAG, "add accept list failed: %d", ret);
+        s_fal_cur_set[s_fal_cur_num++] = *addr;
+    }
+    XF_LOGD(TAG, "accept list: %d/%d", s_fal_cur_num, want_num);
+    return XF_OK;
+}
+
+/**
+ * @brief 执行解析列表的命令，同 filter_list_fal_apply()
+ */
+static xf_err_t filter_list_rl_apply(const filter_list_plan_t *plan,
+                                     const xf_ble_filter_list_rl_entry_t *want_set, uint8_t want_num)
+{
+    xf_err_t ret = XF_OK;
+    if (plan->is_clear) {
+        XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_CLEAR_RESOLVING_LIST, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                              xf_ble_gap_clear_resolving_list());
+        filter_list_cmd_done(ret);
+        XF_CHECK(ret != XF_OK, ret, TAG, "clear resolving list failed: %d", ret);
+        s_rl_cur_num = 0;
+    }
+    for (uint8_t k = plan->del_num; k > 0; k--) {
+        uint8_t idx = plan->del_idx_set[k - 1];
+        XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_DEL_RESOLVING_LIST, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                              xf_ble_gap_del_resolving_list(&s_rl_cur_set[idx].id_addr));
+        filter_list_cmd_done(ret);
+        XF_CHECK(ret != XF_OK, ret, TAG, "del resolving list failed: %d", ret);
+        s_rl_cur_set[idx] = s_rl_cur_set[--s_rl_cur_num];
+    }
+    for (uint8_t k = 0; k < plan->add_num; k++) {
+        const xf_ble_filter_list_rl_entry_t *entry = &want_set[plan->add_idx_set[k]];
+        XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_ADD_RESOLVING_LIST, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                              xf_ble_gap_add_resolving_list(&entry->id_addr, &entry->peer_irk, &entry->local_irk));
+        filter_list_cmd_done(ret);
+        XF_CHECK(ret != XF_OK, ret, TAG, "add resolving list failed: %d", ret);
+        s_rl_cur_set[s_rl_cur_num++] = *entry;
+    }
+    XF_LOGD(TAG, "resolving list: %d/%d", s_rl_cur_num, want_num);
+    return XF_OK;
+}
+
+static void filter_list_cmd_done(xf_err_t ret)
+{
+    XF_BLE_ENTER_CRITICAL();
+    s_stats.cmd_cnt++;
+    if (ret != XF_OK) {
+        s_stats.fail_cnt++;
+    }
+    XF_BLE_EXIT_CRITICAL();
+}
+
+static bool filter_list_scan_uses_fal(xf_ble_gap_scan_filter_policy_t policy)
+{
+    return (policy == XF_BLE_GAP_SCAN_FILTER_POLICY_WLIST)
+           || (policy == XF_BLE_GAP_SCAN_FILTER_POLICY_WLIST_AND_RPA);
+}
+
+static int filter_list_fal_find(const xf_ble_addr_t *set, uint8_t num, const xf_ble_addr_t *addr)
+{
+    for (uint8_t i = 0; i < num; i++) {
+        if (xf_ble_addr_is_equal(&set[i], addr)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int filter_list_rl_find(const xf_ble_filter_list_rl_entry_t *set, uint8_t num,
+                               const xf_ble_addr_t *id_addr)
+{
+    for (uint8_t i = 0; i < num; i++) {
+        if (xf_ble_addr_is_equal(&set[i].id_addr, id_addr)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static xf_err_t filter_list_conn_mgr_update(const xf_ble_addr_t *addr_set, uint8_t num, void *user_data)
+{
+    (void)user_data;
+    xf_err_t ret = xf_ble_filter_list_set_accept(addr_set, num);
+    return (ret == XF_OK) ? xf_ble_filter_list_commit() : ret;
+}
+
+static xf_err_t filter_list_conn_mgr_connect(void *user_data)
+{
+    (void)user_data;
+    return xf_ble_filter_list_connect();
+}
+
+static xf_err_t filter_list_conn_mgr_cancel(void *user_data)
+{
+    (void)user_data;
+    return xf_ble_filter_list_cancel_connect();
+}
+
+static bool filter_list_irk_is_equal(const xf_ble_sm_irk_t *a, const xf_ble_sm_irk_t *b)
+{
+    for (uint8_t i = 0; i < XF_BLE_SM_KEY_SIZE_MAX; i++) {
+        if (a->irk[i] != b->irk[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif /* XF_BLE_IS_ENABLE */
@@ -0,0 +1,238 @@
+/**
+ * @file xf_ble_filter_list.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 过滤接受列表 (白名单) 及解析列表管理。
+ *  上层只需设置期望的列表内容 (期望状态)，提交时与本地镜像 (控制器中的实际内容) 比较，
+ *  生成最少的添加 / 删除 (必要时清空) 命令序列；
+ *  仅当确需修改且控制器正使用该列表时，才暂停相关的扫描、广播或发起连接并在修改后恢复。
+ *  通过本模块的扫描、广播及连接接口启停，才能得知哪些活动需要暂停。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_FILTER_LIST_H__
+#define __XF_BLE_FILTER_LIST_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gap_types.h"
+#include "xf_ble_sm_types.h"
+#include "xf_ble_conn_mgr.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE 解析列表的条目
+ */
+typedef struct {
+    xf_ble_addr_t id_addr;                  /*!< 对端身份地址，见 @ref xf_ble_addr_t */
+    xf_ble_sm_irk_t peer_irk;               /*!< 对端 IRK ，见 @ref xf_ble_sm_irk_t */
+    xf_ble_sm_irk_t local_irk;              /*!< 本端 IRK ，见 @ref xf_ble_sm_irk_t */
+} xf_ble_filter_list_rl_entry_t;
+
+/**
+ * @brief BLE 过滤列表管理的统计
+ */
+typedef struct {
+    uint32_t commit_cnt;                    /*!< 提交次数 (含无变化的提交) */
+    uint32_t cmd_cnt;                       /*!< 已发出的列表命令数 (添加、删除、清空) */
+    uint32_t pause_cnt;                     /*!< 因修改列表而暂停活动 (扫描、广播、发起连接) 的次数 */
+    uint32_t fail_cnt;                      /*!< 失败的列表命令数 */
+} xf_ble_filter_list_stats_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE 过滤列表: 设置期望的过滤接受列表 (提交后生效)
+ *
+ * @param addr_set 地址集合，num 为 0 时可为 NULL
+ * @param num 地址数量
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NO_MEM         超过 XF_BLE_FILTER_LIST_ACCEPT_NUM
+ */
+xf_err_t xf_ble_filter_list_set_accept(const xf_ble_addr_t *addr_set, uint8_t num);
+
+/**
+ * @brief BLE 过滤列表: 向期望的过滤接受列表添加地址 (已存在时不重复添加，提交后生效)
+ *
+ * @param addr 地址
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NO_MEM         超过 XF_BLE_FILTER_LIST_ACCEPT_NUM
+ */
+xf_err_t xf_ble_filter_list_add_accept(const xf_ble_addr_t *addr);
+
+/**
+ * @brief BLE 过滤列表: 从期望的过滤接受列表删除地址 (提交后生效)
+ *
+ * @param addr 地址
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      地址不存在
+ */
+xf_err_t xf_ble_filter_list_del_accept(const xf_ble_addr_t *addr);
+
+/**
+ * @brief BLE 过滤列表: 设置期望的解析列表 (提交后生效)
+ *
+ * @param entry_set 条目集合，见 @ref xf_ble_filter_list_rl_entry_t ， num 为 0 时可为 NULL
+ * @param num 条目数量
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NO_MEM         超过 XF_BLE_FILTER_LIST_RESOLVING_NUM
+ */
+xf_err_t xf_ble_filter_list_set_resolving(
+    const xf_ble_filter_list_rl_entry_t *entry_set, uint8_t num);
+
+/**
+ * @brief BLE 过滤列表: 向期望的解析列表添加条目 (同一身份地址已存在时替换其 IRK ，提交后生效)
+ *
+ * @param entry 条目，见 @ref xf_ble_filter_list_rl_entry_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NO_MEM         超过 XF_BLE_FILTER_LIST_RESOLVING_NUM
+ */
+xf_err_t xf_ble_filter_list_add_resolving(const xf_ble_filter_list_rl_entry_t *entry);
+
+/**
+ * @brief BLE 过滤列表: 从期望的解析列表删除条目 (提交后生效)
+ *
+ * @param id_addr 对端身份地址
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      条目不存在
+ */
+xf_err_t xf_ble_filter_list_del_resolving(const xf_ble_addr_t *id_addr);
+
+/**
+ * @brief BLE 过滤列表: 提交，使控制器中的列表与期望状态一致
+ *
+ * @note 无变化时不发出任何命令，也不暂停任何活动；
+ *  命令失败时本地镜像仅记录已成功的命令，下次提交继续补齐差异
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_BUSY           正在提交 (重入)
+ *      - (OTHER)               第一个失败的列表命令的错误码 (已暂停的活动仍会恢复)
+ */
+xf_err_t xf_ble_filter_list_commit(void);
+
+/**
+ * @brief BLE 过滤列表: 获取统计
+ *
+ * @param[out] stats 统计，见 @ref xf_ble_filter_list_stats_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_ble_filter_list_get_stats(xf_ble_filter_list_stats_t *stats);
+
+/**
+ * @brief BLE 过滤列表: 开启扫描 (同 xf_ble_gap_start_scan() ，并记录扫描参数以便暂停后恢复)
+ *
+ * @param param 扫描参数，见 @ref xf_ble_gap_scan_param_t
+ * @return xf_err_t 同 xf_ble_gap_start_scan()
+ */
+xf_err_t xf_ble_filter_list_start_scan(const xf_ble_gap_scan_param_t *param);
+
+/**
+ * @brief BLE 过滤列表: 停止扫描 (同 xf_ble_gap_stop_scan())
+ *
+ * @return xf_err_t 同 xf_ble_gap_stop_scan()
+ */
+xf_err_t xf_ble_filter_list_stop_scan(void);
+
+/**
+ * @brief BLE 过滤列表: 开启广播 (同 xf_ble_gap_start_adv() ，并记录广播以便暂停后恢复)
+ *
+ * @param adv_id 广播 ID (小于 XF_BLE_FILTER_LIST_ADV_NUM)
+ * @param duration 广告时长，0 表示始终开启；暂停后恢复时重新计时
+ * @param filter_policy 创建该广播时使用的过滤策略，见 @ref xf_ble_gap_adv_filter_policy_t
+ * @return xf_err_t
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - (OTHER)               同 xf_ble_gap_start_adv()
+ *
+ * @note 广播时长到期或因被连接而结束时，需调用 xf_ble_filter_list_stop_adv() 同步状态
+ */
+xf_err_t xf_ble_filter_list_start_adv(xf_ble_adv_id_t adv_id, uint16_t duration,
+                                      xf_ble_gap_adv_filter_policy_t filter_policy);
+
+/**
+ * @brief BLE 过滤列表: 停止广播 (同 xf_ble_gap_stop_adv())
+ *
+ * @param adv_id 广播 ID
+ * @return xf_err_t 同 xf_ble_gap_stop_adv()
+ */
+xf_err_t xf_ble_filter_list_stop_adv(xf_ble_adv_id_t adv_id);
+
+/**
+ * @brief BLE 过滤列表: 以过滤接受列表发起连接 (同 xf_ble_gap_connect_by_accept_list())
+ *
+ * @note 连接建立 (本端为主机) 后自动结束
+ * @return xf_err_t 同 xf_ble_gap_connect_by_accept_list()
+ */
+xf_err_t xf_ble_filter_list_connect(void);
+
+/**
+ * @brief BLE 过滤列表: 取消以过滤接受列表发起的连接 (同 xf_ble_gap_cancel_connect())
+ *
+ * @return xf_err_t 同 xf_ble_gap_cancel_connect()
+ */
+xf_err_t xf_ble_filter_list_cancel_connect(void);
+
+/**
+ * @brief BLE 过滤列表: 获取供连接管理使用的过滤接受列表操作
+ *
+ * @param[out] ops 过滤接受列表操作，见 @ref xf_ble_conn_mgr_fal_ops_t ，
+ *  可直接传给 xf_ble_conn_mgr_set_fal_ops()
+ */
+void xf_ble_filter_list_get_conn_mgr_ops(xf_ble_conn_mgr_fal_ops_t *ops);
+
+/**
+ * @brief BLE 过滤列表的 GAP 事件处理 (连接)
+ *
+ * @note 需在 GAP 事件回调中调用；仅观察事件，固定返回 XF_BLE_EVT_RES_NOT_HANDLED
+ */
+xf_ble_evt_res_t xf_ble_filter_list_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_FILTER_LIST_H__ */
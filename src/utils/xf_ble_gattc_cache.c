@@ -0,0 +1,254 @@
+/**
+ * @file xf_ble_gattc_cache.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE GATTC 属性值缓存。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_sys.h"
+#include "xf_ble_gatt_client.h"
+#include "xf_ble_trace.h"
+#include "xf_ble_latency.h"
+#include "xf_ble_gattc_cache.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_cache"
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct {
+    bool is_used;
+    bool is_valid;                      /*!< value 是否为有效的缓存值 */
+    xf_ble_conn_id_t conn_id;
+    xf_ble_attr_handle_t handle;
+    uint16_t value_len;
+    uint32_t max_age_ms;
+    uint64_t update_us;                 /*!< 缓存值更新时的时间戳 */
+    uint8_t value[XF_BLE_GATTC_CACHE_VALUE_MAX];
+} cache_entry_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static cache_entry_t *cache_entry_get(xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle);
+static void cache_update(
+    xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle,
+    const uint8_t *value, uint16_t value_len);
+
+/* ==================== [Static Variables] ================================== */
+
+static cache_entry_t s_cache_set[XF_BLE_GATTC_CACHE_ENTRY_MAX] = {0};
+static xf_ble_gattc_cache_stats_t s_cache_stats = {0};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_ble_gattc_cache_enable(
+    xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle, uint32_t max_age_ms)
+{
+    XF_BLE_ENTER_CRITICAL();
+    cache_entry_t *entry = cache_entry_get(conn_id, handle);
+    if (entry == NULL) {
+        for (uint8_t i = 0; i < XF_BLE_GATTC_CACHE_ENTRY_MAX; i++) {
+            if (!s_cache_set[i].is_used) {
+                entry = &s_cache_set[i];
+                break;
+            }
+        }
+        if (entry == NULL) {
+            XF_BLE_EXIT_CRITICAL();
+            XF_LOGE(TAG, "cache entry full");
+            return XF_ERR_NO_MEM;
+        }
+        xf_memset(entry, 0, sizeof(cache_entry_t));
+        entry->conn_id = conn_id;
+        entry->handle = handle;
+        entry->is_used = true;
+    }
+    entry->max_age_ms = max_age_ms;
+    XF_BLE_EXIT_CRITICAL();
+    return XF_OK;
+}
+
+xf_err_t xf_ble_gattc_cache_disable(
+    xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle)
+{
+    XF_BLE_ENTER_CRITICAL();
+    cache_entry_t *entry = cache_entry_get(conn_id, handle);
+    if (entry == NULL) {
+        XF_BLE_EXIT_CRITICAL();
+        return XF_ERR_NOT_FOUND;
+    }
+    entry->is_used = false;
+    entry->is_valid = false;
+    XF_BLE_EXIT_CRITICAL();
+    return XF_OK;
+}
+
+xf_err_t xf_ble_gattc_cache_read(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t handle,
+    uint8_t *buf, uint16_t *len, bool *is_hit)
+{
+    XF_ASSERT((buf != NULL) && (len != NULL) && (is_hit != NULL),
+              XF_ERR_INVALID_ARG, TAG, "buf, len or is_hit == NULL");
+
+    *is_hit = false;
+
+    XF_BLE_ENTER_CRITICAL();
+    cache_entry_t *entry = cache_entry_get(conn_id, handle);
+    if (entry != NULL) {
+        bool is_fresh = entry->is_valid;
+        if (is_fresh && (entry->max_age_ms != XF_BLE_GATTC_CACHE_AGE_FOREVER)) {
+            uint64_t age_us = xf_sys_time_get_us() - entry->update_us;
+            if (age_us > (uint64_t)entry->max_age_ms * 1000) {
+                entry->is_valid = false;
+                is_fresh = false;
+                ++s_cache_stats.expired_cnt;
+            }
+        }
+        if (is_fresh) {
+            if (*len < entry->value_len) {
+                XF_BLE_EXIT_CRITICAL();
+                XF_LOGE(TAG, "buf too small: %u < %u", *len, entry->value_len);
+                return XF_ERR_INVALID_ARG;
+            }
+            xf_memcpy(buf, entry->value, entry->value_len);
+            *len = entry->value_len;
+            *is_hit = true;
+            ++s_cache_stats.hit_cnt;
+            XF_BLE_EXIT_CRITICAL();
+            return XF_OK;
+        }
+        ++s_cache_stats.miss_cnt;
+    }
+    XF_BLE_EXIT_CRITICAL();
+
+    xf_err_t ret = XF_OK;
+    XF_BLE_LATENCY_START(XF_BLE_LATENCY_OP_READ, conn_id, handle);
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GATTC_REQUEST_READ_BY_HANDLE, conn_id, handle,
+                          xf_ble_gattc_request_read_by_handle(app_id, conn_id, handle));
+    if (ret != XF_OK) {
+        XF_BLE_LATENCY_CANCEL(XF_BLE_LATENCY_OP_READ, conn_id, handle);
+    }
+    return ret;
+}
+
+void xf_ble_gattc_cache_invalidate_range(
+    xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t start_handle, xf_ble_attr_handle_t end_handle)
+{
+    XF_BLE_ENTER_CRITICAL();
+    for (uint8_t i = 0; i < XF_BLE_GATTC_CACHE_ENTRY_MAX; i++) {
+        cache_entry_t *entry = &s_cache_set[i];
+        if (entry->is_used && (entry->conn_id == conn_id)
+                && (entry->handle >= start_handle) && (entry->handle <= end_handle)) {
+            entry->is_valid = false;
+        }
+    }
+    XF_BLE_EXIT_CRITICAL();
+}
+
+void xf_ble_gattc_cache_clear_conn(xf_ble_conn_id_t conn_id)
+{
+    XF_BLE_ENTER_CRITICAL();
+    for (uint8_t i = 0; i < XF_BLE_GATTC_CACHE_ENTRY_MAX; i++) {
+        if (s_cache_set[i].conn_id == conn_id) {
+            s_cache_set[i].is_used = false;
+            s_cache_set[i].is_valid = false;
+        }
+    }
+    XF_BLE_EXIT_CRITICAL();
+}
+
+xf_err_t xf_ble_gattc_cache_get_stats(xf_ble_gattc_cache_stats_t *stats)
+{
+    XF_ASSERT(stats != NULL, XF_ERR_INVALID_ARG, TAG, "stats == NULL");
+    XF_BLE_ENTER_CRITICAL();
+    *stats = s_cache_stats;
+    XF_BLE_EXIT_CRITICAL();
+    return XF_OK;
+}
+
+void xf_ble_gattc_cache_reset_stats(void)
+{
+    XF_BLE_ENTER_CRITICAL();
+    xf_memset(&s_cache_stats, 0, sizeof(s_cache_stats));
+    XF_BLE_EXIT_CRITICAL();
+}
+
+xf_ble_evt_res_t xf_ble_gattc_cache_event_handler(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param)
+{
+    if (param == NULL) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+    switch (event) {
+    case XF_BLE_GATTC_EVT_READ_CFM:
+        cache_update(param->read_cfm.conn_id, param->read_cfm.handle,
+                     param->read_cfm.value, param->read_cfm.value_len);
+        break;
+    case XF_BLE_GATTC_EVT_NOTIFICATION:
+        cache_update(param->ntf.conn_id, param->ntf.handle,
+                     param->ntf.value, param->ntf.value_len);
+        break;
+    case XF_BLE_GATTC_EVT_INDICATION:
+        cache_update(param->ind.conn_id, param->ind.handle,
+                     param->ind.value, param->ind.value_len);
+        break;
+    default:
+        break;
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static cache_entry_t *cache_entry_get(xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle)
+{
+    for (uint8_t i = 0; i < XF_BLE_GATTC_CACHE_ENTRY_MAX; i++) {
+        cache_entry_t *entry = &s_cache_set[i];
+        if (entry->is_used && (entry->conn_id == conn_id) && (entry->handle == handle)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void cache_update(
+    xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle,
+    const uint8_t *value, uint16_t value_len)
+{
+    XF_BLE_ENTER_CRITICAL();
+    cache_entry_t *entry = cache_entry_get(conn_id, handle);
+    if (entry == NULL) {
+        XF_BLE_EXIT_CRITICAL();
+        return;
+    }
+    if ((value_len > XF_BLE_GATTC_CACHE_VALUE_MAX) || ((value == NULL) && (value_len != 0))) {
+        /* 无法缓存的值，同时丢弃旧值，避免读到过时的值 */
+        entry->is_valid = false;
+        XF_BLE_EXIT_CRITICAL();
+        XF_LOGD(TAG, "handle(%d) value not cacheable: %u", handle, value_len);
+        return;
+    }
+    if (value_len != 0) {
+        xf_memcpy(entry->value, value, value_len);
+    }
+    entry->value_len = value_len;
+    entry->update_us = xf_sys_time_get_us();
+    entry->is_valid = true;
+    ++s_cache_stats.update_cnt;
+    XF_BLE_EXIT_CRITICAL();
+}
+
+#endif /* XF_BLE_IS_ENABLE */
@@ -0,0 +1,166 @@
+/**
+ * @file xf_ble_gattc_cache.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE GATTC 属性值缓存。
+ *  按 (conn_id, handle) 缓存读确认及通知/指示中的属性值，
+ *  在设定的最大有效期内的读取直接在本地完成，不产生 ATT 交互。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_GATTC_CACHE_H__
+#define __XF_BLE_GATTC_CACHE_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gatt_client_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble_gatt
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief BLE GATTC 属性值缓存永不过期 (仅由新值覆盖或手动失效)
+ */
+#define XF_BLE_GATTC_CACHE_AGE_FOREVER      (0)
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE GATTC 属性值缓存统计
+ */
+typedef struct {
+    uint32_t hit_cnt;       /*!< 命中次数 (本地完成的读取) */
+    uint32_t miss_cnt;      /*!< 未命中次数 (包括无缓存值及已过期) */
+    uint32_t expired_cnt;   /*!< 未命中中因已过期导致的次数 */
+    uint32_t update_cnt;    /*!< 缓存值被更新的次数 */
+} xf_ble_gattc_cache_stats_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE GATTC 开启 (conn_id, handle) 的属性值缓存
+ *
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param handle 特征值或描述符的句柄
+ * @param max_age_ms 缓存值的最大有效期，单位 ms ，
+ *  XF_BLE_GATTC_CACHE_AGE_FOREVER 表示永不过期
+ * @return xf_err_t
+ *      - XF_OK                 成功 (已开启时更新有效期)
+ *      - XF_ERR_NO_MEM         缓存条目数已达上限
+ */
+xf_err_t xf_ble_gattc_cache_enable(
+    xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle, uint32_t max_age_ms);
+
+/**
+ * @brief BLE GATTC 关闭 (conn_id, handle) 的属性值缓存
+ *
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param handle 特征值或描述符的句柄
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      未开启
+ */
+xf_err_t xf_ble_gattc_cache_disable(
+    xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle);
+
+/**
+ * @brief BLE GATTC 通过缓存读取属性值
+ *
+ * @note 命中时直接将缓存值拷贝至 buf ；
+ *  未命中时发起读请求 (同 xf_ble_gattc_request_read_by_handle() )，
+ *  结果仍通过 XF_BLE_GATTC_EVT_READ_CFM 事件上报，并同时更新缓存。
+ *  未开启缓存的句柄总是发起读请求 (不计入统计)。
+ * @param app_id 客户端 ID (应用 ID)，见 @ref xf_ble_app_id_t
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param handle 特征值或描述符的句柄
+ * @param buf 读取缓冲区
+ * @param[in,out] len 传入缓冲区大小，命中时传出属性值长度
+ * @param[out] is_hit 是否命中
+ * @return xf_err_t
+ *      - XF_OK                 成功 (命中，或未命中且读请求已发起)
+ *      - XF_ERR_INVALID_ARG    无效参数 (包括缓冲区不足以存放缓存值)
+ *      - (OTHER)               @ref xf_err_t
+ */
+xf_err_t xf_ble_gattc_cache_read(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t handle,
+    uint8_t *buf, uint16_t *len, bool *is_hit);
+
+/**
+ * @brief BLE GATTC 使连接的句柄范围内的缓存值失效
+ *
+ * @note 失效仅丢弃缓存值，已开启的缓存设置保留
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param start_handle 起始句柄
+ * @param end_handle 结束句柄
+ */
+void xf_ble_gattc_cache_invalidate_range(
+    xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t start_handle, xf_ble_attr_handle_t end_handle);
+
+/**
+ * @brief BLE GATTC 删除连接的所有缓存 (包括开启的缓存设置)
+ *
+ * @note 一般在断连时调用
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ */
+void xf_ble_gattc_cache_clear_conn(xf_ble_conn_id_t conn_id);
+
+/**
+ * @brief BLE GATTC 获取属性值缓存统计
+ *
+ * @param[out] stats 统计，见 @ref xf_ble_gattc_cache_stats_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_ble_gattc_cache_get_stats(xf_ble_gattc_cache_stats_t *stats);
+
+/**
+ * @brief BLE GATTC 清零属性值缓存统计
+ */
+void xf_ble_gattc_cache_reset_stats(void);
+
+/**
+ * @brief BLE GATTC 属性值缓存的事件处理
+ *
+ * @note 需在 GATTC 事件回调中调用，用于从读确认及通知/指示中更新缓存值
+ * @param event 事件，见 @ref xf_ble_gattc_evt_t
+ * @param param 事件回调参数，见 @ref xf_ble_gattc_evt_cb_param_t
+ * @return xf_ble_evt_res_t 事件处理结果，固定返回 XF_BLE_EVT_RES_NOT_HANDLED ，
+ *  不影响其他模块对同一事件的处理
+ */
+xf_ble_evt_res_t xf_ble_gattc_cache_event_handler(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble_gatt
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_GATTC_CACHE_H__ */
@@ -0,0 +1,320 @@
+/**
+ * @file xf_ble_gattc_db.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE GATTC 服务结构数据库。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_ble_uuid.h"
+#include "xf_ble_gattc_db.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_db"
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct {
+    bool is_used;
+    xf_ble_conn_id_t conn_id;
+    uint32_t version;               /*!< 服务结构版本，每次修改时更新 */
+    xf_ble_gattc_service_found_set_t service_set_info;
+} db_conn_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static db_conn_t *db_conn_get(xf_ble_conn_id_t conn_id);
+static xf_err_t db_service_copy(
+    xf_ble_gattc_service_found_t *dst, const xf_ble_gattc_service_found_t *src);
+static void db_service_free(xf_ble_gattc_service_found_t *service);
+static void db_service_set_free(xf_ble_gattc_service_found_set_t *service_set_info);
+static bool db_service_is_overlap(
+    const xf_ble_gattc_service_found_t *service,
+    xf_ble_attr_handle_t start_handle, xf_ble_attr_handle_t end_handle);
+
+/* ==================== [Static Variables] ================================== */
+
+static db_conn_t s_db_conn_set[XF_BLE_GATTC_DB_CONN_MAX] = {0};
+static uint32_t s_db_version = 0;
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_ble_gattc_db_set(
+    xf_ble_conn_id_t conn_id,
+    const xf_ble_gattc_service_found_set_t *service_set_info)
+{
+    XF_ASSERT(service_set_info != NULL, XF_ERR_INVALID_ARG,
+              TAG, "service_set_info == NULL");
+    XF_ASSERT((service_set_info->cnt == 0) || (service_set_info->set != NULL),
+              XF_ERR_INVALID_ARG, TAG, "service_set_info->set == NULL");
+
+    db_conn_t *db = db_conn_get(conn_id);
+    if (db == NULL) {
+        for (uint8_t i = 0; i < XF_BLE_GATTC_DB_CONN_MAX; i++) {
+            if (!s_db_conn_set[i].is_used) {
+                db = &s_db_conn_set[i];
+                break;
+            }
+        }
+        XF_CHECK(db == NULL, XF_ERR_NO_MEM, TAG, "db conn full");
+    }
+
+    xf_ble_gattc_service_found_set_t copy = {0};
+    if (service_set_info->cnt != 0) {
+        copy.set = xf_malloc(service_set_info->cnt * sizeof(xf_ble_gattc_service_found_t));
+        XF_CHECK(copy.set == NULL, XF_ERR_NO_MEM, TAG, "malloc service set failed!");
+        xf_memset(copy.set, 0, service_set_info->cnt * sizeof(xf_ble_gattc_service_found_t));
+    }
+    for (uint16_t i = 0; i < service_set_info->cnt; i++) {
+        xf_err_t ret = db_service_copy(&copy.set[i], &service_set_info->set[i]);
+        ++copy.cnt;
+        if (ret != XF_OK) {
+            db_service_set_free(&copy);
+            return ret;
+        }
+    }
+
+    if (db->is_used) {
+        db_service_set_free(&db->service_set_info);
+    }
+    db->service_set_info = copy;
+    db->conn_id = conn_id;
+    db->version = ++s_db_version;
+    db->is_used = true;
+    return XF_OK;
+}
+
+xf_err_t xf_ble_gattc_db_merge_range(
+    xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t start_handle, xf_ble_attr_handle_t end_handle,
+    const xf_ble_gattc_service_found_set_t *service_set_info)
+{
+    uint16_t new_cnt = (service_set_info == NULL) ? 0 : service_set_info->cnt;
+    XF_ASSERT((new_cnt == 0) || (service_set_info->set != NULL),
+              XF_ERR_INVALID_ARG, TAG, "service_set_info->set == NULL");
+
+    db_conn_t *db = db_conn_get(conn_id);
+    if (db == NULL) {
+        if (new_cnt == 0) {
+            return XF_OK;
+        }
+        return xf_ble_gattc_db_set(conn_id, service_set_info);
+    }
+
+    uint16_t keep_cnt = 0;
+    for (uint16_t i = 0; i < db->service_set_info.cnt; i++) {
+        if (!db_service_is_overlap(&db->service_set_info.set[i], start_handle, end_handle)) {
+            ++keep_cnt;
+        }
+    }
+
+    xf_ble_gattc_service_found_set_t merged = {0};
+    uint16_t total_cnt = keep_cnt + new_cnt;
+    if (total_cnt != 0) {
+        merged.set = xf_malloc(total_cnt * sizeof(xf_ble_gattc_service_found_t));
+        XF_CHECK(merged.set == NULL, XF_ERR_NO_MEM, TAG, "malloc service set failed!");
+        xf_memset(merged.set, 0, total_cnt * sizeof(xf_ble_gattc_service_found_t));
+    }
+    /* 先完成所有可能失败的深拷贝，失败时原有服务结构不变 */
+    for (uint16_t i = 0; i < new_cnt; i++) {
+        xf_err_t ret = db_service_copy(&merged.set[i], &service_set_info->set[i]);
+        ++merged.cnt;
+        if (ret != XF_OK) {
+            db_service_set_free(&merged);
+            return ret;
+        }
+    }
+    /* 保留的服务直接转移，被替换的服务释放 */
+    for (uint16_t i = 0; i < db->service_set_info.cnt; i++) {
+        xf_ble_gattc_service_found_t *service = &db->service_set_info.set[i];
+        if (db_service_is_overlap(service, start_handle, end_handle)) {
+            db_service_free(service);
+        } else {
+            merged.set[merged.cnt++] = *service;
+        }
+    }
+    if (db->service_set_info.set != NULL) {
+        xf_free(db->service_set_info.set);
+    }
+
+    /* 按起始句柄插入排序 (两部分各自已有序，数量较少) */
+    for (uint16_t i = 1; i < merged.cnt; i++) {
+        xf_ble_gattc_service_found_t tmp = merged.set[i];
+        uint16_t j = i;
+        while ((j > 0) && (merged.set[j - 1].start_hdl > tmp.start_hdl)) {
+            merged.set[j] = merged.set[j - 1];
+            --j;
+        }
+        merged.set[j] = tmp;
+    }
+    db->service_set_info = merged;
+    db->version = ++s_db_version;
+    return XF_OK;
+}
+
+const xf_ble_gattc_service_found_set_t *xf_ble_gattc_db_get(xf_ble_conn_id_t conn_id)
+{
+    db_conn_t *db = db_conn_get(conn_id);
+    return (db == NULL) ? NULL : &db->service_set_info;
+}
+
+xf_err_t xf_ble_gattc_db_get_version(xf_ble_conn_id_t conn_id, uint32_t *version)
+{
+    XF_ASSERT(version != NULL, XF_ERR_INVALID_ARG, TAG, "version == NULL");
+    db_conn_t *db = db_conn_get(conn_id);
+    if (db == NULL) {
+        return XF_ERR_NOT_FOUND;
+    }
+    *version = db->version;
+    return XF_OK;
+}
+
+xf_err_t xf_ble_gattc_db_clear(xf_ble_conn_id_t conn_id)
+{
+    db_conn_t *db = db_conn_get(conn_id);
+    XF_CHECK(db == NULL, XF_ERR_NOT_FOUND, TAG, "conn(%d) not found", conn_id);
+    db_service_set_free(&db->service_set_info);
+    db->is_used = false;
+    return XF_OK;
+}
+
+xf_err_t xf_ble_gattc_db_find_chara_by_value_handle(
+    xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t value_handle,
+    const xf_ble_gattc_chara_found_t **chara)
+{
+    XF_ASSERT(chara != NULL, XF_ERR_INVALID_ARG, TAG, "chara == NULL");
+
+    db_conn_t *db = db_conn_get(conn_id);
+    if (db == NULL) {
+        return XF_ERR_NOT_FOUND;
+    }
+    for (uint16_t i = 0; i < db->service_set_info.cnt; i++) {
+        const xf_ble_gattc_service_found_t *service = &db->service_set_info.set[i];
+        if ((value_handle < service->start_hdl) || (value_handle > service->end_hdl)) {
+            continue;
+        }
+        for (uint16_t j = 0; j < service->chara_set_info.cnt; j++) {
+            if (service->chara_set_info.set[j].value_handle == value_handle) {
+                *chara = &service->chara_set_info.set[j];
+                return XF_OK;
+            }
+        }
+    }
+    return XF_ERR_NOT_FOUND;
+}
+
+xf_err_t xf_ble_gattc_db_get_cccd_handle(
+    xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t value_handle,
+    xf_ble_attr_handle_t *cccd_handle)
+{
+    XF_ASSERT(cccd_handle != NULL, XF_ERR_INVALID_ARG, TAG, "cccd_handle == NULL");
+
+    const xf_ble_gattc_chara_found_t *chara = NULL;
+    xf_err_t ret = xf_ble_gattc_db_find_chara_by_value_handle(conn_id, value_handle, &chara);
+    if (ret != XF_OK) {
+        return ret;
+    }
+    for (uint16_t i = 0; i < chara->desc_set_info.cnt; i++) {
+        const xf_ble_gattc_desc_found_t *desc = &chara->desc_set_info.set[i];
+        if (xf_ble_uuid_equal(&desc->uuid, XF_BLE_UUID16_DECLARE(XF_BLE_GATT_UUID16_CCCD))) {
+            *cccd_handle = desc->handle;
+            return XF_OK;
+        }
+    }
+    return XF_ERR_NOT_FOUND;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static db_conn_t *db_conn_get(xf_ble_conn_id_t conn_id)
+{
+    for (uint8_t i = 0; i < XF_BLE_GATTC_DB_CONN_MAX; i++) {
+        if (s_db_conn_set[i].is_used && (s_db_conn_set[i].conn_id == conn_id)) {
+            return &s_db_conn_set[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 深拷贝一个服务 (包含特征及描述符)，失败时 dst 中已分配的部分仍需由调用者释放
+ */
+static xf_err_t db_service_copy(
+    xf_ble_gattc_service_found_t *dst, const xf_ble_gattc_service_found_t *src)
+{
+    *dst = *src;
+    dst->chara_set_info.cnt = 0;
+    dst->chara_set_info.set = NULL;
+    if ((src->chara_set_info.cnt == 0) || (src->chara_set_info.set == NULL)) {
+        return XF_OK;
+    }
+
+    uint16_t chara_cnt = src->chara_set_info.cnt;
+    dst->chara_set_info.set = xf_malloc(chara_cnt * sizeof(xf_ble_gattc_chara_found_t));
+    XF_CHECK(dst->chara_set_info.set == NULL, XF_ERR_NO_MEM, TAG, "malloc chara set failed!");
+    xf_memset(dst->chara_set_info.set, 0, chara_cnt * sizeof(xf_ble_gattc_chara_found_t));
+    dst->chara_set_info.cnt = chara_cnt;
+
+    for (uint16_t i = 0; i < chara_cnt; i++) {
+        xf_ble_gattc_chara_found_t *dst_chara = &dst->chara_set_info.set[i];
+        const xf_ble_gattc_chara_found_t *src_chara = &src->chara_set_info.set[i];
+        *dst_chara = *src_chara;
+        dst_chara->desc_set_info.cnt = 0;
+        dst_chara->desc_set_info.set = NULL;
+        if ((src_chara->desc_set_info.cnt == 0) || (src_chara->desc_set_info.set == NULL)) {
+            continue;
+        }
+        uint16_t desc_size = src_chara->desc_set_info.cnt * sizeof(xf_ble_gattc_desc_found_t);
+        dst_chara->desc_set_info.set = xf_malloc(desc_size);
+        XF_CHECK(dst_chara->desc_set_info.set == NULL, XF_ERR_NO_MEM,
+                 TAG, "malloc desc set failed!");
+        xf_memcpy(dst_chara->desc_set_info.set, src_chara->desc_set_info.set, desc_size);
+        dst_chara->desc_set_info.cnt = src_chara->desc_set_info.cnt;
+    }
+    return XF_OK;
+}
+
+static void db_service_free(xf_ble_gattc_service_found_t *service)
+{
+    if (service->chara_set_info.set == NULL) {
+        return;
+    }
+    for (uint16_t i = 0; i < service->chara_set_info.cnt; i++) {
+        if (service->chara_set_info.set[i].desc_set_info.set != NULL) {
+            xf_free(service->chara_set_info.set[i].desc_set_info.set);
+        }
+    }
+    xf_free(service->chara_set_info.set);
+    service->chara_set_info.set = NULL;
+    service->chara_set_info.cnt = 0;
+}
+
+static void db_service_set_free(xf_ble_gattc_service_found_set_t *service_set_info)
+{
+    if (service_set_info->set != NULL) {
+        for (uint16_t i = 0; i < service_set_info->cnt; i++) {
+            db_service_free(&service_set_info->set[i]);
+        }
+        xf_free(service_set_info->set);
+    }
+    service_set_info->set = NULL;
+    service_set_info->cnt = 0;
+}
+
+static bool db_service_is_overlap(
+    const xf_ble_gattc_service_found_t *service,
+    xf_ble_attr_handle_t start_handle, xf_ble_attr_handle_t end_handle)
+{
+    return (service->start_hdl <= end_handle) && (service->end_hdl >= start_handle);
+}
+
+#endif /* XF_BLE_IS_ENABLE */
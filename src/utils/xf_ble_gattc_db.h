@@ -0,0 +1,150 @@
+/**
+ * @file xf_ble_gattc_db.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE GATTC 服务结构数据库。
+ *  按连接保存搜寻到的服务结构 (深拷贝)，供订阅管理等模块查询句柄信息。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_GATTC_DB_H__
+#define __XF_BLE_GATTC_DB_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gatt_client_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble_gatt
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE GATTC 保存连接的服务结构
+ *
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param service_set_info 搜寻到的服务集合信息 (包含各服务下的特征、描述符)，
+ *  见 @ref xf_ble_gattc_service_found_set_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NO_MEM         连接数已达上限或内存不足
+ *
+ * @note 内部会对服务结构进行深拷贝，调用后传入的服务结构可自行释放；
+ *  已存在时将替换原有的服务结构。
+ */
+xf_err_t xf_ble_gattc_db_set(
+    xf_ble_conn_id_t conn_id,
+    const xf_ble_gattc_service_found_set_t *service_set_info);
+
+/**
+ * @brief BLE GATTC 将句柄范围内的服务结构合并至连接的服务结构
+ *
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param start_handle 起始句柄
+ * @param end_handle 结束句柄
+ * @param service_set_info 该范围内搜寻到的服务集合信息，
+ *  见 @ref xf_ble_gattc_service_found_set_t ，为 NULL 时仅删除
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NO_MEM         连接数已达上限或内存不足 (此时原有服务结构不变)
+ *
+ * @note 原有与 [start_handle, end_handle] 有交集的服务均被删除，
+ *  再将传入的服务深拷贝后按起始句柄顺序插入，范围外的服务保持不变。
+ */
+xf_err_t xf_ble_gattc_db_merge_range(
+    xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t start_handle, xf_ble_attr_handle_t end_handle,
+    const xf_ble_gattc_service_found_set_t *service_set_info);
+
+/**
+ * @brief BLE GATTC 获取连接的服务结构
+ *
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @return const xf_ble_gattc_service_found_set_t* 服务集合信息，不存在时返回 NULL
+ */
+const xf_ble_gattc_service_found_set_t *xf_ble_gattc_db_get(xf_ble_conn_id_t conn_id);
+
+/**
+ * @brief BLE GATTC 获取连接的服务结构版本
+ *
+ * @note 服务结构每次被保存、合并时版本都会变化 (全局递增，清除后重新保存也不会重复)，
+ *  可用于判断基于服务结构建立的索引等是否已过时
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param[out] version 版本
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      不存在
+ */
+xf_err_t xf_ble_gattc_db_get_version(xf_ble_conn_id_t conn_id, uint32_t *version);
+
+/**
+ * @brief BLE GATTC 清除连接的服务结构
+ *
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      不存在
+ */
+xf_err_t xf_ble_gattc_db_clear(xf_ble_conn_id_t conn_id);
+
+/**
+ * @brief BLE GATTC 通过特征值句柄查找特征
+ *
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param value_handle 特征值句柄
+ * @param[out] chara 找到的特征，见 @ref xf_ble_gattc_chara_found_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      不存在
+ */
+xf_err_t xf_ble_gattc_db_find_chara_by_value_handle(
+    xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t value_handle,
+    const xf_ble_gattc_chara_found_t **chara);
+
+/**
+ * @brief BLE GATTC 获取特征的客户端特征配置描述符 (CCCD) 的句柄
+ *
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param value_handle 特征值句柄
+ * @param[out] cccd_handle CCCD 句柄
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      特征或 CCCD 不存在
+ */
+xf_err_t xf_ble_gattc_db_get_cccd_handle(
+    xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t value_handle,
+    xf_ble_attr_handle_t *cccd_handle);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble_gatt
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_GATTC_DB_H__ */
@@ -0,0 +1,298 @@
+/**
+ * @file xf_ble_gattc_disc.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE GATTC 服务结构搜寻调度。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_sys.h"
+#include "xf_ble_gatt_client.h"
+#include "xf_ble_gattc_db.h"
+#include "xf_ble_trace.h"
+#include "xf_ble_latency.h"
+#include "xf_ble_gattc_disc.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_disc"
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef enum {
+    DISC_STATE_IDLE = 0,
+    DISC_STATE_SERVICE,         /*!< 待搜寻服务 */
+    DISC_STATE_CHARA,           /*!< 待搜寻 chara_index 对应服务下的特征 (及描述符) */
+    DISC_STATE_DONE,            /*!< 已完成，保留耗时记录 */
+} disc_state_t;
+
+typedef struct {
+    disc_state_t state;
+    bool is_busy;               /*!< 是否正在被某个上下文推进 */
+    uint8_t gen;                /*!< 每次开始或取消时递增，用于丢弃过期的推进结果 */
+    xf_ble_app_id_t app_id;
+    xf_ble_conn_id_t conn_id;
+    xf_ble_attr_handle_t start_handle;
+    xf_ble_attr_handle_t end_handle;
+    uint16_t chara_index;
+    xf_ble_gattc_service_found_set_t service_set_info;
+    xf_ble_gattc_disc_done_cb_t done_cb;
+    void *user_data;
+    uint64_t start_us;
+    uint32_t latency_us;
+} disc_conn_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static disc_conn_t *disc_conn_get(xf_ble_conn_id_t conn_id);
+static bool disc_is_active(const disc_conn_t *disc);
+static void disc_step(disc_conn_t *disc);
+static void disc_latency_finish(xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle, xf_err_t ret);
+
+/* ==================== [Static Variables] ================================== */
+
+static disc_conn_t s_disc_conn_set[XF_BLE_GATTC_DISC_CONN_MAX] = {0};
+static uint8_t s_disc_rr_index = 0;
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_ble_gattc_disc_start(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_gattc_disc_done_cb_t done_cb, void *user_data)
+{
+    return xf_ble_gattc_disc_start_range(app_id, conn_id,
+                                         XF_BLE_ATTR_HANDLE_MIN, XF_BLE_ATTR_HANDLE_MAX,
+                                         done_cb, user_data);
+}
+
+xf_err_t xf_ble_gattc_disc_start_range(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t start_handle, xf_ble_attr_handle_t end_handle,
+    xf_ble_gattc_disc_done_cb_t done_cb, void *user_data)
+{
+    XF_ASSERT((start_handle >= XF_BLE_ATTR_HANDLE_MIN) && (start_handle <= end_handle),
+              XF_ERR_INVALID_ARG, TAG, "invalid range: 0x%04X-0x%04X", start_handle, end_handle);
+
+    disc_conn_t *disc = NULL;
+
+    XF_BLE_ENTER_CRITICAL();
+    disc = disc_conn_get(conn_id);
+    if ((disc != NULL) && disc_is_active(disc)) {
+        XF_BLE_EXIT_CRITICAL();
+        XF_LOGW(TAG, "conn(%d) discovering", conn_id);
+        return XF_ERR_BUSY;
+    }
+    if (disc == NULL) {
+        /* 优先使用空闲的，其次复用已完成的 */
+        for (uint8_t i = 0; i < XF_BLE_GATTC_DISC_CONN_MAX; i++) {
+            disc_conn_t *cur = &s_disc_conn_set[i];
+            if (cur->is_busy) {
+                continue;
+            }
+            if (cur->state == DISC_STATE_IDLE) {
+                disc = cur;
+                break;
+            }
+            if ((disc == NULL) && (cur->state == DISC_STATE_DONE)) {
+                disc = cur;
+            }
+        }
+    }
+    if (disc == NULL) {
+        XF_BLE_EXIT_CRITICAL();
+        XF_LOGE(TAG, "disc conn full");
+        return XF_ERR_NO_MEM;
+    }
+    uint8_t gen = disc->gen + 1;
+    xf_memset(disc, 0, sizeof(disc_conn_t));
+    disc->gen = gen;
+    disc->app_id = app_id;
+    disc->conn_id = conn_id;
+    disc->start_handle = start_handle;
+    disc->end_handle = end_handle;
+    disc->done_cb = done_cb;
+    disc->user_data = user_data;
+    disc->start_us = xf_sys_time_get_us();
+    disc->state = DISC_STATE_SERVICE;
+    XF_BLE_EXIT_CRITICAL();
+    return XF_OK;
+}
+
+xf_err_t xf_ble_gattc_disc_cancel(xf_ble_conn_id_t conn_id)
+{
+    XF_BLE_ENTER_CRITICAL();
+    disc_conn_t *disc = disc_conn_get(conn_id);
+    if ((disc == NULL) || !disc_is_active(disc)) {
+        XF_BLE_EXIT_CRITICAL();
+        return XF_ERR_NOT_FOUND;
+    }
+    ++disc->gen;
+    disc->state = DISC_STATE_IDLE;
+    XF_BLE_EXIT_CRITICAL();
+    return XF_OK;
+}
+
+uint8_t xf_ble_gattc_disc_process(void)
+{
+    uint8_t active_cnt = 0;
+    uint8_t start = s_disc_rr_index;
+    s_disc_rr_index = (s_disc_rr_index + 1) % XF_BLE_GATTC_DISC_CONN_MAX;
+
+    for (uint8_t n = 0; n < XF_BLE_GATTC_DISC_CONN_MAX; n++) {
+        disc_conn_t *disc = &s_disc_conn_set[(start + n) % XF_BLE_GATTC_DISC_CONN_MAX];
+
+        XF_BLE_ENTER_CRITICAL();
+        if (!disc_is_active(disc)) {
+            XF_BLE_EXIT_CRITICAL();
+            continue;
+        }
+        if (disc->is_busy) {
+            /* 正在被其他上下文推进 */
+            XF_BLE_EXIT_CRITICAL();
+            ++active_cnt;
+            continue;
+        }
+        disc->is_busy = true;
+        XF_BLE_EXIT_CRITICAL();
+
+        disc_step(disc);
+
+        XF_BLE_ENTER_CRITICAL();
+        disc->is_busy = false;
+        if (disc_is_active(disc)) {
+            ++active_cnt;
+        }
+        XF_BLE_EXIT_CRITICAL();
+    }
+    return active_cnt;
+}
+
+xf_err_t xf_ble_gattc_disc_get_latency(xf_ble_conn_id_t conn_id, uint32_t *latency_us)
+{
+    XF_ASSERT(latency_us != NULL, XF_ERR_INVALID_ARG, TAG, "latency_us == NULL");
+    disc_conn_t *disc = disc_conn_get(conn_id);
+    if ((disc == NULL) || (disc->state != DISC_STATE_DONE)) {
+        return XF_ERR_NOT_FOUND;
+    }
+    *latency_us = disc->latency_us;
+    return XF_OK;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static disc_conn_t *disc_conn_get(xf_ble_conn_id_t conn_id)
+{
+    for (uint8_t i = 0; i < XF_BLE_GATTC_DISC_CONN_MAX; i++) {
+        disc_conn_t *disc = &s_disc_conn_set[i];
+        if ((disc->state != DISC_STATE_IDLE) && (disc->conn_id == conn_id)) {
+            return disc;
+        }
+    }
+    return NULL;
+}
+
+static bool disc_is_active(const disc_conn_t *disc)
+{
+    return (disc->state == DISC_STATE_SERVICE) || (disc->state == DISC_STATE_CHARA);
+}
+
+/**
+ * @brief 推进一个连接的搜寻状态机一步 (发起一次搜寻请求)
+ *
+ * @note 特征下的描述符由平台侧在搜寻特征时一并填入 desc_set_info ，故无单独的描述符阶段。
+ *  搜寻结果的内存由平台侧管理，完成后深拷贝并合并至服务结构数据库的对应句柄范围。
+ */
+static void disc_step(disc_conn_t *disc)
+{
+    uint8_t gen = disc->gen;
+    disc_state_t state = disc->state;
+    xf_err_t ret = XF_OK;
+
+    if (state == DISC_STATE_SERVICE) {
+        XF_BLE_LATENCY_START(XF_BLE_LATENCY_OP_DISCOVER, disc->conn_id, disc->start_handle);
+        XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GATTC_DISCOVER_SERVICE, disc->conn_id, disc->start_handle,
+                              xf_ble_gattc_discover_service(disc->app_id, disc->conn_id, disc->start_handle,
+                                                            disc->end_handle, NULL, &disc->service_set_info));
+        disc_latency_finish(disc->conn_id, disc->start_handle, ret);
+    } else if (disc->chara_index < disc->service_set_info.cnt) {
+        xf_ble_gattc_service_found_t *service = &disc->service_set_info.set[disc->chara_index];
+        XF_BLE_LATENCY_START(XF_BLE_LATENCY_OP_DISCOVER, disc->conn_id, service->start_hdl);
+        XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GATTC_DISCOVER_CHARA, disc->conn_id, service->start_hdl,
+                              xf_ble_gattc_discover_chara(disc->app_id, disc->conn_id, service->start_hdl,
+                                                          service->end_hdl, NULL, &service->chara_set_info));
+        disc_latency_finish(disc->conn_id, service->start_hdl, ret);
+    }
+
+    /* 搜寻请求为同步调用，期间可能已被取消：此时丢弃结果，不得改动状态 (否则会恢复已取消的搜寻) */
+    XF_BLE_ENTER_CRITICAL();
+    if (gen != disc->gen) {
+        XF_BLE_EXIT_CRITICAL();
+        return;
+    }
+    if (state == DISC_STATE_SERVICE) {
+        if (ret == XF_OK) {
+            disc->chara_index = 0;
+            disc->state = DISC_STATE_CHARA;
+        }
+    } else {
+        ++disc->chara_index;
+    }
+    XF_BLE_EXIT_CRITICAL();
+
+    bool is_done = (ret != XF_OK)
+                   || ((disc->state == DISC_STATE_CHARA)
+                       && (disc->chara_index >= disc->service_set_info.cnt));
+    if (!is_done) {
+        return;
+    }
+    if (ret == XF_OK) {
+        ret = xf_ble_gattc_db_merge_range(disc->conn_id,
+                                          disc->start_handle, disc->end_handle,
+                                          &disc->service_set_info);
+    }
+
+    XF_BLE_ENTER_CRITICAL();
+    if (gen != disc->gen) {
+        /* 推进期间已被取消或重新开始 */
+        XF_BLE_EXIT_CRITICAL();
+        return;
+    }
+    disc->latency_us = (uint32_t)(xf_sys_time_get_us() - disc->start_us);
+    disc->state = DISC_STATE_DONE;
+    XF_BLE_EXIT_CRITICAL();
+
+    xf_ble_gattc_disc_result_t result = {
+        .app_id = disc->app_id,
+        .conn_id = disc->conn_id,
+        .result = ret,
+        .service_cnt = disc->service_set_info.cnt,
+        .latency_us = disc->latency_us,
+    };
+    XF_LOGD(TAG, "conn(%d) disc done:%d, %u us", disc->conn_id, (int)ret,
+            (unsigned)disc->latency_us);
+    if (disc->done_cb != NULL) {
+        disc->done_cb(&result, disc->user_data);
+    }
+}
+
+/**
+ * @brief 搜寻请求同步返回结果，返回即完成
+ */
+static void disc_latency_finish(xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle, xf_err_t ret)
+{
+    if (ret == XF_OK) {
+        XF_BLE_LATENCY_FINISH(XF_BLE_LATENCY_OP_DISCOVER, conn_id, handle);
+    } else {
+        XF_BLE_LATENCY_CANCEL(XF_BLE_LATENCY_OP_DISCOVER, conn_id, handle);
+    }
+}
+
+#endif /* XF_BLE_IS_ENABLE */
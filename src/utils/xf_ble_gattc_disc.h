@@ -0,0 +1,148 @@
+/**
+ * @file xf_ble_gattc_disc.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE GATTC 服务结构搜寻调度。
+ *  为每个连接维护一个搜寻状态机 (服务 -> 各服务下的特征及描述符)，
+ *  多个连接间轮转推进，每个连接完成后保存至服务结构数据库并回调通知。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_GATTC_DISC_H__
+#define __XF_BLE_GATTC_DISC_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gatt_client_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble_gatt
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE GATTC 服务结构搜寻结果
+ */
+typedef struct {
+    xf_ble_app_id_t app_id;                 /*!< 客户端 ID (应用 ID) */
+    xf_ble_conn_id_t conn_id;               /*!< 连接 ID (链接 ID ) */
+    xf_err_t result;                        /*!< 搜寻结果，XF_OK 表示成功，
+                                             *  此时服务结构已保存至数据库，见 xf_ble_gattc_db_get() */
+    uint16_t service_cnt;                   /*!< 搜寻到的服务个数 */
+    uint32_t latency_us;                    /*!< 从开始搜寻到完成的耗时，单位 us */
+} xf_ble_gattc_disc_result_t;
+
+/**
+ * @brief BLE GATTC 服务结构搜寻完成回调
+ *
+ * @param result 搜寻结果，见 @ref xf_ble_gattc_disc_result_t
+ * @param user_data 用户数据
+ */
+typedef void (*xf_ble_gattc_disc_done_cb_t)(
+    const xf_ble_gattc_disc_result_t *result, void *user_data);
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE GATTC 开始搜寻连接的服务结构
+ *
+ * @note 仅将搜寻加入调度，实际搜寻在 xf_ble_gattc_disc_process() 中推进
+ * @param app_id 客户端 ID (应用 ID)，见 @ref xf_ble_app_id_t
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param done_cb 搜寻完成回调，见 @ref xf_ble_gattc_disc_done_cb_t
+ * @param user_data 用户数据
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_BUSY           该连接正在搜寻
+ *      - XF_ERR_NO_MEM         同时搜寻的连接数已达上限
+ */
+xf_err_t xf_ble_gattc_disc_start(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_gattc_disc_done_cb_t done_cb, void *user_data);
+
+/**
+ * @brief BLE GATTC 开始搜寻连接指定句柄范围内的服务结构
+ *
+ * @note 完成后仅替换服务结构数据库中该范围内的服务，见 xf_ble_gattc_db_merge_range() ，
+ *  用于服务变更 (Service Changed) 后的增量搜寻
+ * @param app_id 客户端 ID (应用 ID)，见 @ref xf_ble_app_id_t
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param start_handle 起始句柄
+ * @param end_handle 结束句柄
+ * @param done_cb 搜寻完成回调，见 @ref xf_ble_gattc_disc_done_cb_t
+ * @param user_data 用户数据
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效句柄范围
+ *      - XF_ERR_BUSY           该连接正在搜寻
+ *      - XF_ERR_NO_MEM         同时搜寻的连接数已达上限
+ */
+xf_err_t xf_ble_gattc_disc_start_range(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t start_handle, xf_ble_attr_handle_t end_handle,
+    xf_ble_gattc_disc_done_cb_t done_cb, void *user_data);
+
+/**
+ * @brief BLE GATTC 取消搜寻连接的服务结构
+ *
+ * @note 一般在断连时调用，不会触发完成回调
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      该连接未在搜寻
+ */
+xf_err_t xf_ble_gattc_disc_cancel(xf_ble_conn_id_t conn_id);
+
+/**
+ * @brief BLE GATTC 推进服务结构搜寻
+ *
+ * @note 每次调用为每个正在搜寻的连接各发起一次搜寻请求 (一个服务或一个服务下的特征)，
+ *  多个连接间轮转进行，避免单个连接长时间占用。
+ *  平台的搜寻接口为同步调用，单个调用者会依次推进各连接 (链路间串行)；
+ *  若需多个链路上同时有搜寻请求在进行，需每个链路各有一个工作线程调用本函数，
+ *  正在被某个线程推进的连接会被其他线程跳过。
+ * @return uint8_t 仍在搜寻中的连接的数量
+ */
+uint8_t xf_ble_gattc_disc_process(void);
+
+/**
+ * @brief BLE GATTC 获取连接最近一次服务结构搜寻的耗时
+ *
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param[out] latency_us 耗时，单位 us
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      无已完成的搜寻记录
+ */
+xf_err_t xf_ble_gattc_disc_get_latency(xf_ble_conn_id_t conn_id, uint32_t *latency_us);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble_gatt
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_GATTC_DISC_H__ */
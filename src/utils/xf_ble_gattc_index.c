@@ -0,0 +1,261 @@
+/**
+ * @file xf_ble_gattc_index.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE GATTC 服务结构 UUID 索引。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_ble_gatt_client_types.h"
+#include "xf_ble_gattc_db.h"
+#include "xf_ble_uuid.h"
+#include "xf_ble_gattc_index.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_index"
+
+/* 哈希表存放 entry 下标 + 1 (uint16_t) */
+#define INDEX_ENTRY_MAX     (UINT16_MAX)
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct {
+    uint32_t hash;
+    xf_ble_uuid128_t service_uuid128;
+    xf_ble_uuid128_t chara_uuid128;
+    xf_ble_gattc_chara_info_t info;
+} index_entry_t;
+
+typedef struct {
+    bool is_used;
+    xf_ble_conn_id_t conn_id;
+    uint32_t db_version;        /*!< 建立索引时服务结构的版本 */
+    uint16_t entry_cnt;
+    uint32_t table_size;        /*!< 哈希表大小， 2 的幂 */
+    index_entry_t *entry_set;
+    uint16_t *table;            /*!< 开放寻址哈希表，存放 entry 下标 + 1 ， 0 表示空 */
+} index_conn_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static index_conn_t *index_conn_get(xf_ble_conn_id_t conn_id);
+static index_conn_t *index_conn_prepare(xf_ble_conn_id_t conn_id, xf_err_t *ret);
+static xf_err_t index_build(index_conn_t *index, const xf_ble_gattc_service_found_set_t *db);
+static void index_free(index_conn_t *index);
+static uint32_t index_hash(const xf_ble_uuid128_t *service_uuid128,
+                           const xf_ble_uuid128_t *chara_uuid128);
+
+/* ==================== [Static Variables] ================================== */
+
+static index_conn_t s_index_conn_set[XF_BLE_GATTC_INDEX_CONN_MAX] = {0};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_ble_gattc_find_chara(
+    xf_ble_conn_id_t conn_id,
+    const xf_ble_uuid_info_t *service_uuid,
+    const xf_ble_uuid_info_t *chara_uuid,
+    xf_ble_gattc_chara_info_t *info)
+{
+    XF_ASSERT((chara_uuid != NULL) && (info != NULL), XF_ERR_INVALID_ARG,
+              TAG, "chara_uuid or info == NULL");
+
+    xf_ble_uuid128_t service_uuid128;
+    xf_ble_uuid128_t chara_uuid128;
+    XF_CHECK(!xf_ble_uuid_to_128(chara_uuid, &chara_uuid128), XF_ERR_INVALID_ARG,
+             TAG, "invalid chara uuid type: %d", chara_uuid->type);
+    XF_CHECK((service_uuid != NULL) && !xf_ble_uuid_to_128(service_uuid, &service_uuid128),
+             XF_ERR_INVALID_ARG, TAG, "invalid service uuid type: %d", service_uuid->type);
+
+    xf_err_t ret = XF_OK;
+    index_conn_t *index = index_conn_prepare(conn_id, &ret);
+    if (index == NULL) {
+        return ret;
+    }
+
+    if (service_uuid == NULL) {
+        for (uint16_t i = 0; i < index->entry_cnt; i++) {
+            if (xf_ble_uuid128_equal(&index->entry_set[i].chara_uuid128, &chara_uuid128)) {
+                *info = index->entry_set[i].info;
+                return XF_OK;
+            }
+        }
+        return XF_ERR_NOT_FOUND;
+    }
+
+    uint32_t hash = index_hash(&service_uuid128, &chara_uuid128);
+    uint32_t mask = index->table_size - 1;
+    for (uint32_t pos = hash & mask, n = 0; n < index->table_size; pos = (pos + 1) & mask, n++) {
+        uint16_t slot = index->table[pos];
+        if (slot == 0) {
+            break;
+        }
+        const index_entry_t *entry = &index->entry_set[slot - 1];
+        if ((entry->hash == hash)
+                && xf_ble_uuid128_equal(&entry->chara_uuid128, &chara_uuid128)
+                && xf_ble_uuid128_equal(&entry->service_uuid128, &service_uuid128)) {
+            *info = entry->info;
+            return XF_OK;
+        }
+    }
+    return XF_ERR_NOT_FOUND;
+}
+
+void xf_ble_gattc_index_clear(xf_ble_conn_id_t conn_id)
+{
+    index_conn_t *index = index_conn_get(conn_id);
+    if (index != NULL) {
+        index_free(index);
+    }
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static index_conn_t *index_conn_get(xf_ble_conn_id_t conn_id)
+{
+    for (uint8_t i = 0; i < XF_BLE_GATTC_INDEX_CONN_MAX; i++) {
+        if (s_index_conn_set[i].is_used && (s_index_conn_set[i].conn_id == conn_id)) {
+            return &s_index_conn_set[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 获取连接的索引，不存在或已过时 (服务结构版本变化) 时重新建立
+ */
+static index_conn_t *index_conn_prepare(xf_ble_conn_id_t conn_id, xf_err_t *ret)
+{
+    uint32_t db_version = 0;
+    index_conn_t *index = index_conn_get(conn_id);
+
+    *ret = xf_ble_gattc_db_get_version(conn_id, &db_version);
+    if (*ret != XF_OK) {
+        /* 服务结构已被清除 */
+        if (index != NULL) {
+            index_free(index);
+        }
+        return NULL;
+    }
+    if ((index != NULL) && (index->db_version == db_version)) {
+        return index;
+    }
+
+    if (index == NULL) {
+        for (uint8_t i = 0; i < XF_BLE_GATTC_INDEX_CONN_MAX; i++) {
+            if (!s_index_conn_set[i].is_used) {
+                index = &s_index_conn_set[i];
+                break;
+            }
+        }
+        if (index == NULL) {
+            XF_LOGE(TAG, "index conn full");
+            *ret = XF_ERR_NO_MEM;
+            return NULL;
+        }
+    } else {
+        index_free(index);
+    }
+
+    *ret = index_build(index, xf_ble_gattc_db_get(conn_id));
+    if (*ret != XF_OK) {
+        index_free(index);
+        return NULL;
+    }
+    index->conn_id = conn_id;
+    index->db_version = db_version;
+    index->is_used = true;
+    return index;
+}
+
+static xf_err_t index_build(index_conn_t *index, const xf_ble_gattc_service_found_set_t *db)
+{
+    uint32_t chara_cnt = 0;
+    for (uint16_t i = 0; i < db->cnt; i++) {
+        chara_cnt += db->set[i].chara_set_info.cnt;
+    }
+    XF_CHECK(chara_cnt > INDEX_ENTRY_MAX, XF_ERR_NO_MEM,
+             TAG, "too many charas: %u", (unsigned int)chara_cnt);
+
+    /* 负载因子不超过 0.5 */
+    uint32_t table_size = 4;
+    while (table_size < chara_cnt * 2) {
+        table_size <<= 1;
+    }
+    if (chara_cnt != 0) {
+        index->entry_set = xf_malloc(chara_cnt * sizeof(index_entry_t));
+        XF_CHECK(index->entry_set == NULL, XF_ERR_NO_MEM, TAG, "malloc entry set failed!");
+    }
+    index->table = xf_malloc(table_size * sizeof(uint16_t));
+    XF_CHECK(index->table == NULL, XF_ERR_NO_MEM, TAG, "malloc table failed!");
+    xf_memset(index->table, 0, table_size * sizeof(uint16_t));
+    index->table_size = table_size;
+    index->entry_cnt = 0;
+
+    uint32_t mask = table_size - 1;
+    for (uint16_t i = 0; i < db->cnt; i++) {
+        const xf_ble_gattc_service_found_t *service = &db->set[i];
+        xf_ble_uuid128_t service_uuid128;
+        if (!xf_ble_uuid_to_128(&service->uuid, &service_uuid128)) {
+            continue;
+        }
+        for (uint16_t j = 0; j < service->chara_set_info.cnt; j++) {
+            const xf_ble_gattc_chara_found_t *chara = &service->chara_set_info.set[j];
+            index_entry_t *entry = &index->entry_set[index->entry_cnt];
+            if (!xf_ble_uuid_to_128(&chara->uuid, &entry->chara_uuid128)) {
+                continue;
+            }
+            entry->service_uuid128 = service_uuid128;
+            entry->hash = index_hash(&entry->service_uuid128, &entry->chara_uuid128);
+            entry->info.value_handle = chara->value_handle;
+            entry->info.props = chara->props;
+            entry->info.cccd_handle = XF_BLE_ATTR_HANDLE_INVALID;
+            for (uint16_t k = 0; k < chara->desc_set_info.cnt; k++) {
+                const xf_ble_gattc_desc_found_t *desc = &chara->desc_set_info.set[k];
+                if (xf_ble_uuid_equal(&desc->uuid, XF_BLE_UUID16_DECLARE(XF_BLE_GATT_UUID16_CCCD))) {
+                    entry->info.cccd_handle = desc->handle;
+                    break;
+                }
+            }
+            /* 服务结构按句柄顺序排列，相同键先插入者先被探测到 */
+            uint32_t pos = entry->hash & mask;
+            while (index->table[pos] != 0) {
+                pos = (pos + 1) & mask;
+            }
+            index->table[pos] = ++index->entry_cnt;
+        }
+    }
+    return XF_OK;
+}
+
+static void index_free(index_conn_t *index)
+{
+    if (index->entry_set != NULL) {
+        xf_free(index->entry_set);
+    }
+    if (index->table != NULL) {
+        xf_free(index->table);
+    }
+    xf_memset(index, 0, sizeof(index_conn_t));
+}
+
+/**
+ * @brief 组合服务 UUID 与特征 UUID 的哈希
+ */
+static uint32_t index_hash(const xf_ble_uuid128_t *service_uuid128,
+                           const xf_ble_uuid128_t *chara_uuid128)
+{
+    uint32_t hash = xf_ble_uuid128_hash(service_uuid128);
+    return (hash * 0x9E3779B1U) ^ xf_ble_uuid128_hash(chara_uuid128);
+}
+
+#endif /* XF_BLE_IS_ENABLE */
@@ -0,0 +1,94 @@
+/**
+ * @file xf_ble_gattc_index.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE GATTC 服务结构 UUID 索引。
+ *  基于服务结构数据库，为每个连接建立 (服务 UUID, 特征 UUID) -> 特征信息 的哈希索引，
+ *  UUID 统一转换为 128-bit 形式后比较，避免逐个遍历服务结构。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_GATTC_INDEX_H__
+#define __XF_BLE_GATTC_INDEX_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gatt_common.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble_gatt
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE GATTC 通过 UUID 查找到的特征信息
+ */
+typedef struct {
+    xf_ble_attr_handle_t value_handle;      /*!< 特征值句柄 */
+    xf_ble_gatt_chara_property_t props;     /*!< 特征特性，见 @ref xf_ble_gatt_chara_property_t */
+    xf_ble_attr_handle_t cccd_handle;       /*!< CCCD 句柄，不存在时为 XF_BLE_ATTR_HANDLE_INVALID */
+} xf_ble_gattc_chara_info_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE GATTC 通过服务 UUID 及特征 UUID 查找特征
+ *
+ * @note 首次查找 (或服务结构变化后的首次查找) 时根据服务结构数据库建立索引，之后为哈希查找。
+ *  16-bit 、 32-bit UUID 按蓝牙基础 UUID 转换为 128-bit 后比较，
+ *  即同一 UUID 的不同长度形式视为相同 (128-bit UUID 按小端字节序)。
+ *  存在多个相同 UUID 的特征时返回句柄最小的一个。
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param service_uuid 服务 UUID ，为 NULL 时匹配任意服务 (遍历查找)
+ * @param chara_uuid 特征 UUID
+ * @param[out] info 特征信息，见 @ref xf_ble_gattc_chara_info_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      不存在 (包括服务结构未保存至数据库)
+ *      - XF_ERR_NO_MEM         建立索引时内存不足或连接数已达上限
+ */
+xf_err_t xf_ble_gattc_find_chara(
+    xf_ble_conn_id_t conn_id,
+    const xf_ble_uuid_info_t *service_uuid,
+    const xf_ble_uuid_info_t *chara_uuid,
+    xf_ble_gattc_chara_info_t *info);
+
+/**
+ * @brief BLE GATTC 删除连接的 UUID 索引
+ *
+ * @note 一般在断连时调用；服务结构变化时索引会自动重建，无需调用
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ */
+void xf_ble_gattc_index_clear(xf_ble_conn_id_t conn_id);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble_gatt
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_GATTC_INDEX_H__ */
@@ -0,0 +1,201 @@
+/**
+ * @file xf_ble_gattc_ntf.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE GATTC 通知/指示分发表。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_ble_gattc_ntf.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_ntf"
+
+#define NTF_TABLE_MASK      (XF_BLE_GATTC_NTF_TABLE_SIZE - 1)
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 分发表表项，handler 为 NULL 表示空闲
+ */
+typedef struct {
+    uint32_t key;                       /*!< (conn_id << 16) | handle */
+    xf_ble_gattc_ntf_handler_t handler;
+    void *user_data;
+} ntf_entry_t;
+
+/* 分发表大小必须为 2 的幂 */
+typedef char ntf_table_size_check_t[
+    ((XF_BLE_GATTC_NTF_TABLE_SIZE & NTF_TABLE_MASK) == 0) ? 1 : -1];
+
+/* ==================== [Static Prototypes] ================================= */
+
+static inline uint32_t ntf_key(xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle);
+static inline uint32_t ntf_home(uint32_t key);
+static int32_t ntf_find(uint32_t key);
+static void ntf_remove_at(uint32_t pos);
+
+/* ==================== [Static Variables] ================================== */
+
+static ntf_entry_t s_ntf_table[XF_BLE_GATTC_NTF_TABLE_SIZE] = {0};
+static uint16_t s_ntf_cnt = 0;
+static bool s_is_drop_unregistered = false;
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_ble_gattc_ntf_handler_register(
+    xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle,
+    xf_ble_gattc_ntf_handler_t handler, void *user_data)
+{
+    XF_ASSERT(handler != NULL, XF_ERR_INVALID_ARG, TAG, "handler == NULL");
+    XF_ASSERT(handle != XF_BLE_ATTR_HANDLE_INVALID, XF_ERR_INVALID_ARG,
+              TAG, "handle invalid");
+
+    uint32_t key = ntf_key(conn_id, handle);
+
+    XF_BLE_ENTER_CRITICAL();
+    int32_t pos = ntf_find(key);
+    if (pos < 0) {
+        /* 保留至少一个空位，保证查找总能终止 */
+        if (s_ntf_cnt >= (XF_BLE_GATTC_NTF_TABLE_SIZE - 1)) {
+            XF_BLE_EXIT_CRITICAL();
+            XF_LOGE(TAG, "ntf table full");
+            return XF_ERR_NO_MEM;
+        }
+        pos = ntf_home(key);
+        while (s_ntf_table[pos].handler != NULL) {
+            pos = (pos + 1) & NTF_TABLE_MASK;
+        }
+        ++s_ntf_cnt;
+    }
+    s_ntf_table[pos].key = key;
+    s_ntf_table[pos].user_data = user_data;
+    s_ntf_table[pos].handler = handler;
+    XF_BLE_EXIT_CRITICAL();
+    return XF_OK;
+}
+
+xf_err_t xf_ble_gattc_ntf_handler_unregister(
+    xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle)
+{
+    XF_BLE_ENTER_CRITICAL();
+    int32_t pos = ntf_find(ntf_key(conn_id, handle));
+    if (pos >= 0) {
+        ntf_remove_at(pos);
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return (pos >= 0) ? XF_OK : XF_ERR_NOT_FOUND;
+}
+
+xf_err_t xf_ble_gattc_ntf_handler_unregister_conn(xf_ble_conn_id_t conn_id)
+{
+    XF_BLE_ENTER_CRITICAL();
+    uint32_t pos = 0;
+    while (pos < XF_BLE_GATTC_NTF_TABLE_SIZE) {
+        if ((s_ntf_table[pos].handler != NULL)
+                && ((s_ntf_table[pos].key >> 16) == conn_id)) {
+            /* 删除后可能有后续表项被前移至此，需重新检查当前位置 */
+            ntf_remove_at(pos);
+            continue;
+        }
+        ++pos;
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return XF_OK;
+}
+
+void xf_ble_gattc_ntf_set_drop_unregistered(bool is_drop)
+{
+    s_is_drop_unregistered = is_drop;
+}
+
+xf_ble_evt_res_t xf_ble_gattc_ntf_dispatch(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param)
+{
+    if (((event != XF_BLE_GATTC_EVT_NOTIFICATION) && (event != XF_BLE_GATTC_EVT_INDICATION))
+            || (param == NULL)) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+
+    xf_ble_gattc_ntf_handler_t handler = NULL;
+    void *user_data = NULL;
+
+    XF_BLE_ENTER_CRITICAL();
+    int32_t pos = ntf_find(ntf_key(param->ntf.conn_id, param->ntf.handle));
+    if (pos >= 0) {
+        handler = s_ntf_table[pos].handler;
+        user_data = s_ntf_table[pos].user_data;
+    }
+    XF_BLE_EXIT_CRITICAL();
+
+    if (handler == NULL) {
+        return s_is_drop_unregistered ? XF_BLE_EVT_RES_HANDLED : XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+    handler(event, &param->ntf, user_data);
+    return XF_BLE_EVT_RES_HANDLED;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static inline uint32_t ntf_key(xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle)
+{
+    return ((uint32_t)conn_id << 16) | handle;
+}
+
+static inline uint32_t ntf_home(uint32_t key)
+{
+    uint32_t h = key * 0x9E3779B1U;
+    return (h ^ (h >> 16)) & NTF_TABLE_MASK;
+}
+
+static int32_t ntf_find(uint32_t key)
+{
+    uint32_t pos = ntf_home(key);
+    while (s_ntf_table[pos].handler != NULL) {
+        if (s_ntf_table[pos].key == key) {
+            return (int32_t)pos;
+        }
+        pos = (pos + 1) & NTF_TABLE_MASK;
+    }
+    return -1;
+}
+
+/**
+ * @brief 删除表项 (线性探测的后移删除，不使用墓碑标记)
+ */
+static void ntf_remove_at(uint32_t pos)
+{
+    uint32_t hole = pos;
+    uint32_t next = pos;
+    for (;;) {
+        next = (next + 1) & NTF_TABLE_MASK;
+        if (s_ntf_table[next].handler == NULL) {
+            break;
+        }
+        uint32_t home = ntf_home(s_ntf_table[next].key);
+        /* home 不在 (hole, next] 区间内时，该表项可前移填补空洞 */
+        bool in_range = (hole <= next)
+                        ? ((home > hole) && (home <= next))
+                        : ((home > hole) || (home <= next));
+        if (!in_range) {
+            s_ntf_table[hole] = s_ntf_table[next];
+            hole = next;
+        }
+    }
+    s_ntf_table[hole].handler = NULL;
+    s_ntf_table[hole].user_data = NULL;
+    s_ntf_table[hole].key = 0;
+    --s_ntf_cnt;
+}
+
+#endif /* XF_BLE_IS_ENABLE */
@@ -0,0 +1,126 @@
+/**
+ * @file xf_ble_gattc_ntf.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE GATTC 通知/指示分发表。
+ *  按 (conn_id, handle) 注册处理函数，收到通知或指示时直接查表 (O(1)) 调用对应的处理函数。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_GATTC_NTF_H__
+#define __XF_BLE_GATTC_NTF_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gatt_client_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble_gatt
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE GATTC 通知/指示处理函数原型
+ *
+ * @param event 事件，XF_BLE_GATTC_EVT_NOTIFICATION 或 XF_BLE_GATTC_EVT_INDICATION
+ * @param param 通知/指示事件的参数，见 @ref xf_ble_gattc_evt_param_ntf_t
+ * @param user_data 注册时传入的用户数据
+ */
+typedef void (*xf_ble_gattc_ntf_handler_t)(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_param_ntf_t *param,
+    void *user_data);
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE GATTC 注册 (conn_id, handle) 对应的通知/指示处理函数
+ *
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param handle 特征值句柄
+ * @param handler 处理函数，见 @ref xf_ble_gattc_ntf_handler_t
+ * @param user_data 用户数据，调用处理函数时传入
+ * @return xf_err_t
+ *      - XF_OK                 成功 (已存在时将覆盖原处理函数)
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NO_MEM         分发表已满
+ */
+xf_err_t xf_ble_gattc_ntf_handler_register(
+    xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle,
+    xf_ble_gattc_ntf_handler_t handler, void *user_data);
+
+/**
+ * @brief BLE GATTC 注销 (conn_id, handle) 对应的通知/指示处理函数
+ *
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param handle 特征值句柄
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      未注册
+ */
+xf_err_t xf_ble_gattc_ntf_handler_unregister(
+    xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle);
+
+/**
+ * @brief BLE GATTC 注销某个连接下所有的通知/指示处理函数
+ *
+ * @note 一般在断连时调用
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ */
+xf_err_t xf_ble_gattc_ntf_handler_unregister_conn(xf_ble_conn_id_t conn_id);
+
+/**
+ * @brief BLE GATTC 设置是否丢弃未注册的通知/指示
+ *
+ * @param is_drop
+ *      - true      未注册的通知/指示在分发时直接视为已处理 (丢弃)
+ *      - false     未注册的通知/指示返回未处理，交由后续的事件回调处理 (默认)
+ */
+void xf_ble_gattc_ntf_set_drop_unregistered(bool is_drop);
+
+/**
+ * @brief BLE GATTC 通知/指示分发
+ *
+ * @note 需在 GATTC 事件回调中调用
+ * @param event 事件，见 @ref xf_ble_gattc_evt_t
+ * @param param 事件回调参数，见 @ref xf_ble_gattc_evt_cb_param_t
+ * @return xf_ble_evt_res_t 事件处理结果
+ *      - XF_BLE_EVT_RES_NOT_HANDLED    非通知/指示事件，或未注册且未设置丢弃
+ *      - XF_BLE_EVT_RES_HANDLED        已分发至处理函数，或已丢弃
+ */
+xf_ble_evt_res_t xf_ble_gattc_ntf_dispatch(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble_gatt
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_GATTC_NTF_H__ */
@@ -0,0 +1,364 @@
+/**
+ * @file xf_ble_gattc_stream.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE GATTC 流式发送 (写命令)。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_sys.h"
+#include "xf_ble_gatt_client.h"
+#include "xf_ble_pool.h"
+#include "xf_ble_conn_table.h"
+#include "xf_ble_conn_param_mgr.h"
+#include "xf_ble_trace.h"
+#include "xf_ble_gattc_stream.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_stream"
+
+#define STREAM_MTU_MIN      (23)
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef enum {
+    STREAM_STATE_IDLE = 0,
+    STREAM_STATE_RUNNING,
+    STREAM_STATE_DRAINING,      /*!< 数据已全部提交，等待控制器发送完成 */
+} stream_state_t;
+
+typedef struct {
+    stream_state_t state;
+    xf_ble_app_id_t app_id;
+    xf_ble_conn_id_t conn_id;
+    xf_ble_attr_handle_t handle;
+    xf_ble_gattc_stream_cfg_t cfg;
+    uint16_t chunk_size;
+    uint8_t credits;            /*!< 当前可用的 TX credits */
+    bool pumping;               /*!< 是否有上下文正在发送 */
+    bool repump;                /*!< 发送期间是否有新的 credits 返还 */
+    uint8_t *chunk_buf;         /*!< pull_cb 模式下的分包缓冲 */
+    uint16_t chunk_len;         /*!< 分包缓冲中待发送 (已拉取) 的数据长度 */
+    uint32_t offset;
+    uint32_t pkts;
+    uint64_t start_us;
+    uint64_t end_us;
+} stream_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static stream_t *stream_get(xf_ble_gattc_stream_id_t stream_id);
+static void stream_pump(stream_t *s);
+static bool stream_take_credit(stream_t *s);
+static void stream_give_credit(stream_t *s, uint16_t num);
+static xf_err_t stream_send_chunk(stream_t *s, bool *eof);
+static void stream_check_done(stream_t *s);
+static void stream_finish(stream_t *s, xf_err_t result);
+static void stream_stats_fill(const stream_t *s, xf_ble_gattc_stream_stats_t *stats);
+
+/* ==================== [Static Variables] ================================== */
+
+static stream_t s_stream_set[XF_BLE_GATTC_STREAM_MAX_NUM] = {0};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_ble_gattc_stream_start(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t handle,
+    const xf_ble_gattc_stream_cfg_t *cfg,
+    xf_ble_gattc_stream_id_t *stream_id)
+{
+    XF_ASSERT(cfg != NULL, XF_ERR_INVALID_ARG, TAG, "cfg == NULL");
+    XF_ASSERT(stream_id != NULL, XF_ERR_INVALID_ARG, TAG, "stream_id == NULL");
+    XF_ASSERT((cfg->data != NULL) != (cfg->pull_cb != NULL), XF_ERR_INVALID_ARG,
+              TAG, "one of data and pull_cb must be set");
+    XF_ASSERT(handle != XF_BLE_ATTR_HANDLE_INVALID, XF_ERR_INVALID_ARG,
+              TAG, "handle invalid");
+
+    stream_t *s = NULL;
+    for (uint8_t i = 0; i < XF_BLE_GATTC_STREAM_MAX_NUM; i++) {
+        stream_t *cur = &s_stream_set[i];
+        if (cur->state == STREAM_STATE_IDLE) {
+            if (s == NULL) {
+                s = cur;
+                *stream_id = i;
+            }
+            continue;
+        }
+        XF_CHECK(cur->conn_id == conn_id, XF_ERR_BUSY,
+                 TAG, "conn(%d) already has a stream", conn_id);
+    }
+    XF_CHECK(s == NULL, XF_ERR_NO_MEM, TAG, "no free stream");
+
+    uint16_t mtu = (cfg->mtu != 0) ? cfg->mtu : xf_ble_conn_table_get_mtu(conn_id);
+    if (mtu < STREAM_MTU_MIN) {
+        mtu = STREAM_MTU_MIN;
+    }
+
+    xf_memset(s, 0, sizeof(stream_t));
+    s->app_id = app_id;
+    s->conn_id = conn_id;
+    s->handle = handle;
+    s->cfg = *cfg;
+    s->chunk_size = mtu - XF_BLE_GATTC_STREAM_ATT_HDR_SIZE;
+    if (s->cfg.tx_credits == 0) {
+        s->cfg.tx_credits = XF_BLE_GATTC_STREAM_TX_CREDITS_DEFAULT;
+    }
+    s->credits = s->cfg.tx_credits;
+
+    if (s->cfg.pull_cb != NULL) {
+        s->chunk_buf = xf_ble_pool_alloc(s->chunk_size);
+        XF_CHECK(s->chunk_buf == NULL, XF_ERR_NO_MEM, TAG, "alloc chunk_buf failed!");
+    }
+
+    s->start_us = xf_sys_time_get_us();
+    s->state = STREAM_STATE_RUNNING;
+    stream_pump(s);
+    return XF_OK;
+}
+
+xf_err_t xf_ble_gattc_stream_abort(xf_ble_gattc_stream_id_t stream_id)
+{
+    stream_t *s = stream_get(stream_id);
+    XF_CHECK(s == NULL, XF_ERR_NOT_FOUND, TAG, "stream(%d) not found", stream_id);
+    stream_finish(s, XF_FAIL);
+    return XF_OK;
+}
+
+xf_err_t xf_ble_gattc_stream_get_stats(
+    xf_ble_gattc_stream_id_t stream_id, xf_ble_gattc_stream_stats_t *stats)
+{
+    XF_ASSERT(stats != NULL, XF_ERR_INVALID_ARG, TAG, "stats == NULL");
+    stream_t *s = stream_get(stream_id);
+    XF_CHECK(s == NULL, XF_ERR_NOT_FOUND, TAG, "stream(%d) not found", stream_id);
+    stream_stats_fill(s, stats);
+    return XF_OK;
+}
+
+xf_ble_evt_res_t xf_ble_gattc_stream_event_handler(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param)
+{
+    if ((event != XF_BLE_GATTC_EVT_TX_COMPLETE) || (param == NULL)) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+    for (uint8_t i = 0; i < XF_BLE_GATTC_STREAM_MAX_NUM; i++) {
+        stream_t *s = &s_stream_set[i];
+        if ((s->state == STREAM_STATE_IDLE)
+                || (s->conn_id != param->tx_complete.conn_id)) {
+            continue;
+        }
+        stream_give_credit(s, param->tx_complete.num_pkts);
+        stream_pump(s);
+        return XF_BLE_EVT_RES_HANDLED;
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+xf_ble_evt_res_t xf_ble_gattc_stream_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param)
+{
+    if ((event != XF_BLE_GAP_EVT_DISCONNECT) || (param == NULL)) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+    for (uint8_t i = 0; i < XF_BLE_GATTC_STREAM_MAX_NUM; i++) {
+        stream_t *s = &s_stream_set[i];
+        if ((s->state != STREAM_STATE_IDLE)
+                && (s->conn_id == param->disconnect.conn_id)) {
+            /* 链路已断开，不会再有发送完成事件 */
+            stream_finish(s, XF_ERR_INVALID_STATE);
+        }
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static stream_t *stream_get(xf_ble_gattc_stream_id_t stream_id)
+{
+    if ((stream_id >= XF_BLE_GATTC_STREAM_MAX_NUM)
+            || (s_stream_set[stream_id].state == STREAM_STATE_IDLE)) {
+        return NULL;
+    }
+    return &s_stream_set[stream_id];
+}
+
+/**
+ * @brief 只要还有 credits 就持续提交写命令。
+ *
+ * @note 发送完成事件 (协议栈上下文) 与开启流 (应用上下文) 都可能触发发送，
+ *  通过 pumping/repump 标记保证同一时刻只有一个上下文在提交数据，
+ *  另一个上下文只需留下 repump 标记即可返回。
+ */
+static void stream_pump(stream_t *s)
+{
+    XF_BLE_ENTER_CRITICAL();
+    if (s->pumping) {
+        s->repump = true;
+        XF_BLE_EXIT_CRITICAL();
+        return;
+    }
+    s->pumping = true;
+    s->repump = false;
+    XF_BLE_EXIT_CRITICAL();
+
+    bool again = false;
+    do {
+        while ((s->state == STREAM_STATE_RUNNING) && stream_take_credit(s)) {
+            bool eof = false;
+            xf_err_t ret = stream_send_chunk(s, &eof);
+            if ((ret == XF_OK) && !eof) {
+                continue;
+            }
+            /* 本包未提交，归还 credit */
+            stream_give_credit(s, 1);
+            if (eof) {
+                s->state = STREAM_STATE_DRAINING;
+            } else if ((ret == XF_ERR_BUSY) || (ret == XF_ERR_NO_MEM)) {
+                /* 协议栈侧暂时无法缓存，等待下一次发送完成事件 */
+                if (s->credits < s->cfg.tx_credits) {
+                    break;
+                }
+                /* 无在途数据包，不会再有发送完成事件 */
+                s->pumping = false;
+                stream_finish(s, ret);
+                return;
+            } else {
+                s->pumping = false;
+                stream_finish(s, ret);
+                return;
+            }
+        }
+        XF_BLE_ENTER_CRITICAL();
+        again = s->repump;
+        s->repump = false;
+        if (!again) {
+            s->pumping = false;
+        }
+        XF_BLE_EXIT_CRITICAL();
+    } while (again);
+
+    /* 在途数据包数作为发送队列深度，供自适应连接参数判断大量传输 */
+    xf_ble_conn_param_mgr_set_depth(s->conn_id, s->cfg.tx_credits - s->credits, 0);
+    stream_check_done(s);
+}
+
+static bool stream_take_credit(stream_t *s)
+{
+    bool ok = false;
+    XF_BLE_ENTER_CRITICAL();
+    if (s->credits > 0) {
+        --s->credits;
+        ok = true;
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return ok;
+}
+
+static void stream_give_credit(stream_t *s, uint16_t num)
+{
+    XF_BLE_ENTER_CRITICAL();
+    uint16_t credits = s->credits + num;
+    s->credits = (credits > s->cfg.tx_credits) ? s->cfg.tx_credits : (uint8_t)credits;
+    XF_BLE_EXIT_CRITICAL();
+}
+
+static xf_err_t stream_send_chunk(stream_t *s, bool *eof)
+{
+    uint8_t *chunk = NULL;
+    uint16_t len = 0;
+
+    if (s->cfg.data != NULL) {
+        uint32_t remain = s->cfg.data_len - s->offset;
+        len = (remain > s->chunk_size) ? s->chunk_size : (uint16_t)remain;
+        chunk = (uint8_t *)&s->cfg.data[s->offset];
+    } else {
+        /* 上次提交失败的分包仍在缓冲中，不重复拉取 */
+        if (s->chunk_len == 0) {
+            s->chunk_len = s->cfg.pull_cb(s->offset, s->chunk_buf,
+                                          s->chunk_size, s->cfg.user_data);
+        }
+        len = s->chunk_len;
+        chunk = s->chunk_buf;
+    }
+    if (len == 0) {
+        *eof = true;
+        return XF_OK;
+    }
+
+    xf_err_t ret = XF_OK;
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GATTC_REQUEST_WRITE, s->conn_id, s->handle,
+                          xf_ble_gattc_request_write(s->app_id, s->conn_id, s->handle, chunk, len,
+                                                     XF_BLE_GATT_WRITE_TYPE_NO_RSP));
+    if (ret != XF_OK) {
+        return ret;
+    }
+    s->chunk_len = 0;
+    s->offset += len;
+    ++s->pkts;
+    xf_ble_conn_param_mgr_report(s->conn_id, len, 0);
+    return XF_OK;
+}
+
+static void stream_check_done(stream_t *s)
+{
+    bool done = false;
+    XF_BLE_ENTER_CRITICAL();
+    done = (s->state == STREAM_STATE_DRAINING) && !s->pumping
+           && (s->credits == s->cfg.tx_credits);
+    XF_BLE_EXIT_CRITICAL();
+    if (done) {
+        stream_finish(s, XF_OK);
+    }
+}
+
+static void stream_finish(stream_t *s, xf_err_t result)
+{
+    XF_BLE_ENTER_CRITICAL();
+    if (s->state == STREAM_STATE_IDLE) {
+        XF_BLE_EXIT_CRITICAL();
+        return;
+    }
+    s->state = STREAM_STATE_IDLE;
+    XF_BLE_EXIT_CRITICAL();
+
+    s->end_us = xf_sys_time_get_us();
+    xf_ble_conn_param_mgr_set_depth(s->conn_id, 0, 0);
+    if (s->chunk_buf != NULL) {
+        xf_ble_pool_free(s->chunk_buf);
+        s->chunk_buf = NULL;
+    }
+
+    xf_ble_gattc_stream_stats_t stats = {0};
+    stream_stats_fill(s, &stats);
+    XF_LOGD(TAG, "stream conn(%d) done:%d, %u bytes, %u B/s", s->conn_id, (int)result,
+            (unsigned)stats.total_bytes, (unsigned)stats.throughput);
+    if (s->cfg.done_cb != NULL) {
+        s->cfg.done_cb((xf_ble_gattc_stream_id_t)(s - s_stream_set), result,
+                       &stats, s->cfg.user_data);
+    }
+}
+
+static void stream_stats_fill(const stream_t *s, xf_ble_gattc_stream_stats_t *stats)
+{
+    uint64_t end_us = (s->state == STREAM_STATE_IDLE) ? s->end_us : xf_sys_time_get_us();
+    uint64_t elapsed_us = end_us - s->start_us;
+
+    stats->total_bytes = s->offset;
+    stats->total_pkts = s->pkts;
+    stats->elapsed_us = (uint32_t)elapsed_us;
+    stats->throughput = (elapsed_us == 0) ? 0
+                        : (uint32_t)(((uint64_t)s->offset * 1000000U) / elapsed_us);
+}
+
+#endif /* XF_BLE_IS_ENABLE */
@@ -0,0 +1,200 @@
+/**
+ * @file xf_ble_gattc_stream.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE GATTC 流式发送 (写命令)。
+ *  将任意长度的数据按 (MTU - 3) 分包，并依据平台侧上报的发送完成 (TX credits)
+ *  持续填满控制器的发送队列，用于固件、日志等批量数据的上传。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_GATTC_STREAM_H__
+#define __XF_BLE_GATTC_STREAM_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gap_types.h"
+#include "xf_ble_gatt_client_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble_gatt
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief 无效的流 ID
+ */
+#define XF_BLE_GATTC_STREAM_ID_INVALID      (0xFF)
+
+/**
+ * @brief ATT 写命令的头部大小 (opcode + handle)，每包的有效数据长度为 (MTU - 3)
+ */
+#define XF_BLE_GATTC_STREAM_ATT_HDR_SIZE    (3)
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE GATTC 流 ID
+ */
+typedef uint8_t xf_ble_gattc_stream_id_t;
+
+/**
+ * @brief BLE GATTC 流的数据拉取回调
+ *
+ * @param offset 当前要拉取的数据在整个流中的偏移
+ * @param[out] buf 数据存放的缓冲区
+ * @param buf_size 缓冲区大小 (即单包最大有效数据长度 MTU - 3)
+ * @param user_data 用户数据
+ * @return uint16_t 实际填入的数据长度，返回 0 表示数据已全部拉取完毕
+ */
+typedef uint16_t (*xf_ble_gattc_stream_pull_cb_t)(
+    uint32_t offset, uint8_t *buf, uint16_t buf_size, void *user_data);
+
+/**
+ * @brief BLE GATTC 流的统计信息
+ */
+typedef struct {
+    uint32_t total_bytes;       /*!< 已发送的字节数 */
+    uint32_t total_pkts;        /*!< 已发送的数据包个数 */
+    uint32_t elapsed_us;        /*!< 从开始发送至今 (或至完成时) 的耗时，单位 us */
+    uint32_t throughput;        /*!< 平均吞吐量，单位 byte/s */
+} xf_ble_gattc_stream_stats_t;
+
+/**
+ * @brief BLE GATTC 流完成回调
+ *
+ * @param stream_id 流 ID
+ * @param result 流结果
+ *      - XF_OK                 所有数据已发送，且控制器已确认发送完成
+ *      - XF_FAIL               被中止
+ *      - (OTHER)               发送失败时写请求返回的错误码
+ * @param stats 流的统计信息，见 @ref xf_ble_gattc_stream_stats_t
+ * @param user_data 用户数据
+ */
+typedef void (*xf_ble_gattc_stream_done_cb_t)(
+    xf_ble_gattc_stream_id_t stream_id, xf_err_t result,
+    const xf_ble_gattc_stream_stats_t *stats, void *user_data);
+
+/**
+ * @brief BLE GATTC 流的配置
+ *
+ * @note 数据来源二选一:
+ *  1. data + data_len: 连续的数据缓冲区，流结束前需保持有效
+ *  2. pull_cb: 每次发送前从回调中拉取一包数据
+ */
+typedef struct {
+    const uint8_t *data;                    /*!< 要发送的数据 (使用 pull_cb 时填 NULL) */
+    uint32_t data_len;                      /*!< 要发送的数据的长度 */
+    xf_ble_gattc_stream_pull_cb_t pull_cb;  /*!< 数据拉取回调，见 @ref xf_ble_gattc_stream_pull_cb_t */
+    uint16_t mtu;                           /*!< 当前链路的 MTU，数据按 (MTU - 3) 分包，
+                                             *  0 表示从连接状态表获取，见 xf_ble_conn_table_get_mtu() */
+    uint8_t tx_credits;                     /*!< 控制器可缓存的待发送包数，
+                                             *  0 表示使用 XF_BLE_GATTC_STREAM_TX_CREDITS_DEFAULT */
+    xf_ble_gattc_stream_done_cb_t done_cb;  /*!< 流完成回调，见 @ref xf_ble_gattc_stream_done_cb_t */
+    void *user_data;                        /*!< 用户数据 */
+} xf_ble_gattc_stream_cfg_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE GATTC 开启一个流式发送 (写命令)
+ *
+ * @param app_id 客户端 ID (应用 ID)，见 @ref xf_ble_app_id_t
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param handle 写入的特征值句柄
+ * @param cfg 流的配置，见 @ref xf_ble_gattc_stream_cfg_t
+ * @param[out] stream_id 流 ID，见 @ref xf_ble_gattc_stream_id_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_BUSY           该连接已有进行中的流
+ *      - XF_ERR_NO_MEM         流数量已达上限或内存不足
+ *      - (OTHER)               @ref xf_err_t
+ *
+ * @note 依赖平台侧上报 XF_BLE_GATTC_EVT_TX_COMPLETE 事件，
+ *  且需在 GATTC 事件回调中调用 xf_ble_gattc_stream_event_handler() ，
+ *  在 GAP 事件回调中调用 xf_ble_gattc_stream_gap_event_handler() 。
+ */
+xf_err_t xf_ble_gattc_stream_start(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t handle,
+    const xf_ble_gattc_stream_cfg_t *cfg,
+    xf_ble_gattc_stream_id_t *stream_id);
+
+/**
+ * @brief BLE GATTC 中止一个流式发送
+ *
+ * @param stream_id 流 ID，见 @ref xf_ble_gattc_stream_id_t
+ * @return xf_err_t
+ *      - XF_OK                 成功，完成回调将以 XF_FAIL 被调用
+ *      - XF_ERR_NOT_FOUND      流不存在
+ */
+xf_err_t xf_ble_gattc_stream_abort(xf_ble_gattc_stream_id_t stream_id);
+
+/**
+ * @brief BLE GATTC 获取流的统计信息
+ *
+ * @param stream_id 流 ID，见 @ref xf_ble_gattc_stream_id_t
+ * @param[out] stats 统计信息，见 @ref xf_ble_gattc_stream_stats_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      流不存在
+ */
+xf_err_t xf_ble_gattc_stream_get_stats(
+    xf_ble_gattc_stream_id_t stream_id, xf_ble_gattc_stream_stats_t *stats);
+
+/**
+ * @brief BLE GATTC 流式发送的事件处理
+ *
+ * @note 需在 GATTC 事件回调中调用，用于回收 TX credits 并继续发送
+ * @param event 事件，见 @ref xf_ble_gattc_evt_t
+ * @param param 事件回调参数，见 @ref xf_ble_gattc_evt_cb_param_t
+ * @return xf_ble_evt_res_t 事件处理结果
+ *      - XF_BLE_EVT_RES_NOT_HANDLED    事件未被处理 (与流无关)
+ *      - XF_BLE_EVT_RES_HANDLED        事件已被处理
+ */
+xf_ble_evt_res_t xf_ble_gattc_stream_event_handler(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param);
+
+/**
+ * @brief BLE GATTC 流式发送的 GAP 事件处理 (断连)
+ *
+ * @note 需在 GAP 事件回调中调用；断连时以 XF_ERR_INVALID_STATE 结束该连接上的流并释放缓冲，
+ *  仅观察事件，固定返回 XF_BLE_EVT_RES_NOT_HANDLED
+ * @param event 事件，见 @ref xf_ble_gap_evt_t
+ * @param param 事件回调参数，见 @ref xf_ble_gap_evt_cb_param_t
+ * @return xf_ble_evt_res_t 事件处理结果
+ */
+xf_ble_evt_res_t xf_ble_gattc_stream_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble_gatt
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_GATTC_STREAM_H__ */
@@ -0,0 +1,357 @@
+/**
+ * @file xf_ble_gattc_sub.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE GATTC 订阅 (CCCD) 管理。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_ble_gatt_client.h"
+#include "xf_ble_gattc_db.h"
+#include "xf_ble_trace.h"
+#include "xf_ble_latency.h"
+#include "xf_ble_utils.h"
+#include "xf_ble_gattc_sub.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_sub"
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct {
+    xf_ble_attr_handle_t value_handle;
+    xf_ble_attr_handle_t cccd_handle;
+    xf_ble_gattc_sub_type_t type;
+    xf_ble_gattc_ntf_handler_t handler;
+    void *user_data;
+} sub_item_t;
+
+typedef struct {
+    bool is_used;
+    bool is_addr_valid;         /*!< 地址是否有效 (未经 GAP 事件跟踪的连接无法记录对端) */
+    bool is_connected;
+    bool is_bonded;
+    bool is_restore_pending;    /*!< 已重连，待链路加密 (配对结束) 后恢复订阅 */
+    xf_ble_conn_id_t conn_id;
+    xf_ble_app_id_t app_id;
+    xf_ble_addr_t addr;
+    uint32_t last_used;         /*!< 最近使用的序号，用于淘汰最久未使用的记录 */
+    uint8_t item_cnt;
+    sub_item_t item_set[XF_BLE_GATTC_SUB_PER_PEER_MAX];
+} sub_peer_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static sub_peer_t *sub_peer_get_by_conn(xf_ble_conn_id_t conn_id);
+static sub_peer_t *sub_peer_get_by_addr(const xf_ble_addr_t *addr);
+static sub_peer_t *sub_peer_alloc(void);
+static void sub_peer_touch(sub_peer_t *peer);
+static sub_item_t *sub_item_get(sub_peer_t *peer, xf_ble_attr_handle_t value_handle);
+static void sub_item_remove(sub_peer_t *peer, sub_item_t *item);
+static void sub_ntf_register_all(const sub_peer_t *peer);
+static xf_err_t sub_cccd_write(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t cccd_handle, uint16_t cccd_value);
+
+/* ==================== [Static Variables] ================================== */
+
+static sub_peer_t s_sub_peer_set[XF_BLE_GATTC_SUB_PEER_MAX] = {0};
+static uint32_t s_sub_use_seq = 0;
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_ble_gattc_subscribe(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t chara_value_handle,
+    xf_ble_gattc_sub_type_t type,
+    xf_ble_gattc_ntf_handler_t handler, void *user_data)
+{
+    XF_ASSERT((type & (XF_BLE_GATTC_SUB_NOTIFY | XF_BLE_GATTC_SUB_INDICATE)) != 0,
+              XF_ERR_INVALID_ARG, TAG, "type invalid:%d", type);
+
+    xf_ble_attr_handle_t cccd_handle = XF_BLE_ATTR_HANDLE_INVALID;
+    xf_err_t ret = xf_ble_gattc_db_get_cccd_handle(conn_id, chara_value_handle, &cccd_handle);
+    XF_CHECK(ret != XF_OK, ret, TAG, "cccd of handle(%d) not found", chara_value_handle);
+
+    sub_peer_t *peer = sub_peer_get_by_conn(conn_id);
+    sub_item_t *item = (peer == NULL) ? NULL : sub_item_get(peer, chara_value_handle);
+    bool is_new = (item == NULL);
+    if ((peer != NULL) && is_new) {
+        XF_CHECK(peer->item_cnt >= XF_BLE_GATTC_SUB_PER_PEER_MAX, XF_ERR_NO_MEM,
+                 TAG, "sub item full");
+    }
+
+    ret = sub_cccd_write(app_id, conn_id, cccd_handle, type);
+    XF_CHECK(ret != XF_OK, ret, TAG, "write cccd(%d) failed:%d", cccd_handle, ret);
+
+    /* 写入成功后才分配记录 (可能淘汰其他对端的记录)，失败时不留下空记录 */
+    bool is_new_peer = (peer == NULL);
+    if (is_new_peer) {
+        peer = sub_peer_alloc();
+        if (peer == NULL) {
+            sub_cccd_write(app_id, conn_id, cccd_handle, XF_BLE_GATT_CCCD_VALUE_NONE);
+            XF_LOGE(TAG, "sub peer full");
+            return XF_ERR_NO_MEM;
+        }
+        peer->is_connected = true;
+        peer->conn_id = conn_id;
+    }
+    if (is_new) {
+        item = &peer->item_set[peer->item_cnt];
+    }
+
+    if (handler != NULL) {
+        ret = xf_ble_gattc_ntf_handler_register(conn_id, chara_value_handle, handler, user_data);
+        if (ret != XF_OK) {
+            if (is_new_peer) {
+                xf_memset(peer, 0, sizeof(sub_peer_t));
+            }
+            XF_LOGE(TAG, "register ntf handler failed:%d", ret);
+            return ret;
+        }
+    }
+
+    item->value_handle = chara_value_handle;
+    item->cccd_handle = cccd_handle;
+    item->type = type;
+    item->handler = handler;
+    item->user_data = user_data;
+    if (is_new) {
+        ++peer->item_cnt;
+    }
+    peer->app_id = app_id;
+    sub_peer_touch(peer);
+    return XF_OK;
+}
+
+xf_err_t xf_ble_gattc_unsubscribe(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t chara_value_handle)
+{
+    sub_peer_t *peer = sub_peer_get_by_conn(conn_id);
+    XF_CHECK(peer == NULL, XF_ERR_NOT_FOUND, TAG, "conn(%d) no sub", conn_id);
+    sub_item_t *item = sub_item_get(peer, chara_value_handle);
+    XF_CHECK(item == NULL, XF_ERR_NOT_FOUND, TAG, "handle(%d) no sub", chara_value_handle);
+
+    xf_ble_gattc_ntf_handler_unregister(conn_id, chara_value_handle);
+    xf_err_t ret = sub_cccd_write(app_id, conn_id, item->cccd_handle,
+                                  XF_BLE_GATT_CCCD_VALUE_NONE);
+    sub_item_remove(peer, item);
+    return ret;
+}
+
+xf_err_t xf_ble_gattc_subscribe_restore(xf_ble_conn_id_t conn_id)
+{
+    sub_peer_t *peer = sub_peer_get_by_conn(conn_id);
+    if ((peer == NULL) || (peer->item_cnt == 0)) {
+        return XF_ERR_NOT_FOUND;
+    }
+
+    peer->is_restore_pending = false;
+    sub_ntf_register_all(peer);
+    /* 不等待每个写请求的确认，连续发出所有 CCCD 写请求，由协议栈排队发送 */
+    xf_err_t ret = XF_OK;
+    for (uint8_t i = 0; i < peer->item_cnt; i++) {
+        sub_item_t *item = &peer->item_set[i];
+        xf_err_t ret_write = sub_cccd_write(peer->app_id, conn_id,
+                                            item->cccd_handle, item->type);
+        if ((ret_write != XF_OK) && (ret == XF_OK)) {
+            XF_LOGW(TAG, "restore cccd(%d) failed:%d", item->cccd_handle, ret_write);
+            ret = ret_write;
+        }
+    }
+    sub_peer_touch(peer);
+    return ret;
+}
+
+xf_err_t xf_ble_gattc_subscribe_forget(const xf_ble_addr_t *addr)
+{
+    XF_ASSERT(addr != NULL, XF_ERR_INVALID_ARG, TAG, "addr == NULL");
+    sub_peer_t *peer = sub_peer_get_by_addr(addr);
+    XF_CHECK(peer == NULL, XF_ERR_NOT_FOUND, TAG, "peer not found");
+    if (peer->is_connected) {
+        /* 保持连接跟踪，仅清除订阅记录 */
+        peer->item_cnt = 0;
+        peer->is_bonded = false;
+        return XF_OK;
+    }
+    xf_memset(peer, 0, sizeof(sub_peer_t));
+    return XF_OK;
+}
+
+xf_ble_evt_res_t xf_ble_gattc_sub_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param)
+{
+    if (param == NULL) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+
+    switch (event) {
+    case XF_BLE_GAP_EVT_CONNECT: {
+        if (param->connect.addr == NULL) {
+            break;
+        }
+        sub_peer_t *peer = sub_peer_get_by_addr(param->connect.addr);
+        if (peer == NULL) {
+            peer = sub_peer_alloc();
+            if (peer == NULL) {
+                XF_LOGW(TAG, "sub peer full, conn(%d) not tracked", param->connect.conn_id);
+                break;
+            }
+            peer->addr = *param->connect.addr;
+            peer->is_addr_valid = true;
+        }
+        peer->is_connected = true;
+        peer->conn_id = param->connect.conn_id;
+        sub_peer_touch(peer);
+        /* 有记录的对端均已绑定，可能沿用已保存的 CCCD 直接发送通知，先注册处理函数 */
+        sub_ntf_register_all(peer);
+        /* CCCD 可能需加密后才能写入，待配对结束 (链路加密) 后再写入 */
+        peer->is_restore_pending = (peer->item_cnt != 0);
+    } break;
+    case XF_BLE_GAP_EVT_DISCONNECT: {
+        sub_peer_t *peer = sub_peer_get_by_conn(param->disconnect.conn_id);
+        if (peer == NULL) {
+            break;
+        }
+        xf_ble_gattc_ntf_handler_unregister_conn(peer->conn_id);
+        peer->is_connected = false;
+        peer->is_restore_pending = false;
+        if (!peer->is_bonded || !peer->is_addr_valid) {
+            xf_memset(peer, 0, sizeof(sub_peer_t));
+        }
+    } break;
+    case XF_BLE_GAP_EVT_PAIR_END: {
+        sub_peer_t *peer = sub_peer_get_by_conn(param->pair_end.conn_id);
+        if ((peer == NULL) || !param->pair_end.is_succ) {
+            break;
+        }
+        peer->is_bonded = true;
+        if (peer->is_restore_pending) {
+            xf_ble_gattc_subscribe_restore(peer->conn_id);
+        }
+    } break;
+    default:
+        break;
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static sub_peer_t *sub_peer_get_by_conn(xf_ble_conn_id_t conn_id)
+{
+    for (uint8_t i = 0; i < XF_BLE_GATTC_SUB_PEER_MAX; i++) {
+        sub_peer_t *peer = &s_sub_peer_set[i];
+        if (peer->is_used && peer->is_connected && (peer->conn_id == conn_id)) {
+            return peer;
+        }
+    }
+    return NULL;
+}
+
+static sub_peer_t *sub_peer_get_by_addr(const xf_ble_addr_t *addr)
+{
+    for (uint8_t i = 0; i < XF_BLE_GATTC_SUB_PEER_MAX; i++) {
+        sub_peer_t *peer = &s_sub_peer_set[i];
+        if (peer->is_used && peer->is_addr_valid && xf_ble_addr_is_equal(&peer->addr, addr)) {
+            return peer;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 分配一个对端记录，已满时淘汰最久未使用的未连接的记录
+ */
+static sub_peer_t *sub_peer_alloc(void)
+{
+    sub_peer_t *victim = NULL;
+    for (uint8_t i = 0; i < XF_BLE_GATTC_SUB_PEER_MAX; i++) {
+        sub_peer_t *peer = &s_sub_peer_set[i];
+        if (!peer->is_used) {
+            victim = peer;
+            break;
+        }
+        if (peer->is_connected) {
+            continue;
+        }
+        if ((victim == NULL) || ((int32_t)(peer->last_used - victim->last_used) < 0)) {
+            victim = peer;
+        }
+    }
+    if (victim == NULL) {
+        return NULL;
+    }
+    xf_memset(victim, 0, sizeof(sub_peer_t));
+    victim->is_used = true;
+    return victim;
+}
+
+static void sub_peer_touch(sub_peer_t *peer)
+{
+    peer->last_used = ++s_sub_use_seq;
+}
+
+static sub_item_t *sub_item_get(sub_peer_t *peer, xf_ble_attr_handle_t value_handle)
+{
+    for (uint8_t i = 0; i < peer->item_cnt; i++) {
+        if (peer->item_set[i].value_handle == value_handle) {
+            return &peer->item_set[i];
+        }
+    }
+    return NULL;
+}
+
+static void sub_item_remove(sub_peer_t *peer, sub_item_t *item)
+{
+    sub_item_t *last = &peer->item_set[peer->item_cnt - 1];
+    if (item != last) {
+        *item = *last;
+    }
+    xf_memset(last, 0, sizeof(sub_item_t));
+    --peer->item_cnt;
+}
+
+/**
+ * @brief 为对端的所有订阅注册通知处理函数 (已存在时覆盖)
+ */
+static void sub_ntf_register_all(const sub_peer_t *peer)
+{
+    for (uint8_t i = 0; i < peer->item_cnt; i++) {
+        const sub_item_t *item = &peer->item_set[i];
+        if (item->handler != NULL) {
+            xf_ble_gattc_ntf_handler_register(peer->conn_id, item->value_handle,
+                                              item->handler, item->user_data);
+        }
+    }
+}
+
+static xf_err_t sub_cccd_write(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t cccd_handle, uint16_t cccd_value)
+{
+    /* CCCD 值为 16-bit 小端序 */
+    uint8_t value[2] = {(uint8_t)(cccd_value & 0xFF), (uint8_t)(cccd_value >> 8)};
+    xf_err_t ret = XF_OK;
+    XF_BLE_LATENCY_START(XF_BLE_LATENCY_OP_WRITE, conn_id, cccd_handle);
+    XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GATTC_REQUEST_WRITE, conn_id, cccd_handle,
+                          xf_ble_gattc_request_write(app_id, conn_id, cccd_handle, value, sizeof(value),
+                                                     XF_BLE_GATT_WRITE_TYPE_WITH_RSP));
+    if (ret != XF_OK) {
+        XF_BLE_LATENCY_CANCEL(XF_BLE_LATENCY_OP_WRITE, conn_id, cccd_handle);
+    }
+    return ret;
+}
+
+#endif /* XF_BLE_IS_ENABLE */
@@ -0,0 +1,143 @@
+/**
+ * @file xf_ble_gattc_sub.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE GATTC 订阅 (CCCD) 管理。
+ *  根据服务结构数据库自动查找 CCCD 并写入，按对端设备记录订阅，
+ *  已绑定的对端重连并完成加密后一次性 (连续) 重新写入所有 CCCD 以恢复订阅。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_GATTC_SUB_H__
+#define __XF_BLE_GATTC_SUB_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gap_types.h"
+#include "xf_ble_gatt_client_types.h"
+#include "xf_ble_gattc_ntf.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble_gatt
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE GATTC 订阅类型 (可组合)
+ */
+typedef uint8_t xf_ble_gattc_sub_type_t;
+enum _xf_ble_gattc_sub_type_t {
+    XF_BLE_GATTC_SUB_NOTIFY     = XF_BLE_GATT_CCCD_VALUE_NOTIFY,    /*!< 订阅通知 */
+    XF_BLE_GATTC_SUB_INDICATE   = XF_BLE_GATT_CCCD_VALUE_INDICATE,  /*!< 订阅指示 */
+};
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE GATTC 订阅特征的通知/指示
+ *
+ * @param app_id 客户端 ID (应用 ID)，见 @ref xf_ble_app_id_t
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param chara_value_handle 特征值句柄
+ * @param type 订阅类型，见 @ref xf_ble_gattc_sub_type_t
+ * @param handler 通知/指示的处理函数，见 @ref xf_ble_gattc_ntf_handler_t ，
+ *  为 NULL 时只写入 CCCD，不注册处理函数
+ * @param user_data 用户数据，调用处理函数时传入
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      服务结构数据库中找不到该特征或其 CCCD
+ *      - XF_ERR_NO_MEM         订阅数已达上限
+ *      - (OTHER)               @ref xf_err_t
+ *
+ * @note 需先将服务结构保存至数据库，见 xf_ble_gattc_db_set()
+ */
+xf_err_t xf_ble_gattc_subscribe(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t chara_value_handle,
+    xf_ble_gattc_sub_type_t type,
+    xf_ble_gattc_ntf_handler_t handler, void *user_data);
+
+/**
+ * @brief BLE GATTC 取消订阅特征的通知/指示
+ *
+ * @param app_id 客户端 ID (应用 ID)，见 @ref xf_ble_app_id_t
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param chara_value_handle 特征值句柄
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      未订阅
+ *      - (OTHER)               @ref xf_err_t
+ */
+xf_err_t xf_ble_gattc_unsubscribe(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t chara_value_handle);
+
+/**
+ * @brief BLE GATTC 恢复连接对端已记录的所有订阅
+ *
+ * @note 已绑定的对端重连后，在配对结束 (链路加密) 事件中自动调用；
+ *  若重连后不进行加密，需在连接后手动调用
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @return xf_err_t
+ *      - XF_OK                 成功 (已连续发出所有 CCCD 写请求)
+ *      - XF_ERR_NOT_FOUND      该连接对端无已记录的订阅
+ *      - (OTHER)               @ref xf_err_t
+ */
+xf_err_t xf_ble_gattc_subscribe_restore(xf_ble_conn_id_t conn_id);
+
+/**
+ * @brief BLE GATTC 删除对端设备已记录的所有订阅
+ *
+ * @param addr 对端地址，见 @ref xf_ble_addr_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      无记录
+ */
+xf_err_t xf_ble_gattc_subscribe_forget(const xf_ble_addr_t *addr);
+
+/**
+ * @brief BLE GATTC 订阅管理的 GAP 事件处理
+ *
+ * @note 需在 GAP 事件回调中调用，用于跟踪连接、断连及绑定状态，
+ *  已绑定的对端设备在断连后仍保留订阅记录，重连后在配对结束 (链路加密) 事件中自动恢复
+ *  (对端的 CCCD 通常需加密后才能写入)
+ * @param event 事件，见 @ref xf_ble_gap_evt_t
+ * @param param 事件回调参数，见 @ref xf_ble_gap_evt_cb_param_t
+ * @return xf_ble_evt_res_t 事件处理结果，固定返回 XF_BLE_EVT_RES_NOT_HANDLED ，
+ *  不影响其他模块对同一事件的处理
+ */
+xf_ble_evt_res_t xf_ble_gattc_sub_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble_gatt
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_GATTC_SUB_H__ */
@@ -0,0 +1,144 @@
+/**
+ * @file xf_ble_gattc_svc_chg.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE GATTC 服务变更 (Service Changed) 处理。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_ble_gatt_common.h"
+#include "xf_ble_gattc_db.h"
+#include "xf_ble_gattc_cache.h"
+#include "xf_ble_gattc_disc.h"
+#include "xf_ble_uuid.h"
+#include "xf_ble_gattc_svc_chg.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_svc_chg"
+
+/**
+ * @brief 服务变更特征值长度: 起始句柄 (2) + 结束句柄 (2)，小端
+ */
+#define SVC_CHG_VALUE_LEN   (4)
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static bool svc_chg_is_value_handle(xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle);
+static void svc_chg_widen_range(xf_ble_conn_id_t conn_id,
+                                xf_ble_attr_handle_t *start_handle, xf_ble_attr_handle_t *end_handle);
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_ble_gattc_disc_done_cb_t s_svc_chg_done_cb = NULL;
+static void *s_svc_chg_user_data = NULL;
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void xf_ble_gattc_svc_chg_set_done_cb(
+    xf_ble_gattc_disc_done_cb_t done_cb, void *user_data)
+{
+    s_svc_chg_done_cb = done_cb;
+    s_svc_chg_user_data = user_data;
+}
+
+xf_err_t xf_ble_gattc_svc_chg_apply(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t start_handle, xf_ble_attr_handle_t end_handle)
+{
+    XF_ASSERT((start_handle >= XF_BLE_ATTR_HANDLE_MIN) && (start_handle <= end_handle),
+              XF_ERR_INVALID_ARG, TAG, "invalid range: 0x%04X-0x%04X", start_handle, end_handle);
+
+    XF_LOGI(TAG, "conn(%d) service changed: 0x%04X-0x%04X", conn_id, start_handle, end_handle);
+
+    /* 与范围有交集的服务整体重新搜寻，成功后才替换数据库中的这些服务，失败时保留原有服务结构以便重试 */
+    svc_chg_widen_range(conn_id, &start_handle, &end_handle);
+    xf_ble_gattc_cache_invalidate_range(conn_id, start_handle, end_handle);
+
+    xf_err_t ret = xf_ble_gattc_disc_start_range(app_id, conn_id, start_handle, end_handle,
+                   s_svc_chg_done_cb, s_svc_chg_user_data);
+    if (ret == XF_ERR_BUSY) {
+        /* 正在进行的搜寻结果可能已过时，改为完整搜寻 */
+        xf_ble_gattc_disc_cancel(conn_id);
+        ret = xf_ble_gattc_disc_start(app_id, conn_id, s_svc_chg_done_cb, s_svc_chg_user_data);
+    }
+    if (ret != XF_OK) {
+        XF_LOGW(TAG, "conn(%d) rediscover failed: %d", conn_id, ret);
+    }
+    return ret;
+}
+
+xf_ble_evt_res_t xf_ble_gattc_svc_chg_event_handler(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param)
+{
+    if ((event != XF_BLE_GATTC_EVT_INDICATION) || (param == NULL)) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+    xf_ble_gattc_evt_param_ind_t *ind = &param->ind;
+    if (!svc_chg_is_value_handle(ind->conn_id, ind->handle)) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+    if ((ind->value == NULL) || (ind->value_len != SVC_CHG_VALUE_LEN)) {
+        XF_LOGW(TAG, "invalid service changed value len: %u", ind->value_len);
+        return XF_BLE_EVT_RES_HANDLED;
+    }
+    xf_ble_attr_handle_t start_handle = (xf_ble_attr_handle_t)(ind->value[0] | (ind->value[1] << 8));
+    xf_ble_attr_handle_t end_handle = (xf_ble_attr_handle_t)(ind->value[2] | (ind->value[3] << 8));
+    xf_ble_gattc_svc_chg_apply(ind->app_id, ind->conn_id, start_handle, end_handle);
+    return XF_BLE_EVT_RES_HANDLED;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 将范围扩展至与其有交集的已搜寻服务的并集
+ */
+static void svc_chg_widen_range(xf_ble_conn_id_t conn_id,
+                                xf_ble_attr_handle_t *start_handle, xf_ble_attr_handle_t *end_handle)
+{
+    const xf_ble_gattc_service_found_set_t *db = xf_ble_gattc_db_get(conn_id);
+    if (db == NULL) {
+        return;
+    }
+    bool is_changed = true;
+    while (is_changed) {
+        is_changed = false;
+        for (uint16_t i = 0; i < db->cnt; i++) {
+            const xf_ble_gattc_service_found_t *service = &db->set[i];
+            if ((service->start_hdl > *end_handle) || (service->end_hdl < *start_handle)) {
+                continue;
+            }
+            if (service->start_hdl < *start_handle) {
+                *start_handle = service->start_hdl;
+                is_changed = true;
+            }
+            if (service->end_hdl > *end_handle) {
+                *end_handle = service->end_hdl;
+                is_changed = true;
+            }
+        }
+    }
+}
+
+static bool svc_chg_is_value_handle(xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle)
+{
+    const xf_ble_gattc_chara_found_t *chara = NULL;
+    if (xf_ble_gattc_db_find_chara_by_value_handle(conn_id, handle, &chara) != XF_OK) {
+        return false;
+    }
+    return xf_ble_uuid_equal(&chara->uuid,
+                             XF_BLE_UUID16_DECLARE(XF_BLE_GATT_UUID16_SERVICE_CHANGED));
+}
+
+#endif /* XF_BLE_IS_ENABLE */
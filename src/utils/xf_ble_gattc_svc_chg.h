@@ -0,0 +1,101 @@
+/**
+ * @file xf_ble_gattc_svc_chg.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE GATTC 服务变更 (Service Changed) 处理。
+ *  识别对端的服务变更指示，解析受影响的句柄范围，
+ *  仅使该范围内的属性值缓存失效，并只对该范围重新搜寻，成功后替换该范围内的服务结构。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_GATTC_SVC_CHG_H__
+#define __XF_BLE_GATTC_SVC_CHG_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gatt_client_types.h"
+#include "xf_ble_gattc_disc.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble_gatt
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE GATTC 设置服务变更后重新搜寻完成的回调
+ *
+ * @param done_cb 搜寻完成回调，见 @ref xf_ble_gattc_disc_done_cb_t ，可为 NULL
+ * @param user_data 用户数据
+ */
+void xf_ble_gattc_svc_chg_set_done_cb(
+    xf_ble_gattc_disc_done_cb_t done_cb, void *user_data);
+
+/**
+ * @brief BLE GATTC 处理连接的服务变更
+ *
+ * @note 范围先扩展至与其有交集的已搜寻服务的并集 (这些服务整体失效)，
+ *  再使该范围内的属性值缓存失效，并通过 xf_ble_gattc_disc_start_range() 只对该范围重新搜寻；
+ *  该连接正在搜寻时改为重新进行完整搜寻。
+ *  范围内原有的服务结构在搜寻成功后才被替换，搜寻失败 (完成回调的 result 不为 XF_OK)
+ *  或未能开始搜寻时保持不变，可再次调用本函数重试。
+ *  范围内的订阅 (CCCD) 如需恢复，可在搜寻完成后调用 xf_ble_gattc_subscribe_restore()
+ * @param app_id 客户端 ID (应用 ID)，见 @ref xf_ble_app_id_t
+ * @param conn_id 连接 ID (链接 ID )，见 @ref xf_ble_conn_id_t
+ * @param start_handle 受影响的起始句柄
+ * @param end_handle 受影响的结束句柄
+ * @return xf_err_t
+ *      - XF_OK                 成功 (已开始重新搜寻)
+ *      - XF_ERR_INVALID_ARG    无效句柄范围
+ *      - (OTHER)               @ref xf_err_t
+ */
+xf_err_t xf_ble_gattc_svc_chg_apply(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id,
+    xf_ble_attr_handle_t start_handle, xf_ble_attr_handle_t end_handle);
+
+/**
+ * @brief BLE GATTC 服务变更的事件处理
+ *
+ * @note 需在 GATTC 事件回调中调用，且需先将服务结构保存至数据库
+ *  (以识别服务变更特征的值句柄)，见 xf_ble_gattc_db_set()
+ * @param event 事件，见 @ref xf_ble_gattc_evt_t
+ * @param param 事件回调参数，见 @ref xf_ble_gattc_evt_cb_param_t
+ * @return xf_ble_evt_res_t 事件处理结果
+ *      - XF_BLE_EVT_RES_NOT_HANDLED    事件未被处理 (非服务变更指示)
+ *      - XF_BLE_EVT_RES_HANDLED        事件已被处理
+ */
+xf_ble_evt_res_t xf_ble_gattc_svc_chg_event_handler(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble_gatt
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_GATTC_SVC_CHG_H__ */
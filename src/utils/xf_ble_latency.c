@@ -0,0 +1,546 @@
+/**
+ * @file xf_ble_latency.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 往返时延统计。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_sys.h"
+#include "xf_ble_utils.h"
+#include "xf_ble_latency.h"
+
+#if XF_BLE_IS_ENABLE && XF_BLE_LATENCY_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_latency"
+
+#define LAT_SUB_NUM         (1U << XF_BLE_LATENCY_SUB_BITS)
+#define LAT_SUB_MASK        (LAT_SUB_NUM - 1)
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct {
+    bool is_used;
+    xf_ble_latency_op_t op;
+    xf_ble_conn_id_t conn_id;
+    xf_ble_attr_handle_t handle;
+    xf_ble_addr_t addr;                 /*!< 仅连接操作 */
+    uint32_t seq;                       /*!< 发起顺序 */
+    uint64_t start_us;
+} lat_pending_t;
+
+typedef struct {
+    bool is_used;
+    bool is_connected;                  /*!< 是否对应一个当前连接 (conn_id 有效) */
+    bool has_addr;                      /*!< 对端地址是否已知 (由连接事件得到) */
+    xf_ble_conn_id_t conn_id;
+    xf_ble_addr_t addr;                 /*!< 对端地址，统计按对端累计 */
+    uint32_t seq;                       /*!< 最近使用的顺序，用于回收已断开的对端 */
+    xf_ble_latency_hist_t hist_set[_XF_BLE_LATENCY_OP_MAX];
+} lat_conn_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void lat_start(xf_ble_latency_op_t op, xf_ble_conn_id_t conn_id,
+                      xf_ble_attr_handle_t handle, const xf_ble_addr_t *addr);
+static lat_pending_t *lat_pending_find(xf_ble_latency_op_t op, xf_ble_conn_id_t conn_id,
+                                       xf_ble_attr_handle_t handle, const xf_ble_addr_t *addr);
+static void lat_record(xf_ble_latency_op_t op, xf_ble_conn_id_t conn_id, uint32_t latency_us);
+static lat_conn_t *lat_conn_get(xf_ble_conn_id_t conn_id, bool is_create);
+static lat_conn_t *lat_peer_get(const xf_ble_addr_t *addr);
+static lat_conn_t *lat_conn_alloc(void);
+static void lat_conn_bind(xf_ble_conn_id_t conn_id, const xf_ble_addr_t *addr);
+static void lat_hist_add(xf_ble_latency_hist_t *hist, uint32_t value);
+static void lat_hist_merge(xf_ble_latency_hist_t *dst, const xf_ble_latency_hist_t *src);
+static uint16_t lat_bucket_index(uint32_t value);
+static uint32_t lat_bucket_upper(uint16_t index);
+
+/* ==================== [Static Variables] ================================== */
+
+static lat_pending_t s_lat_pending_set[XF_BLE_LATENCY_PENDING_MAX] = {0};
+static lat_conn_t s_lat_conn_set[XF_BLE_LATENCY_CONN_MAX] = {0};
+static uint32_t s_lat_seq = 0;
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void xf_ble_latency_start(xf_ble_latency_op_t op, xf_ble_conn_id_t conn_id,
+                          xf_ble_attr_handle_t handle)
+{
+    if ((op >= _XF_BLE_LATENCY_OP_MAX) || (op == XF_BLE_LATENCY_OP_CONNECT)) {
+        return;
+    }
+    lat_start(op, conn_id, handle, NULL);
+}
+
+void xf_ble_latency_start_connect(const xf_ble_addr_t *addr)
+{
+    if (addr == NULL) {
+        return;
+    }
+    lat_start(XF_BLE_LATENCY_OP_CONNECT, XF_BLE_LATENCY_CONN_ID_ALL, 0, addr);
+}
+
+void xf_ble_latency_finish(xf_ble_latency_op_t op, xf_ble_conn_id_t conn_id,
+                           xf_ble_attr_handle_t handle)
+{
+    /* 连接操作按地址匹配，见 xf_ble_latency_gap_event_handler() */
+    if ((op >= _XF_BLE_LATENCY_OP_MAX) || (op == XF_BLE_LATENCY_OP_CONNECT)) {
+        return;
+    }
+    uint64_t now_us = xf_sys_time_get_us();
+
+    XF_BLE_ENTER_CRITICAL();
+    lat_pending_t *p = lat_pending_find(op, conn_id, handle, NULL);
+    if (p != NULL) {
+        uint64_t latency_us = now_us - p->start_us;
+        p->is_used = false;
+        lat_record(op, conn_id, (latency_us > UINT32_MAX) ? UINT32_MAX : (uint32_t)latency_us);
+    }
+    XF_BLE_EXIT_CRITICAL();
+}
+
+void xf_ble_latency_cancel(xf_ble_latency_op_t op, xf_ble_conn_id_t conn_id,
+                           xf_ble_attr_handle_t handle)
+{
+    /* 连接操作见 xf_ble_latency_cancel_connect() */
+    if ((op >= _XF_BLE_LATENCY_OP_MAX) || (op == XF_BLE_LATENCY_OP_CONNECT)) {
+        return;
+    }
+    XF_BLE_ENTER_CRITICAL();
+    lat_pending_t *p = lat_pending_find(op, conn_id, handle, NULL);
+    if (p != NULL) {
+        p->is_used = false;
+    }
+    XF_BLE_EXIT_CRITICAL();
+}
+
+void xf_ble_latency_cancel_connect(const xf_ble_addr_t *addr)
+{
+    if (addr == NULL) {
+        return;
+    }
+    XF_BLE_ENTER_CRITICAL();
+    lat_pending_t *p = lat_pending_find(XF_BLE_LATENCY_OP_CONNECT, 0, 0, addr);
+    if (p != NULL) {
+        p->is_used = false;
+    }
+    XF_BLE_EXIT_CRITICAL();
+}
+
+xf_ble_evt_res_t xf_ble_latency_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param)
+{
+    if (param == NULL) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+    if ((event == XF_BLE_GAP_EVT_CONNECT) && (param->connect.addr != NULL)) {
+        uint64_t now_us = xf_sys_time_get_us();
+        XF_BLE_ENTER_CRITICAL();
+        lat_conn_bind(param->connect.conn_id, param->connect.addr);
+        lat_pending_t *p = lat_pending_find(XF_BLE_LATENCY_OP_CONNECT, 0, 0, param->connect.addr);
+        if (p != NULL) {
+            uint64_t latency_us = now_us - p->start_us;
+            p->is_used = false;
+            lat_record(XF_BLE_LATENCY_OP_CONNECT, param->connect.conn_id,
+                       (latency_us > UINT32_MAX) ? UINT32_MAX : (uint32_t)latency_us);
+        }
+        XF_BLE_EXIT_CRITICAL();
+    } else if (event == XF_BLE_GAP_EVT_DISCONNECT) {
+        /* 连接上等待完成的操作不再有完成事件；连接未建立即断开的连接操作同样丢弃 */
+        XF_BLE_ENTER_CRITICAL();
+        for (uint8_t i = 0; i < XF_BLE_LATENCY_PENDING_MAX; i++) {
+            lat_pending_t *p = &s_lat_pending_set[i];
+            if (!p->is_used) {
+                continue;
+            }
+            if ((p->op == XF_BLE_LATENCY_OP_CONNECT)
+                    ? ((param->disconnect.addr != NULL)
+                       && xf_ble_addr_is_equal(&p->addr, param->disconnect.addr))
+                    : (p->conn_id == param->disconnect.conn_id)) {
+                p->is_used = false;
+            }
+        }
+        /* 统计保留在对端名下，连接 ID 可能被之后的其他对端复用 */
+        lat_conn_t *c = lat_conn_get(param->disconnect.conn_id, false);
+        if (c != NULL) {
+            c->is_connected = false;
+        }
+        XF_BLE_EXIT_CRITICAL();
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+xf_ble_evt_res_t xf_ble_latency_gatts_event_handler(
+    xf_ble_gatts_evt_t event,
+    xf_ble_gatts_evt_cb_param_t *param)
+{
+    if ((event != XF_BLE_GATTS_EVT_IND_CFM) || (param == NULL)) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+    if (param->ind_cfm.status == XF_OK) {
+        xf_ble_latency_finish(XF_BLE_LATENCY_OP_INDICATE,
+                              param->ind_cfm.conn_id, param->ind_cfm.handle);
+    } else {
+        xf_ble_latency_cancel(XF_BLE_LATENCY_OP_INDICATE,
+                              param->ind_cfm.conn_id, param->ind_cfm.handle);
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+xf_ble_evt_res_t xf_ble_latency_gattc_event_handler(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param)
+{
+    if (param == NULL) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+    if (event == XF_BLE_GATTC_EVT_READ_CFM) {
+        xf_ble_latency_finish(XF_BLE_LATENCY_OP_READ,
+                              param->read_cfm.conn_id, param->read_cfm.handle);
+    } else if (event == XF_BLE_GATTC_EVT_WRITE_CFM) {
+        xf_ble_latency_finish(XF_BLE_LATENCY_OP_WRITE,
+                              param->write_cfm.conn_id, param->write_cfm.handle);
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+xf_err_t xf_ble_latency_snapshot(xf_ble_latency_op_t op, xf_ble_conn_id_t conn_id,
+                                 xf_ble_latency_hist_t *hist)
+{
+    XF_ASSERT(op < _XF_BLE_LATENCY_OP_MAX, XF_ERR_INVALID_ARG, TAG, "invalid op: %d", op);
+    XF_ASSERT(hist != NULL, XF_ERR_INVALID_ARG, TAG, "hist == NULL");
+
+    xf_err_t ret = XF_OK;
+    xf_memset(hist, 0, sizeof(xf_ble_latency_hist_t));
+    XF_BLE_ENTER_CRITICAL();
+    if (conn_id == XF_BLE_LATENCY_CONN_ID_ALL) {
+        for (uint8_t i = 0; i < XF_BLE_LATENCY_CONN_MAX; i++) {
+            if (s_lat_conn_set[i].is_used) {
+                lat_hist_merge(hist, &s_lat_conn_set[i].hist_set[op]);
+            }
+        }
+    } else {
+        lat_conn_t *c = lat_conn_get(conn_id, false);
+        if (c != NULL) {
+            *hist = c->hist_set[op];
+        } else {
+            ret = XF_ERR_NOT_FOUND;
+        }
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return ret;
+}
+
+xf_err_t xf_ble_latency_snapshot_peer(xf_ble_latency_op_t op, const xf_ble_addr_t *addr,
+                                      xf_ble_latency_hist_t *hist)
+{
+    XF_ASSERT(op < _XF_BLE_LATENCY_OP_MAX, XF_ERR_INVALID_ARG, TAG, "invalid op: %d", op);
+    XF_ASSERT(addr != NULL, XF_ERR_INVALID_ARG, TAG, "addr == NULL");
+    XF_ASSERT(hist != NULL, XF_ERR_INVALID_ARG, TAG, "hist == NULL");
+
+    xf_err_t ret = XF_OK;
+    XF_BLE_ENTER_CRITICAL();
+    lat_conn_t *c = lat_peer_get(addr);
+    if (c != NULL) {
+        *hist = c->hist_set[op];
+    } else {
+        xf_memset(hist, 0, sizeof(xf_ble_latency_hist_t));
+        ret = XF_ERR_NOT_FOUND;
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return ret;
+}
+
+void xf_ble_latency_reset(xf_ble_conn_id_t conn_id)
+{
+    XF_BLE_ENTER_CRITICAL();
+    if (conn_id == XF_BLE_LATENCY_CONN_ID_ALL) {
+        xf_memset(s_lat_conn_set, 0, sizeof(s_lat_conn_set));
+        xf_memset(s_lat_pending_set, 0, sizeof(s_lat_pending_set));
+    } else {
+        lat_conn_t *c = lat_conn_get(conn_id, false);
+        if (c != NULL) {
+            xf_memset(c, 0, sizeof(lat_conn_t));
+        }
+    }
+    XF_BLE_EXIT_CRITICAL();
+}
+
+uint32_t xf_ble_latency_hist_percentile(const xf_ble_latency_hist_t *hist, uint16_t permille)
+{
+    if ((hist == NULL) || (hist->cnt == 0)) {
+        return 0;
+    }
+    if (permille > 1000) {
+        permille = 1000;
+    }
+    /* 第 rank 个样本 (向上取整，至少为 1) 所在的区间 */
+    uint64_t rank = ((uint64_t)hist->cnt * permille + 999) / 1000;
+    if (rank == 0) {
+        rank = 1;
+    }
+    uint64_t acc = 0;
+    for (uint16_t i = 0; i < XF_BLE_LATENCY_BUCKET_NUM; i++) {
+        acc += hist->bucket[i];
+        if (acc >= rank) {
+            uint32_t upper = lat_bucket_upper(i);
+            if (upper > hist->max_us) {
+                upper = hist->max_us;
+            }
+            return (upper < hist->min_us) ? hist->min_us : upper;
+        }
+    }
+    return hist->max_us;
+}
+
+void xf_ble_latency_hist_summary(const xf_ble_latency_hist_t *hist,
+                                 xf_ble_latency_summary_t *summary)
+{
+    if ((hist == NULL) || (summary == NULL)) {
+        return;
+    }
+    xf_memset(summary, 0, sizeof(xf_ble_latency_summary_t));
+    if (hist->cnt == 0) {
+        return;
+    }
+    summary->cnt = hist->cnt;
+    summary->min_us = hist->min_us;
+    summary->max_us = hist->max_us;
+    summary->mean_us = (uint32_t)(hist->sum_us / hist->cnt);
+    summary->p50_us = xf_ble_latency_hist_percentile(hist, 500);
+    summary->p90_us = xf_ble_latency_hist_percentile(hist, 900);
+    summary->p99_us = xf_ble_latency_hist_percentile(hist, 990);
+    summary->p999_us = xf_ble_latency_hist_percentile(hist, 999);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void lat_start(xf_ble_latency_op_t op, xf_ble_conn_id_t conn_id,
+                      xf_ble_attr_handle_t handle, const xf_ble_addr_t *addr)
+{
+    uint64_t now_us = xf_sys_time_get_us();
+
+    XF_BLE_ENTER_CRITICAL();
+    /* 优先使用空闲项，已满时覆盖最早发起的操作 (其完成事件可能已丢失) */
+    lat_pending_t *slot = NULL;
+    for (uint8_t i = 0; i < XF_BLE_LATENCY_PENDING_MAX; i++) {
+        lat_pending_t *p = &s_lat_pending_set[i];
+        if (!p->is_used) {
+            slot = p;
+            break;
+        }
+        if ((slot == NULL) || ((int32_t)(p->seq - slot->seq) < 0)) {
+            slot = p;
+        }
+    }
+    slot->is_used = true;
+    slot->op = op;
+    slot->conn_id = conn_id;
+    slot->handle = handle;
+    if (addr != NULL) {
+        slot->addr = *addr;
+    }
+    slot->seq = s_lat_seq++;
+    slot->start_us = now_us;
+    XF_BLE_EXIT_CRITICAL();
+}
+
+/**
+ * @brief 查找最早发起的匹配操作 (需在临界区内调用)
+ *
+ * @note 连接操作按地址匹配，其余操作按 (连接 ID, 句柄) 匹配
+ */
+static lat_pending_t *lat_pending_find(xf_ble_latency_op_t op, xf_ble_conn_id_t conn_id,
+                                       xf_ble_attr_handle_t handle, const xf_ble_addr_t *addr)
+{
+    lat_pending_t *found = NULL;
+    for (uint8_t i = 0; i < XF_BLE_LATENCY_PENDING_MAX; i++) {
+        lat_pending_t *p = &s_lat_pending_set[i];
+        if (!p->is_used || (p->op != op)) {
+            continue;
+        }
+        bool is_match = (op == XF_BLE_LATENCY_OP_CONNECT)
+                        ? xf_ble_addr_is_equal(&p->addr, addr)
+                        : ((p->conn_id == conn_id) && (p->handle == handle));
+        if (is_match && ((found == NULL) || ((int32_t)(p->seq - found->seq) < 0))) {
+            found = p;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief 记录一个样本 (需在临界区内调用)
+ */
+static void lat_record(xf_ble_latency_op_t op, xf_ble_conn_id_t conn_id, uint32_t latency_us)
+{
+    lat_conn_t *c = lat_conn_get(conn_id, true);
+    if (c == NULL) {
+        XF_LOGD(TAG, "no free conn slot for conn(%d)", conn_id);
+        return;
+    }
+    lat_hist_add(&c->hist_set[op], latency_us);
+}
+
+/**
+ * @brief 获取当前连接的统计项 (需在临界区内调用)
+ *
+ * @note is_create 时若该连接尚未绑定对端 (未经连接事件)，分配一个匿名项
+ */
+static lat_conn_t *lat_conn_get(xf_ble_conn_id_t conn_id, bool is_create)
+{
+    for (uint8_t i = 0; i < XF_BLE_LATENCY_CONN_MAX; i++) {
+        lat_conn_t *c = &s_lat_conn_set[i];
+        if (c->is_used && c->is_connected && (c->conn_id == conn_id)) {
+            c->seq = s_lat_seq++;
+            return c;
+        }
+    }
+    if (!is_create) {
+        return NULL;
+    }
+    lat_conn_t *c = lat_conn_alloc();
+    if (c != NULL) {
+        c->is_connected = true;
+        c->conn_id = conn_id;
+    }
+    return c;
+}
+
+/**
+ * @brief 按对端地址获取统计项 (需在临界区内调用)
+ */
+static lat_conn_t *lat_peer_get(const xf_ble_addr_t *addr)
+{
+    for (uint8_t i = 0; i < XF_BLE_LATENCY_CONN_MAX; i++) {
+        lat_conn_t *c = &s_lat_conn_set[i];
+        if (c->is_used && c->has_addr && xf_ble_addr_is_equal(&c->addr, addr)) {
+            return c;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 分配统计项 (需在临界区内调用)
+ *
+ * @note 优先使用空闲项，已满时回收最久未使用的已断开对端；均处于连接中时返回 NULL
+ */
+static lat_conn_t *lat_conn_alloc(void)
+{
+    lat_conn_t *slot = NULL;
+    for (uint8_t i = 0; i < XF_BLE_LATENCY_CONN_MAX; i++) {
+        lat_conn_t *c = &s_lat_conn_set[i];
+        if (!c->is_used) {
+            slot = c;
+            break;
+        }
+        if (!c->is_connected
+                && ((slot == NULL) || ((int32_t)(c->seq - slot->seq) < 0))) {
+            slot = c;
+        }
+    }
+    if (slot == NULL) {
+        return NULL;
+    }
+    xf_memset(slot, 0, sizeof(lat_conn_t));
+    slot->is_used = true;
+    slot->seq = s_lat_seq++;
+    return slot;
+}
+
+/**
+ * @brief 连接建立时将连接 ID 绑定到对端的统计项 (需在临界区内调用)
+ */
+static void lat_conn_bind(xf_ble_conn_id_t conn_id, const xf_ble_addr_t *addr)
+{
+    /* 丢失断连事件时，该连接 ID 可能仍绑定在之前的对端上 */
+    lat_conn_t *c = lat_conn_get(conn_id, false);
+    if (c != NULL) {
+        if (c->has_addr && xf_ble_addr_is_equal(&c->addr, addr)) {
+            return;
+        }
+        c->is_connected = false;
+    }
+    c = lat_peer_get(addr);
+    if (c == NULL) {
+        c = lat_conn_alloc();
+        if (c == NULL) {
+            XF_LOGD(TAG, "no free conn slot for conn(%d)", conn_id);
+            return;
+        }
+        c->has_addr = true;
+        c->addr = *addr;
+    }
+    c->is_connected = true;
+    c->conn_id = conn_id;
+    c->seq = s_lat_seq++;
+}
+
+static void lat_hist_add(xf_ble_latency_hist_t *hist, uint32_t value)
+{
+    if ((hist->cnt == 0) || (value < hist->min_us)) {
+        hist->min_us = value;
+    }
+    if (value > hist->max_us) {
+        hist->max_us = value;
+    }
+    ++hist->cnt;
+    hist->sum_us += value;
+    ++hist->bucket[lat_bucket_index(value)];
+}
+
+static void lat_hist_merge(xf_ble_latency_hist_t *dst, const xf_ble_latency_hist_t *src)
+{
+    if (src->cnt == 0) {
+        return;
+    }
+    if ((dst->cnt == 0) || (src->min_us < dst->min_us)) {
+        dst->min_us = src->min_us;
+    }
+    if (src->max_us > dst->max_us) {
+        dst->max_us = src->max_us;
+    }
+    dst->cnt += src->cnt;
+    dst->sum_us += src->sum_us;
+    for (uint16_t i = 0; i < XF_BLE_LATENCY_BUCKET_NUM; i++) {
+        dst->bucket[i] += src->bucket[i];
+    }
+}
+
+/**
+ * @brief 值所在的区间: 小于 LAT_SUB_NUM 时每个值一个区间，
+ *  否则由最高位 e 及其后 SUB_BITS 位 m 决定: LAT_SUB_NUM + (e - SUB_BITS) * LAT_SUB_NUM + m
+ */
+static uint16_t lat_bucket_index(uint32_t value)
+{
+    if (value < LAT_SUB_NUM) {
+        return (uint16_t)value;
+    }
+    uint32_t e = 31 - (uint32_t)__builtin_clz(value);
+    uint32_t m = (value >> (e - XF_BLE_LATENCY_SUB_BITS)) & LAT_SUB_MASK;
+    return (uint16_t)(LAT_SUB_NUM + (e - XF_BLE_LATENCY_SUB_BITS) * LAT_SUB_NUM + m);
+}
+
+static uint32_t lat_bucket_upper(uint16_t index)
+{
+    if (index < LAT_SUB_NUM) {
+        return index;
+    }
+    uint32_t k = index - LAT_SUB_NUM;
+    uint32_t shift = k / LAT_SUB_NUM;
+    uint64_t lower = (uint64_t)(LAT_SUB_NUM + (k % LAT_SUB_NUM)) << shift;
+    uint64_t upper = lower + ((uint64_t)1 << shift) - 1;
+    return (upper > UINT32_MAX) ? UINT32_MAX : (uint32_t)upper;
+}
+
+#endif /* XF_BLE_IS_ENABLE && XF_BLE_LATENCY_ENABLE */
@@ -0,0 +1,277 @@
+/**
+ * @file xf_ble_latency.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 往返时延统计。
+ *  记录连接、服务搜寻、读、写、指示等操作的发起时间，并与对应的完成事件匹配，
+ *  按操作及对端 (连接事件中的对端地址) 累计到对数-线性直方图中，提供最小、最大、平均值及百分位数。
+ *  断连后统计仍保留在对端名下，再次连接时继续累计；统计项不足时回收最久未使用的已断开对端。
+ *  由 XF_BLE_LATENCY_ENABLE 开启，关闭时统计宏展开为空。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_LATENCY_H__
+#define __XF_BLE_LATENCY_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gap_types.h"
+#include "xf_ble_gatt_server_types.h"
+#include "xf_ble_gatt_client_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief BLE 往返时延直方图的区间数量
+ *
+ * @note 小于 2^SUB_BITS 微秒的值每微秒一个区间，其余每个 2 的幂区间再线性分为 2^SUB_BITS 个子区间
+ */
+#define XF_BLE_LATENCY_BUCKET_NUM \
+    ((1 << XF_BLE_LATENCY_SUB_BITS) * (33 - XF_BLE_LATENCY_SUB_BITS))
+
+/**
+ * @brief BLE 往返时延统计: 所有连接
+ */
+#define XF_BLE_LATENCY_CONN_ID_ALL  (0xFF)
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE 往返时延统计的操作
+ */
+typedef uint8_t xf_ble_latency_op_t;
+enum _xf_ble_latency_op_t {
+    XF_BLE_LATENCY_OP_CONNECT = 0,  /*!< xf_ble_gap_connect() 至连接事件 */
+    XF_BLE_LATENCY_OP_DISCOVER,     /*!< xf_ble_gattc_discover_service() / xf_ble_gattc_discover_chara() */
+    XF_BLE_LATENCY_OP_READ,         /*!< xf_ble_gattc_request_read_by_handle() 至读确认事件 */
+    XF_BLE_LATENCY_OP_WRITE,        /*!< xf_ble_gattc_request_write() (需响应) 至写确认事件 */
+    XF_BLE_LATENCY_OP_INDICATE,     /*!< xf_ble_gatts_send_indication() 至指示确认事件 */
+    _XF_BLE_LATENCY_OP_MAX,
+};
+
+/**
+ * @brief BLE 往返时延直方图
+ */
+typedef struct {
+    uint32_t cnt;                                   /*!< 样本数 */
+    uint32_t min_us;                                /*!< 最小值 (微秒) */
+    uint32_t max_us;                                /*!< 最大值 (微秒) */
+    uint64_t sum_us;                                /*!< 总和 (微秒) */
+    uint32_t bucket[XF_BLE_LATENCY_BUCKET_NUM];     /*!< 各区间的样本数 */
+} xf_ble_latency_hist_t;
+
+/**
+ * @brief BLE 往返时延统计摘要 (微秒)
+ *
+ * @note 百分位数为所在区间的上界 (不超过最大值)
+ */
+typedef struct {
+    uint32_t cnt;           /*!< 样本数 */
+    uint32_t min_us;        /*!< 最小值 */
+    uint32_t max_us;        /*!< 最大值 */
+    uint32_t mean_us;       /*!< 平均值 */
+    uint32_t p50_us;        /*!< 50 百分位数 */
+    uint32_t p90_us;        /*!< 90 百分位数 */
+    uint32_t p99_us;        /*!< 99 百分位数 */
+    uint32_t p999_us;       /*!< 99.9 百分位数 */
+} xf_ble_latency_summary_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+#if XF_BLE_LATENCY_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @brief BLE 往返时延统计: 操作发起
+ *
+ * @note 通常通过 XF_BLE_LATENCY_START() 调用。 utils 中的异步命令、缓存、订阅及搜寻已调用，
+ *  应用直接调用 xf_ble_gattc_request_read_by_handle() 、 xf_ble_gatts_send_indication() 等时需自行调用
+ * @param op 操作，见 @ref xf_ble_latency_op_t ，连接操作见 xf_ble_latency_start_connect()
+ * @param conn_id 连接 ID
+ * @param handle 属性句柄 (搜寻时为起始句柄)
+ */
+void xf_ble_latency_start(xf_ble_latency_op_t op, xf_ble_conn_id_t conn_id,
+                          xf_ble_attr_handle_t handle);
+
+/**
+ * @brief BLE 往返时延统计: 连接操作发起
+ *
+ * @param addr 对端地址，与连接事件中的地址匹配
+ */
+void xf_ble_latency_start_connect(const xf_ble_addr_t *addr);
+
+/**
+ * @brief BLE 往返时延统计: 操作完成 (按发起顺序匹配最早的同类操作并记录时延)
+ *
+ * @note 由事件处理函数调用；同步完成的操作 (如服务搜寻) 在调用返回后直接调用
+ */
+void xf_ble_latency_finish(xf_ble_latency_op_t op, xf_ble_conn_id_t conn_id,
+                           xf_ble_attr_handle_t handle);
+
+/**
+ * @brief BLE 往返时延统计: 取消已发起的操作 (如发起失败)，不记录时延
+ */
+void xf_ble_latency_cancel(xf_ble_latency_op_t op, xf_ble_conn_id_t conn_id,
+                           xf_ble_attr_handle_t handle);
+
+/**
+ * @brief BLE 往返时延统计: 取消已发起的连接操作
+ */
+void xf_ble_latency_cancel_connect(const xf_ble_addr_t *addr);
+
+/**
+ * @brief BLE 往返时延统计的 GAP 事件处理 (连接、断连)
+ *
+ * @note 需在 GAP 事件回调中调用 (统计按连接事件中的对端地址归属)；
+ *  仅观察事件，固定返回 XF_BLE_EVT_RES_NOT_HANDLED
+ */
+xf_ble_evt_res_t xf_ble_latency_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param);
+
+/**
+ * @brief BLE 往返时延统计的 GATTS 事件处理 (指示确认)
+ *
+ * @note 同 xf_ble_latency_gap_event_handler()
+ */
+xf_ble_evt_res_t xf_ble_latency_gatts_event_handler(
+    xf_ble_gatts_evt_t event,
+    xf_ble_gatts_evt_cb_param_t *param);
+
+/**
+ * @brief BLE 往返时延统计的 GATTC 事件处理 (读确认、写确认)
+ *
+ * @note 同 xf_ble_latency_gap_event_handler()
+ */
+xf_ble_evt_res_t xf_ble_latency_gattc_event_handler(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param);
+
+/**
+ * @brief BLE 往返时延统计: 获取直方图快照
+ *
+ * @param op 操作，见 @ref xf_ble_latency_op_t
+ * @param conn_id 当前连接的 ID ， XF_BLE_LATENCY_CONN_ID_ALL 表示合并所有对端 (含已断开的)
+ * @param[out] hist 直方图，见 @ref xf_ble_latency_hist_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      该连接无统计 (已断开的对端见 xf_ble_latency_snapshot_peer())
+ */
+xf_err_t xf_ble_latency_snapshot(xf_ble_latency_op_t op, xf_ble_conn_id_t conn_id,
+                                 xf_ble_latency_hist_t *hist);
+
+/**
+ * @brief BLE 往返时延统计: 获取某个对端的直方图快照 (不论当前是否连接)
+ *
+ * @param op 操作，见 @ref xf_ble_latency_op_t
+ * @param addr 对端地址 (连接事件中的地址)
+ * @param[out] hist 直方图，见 @ref xf_ble_latency_hist_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      该对端无统计
+ */
+xf_err_t xf_ble_latency_snapshot_peer(xf_ble_latency_op_t op, const xf_ble_addr_t *addr,
+                                      xf_ble_latency_hist_t *hist);
+
+/**
+ * @brief BLE 往返时延统计清零
+ *
+ * @param conn_id 当前连接的 ID ， XF_BLE_LATENCY_CONN_ID_ALL 表示所有对端 (同时清除等待完成的操作)
+ */
+void xf_ble_latency_reset(xf_ble_conn_id_t conn_id);
+
+/**
+ * @brief BLE 往返时延直方图的百分位数
+ *
+ * @param hist 直方图
+ * @param permille 千分位，如 500 (p50)、 999 (p99.9)
+ * @return uint32_t 百分位数 (微秒)，无样本时为 0
+ */
+uint32_t xf_ble_latency_hist_percentile(const xf_ble_latency_hist_t *hist, uint16_t permille);
+
+/**
+ * @brief BLE 往返时延直方图的统计摘要
+ *
+ * @param hist 直方图
+ * @param[out] summary 摘要，见 @ref xf_ble_latency_summary_t
+ */
+void xf_ble_latency_hist_summary(const xf_ble_latency_hist_t *hist,
+                                 xf_ble_latency_summary_t *summary);
+
+#endif /* XF_BLE_LATENCY_ENABLE */
+
+/* ==================== [Macros] ============================================ */
+
+#if XF_BLE_LATENCY_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @brief BLE 往返时延统计: 操作发起，见 xf_ble_latency_start()
+ */
+#define XF_BLE_LATENCY_START(op, conn_id, handle) \
+    xf_ble_latency_start((op), (conn_id), (handle))
+
+/**
+ * @brief BLE 往返时延统计: 连接操作发起，见 xf_ble_latency_start_connect()
+ */
+#define XF_BLE_LATENCY_START_CONNECT(addr)          xf_ble_latency_start_connect(addr)
+
+/**
+ * @brief BLE 往返时延统计: 操作完成，见 xf_ble_latency_finish()
+ */
+#define XF_BLE_LATENCY_FINISH(op, conn_id, handle) \
+    xf_ble_latency_finish((op), (conn_id), (handle))
+
+/**
+ * @brief BLE 往返时延统计: 取消操作，见 xf_ble_latency_cancel()
+ */
+#define XF_BLE_LATENCY_CANCEL(op, conn_id, handle) \
+    xf_ble_latency_cancel((op), (conn_id), (handle))
+
+/**
+ * @brief BLE 往返时延统计: 取消连接操作，见 xf_ble_latency_cancel_connect()
+ */
+#define XF_BLE_LATENCY_CANCEL_CONNECT(addr)         xf_ble_latency_cancel_connect(addr)
+
+#else
+
+#define XF_BLE_LATENCY_START(op, conn_id, handle) \
+    do { (void)(op); (void)(conn_id); (void)(handle); } while (0)
+#define XF_BLE_LATENCY_START_CONNECT(addr)          do { (void)(addr); } while (0)
+#define XF_BLE_LATENCY_FINISH(op, conn_id, handle) \
+    do { (void)(op); (void)(conn_id); (void)(handle); } while (0)
+#define XF_BLE_LATENCY_CANCEL(op, conn_id, handle) \
+    do { (void)(op); (void)(conn_id); (void)(handle); } while (0)
+#define XF_BLE_LATENCY_CANCEL_CONNECT(addr)         do { (void)(addr); } while (0)
+
+#endif /* XF_BLE_LATENCY_ENABLE */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_LATENCY_H__ */
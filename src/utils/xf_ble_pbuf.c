@@ -0,0 +1,85 @@
+/**
+ * @file xf_ble_pbuf.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 数据包缓冲区 (带引用计数)。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_ble_pool.h"
+#include "xf_ble_pbuf.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_pbuf"
+
+/* 引用计数可能在协议栈及工作线程中同时增减 */
+#define PBUF_REF_INC(p)     __atomic_add_fetch(&(p)->ref, 1, __ATOMIC_RELAXED)
+#define PBUF_REF_DEC(p)     __atomic_sub_fetch(&(p)->ref, 1, __ATOMIC_ACQ_REL)
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+/* ==================== [Static Variables] ================================== */
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_ble_pbuf_t *xf_ble_pbuf_alloc(uint16_t size)
+{
+    XF_CHECK(size > UINT16_MAX - sizeof(xf_ble_pbuf_t), NULL, TAG, "size too large: %u", size);
+    /* 缓冲区头与数据一次从缓冲池分配，数据紧跟在头之后 */
+    xf_ble_pbuf_t *pbuf = (xf_ble_pbuf_t *)xf_ble_pool_alloc(sizeof(xf_ble_pbuf_t) + size);
+    if (pbuf == NULL) {
+        XF_LOGE(TAG, "alloc failed: %u", size);
+        return NULL;
+    }
+    pbuf->payload = (uint8_t *)(pbuf + 1);
+    pbuf->len = 0;
+    pbuf->size = size;
+    pbuf->ref = 1;
+    return pbuf;
+}
+
+xf_ble_pbuf_t *xf_ble_pbuf_take(xf_ble_pbuf_t *pbuf)
+{
+    if (pbuf != NULL) {
+        PBUF_REF_INC(pbuf);
+    }
+    return pbuf;
+}
+
+xf_ble_pbuf_t *xf_ble_pbuf_take_or_copy(xf_ble_pbuf_t *pbuf, const uint8_t *data, uint16_t len)
+{
+    if (pbuf != NULL) {
+        return xf_ble_pbuf_take(pbuf);
+    }
+    pbuf = xf_ble_pbuf_alloc(len);
+    if ((pbuf != NULL) && (data != NULL)) {
+        xf_memcpy(pbuf->payload, data, len);
+        pbuf->len = len;
+    }
+    return pbuf;
+}
+
+void xf_ble_pbuf_release(xf_ble_pbuf_t *pbuf)
+{
+    if (pbuf == NULL) {
+        return;
+    }
+    if (PBUF_REF_DEC(pbuf) == 0) {
+        xf_ble_pool_free(pbuf);
+    }
+}
+
+/* ==================== [Static Functions] ================================== */
+
+#endif /* XF_BLE_IS_ENABLE */
@@ -0,0 +1,90 @@
+/**
+ * @file xf_ble_pbuf.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 数据包缓冲区 (带引用计数)。
+ *  对接层分配缓冲区并将控制器收到的数据直接填入，随事件参数传出 (需开启 XF_BLE_EVT_PBUF_ENABLE)；
+ *  需要在回调结束后继续使用数据的处理函数持有 (take) 缓冲区而非拷贝数据，用完后释放。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_PBUF_H__
+#define __XF_BLE_PBUF_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE 分配数据包缓冲区
+ *
+ * @note 从缓冲池分配 (见 xf_ble_pool_alloc() )，分配后引用计数为 1 ，数据长度为 0 。
+ *  对接层的用法: 分配，填入数据并设置 len ，将 payload 及缓冲区填入事件参数的 value 及 pbuf 成员，
+ *  调用事件回调，回调返回后调用 xf_ble_pbuf_release() 释放自身的引用
+ * @param size 数据容量
+ * @return xf_ble_pbuf_t* 缓冲区，内存不足时为 NULL
+ */
+xf_ble_pbuf_t *xf_ble_pbuf_alloc(uint16_t size);
+
+/**
+ * @brief BLE 持有数据包缓冲区 (引用计数加 1)
+ *
+ * @param pbuf 缓冲区，通常为事件参数中的 pbuf 成员
+ * @return xf_ble_pbuf_t* 同 pbuf ， pbuf 为 NULL 时返回 NULL
+ */
+xf_ble_pbuf_t *xf_ble_pbuf_take(xf_ble_pbuf_t *pbuf);
+
+/**
+ * @brief BLE 持有数据包缓冲区，对接层未提供缓冲区时分配并拷贝数据
+ *
+ * @note 用于同时兼容提供与未提供 pbuf 的对接层
+ * @param pbuf 缓冲区，可为 NULL
+ * @param data 数据，即事件参数中的 value 等成员
+ * @param len 数据长度
+ * @return xf_ble_pbuf_t* 持有的缓冲区，内存不足时为 NULL
+ */
+xf_ble_pbuf_t *xf_ble_pbuf_take_or_copy(xf_ble_pbuf_t *pbuf, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief BLE 释放数据包缓冲区 (引用计数减 1 ，减至 0 时回收)
+ *
+ * @param pbuf 缓冲区，可为 NULL
+ */
+void xf_ble_pbuf_release(xf_ble_pbuf_t *pbuf);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_PBUF_H__ */
@@ -0,0 +1,235 @@
+/**
+ * @file xf_ble_pool.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 缓冲池。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_ble_pool.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_pool"
+
+#if (XF_BLE_POOL_SMALL_SIZE > XF_BLE_POOL_MEDIUM_SIZE) \
+    || (XF_BLE_POOL_MEDIUM_SIZE > XF_BLE_POOL_LARGE_SIZE)
+#error "XF_BLE_POOL_*_SIZE must be in ascending order"
+#endif
+
+/* 块按指针大小对齐，空闲块的首部用于保存空闲链表指针 */
+#define POOL_ALIGN(size)    (((size) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+#define POOL_BLOCK_SIZE(size) \
+    ((POOL_ALIGN(size) < sizeof(void *)) ? sizeof(void *) : POOL_ALIGN(size))
+/* 额外加 1 避免块数量为 0 时数组长度为 0 */
+#define POOL_MEM_WORDS(size, num) \
+    ((POOL_BLOCK_SIZE(size) * (num)) / sizeof(void *) + 1)
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct _pool_block_t {
+    struct _pool_block_t *next;
+} pool_block_t;
+
+typedef struct {
+    uint8_t *mem;
+    uint16_t block_size;
+    uint16_t block_num;
+    pool_block_t *free_list;
+    xf_ble_pool_stats_t stats;
+} pool_class_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void *pool_alloc_locked(uint16_t size);
+static bool pool_free_locked(void *ptr);
+static pool_class_t *pool_class_find(const void *ptr);
+static void pool_init(void);
+
+/* ==================== [Static Variables] ================================== */
+
+static void *s_pool_mem_small[POOL_MEM_WORDS(XF_BLE_POOL_SMALL_SIZE, XF_BLE_POOL_SMALL_NUM)];
+static void *s_pool_mem_medium[POOL_MEM_WORDS(XF_BLE_POOL_MEDIUM_SIZE, XF_BLE_POOL_MEDIUM_NUM)];
+static void *s_pool_mem_large[POOL_MEM_WORDS(XF_BLE_POOL_LARGE_SIZE, XF_BLE_POOL_LARGE_NUM)];
+
+static pool_class_t s_pool_class_set[XF_BLE_POOL_CLASS_NUM] = {
+    {
+        .mem = (uint8_t *)s_pool_mem_small,
+        .block_size = POOL_BLOCK_SIZE(XF_BLE_POOL_SMALL_SIZE),
+        .block_num = XF_BLE_POOL_SMALL_NUM,
+    },
+    {
+        .mem = (uint8_t *)s_pool_mem_medium,
+        .block_size = POOL_BLOCK_SIZE(XF_BLE_POOL_MEDIUM_SIZE),
+        .block_num = XF_BLE_POOL_MEDIUM_NUM,
+    },
+    {
+        .mem = (uint8_t *)s_pool_mem_large,
+        .block_size = POOL_BLOCK_SIZE(XF_BLE_POOL_LARGE_SIZE),
+        .block_num = XF_BLE_POOL_LARGE_NUM,
+    },
+};
+static bool s_pool_is_inited = false;
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void *xf_ble_pool_alloc(uint16_t size)
+{
+    XF_BLE_ENTER_CRITICAL();
+    void *ptr = pool_alloc_locked(size);
+    XF_BLE_EXIT_CRITICAL();
+#if XF_BLE_POOL_HEAP_FALLBACK
+    if (ptr == NULL) {
+        ptr = xf_malloc(size);
+    }
+#endif
+    return ptr;
+}
+
+void xf_ble_pool_free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    XF_BLE_ENTER_CRITICAL();
+    bool is_freed = pool_free_locked(ptr);
+    XF_BLE_EXIT_CRITICAL();
+#if XF_BLE_POOL_HEAP_FALLBACK
+    if (!is_freed) {
+        xf_free(ptr);
+    }
+#else
+    if (!is_freed) {
+        XF_LOGE(TAG, "free invalid ptr: %p", ptr);
+    }
+#endif
+}
+
+void *xf_ble_pool_alloc_from_isr(uint16_t size)
+{
+    uint32_t state;
+    XF_BLE_ENTER_CRITICAL_FROM_ISR(state);
+    void *ptr = pool_alloc_locked(size);
+    XF_BLE_EXIT_CRITICAL_FROM_ISR(state);
+    return ptr;
+}
+
+void xf_ble_pool_free_from_isr(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    uint32_t state;
+    XF_BLE_ENTER_CRITICAL_FROM_ISR(state);
+    pool_free_locked(ptr);
+    XF_BLE_EXIT_CRITICAL_FROM_ISR(state);
+}
+
+xf_err_t xf_ble_pool_get_stats(uint8_t class_index, xf_ble_pool_stats_t *stats)
+{
+    XF_ASSERT(class_index < XF_BLE_POOL_CLASS_NUM, XF_ERR_INVALID_ARG, TAG,
+              "invalid class: %d", class_index);
+    XF_ASSERT(stats != NULL, XF_ERR_INVALID_ARG, TAG, "stats == NULL");
+
+    XF_BLE_ENTER_CRITICAL();
+    const pool_class_t *c = &s_pool_class_set[class_index];
+    *stats = c->stats;
+    stats->block_size = c->block_size;
+    stats->block_num = c->block_num;
+    XF_BLE_EXIT_CRITICAL();
+    return XF_OK;
+}
+
+void xf_ble_pool_reset_stats(void)
+{
+    XF_BLE_ENTER_CRITICAL();
+    for (uint8_t i = 0; i < XF_BLE_POOL_CLASS_NUM; i++) {
+        xf_ble_pool_stats_t *stats = &s_pool_class_set[i].stats;
+        stats->used_max = stats->used;
+        stats->alloc_cnt = 0;
+        stats->fail_cnt = 0;
+    }
+    XF_BLE_EXIT_CRITICAL();
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void *pool_alloc_locked(uint16_t size)
+{
+    if (!s_pool_is_inited) {
+        pool_init();
+    }
+    for (uint8_t i = 0; i < XF_BLE_POOL_CLASS_NUM; i++) {
+        pool_class_t *c = &s_pool_class_set[i];
+        if (size > c->block_size) {
+            continue;
+        }
+        pool_block_t *block = c->free_list;
+        if (block == NULL) {
+            if (c->block_num != 0) {
+                ++c->stats.fail_cnt;
+            }
+            continue;
+        }
+        c->free_list = block->next;
+        ++c->stats.alloc_cnt;
+        if (++c->stats.used > c->stats.used_max) {
+            c->stats.used_max = c->stats.used;
+        }
+        return block;
+    }
+    return NULL;
+}
+
+static bool pool_free_locked(void *ptr)
+{
+    pool_class_t *c = pool_class_find(ptr);
+    if (c == NULL) {
+        return false;
+    }
+    pool_block_t *block = (pool_block_t *)ptr;
+    block->next = c->free_list;
+    c->free_list = block;
+    --c->stats.used;
+    return true;
+}
+
+/**
+ * @brief 按地址范围查找块所属的类别
+ */
+static pool_class_t *pool_class_find(const void *ptr)
+{
+    const uint8_t *p = (const uint8_t *)ptr;
+    for (uint8_t i = 0; i < XF_BLE_POOL_CLASS_NUM; i++) {
+        pool_class_t *c = &s_pool_class_set[i];
+        if ((p >= c->mem) && (p < c->mem + (size_t)c->block_size * c->block_num)) {
+            return c;
+        }
+    }
+    return NULL;
+}
+
+static void pool_init(void)
+{
+    for (uint8_t i = 0; i < XF_BLE_POOL_CLASS_NUM; i++) {
+        pool_class_t *c = &s_pool_class_set[i];
+        c->free_list = NULL;
+        /* 倒序串接，使分配从低地址开始 */
+        for (uint16_t j = c->block_num; j > 0; j--) {
+            pool_block_t *block = (pool_block_t *)(c->mem + (size_t)c->block_size * (j - 1));
+            block->next = c->free_list;
+            c->free_list = block;
+        }
+    }
+    s_pool_is_inited = true;
+}
+
+#endif /* XF_BLE_IS_ENABLE */
@@ -0,0 +1,118 @@
+/**
+ * @file xf_ble_pool.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 缓冲池。
+ *  按大小分为小、中、大三类固定大小的块，分配与释放均为 O(1)，
+ *  用于通知、读写、扫描结果等数据，避免长期运行后堆内存碎片化。
+ *  各类块的大小及数量见 xf_ble_config_internal.h 中的 XF_BLE_POOL_* 配置。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_POOL_H__
+#define __XF_BLE_POOL_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief BLE 缓冲池块的类别数 (小、中、大)
+ */
+#define XF_BLE_POOL_CLASS_NUM       (3)
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE 缓冲池单类块的统计
+ */
+typedef struct {
+    uint16_t block_size;    /*!< 块大小 */
+    uint16_t block_num;     /*!< 块数量 */
+    uint16_t used;          /*!< 当前已分配的块数 */
+    uint16_t used_max;      /*!< 已分配块数的历史最大值 (高水位) */
+    uint32_t alloc_cnt;     /*!< 分配的次数 */
+    uint32_t fail_cnt;      /*!< 因该类块已用尽而改用更大的块或分配失败的次数 */
+} xf_ble_pool_stats_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE 从缓冲池分配内存
+ *
+ * @note 优先使用能容纳 size 的最小的块，已用尽时依次尝试更大的块；
+ *  均不可用时，若 XF_BLE_POOL_HEAP_FALLBACK 开启则从堆中分配
+ * @param size 大小
+ * @return void* 分配的内存，失败时为 NULL
+ */
+void *xf_ble_pool_alloc(uint16_t size);
+
+/**
+ * @brief BLE 释放从缓冲池分配的内存
+ *
+ * @param ptr xf_ble_pool_alloc() 或 xf_ble_pool_alloc_from_isr() 分配的内存，可为 NULL
+ */
+void xf_ble_pool_free(void *ptr);
+
+/**
+ * @brief BLE 从缓冲池分配内存 (中断上下文)
+ *
+ * @note 同 xf_ble_pool_alloc() ，但使用 XF_BLE_ENTER_CRITICAL_FROM_ISR() ，且不会从堆中分配
+ */
+void *xf_ble_pool_alloc_from_isr(uint16_t size);
+
+/**
+ * @brief BLE 释放从缓冲池分配的内存 (中断上下文)
+ *
+ * @note ptr 不能是从堆中分配的内存
+ */
+void xf_ble_pool_free_from_isr(void *ptr);
+
+/**
+ * @brief BLE 获取缓冲池单类块的统计
+ *
+ * @param class_index 类别，小于 XF_BLE_POOL_CLASS_NUM ，按块大小从小到大排列
+ * @param[out] stats 统计，见 @ref xf_ble_pool_stats_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_ble_pool_get_stats(uint8_t class_index, xf_ble_pool_stats_t *stats);
+
+/**
+ * @brief BLE 缓冲池高水位及计数清零 (高水位重置为当前已分配的块数)
+ */
+void xf_ble_pool_reset_stats(void);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_POOL_H__ */
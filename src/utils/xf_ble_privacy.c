@@ -0,0 +1,284 @@
+/**
+ * @file xf_ble_privacy.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 本端隐私: 可解析私有地址 (RPA) 的生成与定时轮换。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_sys.h"
+#include "xf_ble_gap.h"
+#include "xf_ble_trace.h"
+#include "xf_ble_aes.h"
+#include "xf_ble_privacy.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_privacy"
+
+/* 设备地址占用第 0 个槽位 */
+#define PRIVACY_SLOT_NUM        (1 + XF_BLE_PRIVACY_ADV_NUM)
+#define PRIVACY_RAND_RETRY      (4)
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct {
+    bool is_used;
+    bool is_next_ready;                     /*!< 下一个地址已生成 */
+    bool is_pending;                        /*!< 轮换下发失败，待重试 */
+    uint8_t cur;                            /*!< 当前地址在 addr_set 中的下标，另一个为下一个地址 */
+    xf_ble_adv_id_t adv_id;                 /*!< XF_BLE_ADV_ID_INVALID 表示设备地址 */
+    xf_ble_addr_t addr_set[2];
+} privacy_slot_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static privacy_slot_t *privacy_slot_find(xf_ble_adv_id_t adv_id);
+static xf_err_t privacy_slot_rotate(privacy_slot_t *slot);
+static xf_err_t privacy_apply(const privacy_slot_t *slot, const xf_ble_addr_t *addr);
+static xf_err_t privacy_gen(xf_ble_addr_t *addr);
+
+/* ==================== [Static Variables] ================================== */
+
+static bool s_is_inited = false;
+static xf_ble_aes_ctx_t s_ctx = {0};
+static uint16_t s_timeout_s = XF_BLE_PRIVACY_TIMEOUT_DEFAULT;
+static uint64_t s_rotate_us = 0;            /*!< 下次轮换的时间 */
+static privacy_slot_t s_slot_set[PRIVACY_SLOT_NUM] = {0};
+static xf_ble_privacy_stats_t s_stats = {0};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_ble_privacy_init(const xf_ble_sm_irk_t *local_irk, uint16_t timeout_s)
+{
+    XF_CHECK(local_irk == NULL, XF_ERR_INVALID_ARG, TAG, "local_irk == NULL");
+    XF_CHECK(timeout_s == 0, XF_ERR_INVALID_ARG, TAG, "timeout_s == 0");
+
+    s_is_inited = false;
+    xf_memset(s_slot_set, 0, sizeof(s_slot_set));
+    xf_ble_aes_set_key(&s_ctx, local_irk->irk);
+    s_timeout_s = timeout_s;
+
+    privacy_slot_t *slot = &s_slot_set[0];
+    slot->adv_id = XF_BLE_ADV_ID_INVALID;
+    xf_err_t ret = privacy_gen(&slot->addr_set[0]);
+    if (ret == XF_OK) {
+        ret = privacy_apply(slot, &slot->addr_set[0]);
+    }
+    XF_CHECK(ret != XF_OK, ret, TAG, "set local rpa failed: %d", ret);
+    slot->is_used = true;
+
+    s_rotate_us = xf_sys_time_get_us() + (uint64_t)s_timeout_s * 1000000;
+    s_is_inited = true;
+    return XF_OK;
+}
+
+xf_err_t xf_ble_privacy_set_timeout(uint16_t timeout_s)
+{
+    XF_CHECK(timeout_s == 0, XF_ERR_INVALID_ARG, TAG, "timeout_s == 0");
+    s_timeout_s = timeout_s;
+    return XF_OK;
+}
+
+xf_err_t xf_ble_privacy_add_adv(xf_ble_adv_id_t adv_id)
+{
+    XF_CHECK(adv_id == XF_BLE_ADV_ID_INVALID, XF_ERR_INVALID_ARG, TAG, "invalid adv_id");
+    XF_CHECK(!s_is_inited, XF_ERR_INVALID_STATE, TAG, "not inited");
+
+    if (privacy_slot_find(adv_id) != NULL) {
+        return XF_OK;
+    }
+    privacy_slot_t *slot = NULL;
+    for (uint8_t i = 1; (i < PRIVACY_SLOT_NUM) && (slot == NULL); i++) {
+        slot = s_slot_set[i].is_used ? NULL : &s_slot_set[i];
+    }
+    XF_CHECK(slot == NULL, XF_ERR_NO_MEM, TAG, "adv num exceeds max: %d", XF_BLE_PRIVACY_ADV_NUM);
+
+    xf_memset(slot, 0, sizeof(privacy_slot_t));
+    slot->adv_id = adv_id;
+    xf_err_t ret = privacy_gen(&slot->addr_set[0]);
+    if (ret == XF_OK) {
+        ret = privacy_apply(slot, &slot->addr_set[0]);
+    }
+    XF_CHECK(ret != XF_OK, ret, TAG, "adv(%d) set rpa failed: %d", adv_id, ret);
+    slot->is_used = true;
+    return XF_OK;
+}
+
+xf_err_t xf_ble_privacy_del_adv(xf_ble_adv_id_t adv_id)
+{
+    privacy_slot_t *slot = (adv_id != XF_BLE_ADV_ID_INVALID) ? privacy_slot_find(adv_id) : NULL;
+    if (slot == NULL) {
+        return XF_ERR_NOT_FOUND;
+    }
+    xf_memset(slot, 0, sizeof(privacy_slot_t));
+    return XF_OK;
+}
+
+xf_err_t xf_ble_privacy_get_addr(xf_ble_adv_id_t adv_id, xf_ble_addr_t *addr)
+{
+    XF_CHECK(addr == NULL, XF_ERR_INVALID_ARG, TAG, "addr == NULL");
+
+    privacy_slot_t *slot = privacy_slot_find(adv_id);
+    if (slot == NULL) {
+        return XF_ERR_NOT_FOUND;
+    }
+    *addr = slot->addr_set[slot->cur];
+    return XF_OK;
+}
+
+xf_err_t xf_ble_privacy_rotate(void)
+{
+    XF_CHECK(!s_is_inited, XF_ERR_INVALID_STATE, TAG, "not inited");
+
+    xf_err_t first_ret = XF_OK;
+    for (uint8_t i = 0; i < PRIVACY_SLOT_NUM; i++) {
+        if (!s_slot_set[i].is_used) {
+            continue;
+        }
+        xf_err_t ret = privacy_slot_rotate(&s_slot_set[i]);
+        if ((ret != XF_OK) && (first_ret == XF_OK)) {
+            first_ret = ret;
+        }
+    }
+    s_rotate_us = xf_sys_time_get_us() + (uint64_t)s_timeout_s * 1000000;
+    return first_ret;
+}
+
+xf_err_t xf_ble_privacy_get_stats(xf_ble_privacy_stats_t *stats)
+{
+    XF_CHECK(stats == NULL, XF_ERR_INVALID_ARG, TAG, "stats == NULL");
+    *stats = s_stats;
+    return XF_OK;
+}
+
+void xf_ble_privacy_process(void)
+{
+    if (!s_is_inited) {
+        return;
+    }
+    if (xf_sys_time_get_us() >= s_rotate_us) {
+        xf_ble_privacy_rotate();
+        return;
+    }
+
+    bool is_gen = false;
+    for (uint8_t i = 0; i < PRIVACY_SLOT_NUM; i++) {
+        privacy_slot_t *slot = &s_slot_set[i];
+        if (!slot->is_used) {
+            continue;
+        }
+        if (slot->is_pending) {
+            /* 如平台在扫描或发起连接中拒绝修改设备地址，稍后重试 */
+            privacy_slot_rotate(slot);
+        } else if (!slot->is_next_ready && !is_gen) {
+            /* 提前生成下一个地址，每次最多一个，分散计算 */
+            is_gen = true;
+            slot->is_next_ready = (privacy_gen(&slot->addr_set[slot->cur ^ 1]) == XF_OK);
+        }
+    }
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static privacy_slot_t *privacy_slot_find(xf_ble_adv_id_t adv_id)
+{
+    for (uint8_t i = 0; i < PRIVACY_SLOT_NUM; i++) {
+        if (s_slot_set[i].is_used && (s_slot_set[i].adv_id == adv_id)) {
+            return &s_slot_set[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 切换到下一个地址 (未提前生成时当场生成) 并下发
+ */
+static xf_err_t privacy_slot_rotate(privacy_slot_t *slot)
+{
+    uint8_t next = slot->cur ^ 1;
+    if (!slot->is_next_ready) {
+        xf_err_t ret = privacy_gen(&slot->addr_set[next]);
+        if (ret != XF_OK) {
+            slot->is_pending = true;
+            s_stats.fail_cnt++;
+            return ret;
+        }
+        slot->is_next_ready = true;
+    }
+    xf_err_t ret = privacy_apply(slot, &slot->addr_set[next]);
+    if (ret != XF_OK) {
+        if (!slot->is_pending) {
+            XF_LOGW(TAG, "adv(%d) rotate rpa failed: %d, retry later", slot->adv_id, ret);
+        }
+        slot->is_pending = true;
+        s_stats.fail_cnt++;
+        return ret;
+    }
+    slot->cur = next;
+    slot->is_next_ready = false;
+    slot->is_pending = false;
+    s_stats.rotate_cnt++;
+    return XF_OK;
+}
+
+static xf_err_t privacy_apply(const privacy_slot_t *slot, const xf_ble_addr_t *addr)
+{
+    xf_err_t ret = XF_OK;
+    if (slot->adv_id == XF_BLE_ADV_ID_INVALID) {
+        xf_ble_addr_t local_addr = *addr;
+        XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_SET_LOCAL_ADDR, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                              xf_ble_gap_set_local_addr(&local_addr));
+    } else {
+        XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_SET_ADV_ADDR, XF_BLE_TRACE_CONN_ID_NONE, slot->adv_id,
+                              xf_ble_gap_set_adv_addr(slot->adv_id, addr));
+    }
+    return ret;
+}
+
+/**
+ * @brief 生成 RPA: prand (最高两位 0b01 ，其余 22 位随机且不全为 0 或 1) || ah(IRK, prand)
+ */
+static xf_err_t privacy_gen(xf_ble_addr_t *addr)
+{
+    uint32_t prand = 0;
+    for (uint8_t i = 0; i < PRIVACY_RAND_RETRY; i++) {
+        uint8_t rand[3];
+        xf_err_t ret = XF_OK;
+        XF_BLE_TRACE_API_CALL(ret, XF_BLE_TRACE_API_GAP_GET_RAND, XF_BLE_TRACE_CONN_ID_NONE, 0,
+                              xf_ble_gap_get_rand(rand, sizeof(rand)));
+        if (ret != XF_OK) {
+            return ret;
+        }
+        prand = (((uint32_t)rand[0] << 16) | ((uint32_t)rand[1] << 8) | rand[2]) & 0x3FFFFF;
+        if ((prand != 0) && (prand != 0x3FFFFF)) {
+            break;
+        }
+        prand = 0;
+    }
+    if (prand == 0) {
+        return XF_FAIL;
+    }
+    prand |= 0x400000;
+    uint32_t hash = xf_ble_aes_ah(&s_ctx, prand);
+
+    addr->type = XF_BLE_ADDR_TYPE_RPA_RANDOM;
+    addr->addr[0] = (uint8_t)(prand >> 16);
+    addr->addr[1] = (uint8_t)(prand >> 8);
+    addr->addr[2] = (uint8_t)prand;
+    addr->addr[3] = (uint8_t)(hash >> 16);
+    addr->addr[4] = (uint8_t)(hash >> 8);
+    addr->addr[5] = (uint8_t)hash;
+    s_stats.gen_cnt++;
+    return XF_OK;
+}
+
+#endif /* XF_BLE_IS_ENABLE */
@@ -0,0 +1,158 @@
+/**
+ * @file xf_ble_privacy.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 本端隐私: 可解析私有地址 (RPA) 的生成与定时轮换。
+ *  由本端 IRK 生成 RPA ，设备地址 (扫描、发起连接使用) 及每个广播各使用独立的 RPA 。
+ *  下一个 RPA 在 xf_ble_privacy_process() 中分散地提前生成 (每次最多一个)，
+ *  到期轮换时只需切换到已生成的地址并下发，广播通过 xf_ble_gap_set_adv_addr() 在开启中直接换址，
+ *  不停止广播，也不在轮换时集中计算。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_PRIVACY_H__
+#define __XF_BLE_PRIVACY_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_sm_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief BLE 本端隐私: 推荐的 RPA 轮换周期 (秒)
+ *
+ * @see 蓝牙核心文档 《Core_v5.4》>> Vol 3, Part C >> Appendix A >> TGAP(private_addr_int)
+ */
+#define XF_BLE_PRIVACY_TIMEOUT_DEFAULT  (900)
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE 本端隐私的统计
+ */
+typedef struct {
+    uint32_t rotate_cnt;                    /*!< 已下发的地址轮换次数 (设备地址及各广播分别计数) */
+    uint32_t gen_cnt;                       /*!< 已生成的 RPA 数量 */
+    uint32_t fail_cnt;                      /*!< 下发失败的次数 (下次 xf_ble_privacy_process() 重试) */
+} xf_ble_privacy_stats_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE 本端隐私: 初始化，生成并设置设备地址的 RPA (xf_ble_gap_set_local_addr())
+ *
+ * @param local_irk 本端 IRK ，见 @ref xf_ble_sm_irk_t (配对时分发给对端的同一个 IRK)
+ * @param timeout_s 轮换周期 (秒)，通常为 XF_BLE_PRIVACY_TIMEOUT_DEFAULT
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - (OTHER)               获取随机数或设置地址失败
+ *
+ * @note 本模块的接口均需在同一任务中调用
+ */
+xf_err_t xf_ble_privacy_init(const xf_ble_sm_irk_t *local_irk, uint16_t timeout_s);
+
+/**
+ * @brief BLE 本端隐私: 设置轮换周期 (自下次轮换起生效)
+ *
+ * @param timeout_s 轮换周期 (秒)
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_ble_privacy_set_timeout(uint16_t timeout_s);
+
+/**
+ * @brief BLE 本端隐私: 为广播启用 RPA (生成并通过 xf_ble_gap_set_adv_addr() 设置)
+ *
+ * @param adv_id 广播 ID (创建广播后、开启广播前调用)
+ * @return xf_err_t
+ *      - XF_OK                 成功 (已启用时直接返回)
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_INVALID_STATE  未初始化
+ *      - XF_ERR_NO_MEM         超过 XF_BLE_PRIVACY_ADV_NUM
+ *      - (OTHER)               获取随机数或设置地址失败
+ */
+xf_err_t xf_ble_privacy_add_adv(xf_ble_adv_id_t adv_id);
+
+/**
+ * @brief BLE 本端隐私: 停止管理广播的 RPA (删除广播时调用)
+ *
+ * @param adv_id 广播 ID
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_FOUND      不存在
+ */
+xf_err_t xf_ble_privacy_del_adv(xf_ble_adv_id_t adv_id);
+
+/**
+ * @brief BLE 本端隐私: 获取当前使用的 RPA
+ *
+ * @param adv_id 广播 ID ， XF_BLE_ADV_ID_INVALID 表示设备地址
+ * @param[out] addr 当前 RPA
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      未初始化或广播未启用 RPA
+ */
+xf_err_t xf_ble_privacy_get_addr(xf_ble_adv_id_t adv_id, xf_ble_addr_t *addr);
+
+/**
+ * @brief BLE 本端隐私: 立即轮换所有地址 (如每次连接断开后)，并重新计时
+ *
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_STATE  未初始化
+ *      - (OTHER)               第一个失败的错误码 (失败的地址下次 xf_ble_privacy_process() 重试)
+ */
+xf_err_t xf_ble_privacy_rotate(void);
+
+/**
+ * @brief BLE 本端隐私: 获取统计
+ *
+ * @param[out] stats 统计，见 @ref xf_ble_privacy_stats_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_ble_privacy_get_stats(xf_ble_privacy_stats_t *stats);
+
+/**
+ * @brief BLE 本端隐私: 周期处理 (到期轮换、重试下发失败的地址、提前生成下一个 RPA)
+ *
+ * @note 需周期调用 (如每秒)；每次最多生成一个 RPA (一次 AES)
+ */
+void xf_ble_privacy_process(void);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_PRIVACY_H__ */
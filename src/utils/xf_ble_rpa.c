@@ -0,0 +1,321 @@
+/**
+ * @file xf_ble_rpa.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 可解析私有地址 (RPA) 解析。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_sys.h"
+#include "xf_ble_utils.h"
+#include "xf_ble_aes.h"
+#include "xf_ble_rpa.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_rpa"
+
+#define RPA_IRK_IDX_NONE        (0xFF)      /*!< 缓存条目: 无法解析 */
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct {
+    xf_ble_addr_t id_addr;
+    xf_ble_aes_ctx_t ctx;                   /*!< 以 IRK 为密钥展开的轮密钥 */
+} rpa_irk_t;
+
+typedef struct {
+    uint8_t rpa[XF_BLE_ADDR_LEN];
+    uint8_t irk_idx;                        /*!< s_irk_set 的下标， RPA_IRK_IDX_NONE 表示无法解析 */
+    bool is_valid;
+    uint32_t last_use;                      /*!< LRU 计时 */
+} rpa_cache_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static int rpa_irk_find(const xf_ble_addr_t *id_addr);
+static uint8_t rpa_irk_match(uint32_t prand, uint32_t hash);
+static rpa_cache_t *rpa_cache_find(const uint8_t rpa[XF_BLE_ADDR_LEN]);
+static void rpa_cache_put(const uint8_t rpa[XF_BLE_ADDR_LEN], uint8_t irk_idx);
+static void rpa_cache_flush(bool is_neg_only);
+
+/* ==================== [Static Variables] ================================== */
+
+static rpa_irk_t s_irk_set[XF_BLE_RPA_IRK_NUM] = {0};
+static uint8_t s_irk_num = 0;
+/* 尝试顺序 (s_irk_set 的下标)，最近解析成功的在前 */
+static uint8_t s_irk_order[XF_BLE_RPA_IRK_NUM] = {0};
+
+static rpa_cache_t s_cache_set[XF_BLE_RPA_CACHE_NUM] = {0};
+static uint32_t s_cache_tick = 0;
+
+static xf_ble_rpa_stats_t s_stats = {0};
+
+/* ==================== [Macros] ============================================ */
+
+#define RPA_PRAND(addr)     (((uint32_t)(addr)[0] << 16) | ((uint32_t)(addr)[1] << 8) | (addr)[2])
+#define RPA_HASH(addr)      (((uint32_t)(addr)[3] << 16) | ((uint32_t)(addr)[4] << 8) | (addr)[5])
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_ble_rpa_add_irk(const xf_ble_addr_t *id_addr, const xf_ble_sm_irk_t *irk)
+{
+    XF_CHECK((id_addr == NULL) || (irk == NULL), XF_ERR_INVALID_ARG,
+             TAG, "id_addr or irk == NULL");
+
+    int idx = rpa_irk_find(id_addr);
+    if (idx >= 0) {
+        xf_ble_aes_set_key(&s_irk_set[idx].ctx, irk->irk);
+        /* IRK 已变化，原缓存的结果不再可信 */
+        rpa_cache_flush(false);
+        return XF_OK;
+    }
+    XF_CHECK(s_irk_num >= XF_BLE_RPA_IRK_NUM, XF_ERR_NO_MEM,
+             TAG, "irk num exceeds max: %d", XF_BLE_RPA_IRK_NUM);
+
+    idx = s_irk_num;
+    s_irk_set[idx].id_addr = *id_addr;
+    xf_ble_aes_set_key(&s_irk_set[idx].ctx, irk->irk);
+    /* 新 IRK 排在最后；此前无法解析的 RPA 可能由它解析 */
+    s_irk_order[s_irk_num++] = (uint8_t)idx;
+    rpa_cache_flush(true);
+    return XF_OK;
+}
+
+xf_err_t xf_ble_rpa_del_irk(const xf_ble_addr_t *id_addr)
+{
+    XF_CHECK(id_addr == NULL, XF_ERR_INVALID_ARG, TAG, "id_addr == NULL");
+
+    int idx = rpa_irk_find(id_addr);
+    if (idx < 0) {
+        return XF_ERR_NOT_FOUND;
+    }
+    /* 以最后一个填补空位，并同步尝试顺序 */
+    uint8_t last = s_irk_num - 1;
+    s_irk_set[idx] = s_irk_set[last];
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < s_irk_num; i++) {
+        if (s_irk_order[i] == idx) {
+            continue;
+        }
+        s_irk_order[n++] = (s_irk_order[i] == last) ? (uint8_t)idx : s_irk_order[i];
+    }
+    s_irk_num = last;
+    xf_memset(&s_irk_set[last], 0, sizeof(rpa_irk_t));
+    rpa_cache_flush(false);
+    return XF_OK;
+}
+
+void xf_ble_rpa_clear_irk(void)
+{
+    xf_memset(s_irk_set, 0, sizeof(s_irk_set));
+    s_irk_num = 0;
+    rpa_cache_flush(false);
+}
+
+bool xf_ble_rpa_is_rpa(const xf_ble_addr_t *addr)
+{
+    return xf_ble_addr_is_rpa(addr);
+}
+
+bool xf_ble_rpa_check(const xf_ble_sm_irk_t *irk, const xf_ble_addr_t *addr)
+{
+    if ((irk == NULL) || !xf_ble_rpa_is_rpa(addr)) {
+        return false;
+    }
+    xf_ble_aes_ctx_t ctx;
+    xf_ble_aes_set_key(&ctx, irk->irk);
+    bool is_match = (xf_ble_aes_ah(&ctx, RPA_PRAND(addr->addr)) == RPA_HASH(addr->addr));
+    xf_memset(&ctx, 0, sizeof(ctx));
+    return is_match;
+}
+
+xf_err_t xf_ble_rpa_resolve(const xf_ble_addr_t *addr, xf_ble_addr_t *id_addr)
+{
+    XF_CHECK((addr == NULL) || (id_addr == NULL), XF_ERR_INVALID_ARG,
+             TAG, "addr or id_addr == NULL");
+
+    if (!xf_ble_rpa_is_rpa(addr)) {
+        *id_addr = *addr;
+        return XF_OK;
+    }
+    s_stats.resolve_cnt++;
+
+    uint8_t irk_idx = RPA_IRK_IDX_NONE;
+    rpa_cache_t *cache = rpa_cache_find(addr->addr);
+    if (cache != NULL) {
+        s_stats.cache_hit_cnt++;
+        cache->last_use = ++s_cache_tick;
+        irk_idx = cache->irk_idx;
+    } else {
+        uint8_t i = rpa_irk_match(RPA_PRAND(addr->addr), RPA_HASH(addr->addr));
+        if (i < s_irk_num) {
+            irk_idx = s_irk_order[i];
+            /* 移到最前，活跃设备下次更快解析 */
+            for (; i > 0; i--) {
+                s_irk_order[i] = s_irk_order[i - 1];
+            }
+            s_irk_order[0] = irk_idx;
+        }
+        rpa_cache_put(addr->addr, irk_idx);
+    }
+
+    if (irk_idx == RPA_IRK_IDX_NONE) {
+        return XF_ERR_NOT_FOUND;
+    }
+    s_stats.resolved_cnt++;
+    *id_addr = s_irk_set[irk_idx].id_addr;
+    return XF_OK;
+}
+
+xf_err_t xf_ble_rpa_get_stats(xf_ble_rpa_stats_t *stats)
+{
+    XF_CHECK(stats == NULL, XF_ERR_INVALID_ARG, TAG, "stats == NULL");
+    *stats = s_stats;
+    return XF_OK;
+}
+
+#if XF_BLE_RPA_BENCH_ENABLE
+
+xf_err_t xf_ble_rpa_bench(uint8_t irk_num, uint32_t rpa_num, xf_ble_rpa_bench_result_t *result)
+{
+    XF_CHECK(result == NULL, XF_ERR_INVALID_ARG, TAG, "result == NULL");
+    XF_CHECK((irk_num == 0) || (rpa_num == 0), XF_ERR_INVALID_ARG, TAG, "irk_num or rpa_num == 0");
+    XF_CHECK(irk_num > XF_BLE_RPA_IRK_NUM, XF_ERR_NO_MEM,
+             TAG, "irk num exceeds max: %d", XF_BLE_RPA_IRK_NUM);
+
+    xf_ble_rpa_clear_irk();
+    xf_ble_sm_irk_t irk;
+    xf_ble_addr_t addr = {{0}, XF_BLE_ADDR_TYPE_PUBLIC_DEV};
+    for (uint8_t i = 0; i < irk_num; i++) {
+        for (uint8_t k = 0; k < sizeof(irk.irk); k++) {
+            irk.irk[k] = (uint8_t)((i + 1) * 0x9D + k * 0x3B);
+        }
+        addr.addr[0] = i;
+        xf_ble_rpa_add_irk(&addr, &irk);
+    }
+
+    xf_ble_rpa_stats_t stats = s_stats;
+    xf_ble_addr_t id_addr;
+    addr.type = XF_BLE_ADDR_TYPE_RANDOM_DEV;
+    uint64_t start_us = xf_sys_time_get_us();
+    for (uint32_t i = 0; i < rpa_num; i++) {
+        /* prand 各不相同 (最高两位 0b01)，均不命中缓存 */
+        uint32_t prand = 0x400000 | (i & 0x3FFFFF);
+        addr.addr[0] = (uint8_t)(prand >> 16);
+        addr.addr[1] = (uint8_t)(prand >> 8);
+        addr.addr[2] = (uint8_t)prand;
+        addr.addr[3] = (uint8_t)(i >> 22);
+        addr.addr[4] = 0x5A;
+        addr.addr[5] = 0xA5;
+        xf_ble_rpa_resolve(&addr, &id_addr);
+    }
+    uint64_t total_us = xf_sys_time_get_us() - start_us;
+
+    result->total_us = (uint32_t)total_us;
+    result->ah_cnt = s_stats.ah_cnt - stats.ah_cnt;
+    result->per_rpa_ns = (uint32_t)(total_us * 1000 / rpa_num);
+    result->per_ah_ns = (result->ah_cnt == 0) ? 0 : (uint32_t)(total_us * 1000 / result->ah_cnt);
+    s_stats = stats;
+    xf_ble_rpa_clear_irk();
+    XF_LOGI(TAG, "bench: %d irk, %u rpa: %u us, %u ns/ah", irk_num, (unsigned)rpa_num,
+            (unsigned)result->total_us, (unsigned)result->per_ah_ns);
+    return XF_OK;
+}
+
+#endif /* XF_BLE_RPA_BENCH_ENABLE */
+
+/* ==================== [Static Functions] ================================== */
+
+static int rpa_irk_find(const xf_ble_addr_t *id_addr)
+{
+    for (uint8_t i = 0; i < s_irk_num; i++) {
+        if (xf_ble_addr_is_equal(&s_irk_set[i].id_addr, id_addr)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 按尝试顺序每次对 XF_BLE_AES_BATCH_NUM 个 IRK 批量计算 ah ，
+ *  返回第一个匹配的 IRK 在 s_irk_order 中的位置，无匹配时返回 s_irk_num
+ */
+static uint8_t rpa_irk_match(uint32_t prand, uint32_t hash)
+{
+    const xf_ble_aes_ctx_t *ctx_list[XF_BLE_AES_BATCH_NUM];
+    uint32_t hash_list[XF_BLE_AES_BATCH_NUM];
+    uint8_t n;
+    for (uint8_t i = 0; i < s_irk_num; i += n) {
+        n = ((s_irk_num - i) < XF_BLE_AES_BATCH_NUM) ? (uint8_t)(s_irk_num - i) : XF_BLE_AES_BATCH_NUM;
+        for (uint8_t k = 0; k < n; k++) {
+            ctx_list[k] = &s_irk_set[s_irk_order[i + k]].ctx;
+        }
+        xf_ble_aes_ah_batch(ctx_list, n, prand, hash_list);
+        s_stats.ah_cnt += n;
+        for (uint8_t k = 0; k < n; k++) {
+            if (hash_list[k] == hash) {
+                return i + k;
+            }
+        }
+    }
+    return s_irk_num;
+}
+
+static rpa_cache_t *rpa_cache_find(const uint8_t rpa[XF_BLE_ADDR_LEN])
+{
+    for (uint8_t i = 0; i < XF_BLE_RPA_CACHE_NUM; i++) {
+        rpa_cache_t *cache = &s_cache_set[i];
+        if (!cache->is_valid) {
+            continue;
+        }
+        uint8_t j = 0;
+        while ((j < XF_BLE_ADDR_LEN) && (cache->rpa[j] == rpa[j])) {
+            j++;
+        }
+        if (j == XF_BLE_ADDR_LEN) {
+            return cache;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 记录解析结果，替换空闲或最久未使用的条目
+ */
+static void rpa_cache_put(const uint8_t rpa[XF_BLE_ADDR_LEN], uint8_t irk_idx)
+{
+    rpa_cache_t *victim = &s_cache_set[0];
+    for (uint8_t i = 0; i < XF_BLE_RPA_CACHE_NUM; i++) {
+        rpa_cache_t *cache = &s_cache_set[i];
+        if (!cache->is_valid) {
+            victim = cache;
+            break;
+        }
+        /* 计时回绕时按差值比较 */
+        if ((int32_t)(cache->last_use - victim->last_use) < 0) {
+            victim = cache;
+        }
+    }
+    xf_memcpy(victim->rpa, rpa, XF_BLE_ADDR_LEN);
+    victim->irk_idx = irk_idx;
+    victim->is_valid = true;
+    victim->last_use = ++s_cache_tick;
+}
+
+static void rpa_cache_flush(bool is_neg_only)
+{
+    for (uint8_t i = 0; i < XF_BLE_RPA_CACHE_NUM; i++) {
+        if (!is_neg_only || (s_cache_set[i].irk_idx == RPA_IRK_IDX_NONE)) {
+            s_cache_set[i].is_valid = false;
+        }
+    }
+}
+
+#endif /* XF_BLE_IS_ENABLE */
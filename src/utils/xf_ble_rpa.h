@@ -0,0 +1,171 @@
+/**
+ * @file xf_ble_rpa.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 可解析私有地址 (RPA) 解析。
+ *  由 RPA 得到已绑定设备的身份地址需对每个 IRK 计算一次 ah (AES-128)，
+ *  本模块为每个 IRK 预先展开轮密钥，按最近解析成功的顺序尝试 (每次以位切片 AES 对多个 IRK 批量计算，见 xf_ble_aes.h)，
+ *  并以小容量 LRU 缓存记录 RPA 的解析结果 (含无法解析的结果)，
+ *  重复出现的 RPA (同一设备的多次广播) 无需再次计算。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_RPA_H__
+#define __XF_BLE_RPA_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_sm_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE RPA 解析的统计
+ */
+typedef struct {
+    uint32_t resolve_cnt;                   /*!< 解析 RPA 的次数 */
+    uint32_t cache_hit_cnt;                 /*!< 其中命中缓存的次数 */
+    uint32_t resolved_cnt;                  /*!< 其中解析成功的次数 */
+    uint32_t ah_cnt;                        /*!< 计算 ah 的次数 */
+} xf_ble_rpa_stats_t;
+
+#if XF_BLE_RPA_BENCH_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @brief BLE RPA 解析的性能测试结果
+ */
+typedef struct {
+    uint32_t total_us;                      /*!< 解析所有 RPA 的总耗时 (微秒) */
+    uint32_t per_rpa_ns;                    /*!< 每个 RPA 的平均耗时 (纳秒) */
+    uint32_t per_ah_ns;                     /*!< 每次 ah 的平均耗时 (纳秒) */
+    uint32_t ah_cnt;                        /*!< 计算 ah 的次数 */
+} xf_ble_rpa_bench_result_t;
+
+#endif /* XF_BLE_RPA_BENCH_ENABLE */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE RPA: 添加对端 IRK (同一身份地址已存在时替换)
+ *
+ * @param id_addr 对端身份地址
+ * @param irk 对端 IRK ，见 @ref xf_ble_sm_irk_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NO_MEM         超过 XF_BLE_RPA_IRK_NUM
+ *
+ * @note 本模块的接口均需在同一任务中调用 (如 GAP 事件回调所在任务)
+ */
+xf_err_t xf_ble_rpa_add_irk(const xf_ble_addr_t *id_addr, const xf_ble_sm_irk_t *irk);
+
+/**
+ * @brief BLE RPA: 删除对端 IRK
+ *
+ * @param id_addr 对端身份地址
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      不存在
+ */
+xf_err_t xf_ble_rpa_del_irk(const xf_ble_addr_t *id_addr);
+
+/**
+ * @brief BLE RPA: 删除所有对端 IRK
+ */
+void xf_ble_rpa_clear_irk(void);
+
+/**
+ * @brief BLE RPA: 是否为可解析私有地址 (随机地址且最高两位为 0b01)
+ *
+ * @param addr 地址
+ * @return bool 是否为可解析私有地址
+ */
+bool xf_ble_rpa_is_rpa(const xf_ble_addr_t *addr);
+
+/**
+ * @brief BLE RPA: 检查 RPA 是否由指定 IRK 生成 (不使用缓存)
+ *
+ * @param irk IRK ，见 @ref xf_ble_sm_irk_t
+ * @param addr 地址
+ * @return bool 是否匹配 (非 RPA 时为 false)
+ */
+bool xf_ble_rpa_check(const xf_ble_sm_irk_t *irk, const xf_ble_addr_t *addr);
+
+/**
+ * @brief BLE RPA: 解析地址，得到身份地址
+ *
+ * @param addr 地址 (如扫描结果或连接事件中的对端地址)
+ * @param[out] id_addr 身份地址；非 RPA 时即 addr 本身
+ * @return xf_err_t
+ *      - XF_OK                 成功 (非 RPA 时同样成功)
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NOT_FOUND      RPA 无法由已添加的 IRK 解析
+ */
+xf_err_t xf_ble_rpa_resolve(const xf_ble_addr_t *addr, xf_ble_addr_t *id_addr);
+
+/**
+ * @brief BLE RPA: 获取统计
+ *
+ * @param[out] stats 统计，见 @ref xf_ble_rpa_stats_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ */
+xf_err_t xf_ble_rpa_get_stats(xf_ble_rpa_stats_t *stats);
+
+#if XF_BLE_RPA_BENCH_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @brief BLE RPA: 性能测试 (最坏情况)，添加 irk_num 个生成的 IRK 后解析 rpa_num 个各不相同且无法解析的 RPA ，
+ *  即每个 RPA 均未命中缓存并对所有 IRK 计算 ah
+ *
+ * @note 由 XF_BLE_RPA_BENCH_ENABLE 开启；阻塞执行，计时使用 xf_sys_time_get_us() 。
+ *  会清除已添加的 IRK (结束后需重新添加)，统计保持不变。
+ *  参考: x86-64 主机 (gcc -O2) 200 个 IRK 、 10000 个 RPA 约 1 s (每个 IRK 约 0.5 us/ah，每次批量 4 个)；
+ *  需将 XF_BLE_RPA_IRK_NUM 设为不小于 200
+ * @param irk_num IRK 数量 (1 ~ XF_BLE_RPA_IRK_NUM)
+ * @param rpa_num RPA 数量
+ * @param[out] result 结果，见 @ref xf_ble_rpa_bench_result_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NO_MEM         irk_num 超过 XF_BLE_RPA_IRK_NUM
+ */
+xf_err_t xf_ble_rpa_bench(uint8_t irk_num, uint32_t rpa_num, xf_ble_rpa_bench_result_t *result);
+
+#endif /* XF_BLE_RPA_BENCH_ENABLE */
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_RPA_H__ */
@@ -0,0 +1,294 @@
+/**
+ * @file xf_ble_tput.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 最大吞吐量协商。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_sys.h"
+#include "xf_ble_gap.h"
+#include "xf_ble_gatt_client.h"
+#include "xf_ble_trace.h"
+#include "xf_ble_conn_table.h"
+#include "xf_ble_tput.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_tput"
+
+#define TPUT_STEP_PHY       (1 << 0)
+#define TPUT_STEP_DATA_LEN  (1 << 1)
+#define TPUT_STEP_MTU       (1 << 2)
+#define TPUT_STEP_ALL       (TPUT_STEP_PHY | TPUT_STEP_DATA_LEN | TPUT_STEP_MTU)
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct {
+    bool is_used;
+    uint8_t pending;                        /*!< 尚未完成的步骤 (TPUT_STEP_*) */
+    uint64_t deadline_us;
+    xf_ble_tput_result_t result;
+    xf_ble_tput_done_cb_t done_cb;
+    void *user_data;
+} tput_conn_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void tput_step_finish(xf_ble_conn_id_t conn_id, uint8_t steps, xf_err_t ret);
+
+/* ==================== [Static Variables] ================================== */
+
+static tput_conn_t s_tput_conn_set[XF_BLE_TPUT_CONN_NUM] = {0};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_ble_tput_maximize(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id, const xf_ble_tput_cfg_t *cfg,
+    xf_ble_tput_done_cb_t done_cb, void *user_data)
+{
+    static const xf_ble_tput_cfg_t cfg_default = XF_BLE_TPUT_CFG_DEFAULT();
+    if (cfg == NULL) {
+        cfg = &cfg_default;
+    }
+    XF_CHECK(conn_id >= XF_BLE_TPUT_CONN_NUM, XF_ERR_INVALID_ARG,
+             TAG, "conn_id(%d) exceeds max: %d", conn_id, XF_BLE_TPUT_CONN_NUM);
+    XF_CHECK((cfg->tx_octets != 0)
+             && ((cfg->tx_octets < XF_BLE_GAP_DATA_LEN_TX_OCTETS_MIN)
+                 || (cfg->tx_octets > XF_BLE_GAP_DATA_LEN_TX_OCTETS_MAX)),
+             XF_ERR_INVALID_ARG, TAG, "invalid tx_octets: %d", cfg->tx_octets);
+
+    uint8_t steps = ((cfg->phys != 0) ? TPUT_STEP_PHY : 0)
+                    | ((cfg->tx_octets != 0) ? TPUT_STEP_DATA_LEN : 0)
+                    | ((cfg->mtu != 0) ? TPUT_STEP_MTU : 0);
+    XF_CHECK(steps == 0, XF_ERR_INVALID_ARG, TAG, "nothing to negotiate");
+
+    /* 数据长度未变化时控制器不上报事件，已满足时 (需使用连接状态表) 跳过该步骤 */
+    xf_ble_conn_info_t info = {0};
+    bool is_data_len_ok = (steps & TPUT_STEP_DATA_LEN)
+                          && (xf_ble_conn_table_get_info(conn_id, &info) == XF_OK)
+                          && (info.max_tx_octets >= cfg->tx_octets);
+    if (is_data_len_ok) {
+        steps &= ~TPUT_STEP_DATA_LEN;
+        if (steps == 0) {
+            XF_CHECK(s_tput_conn_set[conn_id].is_used, XF_ERR_BUSY,
+                     TAG, "conn(%d) already negotiating", conn_id);
+            xf_ble_tput_result_t result = {0};
+            result.max_tx_octets = info.max_tx_octets;
+            result.max_rx_octets = info.max_rx_octets;
+            if (done_cb != NULL) {
+                done_cb(conn_id, &result, user_data);
+            }
+            return XF_OK;
+        }
+    }
+
+    tput_conn_t *c = &s_tput_conn_set[conn_id];
+    bool is_busy = false;
+    XF_BLE_ENTER_CRITICAL();
+    is_busy = c->is_used;
+    if (!is_busy) {
+        /* 先登记所有步骤，部分平台会在请求接口内同步上报完成事件 */
+        xf_memset(c, 0, sizeof(tput_conn_t));
+        c->is_used = true;
+        c->pending = steps;
+        c->deadline_us = xf_sys_time_get_us() + (uint64_t)XF_BLE_TPUT_TIMEOUT_MS * 1000;
+        c->done_cb = done_cb;
+        c->user_data = user_data;
+        if (is_data_len_ok) {
+            c->result.max_tx_octets = info.max_tx_octets;
+            c->result.max_rx_octets = info.max_rx_octets;
+        }
+    }
+    XF_BLE_EXIT_CRITICAL();
+    XF_CHECK(is_busy, XF_ERR_BUSY, TAG, "conn(%d) already negotiating", conn_id);
+
+    /* 三个过程相互独立，依次发出而不等待完成，链路层过程由控制器自行排队 */
+    uint8_t failed = 0;
+    xf_err_t first_err = XF_OK;
+    xf_err_t ret_set[3] = {XF_OK, XF_OK, XF_OK};
+    if (steps & TPUT_STEP_PHY) {
+        XF_BLE_TRACE_API_CALL(ret_set[0], XF_BLE_TRACE_API_GAP_SET_PHY, conn_id, 0,
+                              xf_ble_gap_set_phy(conn_id, cfg->phys, cfg->phys, XF_BLE_GAP_PHY_CODED_OPT_NONE));
+    }
+    if (steps & TPUT_STEP_DATA_LEN) {
+        XF_BLE_TRACE_API_CALL(ret_set[1], XF_BLE_TRACE_API_GAP_SET_DATA_LEN, conn_id, 0,
+                              xf_ble_gap_set_data_len(conn_id, cfg->tx_octets, cfg->tx_time));
+    }
+    if (steps & TPUT_STEP_MTU) {
+        XF_BLE_TRACE_API_CALL(ret_set[2], XF_BLE_TRACE_API_GATTC_REQUEST_EXCHANGE_MTU, conn_id, 0,
+                              xf_ble_gattc_request_exchange_mtu(app_id, conn_id, cfg->mtu));
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        if (ret_set[i] != XF_OK) {
+            failed |= (1 << i);
+            first_err = (first_err == XF_OK) ? ret_set[i] : first_err;
+        }
+    }
+
+    if (failed == steps) {
+        XF_BLE_ENTER_CRITICAL();
+        c->is_used = false;
+        XF_BLE_EXIT_CRITICAL();
+        XF_LOGW(TAG, "conn(%d) all steps failed: %d", conn_id, first_err);
+        return first_err;
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        if (failed & (1 << i)) {
+            XF_LOGD(TAG, "conn(%d) step(%d) failed: %d", conn_id, i, ret_set[i]);
+            tput_step_finish(conn_id, (1 << i), ret_set[i]);
+        }
+    }
+    return XF_OK;
+}
+
+void xf_ble_tput_process(void)
+{
+    uint64_t now_us = xf_sys_time_get_us();
+    for (uint8_t i = 0; i < XF_BLE_TPUT_CONN_NUM; i++) {
+        tput_conn_t *c = &s_tput_conn_set[i];
+        XF_BLE_ENTER_CRITICAL();
+        bool is_timeout = c->is_used && (now_us >= c->deadline_us);
+        XF_BLE_EXIT_CRITICAL();
+        if (!is_timeout) {
+            continue;
+        }
+        /*
+         * 数据长度请求已被接受，但取值未变化时控制器不上报 XF_BLE_GAP_EVT_DATA_LEN_CHANGE ，
+         * 视为成功，取值以连接状态表为准 (未使用时为 0)
+         */
+        xf_ble_conn_info_t info = {0};
+        bool is_info = (xf_ble_conn_table_get_info(i, &info) == XF_OK);
+        XF_BLE_ENTER_CRITICAL();
+        if (is_info && (c->pending & TPUT_STEP_DATA_LEN)) {
+            c->result.max_tx_octets = info.max_tx_octets;
+            c->result.max_rx_octets = info.max_rx_octets;
+        }
+        XF_BLE_EXIT_CRITICAL();
+        tput_step_finish(i, TPUT_STEP_DATA_LEN, XF_OK);
+        XF_BLE_ENTER_CRITICAL();
+        uint8_t pending = c->is_used ? c->pending : 0;
+        XF_BLE_EXIT_CRITICAL();
+        if (pending != 0) {
+            XF_LOGW(TAG, "conn(%d) steps(0x%x) timeout", i, pending);
+            tput_step_finish(i, TPUT_STEP_ALL, XF_ERR_TIMEOUT);
+        }
+    }
+}
+
+xf_ble_evt_res_t xf_ble_tput_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param)
+{
+    if (param == NULL) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+
+    switch (event) {
+    case XF_BLE_GAP_EVT_PHY_UPDATE: {
+        xf_ble_conn_id_t conn_id = param->phy_upd.conn_id;
+        if (conn_id >= XF_BLE_TPUT_CONN_NUM) {
+            break;
+        }
+        XF_BLE_ENTER_CRITICAL();
+        if (s_tput_conn_set[conn_id].pending & TPUT_STEP_PHY) {
+            s_tput_conn_set[conn_id].result.tx_phy = param->phy_upd.tx_phy;
+            s_tput_conn_set[conn_id].result.rx_phy = param->phy_upd.rx_phy;
+        }
+        XF_BLE_EXIT_CRITICAL();
+        tput_step_finish(conn_id, TPUT_STEP_PHY, param->phy_upd.status);
+    } break;
+    case XF_BLE_GAP_EVT_DATA_LEN_CHANGE: {
+        xf_ble_conn_id_t conn_id = param->data_len.conn_id;
+        if (conn_id >= XF_BLE_TPUT_CONN_NUM) {
+            break;
+        }
+        XF_BLE_ENTER_CRITICAL();
+        if (s_tput_conn_set[conn_id].pending & TPUT_STEP_DATA_LEN) {
+            s_tput_conn_set[conn_id].result.max_tx_octets = param->data_len.max_tx_octets;
+            s_tput_conn_set[conn_id].result.max_rx_octets = param->data_len.max_rx_octets;
+        }
+        XF_BLE_EXIT_CRITICAL();
+        tput_step_finish(conn_id, TPUT_STEP_DATA_LEN, XF_OK);
+    } break;
+    case XF_BLE_GAP_EVT_DISCONNECT:
+        if (param->disconnect.conn_id < XF_BLE_TPUT_CONN_NUM) {
+            tput_step_finish(param->disconnect.conn_id, TPUT_STEP_ALL, XF_FAIL);
+        }
+        break;
+    default:
+        break;
+    }
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+xf_ble_evt_res_t xf_ble_tput_gattc_event_handler(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param)
+{
+    if ((event != XF_BLE_GATTC_EVT_EXCHANGE_MTU) || (param == NULL)
+            || (param->mtu.conn_id >= XF_BLE_TPUT_CONN_NUM)) {
+        return XF_BLE_EVT_RES_NOT_HANDLED;
+    }
+    xf_ble_conn_id_t conn_id = param->mtu.conn_id;
+    XF_BLE_ENTER_CRITICAL();
+    if (s_tput_conn_set[conn_id].pending & TPUT_STEP_MTU) {
+        s_tput_conn_set[conn_id].result.mtu = param->mtu.mtu;
+    }
+    XF_BLE_EXIT_CRITICAL();
+    tput_step_finish(conn_id, TPUT_STEP_MTU, XF_OK);
+    return XF_BLE_EVT_RES_NOT_HANDLED;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 结束指定的步骤 (仅处理尚未完成的步骤)，全部完成时回调结果
+ */
+static void tput_step_finish(xf_ble_conn_id_t conn_id, uint8_t steps, xf_err_t ret)
+{
+    tput_conn_t *c = &s_tput_conn_set[conn_id];
+    xf_ble_tput_result_t result;
+    xf_ble_tput_done_cb_t done_cb = NULL;
+    void *user_data = NULL;
+    bool is_done = false;
+
+    XF_BLE_ENTER_CRITICAL();
+    steps &= c->is_used ? c->pending : 0;
+    if (steps & TPUT_STEP_PHY) {
+        c->result.phy_ret = ret;
+    }
+    if (steps & TPUT_STEP_DATA_LEN) {
+        c->result.data_len_ret = ret;
+    }
+    if (steps & TPUT_STEP_MTU) {
+        c->result.mtu_ret = ret;
+    }
+    c->pending &= ~steps;
+    if ((steps != 0) && (c->pending == 0)) {
+        is_done = true;
+        result = c->result;
+        done_cb = c->done_cb;
+        user_data = c->user_data;
+        c->is_used = false;
+    }
+    XF_BLE_EXIT_CRITICAL();
+
+    if (is_done) {
+        XF_LOGD(TAG, "conn(%d) done: phy %d/%d, octets %d, mtu %d", conn_id,
+                result.tx_phy, result.rx_phy, result.max_tx_octets, result.mtu);
+        if (done_cb != NULL) {
+            done_cb(conn_id, &result, user_data);
+        }
+    }
+}
+
+#endif /* XF_BLE_IS_ENABLE */
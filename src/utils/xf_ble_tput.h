@@ -0,0 +1,163 @@
+/**
+ * @file xf_ble_tput.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 最大吞吐量协商。
+ *  一次性发起 2M PHY 、数据长度扩展 (DLE) 及最大 MTU 协商，三者相互独立，
+ *  不等待前一步完成即发出下一步 (流水线)，全部完成或超时后回调结果。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_TPUT_H__
+#define __XF_BLE_TPUT_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+#include "xf_ble_gap_types.h"
+#include "xf_ble_gatt_client_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief BLE 最大吞吐量协商的默认 MTU (247 = 251 字节链路层载荷 - 4 字节 L2CAP 头)
+ */
+#define XF_BLE_TPUT_MTU_DEFAULT         (247)
+
+/**
+ * @brief BLE 最大吞吐量协商的默认单包发送时间 (us)，即 1M PHY 发送 251 字节所需时间，
+ *  2M PHY 协商失败时仍可使用最大数据长度
+ */
+#define XF_BLE_TPUT_TX_TIME_DEFAULT     (2120)
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE 最大吞吐量协商的配置
+ */
+typedef struct {
+    xf_ble_gap_phy_mask_t phys;         /*!< 期望的收发 PHY，见 @ref xf_ble_gap_phy_mask_t ， 0 表示不协商 PHY */
+    uint16_t tx_octets;                 /*!< 单包最大有效载荷， 0 表示不协商数据长度 */
+    uint16_t tx_time;                   /*!< 单包最大发送时间 (us) */
+    uint16_t mtu;                       /*!< 期望的 MTU ， 0 表示不协商 MTU */
+} xf_ble_tput_cfg_t;
+
+/**
+ * @brief BLE 最大吞吐量协商的默认配置: 2M PHY 、 251 字节数据长度、 247 字节 MTU
+ */
+#define XF_BLE_TPUT_CFG_DEFAULT() \
+{ \
+    .phys = XF_BLE_GAP_PHY_MASK_2M, \
+    .tx_octets = XF_BLE_GAP_DATA_LEN_TX_OCTETS_MAX, \
+    .tx_time = XF_BLE_TPUT_TX_TIME_DEFAULT, \
+    .mtu = XF_BLE_TPUT_MTU_DEFAULT, \
+}
+
+/**
+ * @brief BLE 最大吞吐量协商的结果
+ *
+ * @note 各步骤独立，部分失败时其余步骤的结果仍有效
+ */
+typedef struct {
+    xf_err_t phy_ret;                   /*!< PHY 更新结果 (未协商时为 XF_OK) */
+    xf_err_t data_len_ret;              /*!< 数据长度协商结果 (未协商时为 XF_OK) */
+    xf_err_t mtu_ret;                   /*!< MTU 协商结果 (未协商时为 XF_OK) */
+    xf_ble_gap_phy_type_t tx_phy;       /*!< 协商后的发送 PHY (未知时为 XF_BLE_GAP_PHY_NO_PACKET) */
+    xf_ble_gap_phy_type_t rx_phy;       /*!< 协商后的接收 PHY (未知时为 XF_BLE_GAP_PHY_NO_PACKET) */
+    uint16_t max_tx_octets;             /*!< 协商后的单包发送最大有效载荷 (未知时为 0) */
+    uint16_t max_rx_octets;             /*!< 协商后的单包接收最大有效载荷 (未知时为 0) */
+    uint16_t mtu;                       /*!< 协商后的 MTU (未知时为 0) */
+} xf_ble_tput_result_t;
+
+/**
+ * @brief BLE 最大吞吐量协商完成回调
+ *
+ * @param conn_id 连接 ID
+ * @param result 结果，见 @ref xf_ble_tput_result_t
+ * @param user_data 用户数据
+ */
+typedef void (*xf_ble_tput_done_cb_t)(
+    xf_ble_conn_id_t conn_id, const xf_ble_tput_result_t *result, void *user_data);
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE 最大吞吐量协商
+ *
+ * @param app_id 客户端 ID (应用 ID)，用于 MTU 协商，见 @ref xf_ble_app_id_t
+ * @param conn_id 连接 ID
+ * @param cfg 配置，见 @ref xf_ble_tput_cfg_t ， NULL 表示使用 XF_BLE_TPUT_CFG_DEFAULT()
+ * @param done_cb 完成回调，见 @ref xf_ble_tput_done_cb_t ，可为 NULL
+ * @param user_data 用户数据
+ * @return xf_err_t
+ *      - XF_OK                 成功 (至少一步已发出，结果见回调)
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_BUSY           该连接正在协商
+ *      - (OTHER)               所有步骤均发起失败时，第一个失败步骤的错误码 (不回调)
+ *
+ * @note 依赖平台侧上报 XF_BLE_GAP_EVT_PHY_UPDATE 、 XF_BLE_GAP_EVT_DATA_LEN_CHANGE 及
+ *  XF_BLE_GATTC_EVT_EXCHANGE_MTU 事件，且需在事件回调中调用本模块的事件处理函数，
+ *  并周期性调用 xf_ble_tput_process() 处理超时。
+ *  使用连接状态表 (xf_ble_conn_table) 且当前数据长度已满足 tx_octets 时跳过数据长度步骤，
+ *  无其他步骤时在本函数内直接回调
+ */
+xf_err_t xf_ble_tput_maximize(
+    xf_ble_app_id_t app_id, xf_ble_conn_id_t conn_id, const xf_ble_tput_cfg_t *cfg,
+    xf_ble_tput_done_cb_t done_cb, void *user_data);
+
+/**
+ * @brief BLE 最大吞吐量协商超时处理
+ *
+ * @note 需周期性调用，超过 XF_BLE_TPUT_TIMEOUT_MS 未完成的步骤以 XF_ERR_TIMEOUT 结束；
+ *  数据长度请求已被接受但未收到事件时 (取值未变化时控制器不上报) 视为成功
+ */
+void xf_ble_tput_process(void);
+
+/**
+ * @brief BLE 最大吞吐量协商的 GAP 事件处理 (PHY 更新、数据长度变化、断连)
+ *
+ * @note 需在 GAP 事件回调中调用；仅观察事件，固定返回 XF_BLE_EVT_RES_NOT_HANDLED
+ */
+xf_ble_evt_res_t xf_ble_tput_gap_event_handler(
+    xf_ble_gap_evt_t event,
+    xf_ble_gap_evt_cb_param_t *param);
+
+/**
+ * @brief BLE 最大吞吐量协商的 GATTC 事件处理 (MTU 协商)
+ *
+ * @note 同 xf_ble_tput_gap_event_handler()
+ */
+xf_ble_evt_res_t xf_ble_tput_gattc_event_handler(
+    xf_ble_gattc_evt_t event,
+    xf_ble_gattc_evt_cb_param_t *param);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_TPUT_H__ */
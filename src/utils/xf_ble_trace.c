@@ -0,0 +1,208 @@
+/**
+ * @file xf_ble_trace.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 事件追踪。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_sys.h"
+#include "xf_ble_gap_types.h"
+#include "xf_ble_gatt_server_types.h"
+#include "xf_ble_gatt_client_types.h"
+#include "xf_ble_trace.h"
+
+#if XF_BLE_IS_ENABLE && XF_BLE_TRACE_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_trace"
+
+#if (XF_BLE_TRACE_DEPTH & (XF_BLE_TRACE_DEPTH - 1)) != 0
+#error "XF_BLE_TRACE_DEPTH must be a power of 2"
+#endif
+
+#define TRACE_MASK          (XF_BLE_TRACE_DEPTH - 1)
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t record_size;
+    uint16_t reserved;
+} trace_header_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void trace_evt_locate(xf_ble_trace_module_t module, uint8_t event, const void *param,
+                             xf_ble_conn_id_t *conn_id, xf_ble_attr_handle_t *handle);
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_ble_trace_record_t s_trace_ring[XF_BLE_TRACE_DEPTH];
+static uint32_t s_trace_head = 0;           /*!< 已写入的记录总数 (自由增长) */
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void xf_ble_trace_record(
+    xf_ble_trace_kind_t kind, xf_ble_trace_module_t module, uint16_t id,
+    xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle, int32_t value)
+{
+    /* 原子地占用一个槽位，多个上下文可同时写入 */
+    uint32_t index = __atomic_fetch_add(&s_trace_head, 1, __ATOMIC_RELAXED);
+    xf_ble_trace_record_t *r = &s_trace_ring[index & TRACE_MASK];
+    r->timestamp = XF_BLE_TRACE_TIMESTAMP();
+    r->kind = kind;
+    r->module = module;
+    r->id = id;
+    r->conn_id = conn_id;
+    r->reserved = 0;
+    r->handle = handle;
+    r->value = value;
+}
+
+void xf_ble_trace_evt(
+    xf_ble_trace_kind_t kind, xf_ble_trace_module_t module, uint8_t event,
+    const void *param, int32_t value)
+{
+    xf_ble_conn_id_t conn_id = XF_BLE_TRACE_CONN_ID_NONE;
+    xf_ble_attr_handle_t handle = 0;
+    if (param != NULL) {
+        trace_evt_locate(module, event, param, &conn_id, &handle);
+    }
+    xf_ble_trace_record(kind, module, event, conn_id, handle, value);
+}
+
+uint16_t xf_ble_trace_read(xf_ble_trace_record_t *buf, uint16_t max_cnt)
+{
+    XF_ASSERT(buf != NULL, 0, TAG, "buf == NULL");
+
+    uint32_t head = __atomic_load_n(&s_trace_head, __ATOMIC_ACQUIRE);
+    uint32_t cnt = (head < XF_BLE_TRACE_DEPTH) ? head : XF_BLE_TRACE_DEPTH;
+    if (cnt > max_cnt) {
+        cnt = max_cnt;
+    }
+    for (uint32_t i = 0; i < cnt; i++) {
+        buf[i] = s_trace_ring[(head - cnt + i) & TRACE_MASK];
+    }
+    return (uint16_t)cnt;
+}
+
+void xf_ble_trace_dump(xf_ble_trace_out_cb_t out_cb, void *user_data)
+{
+    if (out_cb == NULL) {
+        return;
+    }
+
+    trace_header_t header = {
+        .magic = XF_BLE_TRACE_MAGIC,
+        .version = XF_BLE_TRACE_VERSION,
+        .record_size = sizeof(xf_ble_trace_record_t),
+    };
+    out_cb(&header, sizeof(header), user_data);
+
+    uint32_t head = __atomic_load_n(&s_trace_head, __ATOMIC_ACQUIRE);
+    uint32_t cnt = (head < XF_BLE_TRACE_DEPTH) ? head : XF_BLE_TRACE_DEPTH;
+    for (uint32_t i = 0; i < cnt; i++) {
+        xf_ble_trace_record_t r = s_trace_ring[(head - cnt + i) & TRACE_MASK];
+        out_cb(&r, sizeof(r), user_data);
+    }
+}
+
+void xf_ble_trace_clear(void)
+{
+    __atomic_store_n(&s_trace_head, 0, __ATOMIC_RELEASE);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+/**
+ * @brief 从事件参数中取出连接 ID 及句柄
+ */
+static void trace_evt_locate(xf_ble_trace_module_t module, uint8_t event, const void *param,
+                             xf_ble_conn_id_t *conn_id, xf_ble_attr_handle_t *handle)
+{
+    if (module == XF_BLE_TRACE_MODULE_GAP) {
+        const xf_ble_gap_evt_cb_param_t *gap = param;
+        switch (event) {
+        case XF_BLE_GAP_EVT_CONNECT_REQ:
+            *conn_id = gap->conn_req.conn_id;
+            break;
+        case XF_BLE_GAP_EVT_CONNECT:
+            *conn_id = gap->connect.conn_id;
+            break;
+        case XF_BLE_GAP_EVT_DISCONNECT:
+            *conn_id = gap->disconnect.conn_id;
+            break;
+        case XF_BLE_GAP_EVT_CONN_PARAM_UPDATE:
+            *conn_id = gap->conn_param_upd.conn_id;
+            break;
+        case XF_BLE_GAP_EVT_PAIR_END:
+            *conn_id = gap->pair_end.conn_id;
+            break;
+        case XF_BLE_GAP_EVT_PHY_UPDATE:
+            *conn_id = gap->phy_upd.conn_id;
+            break;
+        case XF_BLE_GAP_EVT_DATA_LEN_CHANGE:
+            *conn_id = gap->data_len.conn_id;
+            break;
+        default:
+            break;
+        }
+    } else if (module == XF_BLE_TRACE_MODULE_GATTS) {
+        const xf_ble_gatts_evt_cb_param_t *gatts = param;
+        switch (event) {
+        case XF_BLE_GATTS_EVT_EXCHANGE_MTU:
+            *conn_id = gatts->mtu.conn_id;
+            break;
+        case XF_BLE_GATTS_EVT_READ_REQ:
+            *conn_id = gatts->read_req.conn_id;
+            *handle = gatts->read_req.handle;
+            break;
+        case XF_BLE_GATTS_EVT_WRITE_REQ:
+            *conn_id = gatts->write_req.conn_id;
+            *handle = gatts->write_req.handle;
+            break;
+        case XF_BLE_GATTS_EVT_IND_CFM:
+            *conn_id = gatts->ind_cfm.conn_id;
+            *handle = gatts->ind_cfm.handle;
+            break;
+        default:
+            break;
+        }
+    } else if (module == XF_BLE_TRACE_MODULE_GATTC) {
+        const xf_ble_gattc_evt_cb_param_t *gattc = param;
+        switch (event) {
+        case XF_BLE_GATTC_EVT_EXCHANGE_MTU:
+            *conn_id = gattc->mtu.conn_id;
+            break;
+        case XF_BLE_GATTC_EVT_WRITE_CFM:
+            *conn_id = gattc->write_cfm.conn_id;
+            *handle = gattc->write_cfm.handle;
+            break;
+        case XF_BLE_GATTC_EVT_READ_CFM:
+            *conn_id = gattc->read_cfm.conn_id;
+            *handle = gattc->read_cfm.handle;
+            break;
+        case XF_BLE_GATTC_EVT_NOTIFICATION:
+        case XF_BLE_GATTC_EVT_INDICATION:
+            *conn_id = gattc->ntf.conn_id;
+            *handle = gattc->ntf.handle;
+            break;
+        case XF_BLE_GATTC_EVT_TX_COMPLETE:
+            *conn_id = gattc->tx_complete.conn_id;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+#endif /* XF_BLE_IS_ENABLE && XF_BLE_TRACE_ENABLE */
@@ -0,0 +1,319 @@
+/**
+ * @file xf_ble_trace.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 事件追踪。
+ *  以定长二进制记录 (带时间戳、连接 ID 及句柄) 记录 API 调用的进入、退出 (返回值) 及事件的分发，
+ *  写入无锁环形缓冲区，可导出后在主机上由 tools/xf_ble_trace2json.py 转换为
+ *  Chrome / Perfetto 追踪格式 (JSON) 查看。
+ *  由 XF_BLE_TRACE_ENABLE 开启，关闭时追踪宏展开为空，无任何开销。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_TRACE_H__
+#define __XF_BLE_TRACE_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief BLE 事件追踪导出数据的魔数 ("XFBT")
+ */
+#define XF_BLE_TRACE_MAGIC          (0x54424658)
+
+/**
+ * @brief BLE 事件追踪导出数据的格式版本
+ */
+#define XF_BLE_TRACE_VERSION        (1)
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE 事件追踪记录类型
+ */
+typedef uint8_t xf_ble_trace_kind_t;
+enum _xf_ble_trace_kind_t {
+    XF_BLE_TRACE_KIND_API_ENTER = 0,    /*!< API 调用进入 */
+    XF_BLE_TRACE_KIND_API_EXIT,         /*!< API 调用退出， value 为返回值 */
+    XF_BLE_TRACE_KIND_EVT_ENTER,        /*!< 事件分发开始 */
+    XF_BLE_TRACE_KIND_EVT_EXIT,         /*!< 事件分发结束， value 为处理结果 */
+    XF_BLE_TRACE_KIND_EVT_QUEUE,        /*!< 事件入队 (延迟分发)， value 为入队结果 */
+    XF_BLE_TRACE_KIND_USER,             /*!< 用户自定义记录 */
+};
+
+/**
+ * @brief BLE 事件追踪记录所属模块
+ */
+typedef uint8_t xf_ble_trace_module_t;
+enum _xf_ble_trace_module_t {
+    XF_BLE_TRACE_MODULE_API = 0,        /*!< API 调用， id 见 @ref xf_ble_trace_api_t */
+    XF_BLE_TRACE_MODULE_GAP,            /*!< GAP 事件， id 见 @ref xf_ble_gap_evt_t */
+    XF_BLE_TRACE_MODULE_GATTS,          /*!< GATTS 事件， id 见 @ref xf_ble_gatts_evt_t */
+    XF_BLE_TRACE_MODULE_GATTC,          /*!< GATTC 事件， id 见 @ref xf_ble_gattc_evt_t */
+    XF_BLE_TRACE_MODULE_USER,           /*!< 用户自定义 */
+};
+
+/**
+ * @brief BLE 事件追踪的 API ID
+ *
+ * @note 与 tools/xf_ble_trace2json.py 中的名称表保持一致
+ */
+typedef uint16_t xf_ble_trace_api_t;
+enum _xf_ble_trace_api_t {
+    XF_BLE_TRACE_API_ENABLE = 1,                       /*!< xf_ble_enable() */
+    XF_BLE_TRACE_API_DISABLE,                          /*!< xf_ble_disable() */
+    XF_BLE_TRACE_API_GAP_SET_LOCAL_ADDR,               /*!< xf_ble_gap_set_local_addr() */
+    XF_BLE_TRACE_API_GAP_GET_LOCAL_ADDR,               /*!< xf_ble_gap_get_local_addr() */
+    XF_BLE_TRACE_API_GAP_SET_LOCAL_APPEARANCE,         /*!< xf_ble_gap_set_local_appearance() */
+    XF_BLE_TRACE_API_GAP_GET_LOCAL_APPEARANCE,         /*!< xf_ble_gap_get_local_appearance() */
+    XF_BLE_TRACE_API_GAP_SET_LOCAL_NAME,               /*!< xf_ble_gap_set_local_name() */
+    XF_BLE_TRACE_API_GAP_GET_LOCAL_NAME,               /*!< xf_ble_gap_get_local_name() */
+    XF_BLE_TRACE_API_GAP_CREATE_ADV,                   /*!< xf_ble_gap_create_adv() */
+    XF_BLE_TRACE_API_GAP_DELETE_ADV,                   /*!< xf_ble_gap_delete_adv() */
+    XF_BLE_TRACE_API_GAP_START_ADV,                    /*!< xf_ble_gap_start_adv() */
+    XF_BLE_TRACE_API_GAP_STOP_ADV,                     /*!< xf_ble_gap_stop_adv() */
+    XF_BLE_TRACE_API_GAP_SET_ADV_DATA,                 /*!< xf_ble_gap_set_adv_data() */
+    XF_BLE_TRACE_API_GAP_START_SCAN,                   /*!< xf_ble_gap_start_scan() */
+    XF_BLE_TRACE_API_GAP_STOP_SCAN,                    /*!< xf_ble_gap_stop_scan() */
+    XF_BLE_TRACE_API_GAP_UPDATE_CONN_PARAM,            /*!< xf_ble_gap_update_conn_param() */
+    XF_BLE_TRACE_API_GAP_CONNECT,                      /*!< xf_ble_gap_connect() */
+    XF_BLE_TRACE_API_GAP_DISCONNECT,                   /*!< xf_ble_gap_disconnect() */
+    XF_BLE_TRACE_API_GAP_ADD_PAIR,                     /*!< xf_ble_gap_add_pair() */
+    XF_BLE_TRACE_API_GAP_DEL_PAIR,                     /*!< xf_ble_gap_del_pair() */
+    XF_BLE_TRACE_API_GAP_DEL_PAIR_ALL,                 /*!< xf_ble_gap_del_pair_all() */
+    XF_BLE_TRACE_API_GAP_GET_PAIR_LIST,                /*!< xf_ble_gap_get_pair_list() */
+    XF_BLE_TRACE_API_GAP_GET_BOND_LIST,                /*!< xf_ble_gap_get_bond_list() */
+    XF_BLE_TRACE_API_GAP_SET_PAIR_FEATURE,             /*!< xf_ble_gap_set_pair_feature() */
+    XF_BLE_TRACE_API_GAP_REQUEST_PAIR,                 /*!< xf_ble_gap_request_pair() */
+    XF_BLE_TRACE_API_GAP_RESPOND_PAIR,                 /*!< xf_ble_gap_respond_pair() */
+    XF_BLE_TRACE_API_GAP_PAIR_EXCHANGE_PASSKEY,        /*!< xf_ble_gap_pair_exchange_passkey() */
+    XF_BLE_TRACE_API_APP_ATTACH_ADV,                   /*!< xf_ble_app_attach_adv() */
+    XF_BLE_TRACE_API_APP_ATTACH_CONN,                  /*!< xf_ble_app_attach_conn() */
+    XF_BLE_TRACE_API_APP_DETACH_ADV,                   /*!< xf_ble_app_detach_adv() */
+    XF_BLE_TRACE_API_APP_DETACH_CONN,                  /*!< xf_ble_app_detach_conn() */
+    XF_BLE_TRACE_API_GATTS_APP_REGISTER,               /*!< xf_ble_gatts_app_register() */
+    XF_BLE_TRACE_API_GATTS_APP_UNREGISTER,             /*!< xf_ble_gatts_app_unregister() */
+    XF_BLE_TRACE_API_GATTS_ADD_SERVICE,                /*!< xf_ble_gatts_add_service() */
+    XF_BLE_TRACE_API_GATTS_START_SERVICE,              /*!< xf_ble_gatts_start_service() */
+    XF_BLE_TRACE_API_GATTS_STOP_SERVICE,               /*!< xf_ble_gatts_stop_service() */
+    XF_BLE_TRACE_API_GATTS_DEL_SERVICES_ALL,           /*!< xf_ble_gatts_del_services_all() */
+    XF_BLE_TRACE_API_GATTS_SEND_NOTIFICATION,          /*!< xf_ble_gatts_send_notification() */
+    XF_BLE_TRACE_API_GATTS_SEND_INDICATION,            /*!< xf_ble_gatts_send_indication() */
+    XF_BLE_TRACE_API_GATTS_SEND_READ_RSP,              /*!< xf_ble_gatts_send_read_rsp() */
+    XF_BLE_TRACE_API_GATTS_SEND_WRITE_RSP,             /*!< xf_ble_gatts_send_write_rsp() */
+    XF_BLE_TRACE_API_GATTC_APP_REGISTER,               /*!< xf_ble_gattc_app_register() */
+    XF_BLE_TRACE_API_GATTC_APP_UNREGISTER,             /*!< xf_ble_gattc_app_unregister() */
+    XF_BLE_TRACE_API_GATTC_DISCOVER_SERVICE,           /*!< xf_ble_gattc_discover_service() */
+    XF_BLE_TRACE_API_GATTC_DISCOVER_CHARA,             /*!< xf_ble_gattc_discover_chara() */
+    XF_BLE_TRACE_API_GATTC_REQUEST_READ_BY_HANDLE,     /*!< xf_ble_gattc_request_read_by_handle() */
+    XF_BLE_TRACE_API_GATTC_REQUEST_READ_BY_UUID,       /*!< xf_ble_gattc_request_read_by_uuid() */
+    XF_BLE_TRACE_API_GATTC_REQUEST_WRITE,              /*!< xf_ble_gattc_request_write() */
+    XF_BLE_TRACE_API_GATTC_REQUEST_EXCHANGE_MTU,       /*!< xf_ble_gattc_request_exchange_mtu() */
+    XF_BLE_TRACE_API_GAP_SET_PHY,                      /*!< xf_ble_gap_set_phy() */
+    XF_BLE_TRACE_API_GAP_SET_DATA_LEN,                 /*!< xf_ble_gap_set_data_len() */
+    XF_BLE_TRACE_API_GAP_CANCEL_CONNECT,               /*!< xf_ble_gap_cancel_connect() */
+    XF_BLE_TRACE_API_GAP_CONNECT_BY_ACCEPT_LIST,       /*!< xf_ble_gap_connect_by_accept_list() */
+    XF_BLE_TRACE_API_GAP_ADD_ACCEPT_LIST,              /*!< xf_ble_gap_add_accept_list() */
+    XF_BLE_TRACE_API_GAP_DEL_ACCEPT_LIST,              /*!< xf_ble_gap_del_accept_list() */
+    XF_BLE_TRACE_API_GAP_CLEAR_ACCEPT_LIST,            /*!< xf_ble_gap_clear_accept_list() */
+    XF_BLE_TRACE_API_GAP_ADD_RESOLVING_LIST,           /*!< xf_ble_gap_add_resolving_list() */
+    XF_BLE_TRACE_API_GAP_DEL_RESOLVING_LIST,           /*!< xf_ble_gap_del_resolving_list() */
+    XF_BLE_TRACE_API_GAP_CLEAR_RESOLVING_LIST,         /*!< xf_ble_gap_clear_resolving_list() */
+    XF_BLE_TRACE_API_GAP_GET_RAND,                     /*!< xf_ble_gap_get_rand() */
+    XF_BLE_TRACE_API_GAP_SET_ADV_ADDR,                 /*!< xf_ble_gap_set_adv_addr() */
+    _XF_BLE_TRACE_API_MAX,
+    XF_BLE_TRACE_API_USER_BASE = 0x8000,                /*!< 对接层或应用自定义 API ID 的起始值 */
+};
+
+/**
+ * @brief BLE 事件追踪记录 (16 字节，小端)
+ */
+typedef struct {
+    uint32_t timestamp;                 /*!< 时间戳，见 XF_BLE_TRACE_TIMESTAMP() */
+    xf_ble_trace_kind_t kind;           /*!< 记录类型，见 @ref xf_ble_trace_kind_t */
+    xf_ble_trace_module_t module;       /*!< 所属模块，见 @ref xf_ble_trace_module_t */
+    uint16_t id;                        /*!< API ID 或事件 */
+    xf_ble_conn_id_t conn_id;           /*!< 连接 ID ，无时为 XF_BLE_TRACE_CONN_ID_NONE */
+    uint8_t reserved;
+    xf_ble_attr_handle_t handle;        /*!< 属性句柄，无时为 0 */
+    int32_t value;                      /*!< 返回值或处理结果 */
+} xf_ble_trace_record_t;
+
+/**
+ * @brief BLE 事件追踪导出数据的输出函数原型
+ *
+ * @param data 数据
+ * @param len 数据长度
+ * @param user_data 用户数据
+ */
+typedef void (*xf_ble_trace_out_cb_t)(const void *data, uint16_t len, void *user_data);
+
+/* ==================== [Global Prototypes] ================================= */
+
+#if XF_BLE_TRACE_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @brief BLE 事件追踪写入一条记录
+ *
+ * @note 可在任意上下文 (包括中断) 中调用，通常通过 XF_BLE_TRACE_API_ENTER() 等宏调用
+ */
+void xf_ble_trace_record(
+    xf_ble_trace_kind_t kind, xf_ble_trace_module_t module, uint16_t id,
+    xf_ble_conn_id_t conn_id, xf_ble_attr_handle_t handle, int32_t value);
+
+/**
+ * @brief BLE 事件追踪写入一条事件记录 (从事件参数中取出连接 ID 及句柄)
+ *
+ * @param kind 记录类型
+ * @param module 事件所属模块， GAP 、 GATTS 或 GATTC
+ * @param event 事件
+ * @param param 事件参数，对应 module 的 xf_ble_gap_evt_cb_param_t 等，可为 NULL
+ * @param value 处理结果
+ */
+void xf_ble_trace_evt(
+    xf_ble_trace_kind_t kind, xf_ble_trace_module_t module, uint8_t event,
+    const void *param, int32_t value);
+
+/**
+ * @brief BLE 事件追踪读取记录
+ *
+ * @note 按时间先后顺序读取缓冲区中最新的 max_cnt 条记录，不清除记录。
+ *  读取时若仍有写入，个别记录可能不完整
+ * @param[out] buf 记录
+ * @param max_cnt 最多读取的记录数
+ * @return uint16_t 读取的记录数
+ */
+uint16_t xf_ble_trace_read(xf_ble_trace_record_t *buf, uint16_t max_cnt);
+
+/**
+ * @brief BLE 事件追踪导出缓冲区中的全部记录
+ *
+ * @note 输出格式: 8 字节头 (魔数 XF_BLE_TRACE_MAGIC (4) ，版本 (1) ，记录大小 (1) ，保留 (2) )，
+ *  随后为按时间先后排列的记录，均为小端。可写入文件或经串口输出，
+ *  再由 tools/xf_ble_trace2json.py 转换
+ * @param out_cb 输出函数，每次输出头或一条记录
+ * @param user_data 用户数据，调用 out_cb 时传入
+ */
+void xf_ble_trace_dump(xf_ble_trace_out_cb_t out_cb, void *user_data);
+
+/**
+ * @brief BLE 事件追踪清空记录
+ */
+void xf_ble_trace_clear(void);
+
+#endif /* XF_BLE_TRACE_ENABLE */
+
+/* ==================== [Macros] ============================================ */
+
+/**
+ * @brief BLE 事件追踪记录中无连接 ID 时的值
+ */
+#define XF_BLE_TRACE_CONN_ID_NONE   (0xFF)
+
+#if XF_BLE_TRACE_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @brief BLE 事件追踪: API 调用进入
+ *
+ * @param api API ID ，见 @ref xf_ble_trace_api_t
+ * @param conn_id 连接 ID
+ * @param handle 属性句柄
+ */
+#define XF_BLE_TRACE_API_ENTER(api, conn_id, handle) \
+    xf_ble_trace_record(XF_BLE_TRACE_KIND_API_ENTER, XF_BLE_TRACE_MODULE_API, (api), (conn_id), (handle), 0)
+
+/**
+ * @brief BLE 事件追踪: API 调用退出
+ *
+ * @param ret 返回值
+ */
+#define XF_BLE_TRACE_API_EXIT(api, conn_id, handle, ret) \
+    xf_ble_trace_record(XF_BLE_TRACE_KIND_API_EXIT, XF_BLE_TRACE_MODULE_API, (api), (conn_id), (handle), (ret))
+
+/**
+ * @brief BLE 事件追踪: 调用 API ，并在调用前后记录进入及退出
+ *
+ * @param ret 保存返回值的变量
+ * @param call API 调用表达式
+ */
+#define XF_BLE_TRACE_API_CALL(ret, api, conn_id, handle, call) do { \
+        XF_BLE_TRACE_API_ENTER((api), (conn_id), (handle)); \
+        (ret) = (call); \
+        XF_BLE_TRACE_API_EXIT((api), (conn_id), (handle), (ret)); \
+    } while (0)
+
+/**
+ * @brief BLE 事件追踪: 事件分发开始
+ *
+ * @param module 事件所属模块，见 @ref xf_ble_trace_module_t
+ * @param event 事件
+ * @param param 事件参数
+ */
+#define XF_BLE_TRACE_EVT_ENTER(module, event, param) \
+    xf_ble_trace_evt(XF_BLE_TRACE_KIND_EVT_ENTER, (module), (event), (param), 0)
+
+/**
+ * @brief BLE 事件追踪: 事件分发结束
+ *
+ * @param res 处理结果
+ */
+#define XF_BLE_TRACE_EVT_EXIT(module, event, param, res) \
+    xf_ble_trace_evt(XF_BLE_TRACE_KIND_EVT_EXIT, (module), (event), (param), (res))
+
+/**
+ * @brief BLE 事件追踪: 事件入队
+ *
+ * @param res 入队结果
+ */
+#define XF_BLE_TRACE_EVT_QUEUE(module, event, param, res) \
+    xf_ble_trace_evt(XF_BLE_TRACE_KIND_EVT_QUEUE, (module), (event), (param), (res))
+
+/**
+ * @brief BLE 事件追踪: 用户自定义记录
+ */
+#define XF_BLE_TRACE_USER(id, conn_id, handle, value) \
+    xf_ble_trace_record(XF_BLE_TRACE_KIND_USER, XF_BLE_TRACE_MODULE_USER, (id), (conn_id), (handle), (value))
+
+#else
+
+#define XF_BLE_TRACE_API_ENTER(api, conn_id, handle)            do { } while (0)
+#define XF_BLE_TRACE_API_EXIT(api, conn_id, handle, ret)        do { } while (0)
+#define XF_BLE_TRACE_API_CALL(ret, api, conn_id, handle, call)  do { (ret) = (call); } while (0)
+#define XF_BLE_TRACE_EVT_ENTER(module, event, param)            do { } while (0)
+#define XF_BLE_TRACE_EVT_EXIT(module, event, param, res)        do { } while (0)
+#define XF_BLE_TRACE_EVT_QUEUE(module, event, param, res)       do { } while (0)
+#define XF_BLE_TRACE_USER(id, conn_id, handle, value)           do { } while (0)
+
+#endif /* XF_BLE_TRACE_ENABLE */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_TRACE_H__ */
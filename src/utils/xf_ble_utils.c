@@ -12,6 +12,7 @@
 
 #include "xf_utils.h"
 #include "xf_ble_gatt_server.h"
+#include "xf_ble_utils.h"
 
 /* ==================== [Defines] =========================================== */
 
@@ -130,4 +131,25 @@ xf_err_t xf_ble_gatts_svc_att_get_pos_by_handle(
 
     return XF_OK;
 }
+
+bool xf_ble_addr_is_equal(const xf_ble_addr_t *a, const xf_ble_addr_t *b)
+{
+    if (a->type != b->type) {
+        return false;
+    }
+    for (uint8_t i = 0; i < XF_BLE_ADDR_LEN; i++) {
+        if (a->addr[i] != b->addr[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool xf_ble_addr_is_rpa(const xf_ble_addr_t *addr)
+{
+    return (addr != NULL)
+           && ((addr->type == XF_BLE_ADDR_TYPE_RANDOM_DEV) || (addr->type == XF_BLE_ADDR_TYPE_RPA_RANDOM))
+           && ((addr->addr[0] & 0xC0) == 0x40);
+}
+
 /* ==================== [Static Functions] ================================== */
@@ -0,0 +1,68 @@
+/**
+ * @file xf_ble_utils.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE 通用辅助方法。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_UTILS_H__
+#define __XF_BLE_UTILS_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE 地址是否相同 (地址类型及地址均相同)
+ *
+ * @param a 地址，见 @ref xf_ble_addr_t
+ * @param b 地址，见 @ref xf_ble_addr_t
+ * @return bool 是否相同
+ */
+bool xf_ble_addr_is_equal(const xf_ble_addr_t *a, const xf_ble_addr_t *b);
+
+/**
+ * @brief BLE 地址是否为可解析私有地址 (随机地址且最高两位为 0b01)
+ *
+ * @param addr 地址，见 @ref xf_ble_addr_t
+ * @return bool 是否为 RPA
+ */
+bool xf_ble_addr_is_rpa(const xf_ble_addr_t *addr);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_UTILS_H__ */
@@ -0,0 +1,207 @@
+/**
+ * @file xf_ble_uuid.c
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE UUID 辅助方法。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+#include "xf_ble_uuid.h"
+
+#if XF_BLE_IS_ENABLE
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "xf_ble_uuid"
+
+/**
+ * @brief 驻留哈希表大小，不小于驻留数的 2 倍的 2 的幂
+ */
+#define UUID_INTERN_TABLE_SIZE  (UUID_POW2_CEIL(XF_BLE_UUID_INTERN_MAX * 2))
+
+#define UUID_POW2_CEIL(n)       (((n) <= 8) ? 8 : ((n) <= 16) ? 16 : ((n) <= 32) ? 32 \
+                                : ((n) <= 64) ? 64 : ((n) <= 128) ? 128 : ((n) <= 256) ? 256 \
+                                : ((n) <= 512) ? 512 : 1024)
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static uint32_t uuid_load_le32(const uint8_t *p);
+
+/* ==================== [Static Variables] ================================== */
+
+/**
+ * @brief 蓝牙基础 UUID 00000000-0000-1000-8000-00805F9B34FB (小端)
+ */
+static const uint8_t s_base_uuid128[XF_BLE_UUID_TYPE_128] = {
+    0xFB, 0x34, 0x9B, 0x5F, 0x80, 0x00, 0x00, 0x80,
+    0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static xf_ble_uuid128_t s_intern_set[XF_BLE_UUID_INTERN_MAX] = {0};
+static uint16_t s_intern_cnt = 0;
+/* 开放寻址哈希表，存放驻留 ID ( s_intern_set 下标 + 1 )， 0 表示空 */
+static xf_ble_uuid_id_t s_intern_table[UUID_INTERN_TABLE_SIZE] = {0};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+bool xf_ble_uuid_to_128(const xf_ble_uuid_info_t *uuid, xf_ble_uuid128_t *uuid128)
+{
+    xf_ble_uuid_type_t type = uuid->type;
+    /* 以掩码代替分支选择: 16-bit 取 uuid16 ，32-bit 取 uuid32 ，128-bit 取 uuid128 */
+    uint32_t mask_16 = 0U - (uint32_t)(type == XF_BLE_UUID_TYPE_16);
+    uint8_t mask_128 = (uint8_t)(0U - (uint32_t)(type == XF_BLE_UUID_TYPE_128));
+    uint32_t val = ((uint32_t)uuid->uuid16 & mask_16) | (uuid->uuid32 & ~mask_16);
+    uint8_t short128[XF_BLE_UUID_TYPE_128];
+
+    xf_memcpy(short128, s_base_uuid128, sizeof(short128));
+    short128[12] = (uint8_t)(val);
+    short128[13] = (uint8_t)(val >> 8);
+    short128[14] = (uint8_t)(val >> 16);
+    short128[15] = (uint8_t)(val >> 24);
+    for (uint8_t i = 0; i < XF_BLE_UUID_TYPE_128; i++) {
+        uuid128->uuid128[i] = (uint8_t)((uuid->uuid128[i] & mask_128)
+                                        | (short128[i] & (uint8_t)~mask_128));
+    }
+    return (type == XF_BLE_UUID_TYPE_16) | (type == XF_BLE_UUID_TYPE_32)
+           | (type == XF_BLE_UUID_TYPE_128);
+}
+
+uint32_t xf_ble_uuid128_hash(const xf_ble_uuid128_t *uuid128)
+{
+    uint32_t hash = 0x9E3779B9U;
+    for (uint8_t i = 0; i < XF_BLE_UUID_TYPE_128; i += 4) {
+        hash ^= uuid_load_le32(&uuid128->uuid128[i]);
+        hash *= 0x85EBCA6BU;
+        hash ^= hash >> 13;
+    }
+    /* murmur3 fmix32 */
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6BU;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35U;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+uint32_t xf_ble_uuid_hash(const xf_ble_uuid_info_t *uuid)
+{
+    xf_ble_uuid128_t uuid128;
+    xf_ble_uuid_to_128(uuid, &uuid128);
+    return xf_ble_uuid128_hash(&uuid128);
+}
+
+bool xf_ble_uuid128_equal(const xf_ble_uuid128_t *a, const xf_ble_uuid128_t *b)
+{
+    uint32_t diff = 0;
+    for (uint8_t i = 0; i < XF_BLE_UUID_TYPE_128; i += 4) {
+        diff |= uuid_load_le32(&a->uuid128[i]) ^ uuid_load_le32(&b->uuid128[i]);
+    }
+    return diff == 0;
+}
+
+bool xf_ble_uuid_equal(const xf_ble_uuid_info_t *a, const xf_ble_uuid_info_t *b)
+{
+    xf_ble_uuid128_t a128;
+    xf_ble_uuid128_t b128;
+    if (!xf_ble_uuid_to_128(a, &a128) || !xf_ble_uuid_to_128(b, &b128)) {
+        return false;
+    }
+    return xf_ble_uuid128_equal(&a128, &b128);
+}
+
+int xf_ble_uuid_cmp(const xf_ble_uuid_info_t *a, const xf_ble_uuid_info_t *b)
+{
+    xf_ble_uuid128_t a128;
+    xf_ble_uuid128_t b128;
+    xf_ble_uuid_to_128(a, &a128);
+    xf_ble_uuid_to_128(b, &b128);
+    /* 小端存储，从最高有效字节开始比较 */
+    for (int8_t i = XF_BLE_UUID_TYPE_128 - 1; i >= 0; i--) {
+        if (a128.uuid128[i] != b128.uuid128[i]) {
+            return (int)a128.uuid128[i] - (int)b128.uuid128[i];
+        }
+    }
+    return 0;
+}
+
+xf_err_t xf_ble_uuid_intern(const xf_ble_uuid_info_t *uuid, xf_ble_uuid_id_t *id)
+{
+    XF_ASSERT((uuid != NULL) && (id != NULL), XF_ERR_INVALID_ARG, TAG, "uuid or id == NULL");
+
+    xf_ble_uuid128_t uuid128;
+    XF_CHECK(!xf_ble_uuid_to_128(uuid, &uuid128), XF_ERR_INVALID_ARG,
+             TAG, "invalid uuid type: %d", uuid->type);
+
+    uint16_t mask = UUID_INTERN_TABLE_SIZE - 1;
+    uint16_t pos = xf_ble_uuid128_hash(&uuid128) & mask;
+
+    XF_BLE_ENTER_CRITICAL();
+    while (s_intern_table[pos] != XF_BLE_UUID_ID_INVALID) {
+        if (xf_ble_uuid128_equal(&s_intern_set[s_intern_table[pos] - 1], &uuid128)) {
+            *id = s_intern_table[pos];
+            XF_BLE_EXIT_CRITICAL();
+            return XF_OK;
+        }
+        pos = (pos + 1) & mask;
+    }
+    if (s_intern_cnt >= XF_BLE_UUID_INTERN_MAX) {
+        XF_BLE_EXIT_CRITICAL();
+        XF_LOGE(TAG, "uuid intern table full");
+        return XF_ERR_NO_MEM;
+    }
+    s_intern_set[s_intern_cnt] = uuid128;
+    *id = ++s_intern_cnt;
+    s_intern_table[pos] = *id;
+    XF_BLE_EXIT_CRITICAL();
+    return XF_OK;
+}
+
+xf_ble_uuid_id_t xf_ble_uuid_id_find(const xf_ble_uuid_info_t *uuid)
+{
+    xf_ble_uuid128_t uuid128;
+    if ((uuid == NULL) || !xf_ble_uuid_to_128(uuid, &uuid128)) {
+        return XF_BLE_UUID_ID_INVALID;
+    }
+
+    uint16_t mask = UUID_INTERN_TABLE_SIZE - 1;
+    uint16_t pos = xf_ble_uuid128_hash(&uuid128) & mask;
+    xf_ble_uuid_id_t id = XF_BLE_UUID_ID_INVALID;
+
+    XF_BLE_ENTER_CRITICAL();
+    while (s_intern_table[pos] != XF_BLE_UUID_ID_INVALID) {
+        if (xf_ble_uuid128_equal(&s_intern_set[s_intern_table[pos] - 1], &uuid128)) {
+            id = s_intern_table[pos];
+            break;
+        }
+        pos = (pos + 1) & mask;
+    }
+    XF_BLE_EXIT_CRITICAL();
+    return id;
+}
+
+const xf_ble_uuid128_t *xf_ble_uuid_id_get(xf_ble_uuid_id_t id)
+{
+    if ((id == XF_BLE_UUID_ID_INVALID) || (id > s_intern_cnt)) {
+        return NULL;
+    }
+    /* 驻留后不会删除，可直接返回 */
+    return &s_intern_set[id - 1];
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static uint32_t uuid_load_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8)
+           | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+#endif /* XF_BLE_IS_ENABLE */
@@ -0,0 +1,147 @@
+/**
+ * @file xf_ble_uuid.h
+ * @author dotc (dotchan@qq.com)
+ * @brief BLE UUID 辅助方法。
+ *  统一转换为 128-bit 规范形式后进行哈希、比较及排序，
+ *  并提供 UUID 驻留表，热路径上可通过小整数 ID 比较 UUID 。
+ * @date 2026-10-18
+ *
+ * @Copyright (c) 2026, CorAL. All rights reserved.
+ */
+
+#ifndef __XF_BLE_UUID_H__
+#define __XF_BLE_UUID_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_utils.h"
+
+#include "xf_ble_types.h"
+
+#if XF_BLE_IS_ENABLE || defined(__DOXYGEN__)
+
+/**
+ * @cond (XFAPI_USER || XFAPI_PORT)
+ * @addtogroup group_xf_wal_ble
+ * @endcond
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/**
+ * @brief BLE UUID 驻留 ID 无效值
+ */
+#define XF_BLE_UUID_ID_INVALID      (0)
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief BLE 128-bit 规范形式的 UUID (小端字节序)
+ *
+ * @note 16-bit 、 32-bit UUID 按蓝牙基础 UUID (00000000-0000-1000-8000-00805F9B34FB) 展开，
+ *  值位于第 12 ~ 15 字节
+ */
+typedef struct {
+    uint8_t uuid128[XF_BLE_UUID_TYPE_128];
+} xf_ble_uuid128_t;
+
+/**
+ * @brief BLE UUID 驻留 ID ，相同的 UUID (不论长度形式) 对应相同的 ID
+ */
+typedef uint16_t xf_ble_uuid_id_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief BLE UUID 转换为 128-bit 规范形式
+ *
+ * @note 展开过程无分支，长度类型无效时 uuid128 内容无意义
+ * @param uuid UUID ，见 @ref xf_ble_uuid_info_t
+ * @param[out] uuid128 128-bit 规范形式，见 @ref xf_ble_uuid128_t
+ * @return true 成功； false 长度类型无效
+ */
+bool xf_ble_uuid_to_128(const xf_ble_uuid_info_t *uuid, xf_ble_uuid128_t *uuid128);
+
+/**
+ * @brief BLE 计算 128-bit 规范形式 UUID 的 32-bit 哈希
+ *
+ * @param uuid128 128-bit 规范形式，见 @ref xf_ble_uuid128_t
+ * @return uint32_t 哈希值
+ */
+uint32_t xf_ble_uuid128_hash(const xf_ble_uuid128_t *uuid128);
+
+/**
+ * @brief BLE 计算 UUID 的 32-bit 哈希 (同一 UUID 的不同长度形式哈希相同)
+ *
+ * @param uuid UUID ，见 @ref xf_ble_uuid_info_t
+ * @return uint32_t 哈希值
+ */
+uint32_t xf_ble_uuid_hash(const xf_ble_uuid_info_t *uuid);
+
+/**
+ * @brief BLE 判断两个 128-bit 规范形式 UUID 是否相同
+ */
+bool xf_ble_uuid128_equal(const xf_ble_uuid128_t *a, const xf_ble_uuid128_t *b);
+
+/**
+ * @brief BLE 判断两个 UUID 是否相同 (不同长度形式的同一 UUID 视为相同)
+ *
+ * @return true 相同； false 不同或存在无效的长度类型
+ */
+bool xf_ble_uuid_equal(const xf_ble_uuid_info_t *a, const xf_ble_uuid_info_t *b);
+
+/**
+ * @brief BLE 比较两个 UUID 的大小
+ *
+ * @note 按 UUID 字符串形式 (即最高有效字节起) 的顺序比较，可用于排序及二分查找
+ * @return int 小于 0: a < b ； 0: a == b ；大于 0: a > b
+ */
+int xf_ble_uuid_cmp(const xf_ble_uuid_info_t *a, const xf_ble_uuid_info_t *b);
+
+/**
+ * @brief BLE 驻留 UUID ，获取其 ID (不存在时加入驻留表)
+ *
+ * @param uuid UUID ，见 @ref xf_ble_uuid_info_t
+ * @param[out] id 驻留 ID ，见 @ref xf_ble_uuid_id_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    无效参数
+ *      - XF_ERR_NO_MEM         驻留表已满
+ */
+xf_err_t xf_ble_uuid_intern(const xf_ble_uuid_info_t *uuid, xf_ble_uuid_id_t *id);
+
+/**
+ * @brief BLE 查找已驻留 UUID 的 ID (不加入驻留表)
+ *
+ * @param uuid UUID ，见 @ref xf_ble_uuid_info_t
+ * @return xf_ble_uuid_id_t 驻留 ID ，未驻留时返回 XF_BLE_UUID_ID_INVALID
+ */
+xf_ble_uuid_id_t xf_ble_uuid_id_find(const xf_ble_uuid_info_t *uuid);
+
+/**
+ * @brief BLE 获取驻留 ID 对应的 128-bit 规范形式 UUID
+ *
+ * @param id 驻留 ID ，见 @ref xf_ble_uuid_id_t
+ * @return const xf_ble_uuid128_t* 128-bit 规范形式，ID 无效时返回 NULL
+ */
+const xf_ble_uuid128_t *xf_ble_uuid_id_get(xf_ble_uuid_id_t id);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of addtogroup group_xf_wal_ble
+ * @}
+ */
+
+#endif /* XF_BLE_IS_ENABLE */
+
+#endif /* __XF_BLE_UUID_H__ */
@@ -27,6 +27,472 @@ extern "C" {
 #define XF_BLE_IS_ENABLE        (0)
 #endif
 
+/**
+ * @brief XF BLE 临界区 (进入)
+ * @note 部分模块的状态会同时在协议栈上下文与应用上下文中被访问，
+ *  移植时可在 xf_ble_config.h 中定义为平台的关中断或加锁操作。
+ *  默认为空，即认为这些模块只在单一上下文中被调用。
+ */
+#if !defined(XF_BLE_ENTER_CRITICAL)
+#define XF_BLE_ENTER_CRITICAL() do { } while (0)
+#endif
+
+/**
+ * @brief XF BLE 临界区 (退出)
+ */
+#if !defined(XF_BLE_EXIT_CRITICAL)
+#define XF_BLE_EXIT_CRITICAL()  do { } while (0)
+#endif
+
+/**
+ * @brief XF BLE 中断上下文临界区 (进入)
+ * @note state 为 uint32_t 变量，用于保存进入前的状态 (如 FreeRTOS 的
+ *  taskENTER_CRITICAL_FROM_ISR() 的返回值)。默认同 XF_BLE_ENTER_CRITICAL() 。
+ */
+#if !defined(XF_BLE_ENTER_CRITICAL_FROM_ISR)
+#define XF_BLE_ENTER_CRITICAL_FROM_ISR(state)   do { (state) = 0; XF_BLE_ENTER_CRITICAL(); } while (0)
+#endif
+
+/**
+ * @brief XF BLE 中断上下文临界区 (退出)
+ */
+#if !defined(XF_BLE_EXIT_CRITICAL_FROM_ISR)
+#define XF_BLE_EXIT_CRITICAL_FROM_ISR(state)    do { (void)(state); XF_BLE_EXIT_CRITICAL(); } while (0)
+#endif
+
+/**
+ * @brief GATTC 流式发送 (写命令) 可同时进行的流的最大数量
+ */
+#if !defined(XF_BLE_GATTC_STREAM_MAX_NUM)
+#define XF_BLE_GATTC_STREAM_MAX_NUM             (2)
+#endif
+
+/**
+ * @brief GATTC 流式发送 默认的 TX credits 数 (即控制器可缓存的待发送数据包个数)
+ */
+#if !defined(XF_BLE_GATTC_STREAM_TX_CREDITS_DEFAULT)
+#define XF_BLE_GATTC_STREAM_TX_CREDITS_DEFAULT  (4)
+#endif
+
+/**
+ * @brief GATTC 通知/指示分发表的大小 (可同时注册的 (conn_id, handle) 处理函数的最大数量)
+ * @note 必须为 2 的幂
+ */
+#if !defined(XF_BLE_GATTC_NTF_TABLE_SIZE)
+#define XF_BLE_GATTC_NTF_TABLE_SIZE             (32)
+#endif
+
+/**
+ * @brief GATTC 服务结构数据库可同时保存的连接的最大数量
+ */
+#if !defined(XF_BLE_GATTC_DB_CONN_MAX)
+#define XF_BLE_GATTC_DB_CONN_MAX                (4)
+#endif
+
+/**
+ * @brief GATTC 订阅 (CCCD) 管理可记录的对端设备的最大数量
+ */
+#if !defined(XF_BLE_GATTC_SUB_PEER_MAX)
+#define XF_BLE_GATTC_SUB_PEER_MAX               (4)
+#endif
+
+/**
+ * @brief GATTC 订阅 (CCCD) 管理中每个对端设备可记录的订阅的最大数量
+ */
+#if !defined(XF_BLE_GATTC_SUB_PER_PEER_MAX)
+#define XF_BLE_GATTC_SUB_PER_PEER_MAX           (8)
+#endif
+
+/**
+ * @brief GATTC 服务结构搜寻调度可同时进行搜寻的连接的最大数量
+ */
+#if !defined(XF_BLE_GATTC_DISC_CONN_MAX)
+#define XF_BLE_GATTC_DISC_CONN_MAX              (8)
+#endif
+
+/**
+ * @brief GATTC 属性值缓存的最大条目数 (所有连接共享)
+ */
+#if !defined(XF_BLE_GATTC_CACHE_ENTRY_MAX)
+#define XF_BLE_GATTC_CACHE_ENTRY_MAX            (16)
+#endif
+
+/**
+ * @brief GATTC 属性值缓存单个条目可缓存的最大属性值长度，超出的值不缓存
+ */
+#if !defined(XF_BLE_GATTC_CACHE_VALUE_MAX)
+#define XF_BLE_GATTC_CACHE_VALUE_MAX            (32)
+#endif
+
+/**
+ * @brief GATTC UUID 索引可同时索引的连接的最大数量
+ */
+#if !defined(XF_BLE_GATTC_INDEX_CONN_MAX)
+#define XF_BLE_GATTC_INDEX_CONN_MAX             XF_BLE_GATTC_DB_CONN_MAX
+#endif
+
+/**
+ * @brief UUID 驻留表可驻留的 UUID 的最大数量
+ */
+#if !defined(XF_BLE_UUID_INTERN_MAX)
+#define XF_BLE_UUID_INTERN_MAX                  (32)
+#endif
+
+/**
+ * @brief 异步命令可同时进行的请求的最大数量
+ */
+#if !defined(XF_BLE_ASYNC_REQ_MAX)
+#define XF_BLE_ASYNC_REQ_MAX                    (8)
+#endif
+
+/**
+ * @brief 异步命令结果中可保存的最大属性值长度 (读请求)，超出部分截断
+ */
+#if !defined(XF_BLE_ASYNC_VALUE_MAX)
+#define XF_BLE_ASYNC_VALUE_MAX                  (32)
+#endif
+
+/**
+ * @brief 异步命令默认超时时间，单位 ms (同 ATT 事务超时)
+ */
+#if !defined(XF_BLE_ASYNC_TIMEOUT_MS_DEFAULT)
+#define XF_BLE_ASYNC_TIMEOUT_MS_DEFAULT         (30000)
+#endif
+
+/**
+ * @brief 同步等待异步命令完成时每次轮询间让出 CPU 的方法，如 osDelay(1)
+ */
+#if !defined(XF_BLE_ASYNC_WAIT_YIELD)
+#define XF_BLE_ASYNC_WAIT_YIELD()               do { } while (0)
+#endif
+
+/**
+ * @brief 事件队列优先级通道的数量，通道 0 优先级最高
+ */
+#if !defined(XF_BLE_EVTQ_LANE_NUM)
+#define XF_BLE_EVTQ_LANE_NUM                    (2)
+#endif
+
+/**
+ * @brief 事件队列每个通道可缓存的事件数量，需为 2 的幂
+ */
+#if !defined(XF_BLE_EVTQ_DEPTH)
+#define XF_BLE_EVTQ_DEPTH                       (16)
+#endif
+
+/**
+ * @brief 事件队列每个事件可缓存的最大数据长度 (如属性值、广播数据)，超出的事件被丢弃 (数据位于 pbuf 中的事件不受此限制)
+ */
+#if !defined(XF_BLE_EVTQ_PAYLOAD_MAX)
+#define XF_BLE_EVTQ_PAYLOAD_MAX                 (64)
+#endif
+
+/**
+ * @brief 事件分发器可注册的处理函数的最大数量 (GAP 、 GATTS 、 GATTC 共用)
+ */
+#if !defined(XF_BLE_EVT_DISP_HANDLER_MAX)
+#define XF_BLE_EVT_DISP_HANDLER_MAX             (8)
+#endif
+
+/**
+ * @brief 读确认、通知 / 指示、写请求及扫描结果的事件参数是否带有 pbuf 成员 (见 xf_ble_pbuf_t)
+ * @note 开启后对接层上报这些事件时必须将 pbuf 置为有效的缓冲区或 NULL (建议先将整个事件参数清零再填写)，
+ *  否则事件队列会持有并释放未初始化的指针；对接层未适配前请勿开启
+ */
+#if !defined(XF_BLE_EVT_PBUF_ENABLE)
+#define XF_BLE_EVT_PBUF_ENABLE                  (0)
+#endif
+
+/**
+ * @brief 缓冲池小块的大小 (字节)
+ */
+#if !defined(XF_BLE_POOL_SMALL_SIZE)
+#define XF_BLE_POOL_SMALL_SIZE                  (32)
+#endif
+
+/**
+ * @brief 缓冲池小块的数量， 0 表示不使用该大小的块
+ */
+#if !defined(XF_BLE_POOL_SMALL_NUM)
+#define XF_BLE_POOL_SMALL_NUM                   (16)
+#endif
+
+/**
+ * @brief 缓冲池中块的大小 (字节)
+ */
+#if !defined(XF_BLE_POOL_MEDIUM_SIZE)
+#define XF_BLE_POOL_MEDIUM_SIZE                 (256)
+#endif
+
+/**
+ * @brief 缓冲池中块的数量， 0 表示不使用该大小的块
+ */
+#if !defined(XF_BLE_POOL_MEDIUM_NUM)
+#define XF_BLE_POOL_MEDIUM_NUM                  (4)
+#endif
+
+/**
+ * @brief 缓冲池大块的大小 (字节)
+ */
+#if !defined(XF_BLE_POOL_LARGE_SIZE)
+#define XF_BLE_POOL_LARGE_SIZE                  (528)
+#endif
+
+/**
+ * @brief 缓冲池大块的数量， 0 表示不使用该大小的块
+ */
+#if !defined(XF_BLE_POOL_LARGE_NUM)
+#define XF_BLE_POOL_LARGE_NUM                   (2)
+#endif
+
+/**
+ * @brief 缓冲池无合适的空闲块时是否改为从堆中分配 (中断上下文中的分配不会从堆中分配)
+ */
+#if !defined(XF_BLE_POOL_HEAP_FALLBACK)
+#define XF_BLE_POOL_HEAP_FALLBACK               (1)
+#endif
+
+/**
+ * @brief 是否开启事件追踪 (记录 API 调用及事件分发)，关闭时追踪宏展开为空
+ */
+#if !defined(XF_BLE_TRACE_ENABLE)
+#define XF_BLE_TRACE_ENABLE                     (0)
+#endif
+
+/**
+ * @brief 事件追踪环形缓冲区可保存的记录数，需为 2 的幂，写满后覆盖最旧的记录
+ */
+#if !defined(XF_BLE_TRACE_DEPTH)
+#define XF_BLE_TRACE_DEPTH                      (256)
+#endif
+
+/**
+ * @brief 事件追踪记录的时间戳 (uint32_t)，默认为微秒，
+ *  可定义为平台的周期计数器 (如 DWT->CYCCNT) 以降低开销，此时转换工具需指定计数频率
+ */
+#if !defined(XF_BLE_TRACE_TIMESTAMP)
+#define XF_BLE_TRACE_TIMESTAMP()                ((uint32_t)xf_sys_time_get_us())
+#endif
+
+/**
+ * @brief 是否开启往返时延统计 (连接、搜寻、读、写、指示)，关闭时统计宏展开为空
+ */
+#if !defined(XF_BLE_LATENCY_ENABLE)
+#define XF_BLE_LATENCY_ENABLE                   (0)
+#endif
+
+/**
+ * @brief 往返时延统计的对端数量，每个对端每种操作一个直方图
+ *  (约 (4 + 4 * 30) * 4 字节，见 XF_BLE_LATENCY_SUB_BITS)；需不小于同时连接数，
+ *  不足时回收最久未使用的已断开对端
+ */
+#if !defined(XF_BLE_LATENCY_CONN_MAX)
+#define XF_BLE_LATENCY_CONN_MAX                 (4)
+#endif
+
+/**
+ * @brief 往返时延直方图每个 2 的幂区间内的线性子区间数量的位数，
+ *  子区间越多精度越高 (相对误差约 2^-SUB_BITS)，占用内存也越多
+ */
+#if !defined(XF_BLE_LATENCY_SUB_BITS)
+#define XF_BLE_LATENCY_SUB_BITS                 (2)
+#endif
+
+/**
+ * @brief 往返时延统计可同时等待完成的操作数量，已满时丢弃最早的操作
+ */
+#if !defined(XF_BLE_LATENCY_PENDING_MAX)
+#define XF_BLE_LATENCY_PENDING_MAX              (8)
+#endif
+
+/**
+ * @brief 连接状态表的大小，以连接 ID 为下标直接索引，需大于平台可能分配的最大连接 ID (不超过 32)
+ */
+#if !defined(XF_BLE_CONN_TABLE_SIZE)
+#define XF_BLE_CONN_TABLE_SIZE                  (8)
+#endif
+
+/**
+ * @brief 是否由 utils 提供应用与广播、连接关联接口的参考实现 (xf_ble_app_attach_conn() 等)，
+ *  开启后平台侧不应再实现这些接口
+ */
+#if !defined(XF_BLE_APP_ASSOC_ENABLE)
+#define XF_BLE_APP_ASSOC_ENABLE                 (0)
+#endif
+
+/**
+ * @brief 应用关联表的应用 ID 上限 (有效应用 ID 为 [1, XF_BLE_APP_ASSOC_APP_NUM) )
+ */
+#if !defined(XF_BLE_APP_ASSOC_APP_NUM)
+#define XF_BLE_APP_ASSOC_APP_NUM                (8)
+#endif
+
+/**
+ * @brief 应用关联表的广播 ID 上限 (有效广播 ID 为 [0, XF_BLE_APP_ASSOC_ADV_NUM) ，不超过 32)
+ */
+#if !defined(XF_BLE_APP_ASSOC_ADV_NUM)
+#define XF_BLE_APP_ASSOC_ADV_NUM                (4)
+#endif
+
+/**
+ * @brief 应用关联表的连接 ID 上限 (有效连接 ID 为 [0, XF_BLE_APP_ASSOC_CONN_NUM) ，不超过 32)
+ */
+#if !defined(XF_BLE_APP_ASSOC_CONN_NUM)
+#define XF_BLE_APP_ASSOC_CONN_NUM               XF_BLE_CONN_TABLE_SIZE
+#endif
+
+/**
+ * @brief 自适应连接参数管理的连接 ID 上限 (以连接 ID 直接索引)
+ */
+#if !defined(XF_BLE_CONN_PARAM_MGR_CONN_NUM)
+#define XF_BLE_CONN_PARAM_MGR_CONN_NUM          XF_BLE_CONN_TABLE_SIZE
+#endif
+
+/**
+ * @brief 自适应连接参数管理统计收发速率的窗口长度，单位 ms
+ */
+#if !defined(XF_BLE_CONN_PARAM_MGR_WINDOW_MS)
+#define XF_BLE_CONN_PARAM_MGR_WINDOW_MS         (250)
+#endif
+
+/**
+ * @brief 自适应连接参数管理等待对端响应参数更新的超时时间，单位 ms ，超时视为被拒绝
+ */
+#if !defined(XF_BLE_CONN_PARAM_MGR_RSP_TIMEOUT_MS)
+#define XF_BLE_CONN_PARAM_MGR_RSP_TIMEOUT_MS    (5000)
+#endif
+
+/**
+ * @brief 最大吞吐量协商的连接 ID 上限 (以连接 ID 直接索引)
+ */
+#if !defined(XF_BLE_TPUT_CONN_NUM)
+#define XF_BLE_TPUT_CONN_NUM                    XF_BLE_CONN_TABLE_SIZE
+#endif
+
+/**
+ * @brief 最大吞吐量协商的超时时间，单位 ms
+ */
+#if !defined(XF_BLE_TPUT_TIMEOUT_MS)
+#define XF_BLE_TPUT_TIMEOUT_MS                  (5000)
+#endif
+
+/**
+ * @brief 连接管理的目标对端数量上限
+ */
+#if !defined(XF_BLE_CONN_MGR_PEER_NUM)
+#define XF_BLE_CONN_MGR_PEER_NUM                (8)
+#endif
+
+/**
+ * @brief 连接管理单次连接尝试的超时时间，单位 ms
+ */
+#if !defined(XF_BLE_CONN_MGR_CONNECT_TIMEOUT_MS)
+#define XF_BLE_CONN_MGR_CONNECT_TIMEOUT_MS      (5000)
+#endif
+
+/**
+ * @brief 连接管理的最小退避时间，单位 ms (第 n 次连续失败退避 MIN * 2^(n-1) ，另加至多一半的随机抖动)
+ */
+#if !defined(XF_BLE_CONN_MGR_BACKOFF_MIN_MS)
+#define XF_BLE_CONN_MGR_BACKOFF_MIN_MS          (500)
+#endif
+
+/**
+ * @brief 连接管理的最大退避时间，单位 ms (连接维持超过该时间后的断连不计为连续失败)
+ */
+#if !defined(XF_BLE_CONN_MGR_BACKOFF_MAX_MS)
+#define XF_BLE_CONN_MGR_BACKOFF_MAX_MS          (30000)
+#endif
+
+/**
+ * @brief 过滤列表管理的过滤接受列表 (白名单) 容量 (不应超过控制器容量)
+ */
+#if !defined(XF_BLE_FILTER_LIST_ACCEPT_NUM)
+#define XF_BLE_FILTER_LIST_ACCEPT_NUM           (16)
+#endif
+
+/**
+ * @brief 过滤列表管理的解析列表容量 (不应超过控制器容量)
+ */
+#if !defined(XF_BLE_FILTER_LIST_RESOLVING_NUM)
+#define XF_BLE_FILTER_LIST_RESOLVING_NUM        (8)
+#endif
+
+/**
+ * @brief 过滤列表管理可跟踪的广播 ID 上限 (以广播 ID 直接索引，最大 32)
+ */
+#if !defined(XF_BLE_FILTER_LIST_ADV_NUM)
+#define XF_BLE_FILTER_LIST_ADV_NUM              (4)
+#endif
+
+/**
+ * @brief 绑定信息存储的绑定数量上限 (每个绑定仅在内存中占用一个索引项)
+ */
+#if !defined(XF_BLE_BOND_STORE_BOND_NUM)
+#define XF_BLE_BOND_STORE_BOND_NUM              (64)
+#endif
+
+/**
+ * @brief 绑定信息存储中每个绑定可保存的 CCCD 数量上限
+ */
+#if !defined(XF_BLE_BOND_STORE_CCCD_NUM)
+#define XF_BLE_BOND_STORE_CCCD_NUM              (8)
+#endif
+
+/**
+ * @brief 绑定信息存储的后端写入对齐 (字节)，即 flash 最小写入单位
+ */
+#if !defined(XF_BLE_BOND_STORE_WRITE_ALIGN)
+#define XF_BLE_BOND_STORE_WRITE_ALIGN           (4)
+#endif
+
+/**
+ * @brief RPA 解析可添加的对端 IRK 数量上限 (不超过 254)，每个 IRK 占用约 180 字节 (预先展开的轮密钥)
+ */
+#if !defined(XF_BLE_RPA_IRK_NUM)
+#define XF_BLE_RPA_IRK_NUM                      (16)
+#endif
+
+/**
+ * @brief RPA 解析结果的 LRU 缓存容量
+ */
+#if !defined(XF_BLE_RPA_CACHE_NUM)
+#define XF_BLE_RPA_CACHE_NUM                    (16)
+#endif
+
+/**
+ * @brief RPA 解析: 是否提供性能测试 xf_ble_rpa_bench() (IRK 数量受 XF_BLE_RPA_IRK_NUM 限制)
+ */
+#if !defined(XF_BLE_RPA_BENCH_ENABLE)
+#define XF_BLE_RPA_BENCH_ENABLE                 (0)
+#endif
+
+/**
+ * @brief 本端隐私 (RPA 轮换) 可管理的广播数量上限 (每个广播使用独立的 RPA)
+ */
+#if !defined(XF_BLE_PRIVACY_ADV_NUM)
+#define XF_BLE_PRIVACY_ADV_NUM                  (4)
+#endif
+
+/**
+ * @brief BLE AES-128 (RPA 解析、本端隐私及 SM 加密工具箱共用): 使用 AES-NI 指令实现
+ *  (仅 x86 ，需以 -maes 编译)，否则使用常数时间的位切片软件实现
+ */
+#if !defined(XF_BLE_AES_AESNI_ENABLE)
+#if defined(__AES__) && (defined(__x86_64__) || defined(__i386__))
+#define XF_BLE_AES_AESNI_ENABLE                 (1)
+#else
+#define XF_BLE_AES_AESNI_ENABLE                 (0)
+#endif
+#endif
+
+/**
+ * @brief BLE 加密工具箱: 是否提供性能测试 xf_ble_crypto_bench()
+ */
+#if !defined(XF_BLE_CRYPTO_BENCH_ENABLE)
+#define XF_BLE_CRYPTO_BENCH_ENABLE              (0)
+#endif
+
 /* ==================== [Typedefs] ========================================== */
 
 /* ==================== [Global Prototypes] ================================= */
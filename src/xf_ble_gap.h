@@ -81,6 +81,19 @@ xf_err_t xf_ble_gap_set_local_addr(xf_ble_addr_t *addr);
  */
 xf_err_t xf_ble_gap_get_local_addr(xf_ble_addr_t *addr);
 
+/**
+ * @brief BLE GAP 获取随机数 (由控制器或平台的随机数源提供，如 LE Rand)
+ *
+ * @param[out] buf 随机数
+ * @param len 长度 (字节)
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_SUPPORTED  平台不支持
+ *      - XF_FAIL               失败
+ *      - (OTHER)               @ref xf_err_t
+ */
+xf_err_t xf_ble_gap_get_rand(uint8_t *buf, uint8_t len);
+
 /**
  * @brief BLE GAP 设置本端设备的外观
  *
@@ -190,6 +203,21 @@ xf_err_t xf_ble_gap_stop_adv(xf_ble_adv_id_t adv_id);
 xf_err_t xf_ble_gap_set_adv_data(
     xf_ble_adv_id_t adv_id, const xf_ble_gap_adv_data_t *data);
 
+/**
+ * @brief BLE GAP 设置广播使用的本端随机地址 (LE Set Advertising Set Random Address)
+ *
+ * @param adv_id 广播 ID，见 @ref xf_ble_adv_id_t
+ * @param addr 随机地址，见 @ref xf_ble_addr_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_SUPPORTED  平台不支持
+ *      - XF_FAIL               失败
+ *      - (OTHER)               @ref xf_err_t
+ *
+ * @note 广播开启中也可设置，控制器自下一个广播事件起使用新地址，广播不中断
+ */
+xf_err_t xf_ble_gap_set_adv_addr(xf_ble_adv_id_t adv_id, const xf_ble_addr_t *addr);
+
 /**
  * @brief BLE GAP 扫描开启
  *
@@ -224,6 +252,41 @@ xf_err_t xf_ble_gap_stop_scan(void);
 xf_err_t xf_ble_gap_update_conn_param(
     xf_ble_conn_id_t conn_id, xf_ble_gap_conn_param_update_t *param);
 
+/**
+ * @brief BLE GAP 设置连接的 PHY (发起 PHY 更新)
+ *
+ * @param conn_id 连接 (链接) ID，见 @ref xf_ble_conn_id_t
+ * @param tx_phys 发送 PHY 偏好，见 @ref xf_ble_gap_phy_mask_t ，可组合
+ * @param rx_phys 接收 PHY 偏好，见 @ref xf_ble_gap_phy_mask_t ，可组合
+ * @param coded_opts Coded PHY 编码偏好，见 @ref xf_ble_gap_phy_coded_opt_t
+ * @return xf_err_t
+ *      - XF_OK                 成功 (更新结果见 XF_BLE_GAP_EVT_PHY_UPDATE 事件)
+ *      - XF_ERR_NOT_SUPPORTED  平台不支持
+ *      - XF_FAIL               失败
+ *      - (OTHER)               @ref xf_err_t
+ */
+xf_err_t xf_ble_gap_set_phy(
+    xf_ble_conn_id_t conn_id,
+    xf_ble_gap_phy_mask_t tx_phys, xf_ble_gap_phy_mask_t rx_phys,
+    xf_ble_gap_phy_coded_opt_t coded_opts);
+
+/**
+ * @brief BLE GAP 设置连接的数据长度 (数据长度扩展 DLE)
+ *
+ * @param conn_id 连接 (链接) ID，见 @ref xf_ble_conn_id_t
+ * @param tx_octets 单包发送的最大有效载荷，范围：
+ *  [XF_BLE_GAP_DATA_LEN_TX_OCTETS_MIN, XF_BLE_GAP_DATA_LEN_TX_OCTETS_MAX]
+ * @param tx_time 单包发送的最大时间 (us)，范围：
+ *  [XF_BLE_GAP_DATA_LEN_TX_TIME_MIN, XF_BLE_GAP_DATA_LEN_TX_TIME_MAX]
+ * @return xf_err_t
+ *      - XF_OK                 成功 (协商结果见 XF_BLE_GAP_EVT_DATA_LEN_CHANGE 事件)
+ *      - XF_ERR_NOT_SUPPORTED  平台不支持
+ *      - XF_FAIL               失败
+ *      - (OTHER)               @ref xf_err_t
+ */
+xf_err_t xf_ble_gap_set_data_len(
+    xf_ble_conn_id_t conn_id, uint16_t tx_octets, uint16_t tx_time);
+
 /**
  * @brief BLE GAP 发起连接
  *
@@ -235,6 +298,17 @@ xf_err_t xf_ble_gap_update_conn_param(
  */
 xf_err_t xf_ble_gap_connect(const xf_ble_addr_t *addr);
 
+/**
+ * @brief BLE GAP 取消正在进行的连接 (LE Create Connection Cancel)
+ *
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_SUPPORTED  平台不支持
+ *      - XF_FAIL               失败
+ *      - (OTHER)               @ref xf_err_t
+ */
+xf_err_t xf_ble_gap_cancel_connect(void);
+
 /**
  * @brief BLE GAP 断开连接
  *
@@ -246,6 +320,91 @@ xf_err_t xf_ble_gap_connect(const xf_ble_addr_t *addr);
  */
 xf_err_t xf_ble_gap_disconnect(const xf_ble_addr_t *addr);
 
+/**
+ * @brief BLE GAP 以过滤接受列表 (白名单) 发起连接 (发起者过滤策略: 使用过滤接受列表)，
+ *  连接列表中任一设备后结束，可由 xf_ble_gap_cancel_connect() 取消
+ *
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NOT_SUPPORTED  平台不支持
+ *      - XF_FAIL               失败
+ *      - (OTHER)               @ref xf_err_t
+ */
+xf_err_t xf_ble_gap_connect_by_accept_list(void);
+
+/**
+ * @brief BLE GAP 添加设备到过滤接受列表 (白名单)
+ *
+ * @note 控制器正在以过滤接受列表广播、扫描或发起连接时不允许修改，
+ *  可使用 xf_ble_filter_list 模块自动暂停及恢复
+ * @param addr 设备地址，见 @ref xf_ble_addr_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NO_MEM         列表已满
+ *      - XF_FAIL               失败
+ *      - (OTHER)               @ref xf_err_t
+ */
+xf_err_t xf_ble_gap_add_accept_list(const xf_ble_addr_t *addr);
+
+/**
+ * @brief BLE GAP 从过滤接受列表 (白名单) 删除设备
+ *
+ * @param addr 设备地址，见 @ref xf_ble_addr_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - (OTHER)               @ref xf_err_t
+ */
+xf_err_t xf_ble_gap_del_accept_list(const xf_ble_addr_t *addr);
+
+/**
+ * @brief BLE GAP 清空过滤接受列表 (白名单)
+ *
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - (OTHER)               @ref xf_err_t
+ */
+xf_err_t xf_ble_gap_clear_accept_list(void);
+
+/**
+ * @brief BLE GAP 添加设备到解析列表 (用于控制器解析对端可解析私有地址)
+ *
+ * @note 地址解析使能时，控制器正在广播、扫描或发起连接时不允许修改
+ * @param id_addr 对端身份地址，见 @ref xf_ble_addr_t
+ * @param peer_irk 对端 IRK ，见 @ref xf_ble_sm_irk_t
+ * @param local_irk 本端 IRK ，见 @ref xf_ble_sm_irk_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_NO_MEM         列表已满
+ *      - XF_FAIL               失败
+ *      - (OTHER)               @ref xf_err_t
+ */
+xf_err_t xf_ble_gap_add_resolving_list(const xf_ble_addr_t *id_addr,
+                                       const xf_ble_sm_irk_t *peer_irk,
+                                       const xf_ble_sm_irk_t *local_irk);
+
+/**
+ * @brief BLE GAP 从解析列表删除设备
+ *
+ * @param id_addr 对端身份地址，见 @ref xf_ble_addr_t
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - (OTHER)               @ref xf_err_t
+ */
+xf_err_t xf_ble_gap_del_resolving_list(const xf_ble_addr_t *id_addr);
+
+/**
+ * @brief BLE GAP 清空解析列表
+ *
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_FAIL               失败
+ *      - (OTHER)               @ref xf_err_t
+ */
+xf_err_t xf_ble_gap_clear_resolving_list(void);
+
 /**
  * @brief BLE GAP 添加配对
  *
@@ -248,6 +248,38 @@ enum _xf_ble_gap_phy_type_t {
     XF_BLE_GAP_PHY_CODED        = 0x03,     /*!< Coded PHY */
 };
 
+/**
+ * @brief BLE GAP PHY 偏好 (位掩码，可组合)
+ *
+ * @see 蓝牙核心文档 《Core_v5.4》>> Vol 4, Part E >> 7.8.49 LE Set PHY command
+ */
+typedef uint8_t xf_ble_gap_phy_mask_t;
+enum _xf_ble_gap_phy_mask_t {
+    XF_BLE_GAP_PHY_MASK_1M      = 0x01,     /*!< 1M PHY */
+    XF_BLE_GAP_PHY_MASK_2M      = 0x02,     /*!< 2M PHY */
+    XF_BLE_GAP_PHY_MASK_CODED   = 0x04,     /*!< Coded PHY */
+};
+
+/**
+ * @brief BLE GAP Coded PHY 编码偏好
+ */
+typedef uint8_t xf_ble_gap_phy_coded_opt_t;
+enum _xf_ble_gap_phy_coded_opt_t {
+    XF_BLE_GAP_PHY_CODED_OPT_NONE   = 0x00, /*!< 无偏好 */
+    XF_BLE_GAP_PHY_CODED_OPT_S2     = 0x01, /*!< 偏好 S=2 编码 */
+    XF_BLE_GAP_PHY_CODED_OPT_S8     = 0x02, /*!< 偏好 S=8 编码 */
+};
+
+/**
+ * @brief BLE GAP 数据长度扩展 (DLE) 的取值范围
+ *
+ * @see 蓝牙核心文档 《Core_v5.4》>> Vol 4, Part E >> 7.8.33 LE Set Data Length command
+ */
+#define XF_BLE_GAP_DATA_LEN_TX_OCTETS_MIN   (27)        /*!< 单包最大有效载荷的最小值 (字节) */
+#define XF_BLE_GAP_DATA_LEN_TX_OCTETS_MAX   (251)       /*!< 单包最大有效载荷的最大值 (字节) */
+#define XF_BLE_GAP_DATA_LEN_TX_TIME_MIN     (328)       /*!< 单包最大发送时间的最小值 (us) */
+#define XF_BLE_GAP_DATA_LEN_TX_TIME_MAX     (17040)     /*!< 单包最大发送时间的最大值 (us) */
+
 /**
  * @brief BLE GAP 广播参数
  */
@@ -452,6 +484,9 @@ typedef struct {
     xf_ble_gap_scanned_adv_type_t type;         /*!< 扫到的设备广播类型，见 @ref xf_ble_gap_scanned_adv_type_t */
     uint16_t adv_data_len;                       /*!< 广播数据的长度 (指整个广播数据 AdvData ) */
     uint8_t *adv_data;                          /*!< 广播数据 (指整个广播数据 AdvData ) */
+#if XF_BLE_EVT_PBUF_ENABLE || defined(__DOXYGEN__)
+    xf_ble_pbuf_t *pbuf;                        /*!< 广播数据所在的缓冲区 (可为 NULL)，见 @ref xf_ble_pbuf_t */
+#endif
 } xf_ble_gap_evt_param_scan_result_t;
 
 /**
@@ -464,6 +499,27 @@ typedef struct {
     uint16_t timeout;                           /*!< 链接超时 (断连) 时间 */
 } xf_ble_gap_evt_conn_param_upd_t;
 
+/**
+ * @brief BLE PHY 更新事件的参数
+ */
+typedef struct {
+    xf_ble_conn_id_t conn_id;                   /*!< 链接 (连接) ID */
+    xf_err_t status;                            /*!< 更新结果， XF_OK 表示成功 */
+    xf_ble_gap_phy_type_t tx_phy;               /*!< 当前发送 PHY，见 @ref xf_ble_gap_phy_type_t */
+    xf_ble_gap_phy_type_t rx_phy;               /*!< 当前接收 PHY，见 @ref xf_ble_gap_phy_type_t */
+} xf_ble_gap_evt_param_phy_update_t;
+
+/**
+ * @brief BLE 数据长度变化事件的参数
+ */
+typedef struct {
+    xf_ble_conn_id_t conn_id;                   /*!< 链接 (连接) ID */
+    uint16_t max_tx_octets;                     /*!< 单包发送的最大有效载荷 (字节) */
+    uint16_t max_tx_time;                       /*!< 单包发送的最大时间 (us) */
+    uint16_t max_rx_octets;                     /*!< 单包接收的最大有效载荷 (字节) */
+    uint16_t max_rx_time;                       /*!< 单包接收的最大时间 (us) */
+} xf_ble_gap_evt_param_data_len_change_t;
+
 /**
  * @brief BLE GAP 事件回调参数
  */
@@ -510,6 +566,15 @@ typedef union {
                                                  *  @ref xf_ble_gap_evt_param_pair_end_t
                                                  *  XF_BLE_GAP_EVT_PAIR_END
                                                  */
+    xf_ble_gap_evt_param_phy_update_t phy_upd;  /*!< PHY 更新事件的参数，
+                                                 *  @ref xf_ble_gap_evt_param_phy_update_t
+                                                 *  XF_BLE_GAP_EVT_PHY_UPDATE
+                                                 */
+    xf_ble_gap_evt_param_data_len_change_t data_len;
+                                                /*!< 数据长度变化事件的参数，
+                                                 *  @ref xf_ble_gap_evt_param_data_len_change_t
+                                                 *  XF_BLE_GAP_EVT_DATA_LEN_CHANGE
+                                                 */
 } xf_ble_gap_evt_cb_param_t;
 
 /**
@@ -531,6 +596,8 @@ enum _xf_ble_gap_evt_t {
     XF_BLE_GAP_EVT_PAIR_OOB_REQ,               
     XF_BLE_GAP_EVT_PAIR_END,                    /*!< 配对结束事件 */
     XF_BLE_GAP_EVT_CONN_PARAM_UPDATE,           /*!< 连接参数更新事件 */
+    XF_BLE_GAP_EVT_PHY_UPDATE,                  /*!< PHY 更新事件 */
+    XF_BLE_GAP_EVT_DATA_LEN_CHANGE,             /*!< 数据长度变化事件 */
     _XF_BLE_GAP_EVT_MAX,                        /*!< BLE GAP 事件枚举结束值 */
 };
 
@@ -127,6 +127,9 @@ typedef struct {
     xf_ble_attr_handle_t handle; /*!< 特征值或描述符的句柄 */
     uint8_t *value;              /*!< 属性值 */
     uint16_t value_len;          /*!< 属性值长度 */
+#if XF_BLE_EVT_PBUF_ENABLE || defined(__DOXYGEN__)
+    xf_ble_pbuf_t *pbuf;         /*!< 属性值所在的缓冲区 (可为 NULL)，见 @ref xf_ble_pbuf_t */
+#endif
 } xf_ble_gattc_evt_param_read_cfm_t;
 
 /**
@@ -139,8 +142,23 @@ typedef struct {
     xf_ble_attr_handle_t handle; /*!< 特征值或描述符的句柄 */
     uint16_t value_len;          /*!< 通知或指示的属性值长度 */
     uint8_t *value;              /*!< 通知或指示的属性值 */
+#if XF_BLE_EVT_PBUF_ENABLE || defined(__DOXYGEN__)
+    xf_ble_pbuf_t *pbuf;         /*!< 属性值所在的缓冲区 (可为 NULL)，见 @ref xf_ble_pbuf_t */
+#endif
 } xf_ble_gattc_evt_param_ntf_t, xf_ble_gattc_evt_param_ind_t;
 
+/**
+ * @brief BLE GATTC 数据包发送完成事件的参数
+ *
+ * @note 由平台侧在控制器释放发送缓冲 (如 HCI Number Of Completed Packets) 时上报，
+ *  主要用于写命令 (无需响应) 等无确认数据的流量控制
+ */
+typedef struct {
+    xf_ble_app_id_t app_id;   /*!< 应用 ID */
+    xf_ble_conn_id_t conn_id; /*!< 链接(连接) ID */
+    uint16_t num_pkts;        /*!< 本次发送完成 (已释放缓冲) 的数据包个数 */
+} xf_ble_gattc_evt_param_tx_complete_t;
+
 /**
  * @brief BLE GATTC 客户端事件回调参数
  */
@@ -166,6 +184,11 @@ typedef union {
                                         *  @ref xf_ble_gattc_evt_param_ind_t
                                         *  XF_BLE_GATTC_EVT_INDICATION
                                         */
+    xf_ble_gattc_evt_param_tx_complete_t tx_complete;
+    /*!< 数据包发送完成事件的参数，
+        *  @ref xf_ble_gattc_evt_param_tx_complete_t
+        *  XF_BLE_GATTC_EVT_TX_COMPLETE
+        */
 } xf_ble_gattc_evt_cb_param_t;
 
 /**
@@ -178,6 +201,7 @@ enum _xf_ble_gattc_evt_t {
     XF_BLE_GATTC_EVT_READ_CFM,     /*!< 读确认事件 */
     XF_BLE_GATTC_EVT_NOTIFICATION, /*!< 收到通知事件 */
     XF_BLE_GATTC_EVT_INDICATION,   /*!< 收到指示事件 */
+    XF_BLE_GATTC_EVT_TX_COMPLETE,  /*!< 数据包发送完成事件 */
     _XF_BLE_GATTC_EVT_MAX,         /*!< BLE GATTC 事件枚举结束值 */
 };
 
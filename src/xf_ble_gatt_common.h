@@ -41,6 +41,23 @@ extern "C" {
 
 /* ==================== [Defines] =========================================== */
 
+/**
+ * @brief BLE GATT 客户端特征配置描述符 (CCCD) 的 16-bit UUID
+ */
+#define XF_BLE_GATT_UUID16_CCCD                 (0x2902)
+
+/**
+ * @brief BLE GATT 客户端特征配置描述符 (CCCD) 的值
+ */
+#define XF_BLE_GATT_CCCD_VALUE_NONE             (0x0000)    /*!< 关闭通知及指示 */
+#define XF_BLE_GATT_CCCD_VALUE_NOTIFY           (0x0001)    /*!< 开启通知 */
+#define XF_BLE_GATT_CCCD_VALUE_INDICATE         (0x0002)    /*!< 开启指示 */
+
+/**
+ * @brief BLE GATT 服务变更 (Service Changed) 特征的 16-bit UUID
+ */
+#define XF_BLE_GATT_UUID16_SERVICE_CHANGED      (0x2A05)
+
 /* ==================== [Typedefs] ========================================== */
 
 /**
@@ -210,8 +210,23 @@ typedef struct {
     bool is_prep;                               /*!< 是否是 prepare write 操作 */
     uint16_t value_len;                         /*!< 属性值长度 */
     uint8_t *value;                             /*!< 属性值 */
+#if XF_BLE_EVT_PBUF_ENABLE || defined(__DOXYGEN__)
+    xf_ble_pbuf_t *pbuf;                        /*!< 属性值所在的缓冲区 (可为 NULL)，见 @ref xf_ble_pbuf_t */
+#endif
 } xf_ble_gatts_evt_param_write_req_t;
 
+/**
+ * @brief BLE GATTS 指示确认事件的参数
+ *
+ * @note 由平台侧在收到对端对指示的确认 (Handle Value Confirmation) 或指示超时时上报
+ */
+typedef struct {
+    xf_ble_app_id_t app_id;                     /*!< 服务端 (应用) ID */
+    xf_ble_conn_id_t conn_id;                   /*!< 链接 (连接) ID */
+    xf_ble_attr_handle_t handle;                /*!< 指示的属性句柄 */
+    xf_err_t status;                            /*!< XF_OK: 已确认；其他: 失败或超时 */
+} xf_ble_gatts_evt_param_ind_cfm_t;
+
 /**
  * @brief BLE GATTS 发送通知或指示的信息
  */
@@ -255,6 +270,11 @@ typedef union {
      *  @ref xf_ble_gatts_evt_param_write_req_t
      *  XF_BLE_GATTS_EVT_WRITE_REQ
      */
+    xf_ble_gatts_evt_param_ind_cfm_t ind_cfm;
+    /*!< 指示确认事件的参数，
+     *  @ref xf_ble_gatts_evt_param_ind_cfm_t
+     *  XF_BLE_GATTS_EVT_IND_CFM
+     */
 } xf_ble_gatts_evt_cb_param_t;
 
 /**
@@ -266,6 +286,7 @@ enum _xf_ble_gatts_evt_t {
     XF_BLE_GATTS_EVT_EXCHANGE_MTU,              /*!< MTU 协商事件 */
     XF_BLE_GATTS_EVT_READ_REQ,                  /*!< 接收到读请求事件 */
     XF_BLE_GATTS_EVT_WRITE_REQ,                 /*!< 接收到写请求事件 */
+    XF_BLE_GATTS_EVT_IND_CFM,                   /*!< 指示确认事件 */
     _XF_BLE_GATTS_EVT_MAX,                      /*!< BLE GATTS 事件枚举结束值 */
 };
 
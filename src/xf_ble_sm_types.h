@@ -276,6 +276,13 @@ typedef struct _xf_ble_sm_csrk_t {
     uint8_t tk[XF_BLE_SM_KEY_SIZE_MAX];
 } xf_ble_sm_csrk_t;
 
+/**
+ * @brief BLE SM 身份解析密钥 (IRK)
+ */
+typedef struct _xf_ble_sm_irk_t {
+    uint8_t irk[XF_BLE_SM_KEY_SIZE_MAX];    /*!< 密钥值 (MSB 在前) */
+} xf_ble_sm_irk_t;
+
 /**
  * @brief BLE SM 配对特性类型
  */
@@ -244,6 +244,20 @@ typedef union _xf_ble_var_uintptr_t {
     uint32_t    array_u32[sizeof(uintptr_t) / sizeof(uint32_t)];
 } xf_ble_var_uintptr_t;
 
+/**
+ * @brief BLE 数据包缓冲区 (带引用计数)
+ *
+ * @note 对接层可直接将控制器收到的数据填入其中，并通过事件参数中的 pbuf 成员传出，
+ *  事件处理函数调用 xf_ble_pbuf_take() 即可在回调结束后继续持有数据而无需拷贝；
+ *  事件参数中的 pbuf 成员仅在 XF_BLE_EVT_PBUF_ENABLE 开启时存在
+ */
+typedef struct _xf_ble_pbuf_t {
+    uint8_t *payload;                       /*!< 数据 */
+    uint16_t len;                           /*!< 数据长度 */
+    uint16_t size;                          /*!< 数据容量 */
+    uint16_t ref;                           /*!< 引用计数 */
+} xf_ble_pbuf_t;
+
 #define XF_BLE_EVT_ALL       (UINT8_MAX)    /*!< 所有事件 */
 
 /* ==================== [Global Prototypes] ================================= */
@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+xf_ble 事件追踪转换工具。
+
+将 xf_ble_trace_dump() 导出的二进制追踪数据转换为 Chrome / Perfetto 追踪格式 (JSON)，
+可在 chrome://tracing 或 https://ui.perfetto.dev 中打开。
+
+用法:
+    python3 xf_ble_trace2json.py trace.bin -o trace.json
+    python3 xf_ble_trace2json.py trace.bin --ts-hz 64000000   # 时间戳为 64 MHz 周期计数时
+
+注意: API_NAMES 等名称表需与 xf_ble_trace.h 及各事件枚举保持一致。
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+TRACE_MAGIC = 0x54424658
+HEADER_FMT = "<IBBH"
+RECORD_FMT = "<IBBHBBHi"
+
+KIND_API_ENTER = 0
+KIND_API_EXIT = 1
+KIND_EVT_ENTER = 2
+KIND_EVT_EXIT = 3
+KIND_EVT_QUEUE = 4
+KIND_USER = 5
+
+MODULE_API = 0
+MODULE_GAP = 1
+MODULE_GATTS = 2
+MODULE_GATTC = 3
+MODULE_USER = 4
+
+MODULE_NAMES = {
+    MODULE_API: "api",
+    MODULE_GAP: "gap",
+    MODULE_GATTS: "gatts",
+    MODULE_GATTC: "gattc",
+    MODULE_USER: "user",
+}
+
+CONN_ID_NONE = 0xFF
+
+API_NAMES = {
+    1: 'xf_ble_enable',
+    2: 'xf_ble_disable',
+    3: 'xf_ble_gap_set_local_addr',
+    4: 'xf_ble_gap_get_local_addr',
+    5: 'xf_ble_gap_set_local_appearance',
+    6: 'xf_ble_gap_get_local_appearance',
+    7: 'xf_ble_gap_set_local_name',
+    8: 'xf_ble_gap_get_local_name',
+    9: 'xf_ble_gap_create_adv',
+    10: 'xf_ble_gap_delete_adv',
+    11: 'xf_ble_gap_start_adv',
+    12: 'xf_ble_gap_stop_adv',
+    13: 'xf_ble_gap_set_adv_data',
+    14: 'xf_ble_gap_start_scan',
+    15: 'xf_ble_gap_stop_scan',
+    16: 'xf_ble_gap_update_conn_param',
+    17: 'xf_ble_gap_connect',
+    18: 'xf_ble_gap_disconnect',
+    19: 'xf_ble_gap_add_pair',
+    20: 'xf_ble_gap_del_pair',
+    21: 'xf_ble_gap_del_pair_all',
+    22: 'xf_ble_gap_get_pair_list',
+    23: 'xf_ble_gap_get_bond_list',
+    24: 'xf_ble_gap_set_pair_feature',
+    25: 'xf_ble_gap_request_pair',
+    26: 'xf_ble_gap_respond_pair',
+    27: 'xf_ble_gap_pair_exchange_passkey',
+    28: 'xf_ble_app_attach_adv',
+    29: 'xf_ble_app_attach_conn',
+    30: 'xf_ble_app_detach_adv',
+    31: 'xf_ble_app_detach_conn',
+    32: 'xf_ble_gatts_app_register',
+    33: 'xf_ble_gatts_app_unregister',
+    34: 'xf_ble_gatts_add_service',
+    35: 'xf_ble_gatts_start_service',
+    36: 'xf_ble_gatts_stop_service',
+    37: 'xf_ble_gatts_del_services_all',
+    38: 'xf_ble_gatts_send_notification',
+    39: 'xf_ble_gatts_send_indication',
+    40: 'xf_ble_gatts_send_read_rsp',
+    41: 'xf_ble_gatts_send_write_rsp',
+    42: 'xf_ble_gattc_app_register',
+    43: 'xf_ble_gattc_app_unregister',
+    44: 'xf_ble_gattc_discover_service',
+    45: 'xf_ble_gattc_discover_chara',
+    46: 'xf_ble_gattc_request_read_by_handle',
+    47: 'xf_ble_gattc_request_read_by_uuid',
+    48: 'xf_ble_gattc_request_write',
+    49: 'xf_ble_gattc_request_exchange_mtu',
+    50: 'xf_ble_gap_set_phy',
+    51: 'xf_ble_gap_set_data_len',
+    52: 'xf_ble_gap_cancel_connect',
+    53: 'xf_ble_gap_connect_by_accept_list',
+    54: 'xf_ble_gap_add_accept_list',
+    55: 'xf_ble_gap_del_accept_list',
+    56: 'xf_ble_gap_clear_accept_list',
+    57: 'xf_ble_gap_add_resolving_list',
+    58: 'xf_ble_gap_del_resolving_list',
+    59: 'xf_ble_gap_clear_resolving_list',
+    60: 'xf_ble_gap_get_rand',
+    61: 'xf_ble_gap_set_adv_addr',
+}
+
+EVT_NAMES = {
+    MODULE_GAP: [
+        "CONNECT_REQ", "CONNECT", "DISCONNECT", "SCAN_RESULT", "SECURITY_REQ",
+        "PAIR_REQ", "PAIR_JUST_WORKS", "PAIR_PASSKEY_REQ", "PAIR_PASSKEY_ENTRY",
+        "PAIR_NUM_CMP", "PAIR_OOB_REQ", "PAIR_END", "CONN_PARAM_UPDATE",
+        "PHY_UPDATE", "DATA_LEN_CHANGE",
+    ],
+    MODULE_GATTS: [
+        "EXCHANGE_MTU", "READ_REQ", "WRITE_REQ", "IND_CFM",
+    ],
+    MODULE_GATTC: [
+        "EXCHANGE_MTU", "WRITE_CFM", "READ_CFM", "NOTIFICATION", "INDICATION",
+        "TX_COMPLETE",
+    ],
+}
+
+
+def record_name(module, rid):
+    if module == MODULE_API:
+        if rid >= 0x8000:
+            return "user_api_%d" % (rid - 0x8000)
+        return API_NAMES.get(rid, "api_%d" % rid)
+    if module in EVT_NAMES:
+        names = EVT_NAMES[module]
+        evt = names[rid] if rid < len(names) else str(rid)
+        return "%s_EVT_%s" % (MODULE_NAMES[module].upper(), evt)
+    return "user_%d" % rid
+
+
+def parse(data):
+    magic, version, record_size, _ = struct.unpack_from(HEADER_FMT, data, 0)
+    if magic != TRACE_MAGIC:
+        raise ValueError("bad magic: 0x%08X" % magic)
+    if record_size != struct.calcsize(RECORD_FMT):
+        raise ValueError("unsupported record size: %d (version %d)" % (record_size, version))
+    offset = struct.calcsize(HEADER_FMT)
+    while offset + record_size <= len(data):
+        yield struct.unpack_from(RECORD_FMT, data, offset)
+        offset += record_size
+
+
+def convert(records, ts_hz):
+    events = []
+    last_ts = None
+    base = 0
+    for ts, kind, module, rid, conn_id, _, handle, value in records:
+        # 32-bit 时间戳回绕
+        if (last_ts is not None) and (ts < last_ts):
+            base += 1 << 32
+        last_ts = ts
+        us = (base + ts) * 1e6 / ts_hz
+
+        args = {}
+        if conn_id != CONN_ID_NONE:
+            args["conn_id"] = conn_id
+        if handle != 0:
+            args["handle"] = "0x%04X" % handle
+        if kind in (KIND_API_EXIT, KIND_EVT_EXIT, KIND_EVT_QUEUE, KIND_USER):
+            args["value"] = value
+
+        phase = {
+            KIND_API_ENTER: "B",
+            KIND_API_EXIT: "E",
+            KIND_EVT_ENTER: "B",
+            KIND_EVT_EXIT: "E",
+        }.get(kind, "i")
+        name = record_name(module, rid)
+        if kind == KIND_EVT_QUEUE:
+            name = "queue " + name
+        event = {
+            "name": name,
+            "cat": MODULE_NAMES.get(module, "unknown"),
+            "ph": phase,
+            "ts": us,
+            "pid": 0,
+            # API 调用与事件分发分别显示在不同的轨道上
+            "tid": "api" if module in (MODULE_API, MODULE_USER) else "event",
+            "args": args,
+        }
+        if phase == "i":
+            event["s"] = "t"
+        events.append(event)
+    return {"traceEvents": events, "displayTimeUnit": "ms"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="xf_ble trace to Chrome/Perfetto JSON")
+    parser.add_argument("input", help="binary trace from xf_ble_trace_dump()")
+    parser.add_argument("-o", "--output", help="output JSON file (default: stdout)")
+    parser.add_argument("--ts-hz", type=float, default=1e6,
+                        help="timestamp frequency in Hz (default: 1e6, i.e. microseconds)")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+    trace = convert(parse(data), args.ts_hz)
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    json.dump(trace, out, indent=1)
+    if args.output:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()